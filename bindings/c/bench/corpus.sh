@@ -0,0 +1,59 @@
+#!/bin/bash
+# Run the corpus benchmarks for Go, the C ABI and the Python cffi wrapper
+# and regenerate the "Cross-Language Corpus Benchmarks" section of
+# PERFORMANCE.md from them.
+#
+# Usage (from anywhere):
+#   bindings/c/bench/corpus.sh [max_threads] [millis_per_run]
+#
+# Raw results go to bindings/c/lib/; the merged report is written to
+# bindings/c/bench/corpus_report.json, from which the Markdown can be
+# re-rendered with `go run ./cmd/benchreport -in ... -update PERFORMANCE.md`.
+# The Python driver is skipped when the cffi module is not installed.
+
+set -e
+
+BENCH_DIR="$(cd "$(dirname "$0")" && pwd)"
+C_DIR="$(dirname "$BENCH_DIR")"
+ROOT="$(cd "$C_DIR/../.." && pwd)"
+LIB_DIR="$C_DIR/lib"
+THREADS="${1:-$(nproc 2>/dev/null || echo 4)}"
+MILLIS="${2:-200}"
+
+"$C_DIR/build.sh" >/dev/null
+
+echo "Go corpus benchmarks..."
+cpus=1
+c=2
+while [ "$c" -lt "$THREADS" ]; do
+    cpus="$cpus,$c"
+    c=$((c * 2))
+done
+[ "$THREADS" -gt 1 ] && cpus="$cpus,$THREADS"
+(
+    cd "$ROOT"
+    go test ./pkg/exi -run '^$' -bench '^BenchmarkCorpus$' -benchmem
+    go test ./pkg/exi -run '^$' -bench '^BenchmarkCorpusParallel$' -benchmem -cpu "$cpus"
+) > "$LIB_DIR/corpus_go.txt"
+
+echo "C corpus benchmark..."
+g++ -O2 -std=c++17 -pthread -I"$C_DIR/include" "$BENCH_DIR/corpus_bench.cpp" \
+    -L"$LIB_DIR" -lv2gcodec -Wl,-rpath,"$LIB_DIR" -o "$LIB_DIR/corpus_bench"
+"$LIB_DIR/corpus_bench" "$ROOT/testvectors" "$THREADS" "$MILLIS" > "$LIB_DIR/corpus_c.jsonl"
+
+args=(-c "$LIB_DIR/corpus_c.jsonl" -go "$LIB_DIR/corpus_go.txt")
+if python3 -c "import cffi" 2>/dev/null; then
+    echo "Python cffi corpus benchmark..."
+    (
+        cd "$ROOT/bindings/python/cffi"
+        V2G_CODEC_LIBRARY="$LIB_DIR/libv2gcodec.so" python3 bench_cffi.py \
+            "$ROOT/testvectors" --threads "$THREADS" --millis "$MILLIS"
+    ) > "$LIB_DIR/corpus_python.jsonl"
+    args+=(-python "$LIB_DIR/corpus_python.jsonl")
+else
+    echo "cffi not installed; skipping the Python driver"
+fi
+
+cd "$ROOT"
+go run ./cmd/benchreport "${args[@]}" -json "$BENCH_DIR/corpus_report.json" -update PERFORMANCE.md
+echo "Updated PERFORMANCE.md and $BENCH_DIR/corpus_report.json"
@@ -0,0 +1,331 @@
+// Corpus benchmark for libv2gcodec.
+//
+// Runs every message in testvectors/*.exi through the four operations that
+// the Go and Python corpus benchmarks also measure, each through a
+// per-thread v2g_ctx:
+//
+//	decode       v2g_ctx_decode_native       EXI -> C struct
+//	decode_json  v2g_ctx_decode_struct_into  EXI -> JSON
+//	encode       v2g_ctx_encode_native       C struct -> EXI
+//	encode_json  v2g_ctx_encode_struct_into  JSON -> EXI
+//
+// Every call is timed, so the results carry p50/p99 latency next to the
+// throughput. Each message is measured on one thread; the mixed corpus
+// (all messages in turn) is measured at 1, 2, 4, ... max_threads threads.
+// One JSON object per result is written to stdout, in the format
+// cmd/benchreport reads; a readable table goes to stderr.
+//
+// Build and run (from bindings/c, after ./build.sh):
+//
+//	g++ -O2 -std=c++17 -pthread -Iinclude bench/corpus_bench.cpp -Llib -lv2gcodec -Wl,-rpath,'$ORIGIN/../lib' -o lib/corpus_bench
+//	lib/corpus_bench ../../testvectors [max_threads] [millis_per_run] > corpus_c.jsonl
+//
+// License: Apache-2.0 (match repository)
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <glob.h>
+
+#include "v2gcodec.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// kMaxSamples bounds the latency samples kept per thread and run; calls
+// past it are still counted.
+constexpr size_t kMaxSamples = 1 << 22;
+
+// Vector is one test vector with the values the encode operations start
+// from.
+struct Vector {
+  std::string name;
+  int type = 0;
+  std::vector<uint8_t> exi;
+  std::string json;
+  size_t structSize = 0;
+  bool native = false; // NativeMessage can hold the decoded message
+};
+
+enum Op { kDecode, kDecodeJSON, kEncode, kEncodeJSON, kNumOps };
+
+const char *const kOpNames[kNumOps] = {"decode", "decode_json", "encode", "encode_json"};
+const char *const kOpAPIs[kNumOps] = {"v2g_ctx_decode_native", "v2g_ctx_decode_struct_into",
+                                      "v2g_ctx_encode_native", "v2g_ctx_encode_struct_into"};
+
+bool UsesNative(Op op) { return op == kDecode || op == kEncode; }
+
+// kBytesCap is the capacity given to each struct v2g_bytes member.
+constexpr size_t kBytesCap = 4096;
+
+// NativeMessage is the C struct for one message type. The struct v2g_bytes
+// members of the certificate messages point at buffers it owns; other
+// messages with such members are left out of the native operations.
+struct NativeMessage {
+  std::vector<uint64_t> words;
+  std::vector<uint8_t> storage;
+
+  NativeMessage() = default;
+  NativeMessage(int type, size_t size) : words(size / sizeof(uint64_t) + 1) {
+    std::vector<struct v2g_bytes *> members;
+    auto chain = [&](struct v2g_CertificateChain *c) {
+      for (auto &cert : c->Certificates) {
+        members.push_back(&cert);
+      }
+    };
+    if (type == V2G_MSG_CertificateInstallationReq) {
+      chain(&static_cast<struct v2g_CertificateInstallationReq *>(get())->OEMProvisioningCertChain);
+    } else if (type == V2G_MSG_CertificateInstallationRes) {
+      auto *m = static_cast<struct v2g_CertificateInstallationRes *>(get());
+      chain(&m->CPSCertificateChain);
+      chain(&m->ContractCertificateChain);
+      members.push_back(&m->ContractSignatureEncryptedPrivateKey);
+      members.push_back(&m->DHPublicKey);
+    }
+    storage.resize(members.size() * kBytesCap);
+    for (size_t i = 0; i < members.size(); ++i) {
+      members[i]->bytes = storage.data() + i * kBytesCap;
+      members[i]->bytesCap = kBytesCap;
+    }
+  }
+  void *get() { return words.data(); }
+};
+
+// Workspace is the per-thread state: a context, output buffers and a
+// decoded copy of every native message to encode from.
+struct Workspace {
+  v2g_ctx ctx = 0;
+  std::vector<uint8_t> out;
+  std::vector<char> json;
+  std::vector<NativeMessage> msgs;
+  std::vector<uint32_t> samples;
+
+  explicit Workspace(const std::vector<Vector> &corpus)
+      : ctx(v2g_ctx_create()), out(1 << 16), json(1 << 18), msgs(corpus.size()) {
+    for (size_t i = 0; i < corpus.size(); ++i) {
+      if (!corpus[i].native) {
+        continue;
+      }
+      msgs[i] = NativeMessage(corpus[i].type, corpus[i].structSize);
+      v2g_ctx_decode_native(ctx, corpus[i].type, corpus[i].exi.data(), corpus[i].exi.size(),
+                            msgs[i].get());
+    }
+    samples.reserve(kMaxSamples);
+  }
+  ~Workspace() { v2g_ctx_destroy(ctx); }
+
+  int Call(Op op, const Vector &v, size_t index) {
+    size_t written = 0;
+    switch (op) {
+    case kDecode:
+      return v2g_ctx_decode_native(ctx, v.type, v.exi.data(), v.exi.size(), msgs[index].get());
+    case kDecodeJSON:
+      return v2g_ctx_decode_struct_into(ctx, v.type, v.exi.data(), v.exi.size(), json.data(),
+                                        json.size(), &written);
+    case kEncode:
+      return v2g_ctx_encode_native(ctx, v.type, msgs[index].get(), out.data(), out.size(),
+                                   &written);
+    default:
+      return v2g_ctx_encode_struct_into(ctx, v.type, v.json.data(), v.json.size(), out.data(),
+                                        out.size(), &written);
+    }
+  }
+};
+
+struct Result {
+  uint64_t calls = 0;
+  double seconds = 0;
+  uint64_t p50 = 0, p99 = 0;
+};
+
+// Run calls op on threads threads for millis and merges their samples.
+// indices lists the corpus entries each thread cycles through.
+Result Run(const std::vector<Vector> &corpus, const std::vector<size_t> &indices, Op op,
+           int threads, int millis) {
+  std::atomic<bool> start{false}, stop{false};
+  std::atomic<int> ready{0};
+  std::vector<uint64_t> counts(threads);
+  std::vector<std::vector<uint32_t>> samples(threads);
+  std::vector<std::thread> pool;
+  for (int t = 0; t < threads; ++t) {
+    pool.emplace_back([&, t] {
+      Workspace ws(corpus);
+      ready.fetch_add(1);
+      while (!start.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+      }
+      uint64_t n = 0;
+      for (size_t k = 0; !stop.load(std::memory_order_relaxed); ++k) {
+        size_t i = indices[k % indices.size()];
+        auto t0 = Clock::now();
+        int rc = ws.Call(op, corpus[i], i);
+        auto t1 = Clock::now();
+        if (rc != V2G_OK) {
+          std::fprintf(stderr, "%s %s failed: %d (%s)\n", kOpAPIs[op], corpus[i].name.c_str(),
+                       rc, v2g_last_error());
+          std::exit(1);
+        }
+        if (ws.samples.size() < kMaxSamples) {
+          ws.samples.push_back(static_cast<uint32_t>(
+              std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()));
+        }
+        ++n;
+      }
+      counts[t] = n;
+      samples[t] = std::move(ws.samples);
+    });
+  }
+  while (ready.load() < threads) {
+    std::this_thread::yield();
+  }
+  auto t0 = Clock::now();
+  start.store(true, std::memory_order_release);
+  std::this_thread::sleep_for(std::chrono::milliseconds(millis));
+  stop.store(true);
+  for (auto &t : pool) {
+    t.join();
+  }
+
+  Result r;
+  r.seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+  std::vector<uint32_t> all;
+  for (int t = 0; t < threads; ++t) {
+    r.calls += counts[t];
+    all.insert(all.end(), samples[t].begin(), samples[t].end());
+  }
+  if (!all.empty()) {
+    auto at = [&](double q) {
+      auto it = all.begin() + static_cast<ptrdiff_t>(q * (all.size() - 1));
+      std::nth_element(all.begin(), it, all.end());
+      return static_cast<uint64_t>(*it);
+    };
+    r.p50 = at(0.50);
+    r.p99 = at(0.99);
+  }
+  return r;
+}
+
+void Report(Op op, const std::string &message, size_t bytes, int threads, const Result &r) {
+  double rate = r.calls / r.seconds;
+  std::printf("{\"driver\":\"c\",\"op\":\"%s\",\"api\":\"%s\",\"message\":\"%s\",\"bytes\":%zu,"
+              "\"threads\":%d,\"calls\":%llu,\"seconds\":%.6f,\"calls_per_sec\":%.1f,"
+              "\"ns_per_call\":%.1f,\"p50_ns\":%llu,\"p99_ns\":%llu}\n",
+              kOpNames[op], kOpAPIs[op], message.c_str(), bytes, threads,
+              static_cast<unsigned long long>(r.calls), r.seconds, rate, 1e9 * threads / rate,
+              static_cast<unsigned long long>(r.p50), static_cast<unsigned long long>(r.p99));
+  std::fflush(stdout);
+  std::fprintf(stderr, "%-28s %-12s %7d %12.0f %9llu %9llu\n", message.c_str(), kOpNames[op],
+               threads, rate, static_cast<unsigned long long>(r.p50),
+               static_cast<unsigned long long>(r.p99));
+}
+
+// LoadCorpus reads dir/*.exi and prepares the JSON and native form of each
+// message.
+bool LoadCorpus(const std::string &dir, std::vector<Vector> *corpus) {
+  glob_t g;
+  if (glob((dir + "/*.exi").c_str(), 0, nullptr, &g) != 0) {
+    std::fprintf(stderr, "no test vectors in %s\n", dir.c_str());
+    return false;
+  }
+  v2g_ctx ctx = v2g_ctx_create();
+  for (size_t i = 0; i < g.gl_pathc; ++i) {
+    std::ifstream in(g.gl_pathv[i], std::ios::binary);
+    Vector v;
+    v.exi.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    struct v2g_MessageHeaderType header;
+    if (v.exi.empty() || v2g_peek_header(v.exi.data(), v.exi.size(), &v.type, &header) != V2G_OK) {
+      std::fprintf(stderr, "%s: skipped: %s\n", g.gl_pathv[i], v2g_last_error());
+      continue;
+    }
+    v.name = v2g_message_type_name(v.type);
+
+    std::vector<char> json(1 << 18);
+    size_t n = 0;
+    if (v2g_ctx_decode_struct_into(ctx, v.type, v.exi.data(), v.exi.size(), json.data(),
+                                   json.size(), &n) != V2G_OK) {
+      std::fprintf(stderr, "%s: skipped: %s\n", g.gl_pathv[i], v2g_last_error());
+      continue;
+    }
+    v.json.assign(json.data(), n);
+
+    v.structSize = v2g_native_struct_size(v.type);
+    NativeMessage msg(v.type, v.structSize);
+    int rc = v2g_ctx_decode_native(ctx, v.type, v.exi.data(), v.exi.size(), msg.get());
+    v.native = rc == V2G_OK;
+    if (!v.native) {
+      std::fprintf(stderr, "%s: no native decode (%d: %s)\n", v.name.c_str(), rc,
+                   v2g_last_error());
+    }
+    corpus->push_back(std::move(v));
+  }
+  globfree(&g);
+  v2g_ctx_destroy(ctx);
+  return !corpus->empty();
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::string dir = argc > 1 ? argv[1] : "../../testvectors";
+  int maxThreads = argc > 2 ? std::atoi(argv[2])
+                            : static_cast<int>(std::thread::hardware_concurrency());
+  int millis = argc > 3 ? std::atoi(argv[3]) : 200;
+  if (maxThreads < 1) {
+    maxThreads = 1;
+  }
+
+  if (v2g_init() != V2G_OK) {
+    std::fprintf(stderr, "v2g_init failed: %s\n", v2g_last_error());
+    return 1;
+  }
+  std::vector<Vector> corpus;
+  if (!LoadCorpus(dir, &corpus)) {
+    return 1;
+  }
+  std::fprintf(stderr, "%s, %zu messages, %d ms per run\n", v2g_version(), corpus.size(),
+               millis);
+  std::fprintf(stderr, "%-28s %-12s %7s %12s %9s %9s\n", "message", "op", "threads", "calls/s",
+               "p50 ns", "p99 ns");
+
+  for (size_t i = 0; i < corpus.size(); ++i) {
+    for (int op = 0; op < kNumOps; ++op) {
+      if (UsesNative(Op(op)) && !corpus[i].native) {
+        continue;
+      }
+      Result r = Run(corpus, {i}, Op(op), 1, millis);
+      Report(Op(op), corpus[i].name, corpus[i].exi.size(), 1, r);
+    }
+  }
+
+  std::vector<int> counts;
+  for (int t = 1; t < maxThreads; t *= 2) {
+    counts.push_back(t);
+  }
+  counts.push_back(maxThreads);
+  for (int op = 0; op < kNumOps; ++op) {
+    std::vector<size_t> mix;
+    size_t bytes = 0;
+    for (size_t i = 0; i < corpus.size(); ++i) {
+      if (!UsesNative(Op(op)) || corpus[i].native) {
+        mix.push_back(i);
+        bytes += corpus[i].exi.size();
+      }
+    }
+    for (int t : counts) {
+      Result r = Run(corpus, mix, Op(op), t, millis);
+      Report(Op(op), "corpus", bytes / mix.size(), t, r);
+    }
+  }
+  v2g_shutdown();
+  return 0;
+}
@@ -0,0 +1,200 @@
+// Multi-threaded scaling benchmark for libv2gcodec.
+//
+// Every thread decodes the same SessionSetupReq in a loop through
+// v2g_decode_exi (XML output), v2g_decode_native and v2g_ctx_decode_native
+// (one context per thread) for a fixed time. For each thread count it
+// prints the aggregate throughput and the speedup over one thread; with
+// lock-free dispatch the speedup should track the thread count up to the
+// number of cores. It also checks that v2g_last_error is per thread.
+//
+// Build and run (from bindings/c, after ./build.sh):
+//
+//	g++ -O2 -std=c++17 -pthread -Iinclude bench/scaling_bench.cpp -Llib -lv2gcodec -Wl,-rpath,'$ORIGIN/../lib' -o lib/scaling_bench
+//	lib/scaling_bench [max_threads] [millis_per_run]
+//
+// License: Apache-2.0 (match repository)
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "v2gcodec.h"
+
+namespace {
+
+const char kSessionSetupReqXML[] =
+    "<SessionSetupReq><Header><SessionID>0102030405060708</SessionID>"
+    "<TimeStamp>1700000000</TimeStamp></Header>"
+    "<EVCCID>574D4956313233343536373839304142434445</EVCCID></SessionSetupReq>";
+
+struct Payload {
+  std::vector<uint8_t> exi;
+};
+
+enum class Mode { DecodeXML, DecodeNative, CtxDecodeNative };
+
+const char *ModeName(Mode m) {
+  switch (m) {
+  case Mode::DecodeXML:
+    return "v2g_decode_exi";
+  case Mode::DecodeNative:
+    return "v2g_decode_native";
+  case Mode::CtxDecodeNative:
+    return "v2g_ctx_decode_native";
+  }
+  return "?";
+}
+
+// Worker runs the selected decode until stop is set and returns the number
+// of completed calls.
+uint64_t Worker(Mode mode, const Payload &p, const std::atomic<bool> &start,
+                const std::atomic<bool> &stop) {
+  v2g_ctx ctx = mode == Mode::CtxDecodeNative ? v2g_ctx_create() : 0;
+  v2g_SessionSetupReq msg;
+  uint64_t n = 0;
+  while (!start.load(std::memory_order_acquire)) {
+    std::this_thread::yield();
+  }
+  while (!stop.load(std::memory_order_relaxed)) {
+    int rc = V2G_OK;
+    switch (mode) {
+    case Mode::DecodeXML: {
+      char *xml = nullptr;
+      size_t len = 0;
+      rc = v2g_decode_exi(p.exi.data(), p.exi.size(), &xml, &len);
+      v2g_free_buffer(xml);
+      break;
+    }
+    case Mode::DecodeNative:
+      rc = v2g_decode_native(V2G_MSG_SessionSetupReq, p.exi.data(),
+                             p.exi.size(), &msg);
+      break;
+    case Mode::CtxDecodeNative:
+      rc = v2g_ctx_decode_native(ctx, V2G_MSG_SessionSetupReq, p.exi.data(),
+                                 p.exi.size(), &msg);
+      break;
+    }
+    if (rc != V2G_OK) {
+      std::fprintf(stderr, "%s failed: %d (%s)\n", ModeName(mode), rc,
+                   v2g_last_error());
+      std::exit(1);
+    }
+    ++n;
+  }
+  if (ctx != 0) {
+    v2g_ctx_destroy(ctx);
+  }
+  return n;
+}
+
+double Run(Mode mode, const Payload &p, int threads, int millis) {
+  std::atomic<bool> start{false}, stop{false};
+  std::vector<uint64_t> counts(threads);
+  std::vector<std::thread> pool;
+  for (int i = 0; i < threads; ++i) {
+    pool.emplace_back([&, i] { counts[i] = Worker(mode, p, start, stop); });
+  }
+  auto t0 = std::chrono::steady_clock::now();
+  start.store(true, std::memory_order_release);
+  std::this_thread::sleep_for(std::chrono::milliseconds(millis));
+  stop.store(true);
+  for (auto &t : pool) {
+    t.join();
+  }
+  double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  uint64_t total = 0;
+  for (uint64_t c : counts) {
+    total += c;
+  }
+  return total / secs;
+}
+
+// CheckLastErrorIsPerThread makes each thread fail with its own message
+// type and verifies that it reads back its own error.
+bool CheckLastErrorIsPerThread(int threads) {
+  std::atomic<int> ready{0};
+  std::atomic<bool> ok{true};
+  std::vector<std::thread> pool;
+  for (int i = 0; i < threads; ++i) {
+    pool.emplace_back([&, i] {
+      int type = 100 + i;
+      uint8_t out[16];
+      size_t written = 0;
+      v2g_encode_struct_into(type, "{}", 2, out, sizeof out, &written);
+      // Wait until every thread has recorded its error before reading.
+      ready.fetch_add(1);
+      while (ready.load() < threads) {
+        std::this_thread::yield();
+      }
+      const char *err = v2g_last_error();
+      std::string want = "unsupported message type " + std::to_string(type);
+      if (err == nullptr || std::strstr(err, want.c_str()) == nullptr) {
+        std::fprintf(stderr, "thread %d: last error %s, want ...%s\n", i,
+                     err ? err : "(null)", want.c_str());
+        ok = false;
+      }
+    });
+  }
+  for (auto &t : pool) {
+    t.join();
+  }
+  return ok;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  int maxThreads = argc > 1 ? std::atoi(argv[1])
+                            : static_cast<int>(std::thread::hardware_concurrency());
+  int millis = argc > 2 ? std::atoi(argv[2]) : 500;
+  if (maxThreads < 1) {
+    maxThreads = 1;
+  }
+
+  if (v2g_init() != V2G_OK) {
+    std::fprintf(stderr, "v2g_init failed: %s\n", v2g_last_error());
+    return 1;
+  }
+  Payload p;
+  uint8_t *exi = nullptr;
+  size_t exiLen = 0;
+  if (v2g_encode_xml(reinterpret_cast<const uint8_t *>(kSessionSetupReqXML),
+                     std::strlen(kSessionSetupReqXML), &exi, &exiLen) != V2G_OK) {
+    std::fprintf(stderr, "v2g_encode_xml failed: %s\n", v2g_last_error());
+    return 1;
+  }
+  p.exi.assign(exi, exi + exiLen);
+  v2g_free_buffer(exi);
+
+  if (!CheckLastErrorIsPerThread(maxThreads)) {
+    return 1;
+  }
+  std::printf("v2g_last_error is per thread (%d threads)\n", maxThreads);
+
+  std::vector<int> counts;
+  for (int t = 1; t < maxThreads; t *= 2) {
+    counts.push_back(t);
+  }
+  counts.push_back(maxThreads);
+
+  for (Mode mode : {Mode::DecodeXML, Mode::DecodeNative, Mode::CtxDecodeNative}) {
+    std::printf("\n%s (%zu-byte SessionSetupReq)\n", ModeName(mode), p.exi.size());
+    std::printf("%8s %14s %9s %11s\n", "threads", "calls/s", "speedup", "efficiency");
+    double base = 0;
+    for (int t : counts) {
+      double rate = Run(mode, p, t, millis);
+      if (t == 1) {
+        base = rate;
+      }
+      std::printf("%8d %14.0f %8.2fx %10.0f%%\n", t, rate, rate / base,
+                  100 * rate / (base * t));
+    }
+  }
+  v2g_shutdown();
+  return 0;
+}
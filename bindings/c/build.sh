@@ -41,7 +41,7 @@ mkdir -p "$OUTPUT_DIR"
 cd "$BUILD_DIR"
 go build -buildmode=c-shared -o "$OUTPUT_PATH" \
     -ldflags="-s -w" \
-    v2gcodec.go v2gcodec_native.go
+    .
 
 echo ""
 echo "Build complete!"
@@ -58,6 +58,6 @@ echo "  python3 ../python/cffi/v2gcodec_cffi.py"
 echo ""
 echo "To install system-wide (Linux/macOS):"
 echo "  sudo cp ${OUTPUT_PATH} /usr/local/lib/"
-echo "  sudo cp include/v2gcodec.h /usr/local/include/"
+echo "  sudo cp include/v2gcodec.h include/v2gcodec_types.h /usr/local/include/"
 echo "  sudo ldconfig  # Linux only"
 echo ""
@@ -19,7 +19,9 @@
  *
  * Notes:
  *  - All output buffers returned from encode/decode functions are allocated
- *    by the library. Call `v2g_free_buffer` to release them.
+ *    by the library. Call `v2g_free_buffer` to release them. The `*_into`
+ *    variants write into caller-owned buffers instead and allocate nothing
+ *    the caller has to release.
  *  - Functions return 0 (V2G_OK) on success, non-zero error codes otherwise.
  *  - The library maintains a thread-local last error string accessible via
  *    `v2g_last_error()`; copy the string if you need it to survive further
@@ -33,6 +35,9 @@
 
 #include <stddef.h> /* for size_t */
 #include <stdint.h> /* for uint8_t */
+#include <sys/uio.h> /* for struct iovec */
+
+#include "v2gcodec_types.h" /* plain C message structs (v2g_*_native) */
 
 #ifdef __cplusplus
 extern "C" {
@@ -48,6 +53,9 @@ enum v2g_status {
   V2G_ERR_DECODE = 5,      /* decode failure */
   V2G_ERR_SCHEMA = 6,      /* schema / grammar error */
   V2G_ERR_OOM = 7,         /* out of memory */
+  V2G_ERR_BUFFER_TOO_SMALL = 8, /* caller buffer too small; see *written */
+  V2G_NEED_MORE = 9,       /* v2g_stream_feed: message incomplete, feed more */
+  V2G_ERR_BUSY = 10,       /* v2g_submit: queue full, poll and retry */
   V2G_ERR_INTERNAL = 254   /* internal/unclassified error */
 };
 
@@ -57,8 +65,15 @@ enum v2g_status {
  * Initialize global runtime state. Must be called before other API calls
  * except `v2g_version` and `v2g_last_error`.
  *
+ * If the environment variable V2G_GRAMMAR_CACHE names a grammar cache
+ * (written by `v2gcodec generate -grammar-cache`), its grammars are loaded
+ * from it. The XSDs recorded in the cache are hashed, and parsed instead
+ * only if they changed; a cache shipped without its XSDs is used as is.
+ *
  * Returns:
- *   V2G_OK on success, or an error code on failure.
+ *   V2G_OK on success, V2G_ERR_SCHEMA if V2G_GRAMMAR_CACHE is set but
+ *   neither the cache nor its sources can be loaded, or another error code
+ *   on failure.
  */
 int v2g_init(void);
 
@@ -94,6 +109,10 @@ int v2g_shutdown(void);
  * Notes:
  *   - Some XSD files (e.g. ISO-distributed schemas) may be subject to external
  *     licensing; the library does not attempt to redistribute schemas.
+ *   - With a grammar cache configured (V2G_GRAMMAR_CACHE or the
+ *     "grammar-cache" option) whose source hash matches `paths`, the grammars
+ *     are loaded from the cache instead of parsing the XSDs. The cache is
+ *     never written by the library.
  */
 int v2g_load_schemas(const char **paths, size_t count);
 
@@ -102,6 +121,13 @@ int v2g_load_schemas(const char **paths, size_t count);
  *
  * Encode the provided XML document (UTF-8 bytes) into EXI bytes.
  *
+ * The root element selects the ISO 15118-20 message (e.g. SessionSetupReq);
+ * elements are matched by local name, so namespace prefixes are accepted,
+ * and binary fields use the hexBinary form. The output is identical to
+ * encoding the same message with v2g_encode_struct. After
+ * v2g_set_option("use-stub", "true") the legacy minify+gzip payload is
+ * produced instead.
+ *
  * Parameters:
  *   xml       - pointer to XML bytes
  *   xml_len   - length of xml in bytes
@@ -128,7 +154,8 @@ int v2g_encode_xml(const uint8_t *xml, size_t xml_len, uint8_t **out_exi,
 /*
  * v2g_decode_exi
  *
- * Decode the provided EXI bytes into an XML document (UTF-8).
+ * Decode the provided EXI bytes into an XML document (UTF-8). The document
+ * carries no XML declaration or namespace declarations.
  *
  * Parameters:
  *   exi       - pointer to EXI bytes
@@ -196,6 +223,16 @@ const char *v2g_version(void);
  * configuration of the runtime (e.g. toggling stub mode or enabling debug
  * logging). Options and values are interpreted by the implementation.
  *
+ * Options:
+ *   "use-stub" - any value but "false" switches v2g_encode_xml and
+ *                v2g_decode_exi to the legacy minify+gzip stub; the default
+ *                is schema-informed EXI.
+ *   "stats"    - "true" or "false" turns the statistics read by
+ *                v2g_get_stats on or off (default off); "reset" zeroes
+ *                them. Turning them off keeps the values.
+ *   "grammar-cache" - path of the grammar cache v2g_load_schemas prefers
+ *                (default $V2G_GRAMMAR_CACHE); "" disables it.
+ *
  * Parameters:
  *   name  - NUL-terminated option name
  *   value - NUL-terminated option value
@@ -208,13 +245,16 @@ int v2g_set_option(const char *name, const char *value);
 
 /* Thread-safety:
  *
- * - The library supports concurrent calls from multiple threads for encode /
- *   decode operations provided that v2g_init has been called and v2g_shutdown
- *   is not concurrently executing. Certain implementations may require
- *   calling v2g_init from the main thread; consult implementation notes.
+ * - All entry points may be called concurrently from any number of threads.
+ *   Encode and decode calls take no locks: the codec is published through an
+ *   atomic pointer, and v2g_load_schemas, v2g_set_option and v2g_shutdown
+ *   swap in a replacement while calls already in flight finish with the
+ *   codec they started with. Calls made after v2g_shutdown returns fail
+ *   with V2G_ERR_INIT until v2g_init is called again.
  *
- * - The last-error string accessed via v2g_last_error() is thread-local when
- *   possible. Do not assume it is global across threads.
+ * - The last-error string accessed via v2g_last_error() is thread-local: it
+ *   reports the most recent failure on the calling thread only (messages
+ *   longer than 511 bytes are truncated).
  */
 
 /*
@@ -262,6 +302,412 @@ int v2g_encode_struct(int msg_type, const char *json_data, size_t json_len,
 int v2g_decode_struct(int msg_type, const uint8_t *exi_data, size_t exi_len,
                       char **out_json, size_t *out_len);
 
+/*
+ * v2g_encode_struct_into
+ *
+ * Same as v2g_encode_struct, but writes the EXI bytes into a buffer owned by
+ * the caller instead of allocating one. Nothing needs to be freed afterwards,
+ * which makes this variant suitable for hot paths and pre-allocated pools.
+ *
+ * Parameters:
+ *   msg_type  - message type identifier (see V2G_MSG_* constants below)
+ *   json_data - pointer to JSON-encoded message structure
+ *   json_len  - length of json_data in bytes
+ *   out       - caller-owned destination buffer (may be NULL if out_cap is 0)
+ *   out_cap   - capacity of out in bytes
+ *   written   - receives the number of bytes written
+ *
+ * Returns:
+ *   V2G_OK on success. If out_cap is too small, V2G_ERR_BUFFER_TOO_SMALL is
+ *   returned, nothing is written to out and *written holds the required
+ *   capacity; retry with a buffer of at least that size.
+ */
+int v2g_encode_struct_into(int msg_type, const char *json_data,
+                           size_t json_len, uint8_t *out, size_t out_cap,
+                           size_t *written);
+
+/*
+ * v2g_decode_struct_into
+ *
+ * Same as v2g_decode_struct, but writes the NUL-terminated JSON into a buffer
+ * owned by the caller instead of allocating one.
+ *
+ * Parameters:
+ *   msg_type  - message type identifier (see V2G_MSG_* constants below)
+ *   exi_data  - pointer to EXI bytes
+ *   exi_len   - length of exi_data in bytes
+ *   out       - caller-owned destination buffer (may be NULL if out_cap is 0)
+ *   out_cap   - capacity of out in bytes, including room for the trailing NUL
+ *   written   - receives the JSON length in bytes (excluding the NUL)
+ *
+ * Returns:
+ *   V2G_OK on success. If out_cap is too small, V2G_ERR_BUFFER_TOO_SMALL is
+ *   returned, nothing is written to out and *written holds the required
+ *   capacity (including the trailing NUL).
+ */
+int v2g_decode_struct_into(int msg_type, const uint8_t *exi_data,
+                           size_t exi_len, char *out, size_t out_cap,
+                           size_t *written);
+
+/*
+ * V2GTP framing
+ *
+ * Every message on the ISO 15118-20 TCP/TLS connection is preceded by an
+ * 8-byte V2GTP header: version 0x01, inverse version 0xFE, a big-endian
+ * 16-bit payload type and a big-endian 32-bit payload length.
+ *
+ * v2g_v2gtp_parse_header reads the header at data in place. It returns
+ * V2G_OK with the payload type and length (the payload starts at data + 8),
+ * V2G_NEED_MORE if len < 8, or V2G_ERR_DECODE if the version bytes are wrong.
+ *
+ * v2g_encode_struct_v2gtp / v2g_encode_native_v2gtp encode a message as a
+ * complete packet into out: the EXI body is written directly after the
+ * 8-byte header slot, and the header is filled in afterwards. Arguments are
+ * the same as for v2g_encode_struct_into / v2g_encode_native, plus the
+ * payload type (V2G_V2GTP_PAYLOAD_*). *written covers header and body. On
+ * V2G_ERR_BUFFER_TOO_SMALL it holds the capacity needed, and the contents of
+ * out are unspecified.
+ *
+ * v2g_v2gtp_iov writes the header for payload into header (8 bytes owned by
+ * the caller) and sets iov[0] to the header and iov[1] to payload, ready for
+ * writev(fd, iov, 2). Nothing is copied; both buffers must stay valid until
+ * the write completes.
+ */
+#define V2G_V2GTP_HEADER_SIZE 8
+#define V2G_V2GTP_PAYLOAD_SAP 0x8001
+#define V2G_V2GTP_PAYLOAD_MAIN 0x8002
+#define V2G_V2GTP_PAYLOAD_AC 0x8003
+#define V2G_V2GTP_PAYLOAD_DC 0x8004
+#define V2G_V2GTP_PAYLOAD_ACDP 0x8005
+#define V2G_V2GTP_PAYLOAD_WPT 0x8006
+#define V2G_V2GTP_PAYLOAD_SDP_REQUEST 0x9000
+#define V2G_V2GTP_PAYLOAD_SDP_RESPONSE 0x9001
+
+int v2g_v2gtp_parse_header(const uint8_t *data, size_t len,
+                           uint16_t *payload_type, uint32_t *payload_len);
+int v2g_encode_struct_v2gtp(int msg_type, const char *json_data,
+                            size_t json_len, uint16_t payload_type,
+                            uint8_t *out, size_t out_cap, size_t *written);
+int v2g_encode_native_v2gtp(int msg_type, const void *msg,
+                            uint16_t payload_type, uint8_t *out,
+                            size_t out_cap, size_t *written);
+int v2g_ctx_encode_native_v2gtp(v2g_ctx ctx, int msg_type, const void *msg,
+                                uint16_t payload_type, uint8_t *out,
+                                size_t out_cap, size_t *written);
+int v2g_v2gtp_iov(uint16_t payload_type, const uint8_t *payload,
+                  size_t payload_len, uint8_t header[8], struct iovec iov[2]);
+
+/*
+ * v2g_encode_native
+ *
+ * Encode a message given as a plain C struct (see v2gcodec_types.h) into EXI
+ * bytes written to a caller-owned buffer. Fields are copied directly from the
+ * struct; no JSON or XML serialization is involved.
+ *
+ * Parameters:
+ *   msg_type - message type identifier (see V2G_MSG_* constants below)
+ *   msg      - pointer to the struct v2g_<MessageType> matching msg_type
+ *   out      - caller-owned destination buffer (may be NULL if out_cap is 0)
+ *   out_cap  - capacity of out in bytes
+ *   written  - receives the number of EXI bytes written
+ *
+ * Returns:
+ *   V2G_OK on success. V2G_ERR_BUFFER_TOO_SMALL if out_cap is insufficient,
+ *   with the required capacity stored in *written. V2G_ERR_INVALID_ARG if a
+ *   length or count member exceeds its array capacity.
+ *
+ * Ownership:
+ *   The library reads msg (and any struct v2g_bytes buffers it points to)
+ *   only for the duration of the call.
+ */
+int v2g_encode_native(int msg_type, const void *msg, uint8_t *out,
+                      size_t out_cap, size_t *written);
+
+/*
+ * v2g_encoded_size_native
+ *
+ * Compute the exact number of bytes v2g_encode_native writes for msg,
+ * without encoding it, so the caller can allocate the output buffer once.
+ * Costs a fraction of an encode: for a message with certificate chains the
+ * certificates are counted, not copied.
+ *
+ * Returns:
+ *   V2G_OK with the size stored in *size, or the error v2g_encode_native
+ *   would return.
+ */
+int v2g_encoded_size_native(int msg_type, const void *msg, size_t *size);
+
+/*
+ * v2g_decode_native
+ *
+ * Decode EXI bytes into a plain C struct (see v2gcodec_types.h).
+ *
+ * Parameters:
+ *   msg_type - message type identifier (see V2G_MSG_* constants below)
+ *   exi_data - pointer to EXI bytes
+ *   exi_len  - length of exi_data in bytes
+ *   msg      - pointer to the struct v2g_<MessageType> to fill
+ *
+ * Returns:
+ *   V2G_OK on success. V2G_ERR_DECODE if the bytes are malformed or encode a
+ *   different message type. V2G_ERR_BUFFER_TOO_SMALL if a decoded value does
+ *   not fit: either a fixed array capacity is exceeded or a struct v2g_bytes
+ *   member has insufficient bytesCap (its bytesLen then holds the size
+ *   needed).
+ *
+ * Memory ownership:
+ *   Nothing is allocated. struct v2g_bytes members are filled into the
+ *   buffers the caller provided before the call.
+ */
+int v2g_decode_native(int msg_type, const uint8_t *exi_data, size_t exi_len,
+                      void *msg);
+
+/*
+ * v2g_peek_header
+ *
+ * Decode only the message type and the MessageHeaderType (SessionID,
+ * TimeStamp) at the start of an EXI message, e.g. to route it to the
+ * thread that owns the session, without decoding the body. The cost does
+ * not depend on the body size, so certificate-bearing messages peek as
+ * fast as small ones.
+ *
+ * Returns:
+ *   V2G_OK with *msg_type and *header filled in. V2G_ERR_DECODE if the
+ *   bytes do not start with a valid message header, V2G_ERR_BUFFER_TOO_SMALL
+ *   if the SessionID is longer than V2G_SESSION_ID_SIZE.
+ */
+int v2g_peek_header(const uint8_t *exi_data, size_t exi_len, int *msg_type,
+                    struct v2g_MessageHeaderType *header);
+
+/*
+ * v2g_validate_exi
+ *
+ * Check that exi_data starts with a well-formed EXI message without
+ * decoding it into a struct: the 0x80 header, a known message type, and a
+ * body whose length prefixes and list counts stay inside the buffer, with
+ * at most 4096 list entries in total. The decode functions bound no list,
+ * so this is stricter than they are; otherwise it accepts what they accept,
+ * but binary and string content is skipped rather than copied, so it is
+ * cheaper than a decode and its cost does not grow with certificate sizes.
+ *
+ * Parameters:
+ *   exi_data - pointer to EXI bytes
+ *   exi_len  - length of exi_data in bytes
+ *   msg_type - if not NULL, receives the message type (V2G_MSG_*)
+ *   consumed - if not NULL, receives the number of bytes the message takes;
+ *              it is less than exi_len if trailing bytes follow it
+ *
+ * Returns:
+ *   V2G_OK if the message is well-formed. V2G_ERR_DECODE otherwise, with
+ *   the reason in v2g_last_error().
+ */
+int v2g_validate_exi(const uint8_t *exi_data, size_t exi_len, int *msg_type,
+                     size_t *consumed);
+
+/*
+ * v2g_native_struct_size
+ *
+ * Return sizeof(struct v2g_<MessageType>) as compiled into the library for
+ * msg_type, or 0 for unknown types. Callers can compare it with their own
+ * sizeof to detect a header/library mismatch.
+ */
+size_t v2g_native_struct_size(int msg_type);
+
+/*
+ * v2g_encode_batch / v2g_decode_batch
+ *
+ * Encode or decode an array of messages in a single call, paying the
+ * language-boundary cost once per batch instead of once per message. Each
+ * item is processed exactly like the single-message call for its format
+ * (v2g_encode_struct_into / v2g_decode_struct_into for V2G_FORMAT_JSON,
+ * v2g_encode_native / v2g_decode_native for V2G_FORMAT_NATIVE) and receives
+ * its own status and out_len (see struct v2g_batch_item in
+ * v2gcodec_types.h). A failing item does not stop the batch.
+ *
+ * Parameters:
+ *   format - V2G_FORMAT_JSON or V2G_FORMAT_NATIVE
+ *   items  - array of count descriptors
+ *   count  - number of items (0 is allowed)
+ *   failed - optional; receives the number of items whose status != V2G_OK
+ *
+ * Returns:
+ *   V2G_OK if the batch was processed (check each item's status), or
+ *   V2G_ERR_INVALID_ARG if items is NULL or format is unknown.
+ *
+ * Ownership:
+ *   All input and output buffers are owned by the caller; nothing is
+ *   allocated. v2g_last_error() describes the last failing item.
+ */
+int v2g_encode_batch(int format, struct v2g_batch_item *items, size_t count,
+                     size_t *failed);
+int v2g_decode_batch(int format, struct v2g_batch_item *items, size_t count,
+                     size_t *failed);
+
+/*
+ * v2g_ctx_create / v2g_ctx_destroy
+ *
+ * Create or destroy a reusable codec context. A context owns the encoder
+ * and decoder state (bit stream and scratch buffer), which is kept between
+ * calls, so encoding through a context does not allocate once warmed up.
+ *
+ * A context must not be used by two threads at the same time; create one
+ * per thread. The context-free functions above borrow a context from an
+ * internal pool, so explicit contexts mainly matter on hot paths where the
+ * pool handoff is measurable.
+ *
+ * Returns:
+ *   v2g_ctx_create returns a non-zero handle, never one given out before.
+ *   v2g_ctx_destroy ignores 0 and handles already destroyed, and the
+ *   v2g_ctx_* functions fail with V2G_ERR_INVALID_ARG for them.
+ */
+v2g_ctx v2g_ctx_create(void);
+void v2g_ctx_destroy(v2g_ctx ctx);
+
+/*
+ * v2g_ctx_encode_struct_into / v2g_ctx_decode_struct_into
+ * v2g_ctx_encode_native / v2g_ctx_decode_native
+ *
+ * Same as the corresponding functions without the ctx_ prefix, but using
+ * the given context. Parameters, return values and ownership rules are
+ * identical; V2G_ERR_INVALID_ARG is also returned when ctx is 0.
+ */
+int v2g_ctx_encode_struct_into(v2g_ctx ctx, int msg_type,
+                               const char *json_data, size_t json_len,
+                               uint8_t *out, size_t out_cap, size_t *written);
+int v2g_ctx_decode_struct_into(v2g_ctx ctx, int msg_type,
+                               const uint8_t *exi_data, size_t exi_len,
+                               char *out, size_t out_cap, size_t *written);
+int v2g_ctx_encode_native(v2g_ctx ctx, int msg_type, const void *msg,
+                          uint8_t *out, size_t out_cap, size_t *written);
+int v2g_ctx_decode_native(v2g_ctx ctx, int msg_type, const uint8_t *exi_data,
+                          size_t exi_len, void *msg);
+
+/*
+ * v2g_stream_feed / v2g_stream_decode_native / v2g_stream_reset
+ *
+ * Incremental decoding of EXI messages that arrive in fragments (e.g. V2GTP
+ * payloads read from a TLS socket), without reassembling them first. Each
+ * context carries one stream. A chunk that completes a message is decoded
+ * in place; an incomplete tail is copied into the context and decoding is
+ * retried only once enough bytes have arrived.
+ *
+ * v2g_stream_feed parameters:
+ *   ctx      - context created with v2g_ctx_create
+ *   chunk    - next bytes of the stream; only read during the call
+ *   len      - number of bytes in chunk (0 is allowed)
+ *   consumed - receives the number of bytes of chunk that were used
+ *   msg_type - receives the V2G_MSG_* identifier of a completed message
+ *
+ * Returns:
+ *   V2G_OK when a message completed. It is held in the context until the
+ *   next feed or reset; fetch it with v2g_stream_decode_native. The bytes
+ *   chunk[*consumed..len) belong to the next message: feed them again.
+ *   V2G_NEED_MORE when the chunk was buffered (*consumed == len) and the
+ *   message needs more input.
+ *   V2G_ERR_DECODE when the stream is not a valid message. The buffered
+ *   bytes are discarded, so the next feed starts a new message.
+ *
+ * v2g_stream_decode_native copies the completed message into msg, a struct
+ * of the type reported in *msg_type (see v2g_decode_native). It returns
+ * V2G_ERR_INVALID_ARG if no message is held, and otherwise the same codes
+ * as v2g_decode_native. v2g_stream_reset discards buffered input and any
+ * held message.
+ */
+int v2g_stream_feed(v2g_ctx ctx, const uint8_t *chunk, size_t len,
+                    size_t *consumed, int *msg_type);
+int v2g_stream_decode_native(v2g_ctx ctx, void *msg);
+void v2g_stream_reset(v2g_ctx ctx);
+
+/*
+ * v2g_queue_create / v2g_queue_destroy / v2g_queue_fd
+ * v2g_submit / v2g_poll
+ *
+ * Completion queue for event loops (epoll, io_uring, libuv, ...) that must
+ * not block while a heavy message is encoded or decoded. v2g_submit hands
+ * batch items to worker threads inside the library and returns at once;
+ * each item is processed exactly like v2g_encode_batch / v2g_decode_batch
+ * would, on a codec context owned by its worker. When items complete, the
+ * descriptor returned by v2g_queue_fd becomes readable (an eventfd on
+ * Linux, a pipe elsewhere): add it to the event loop and call v2g_poll when
+ * it fires. v2g_poll never blocks, and may return no completions after a
+ * wakeup. Completions are not ordered across workers.
+ *
+ * v2g_queue_create parameters:
+ *   n_workers - number of worker threads; 0 selects one per CPU
+ *   depth     - number of items submitted and not yet polled that the
+ *               queue holds; 0 selects 256
+ *
+ * v2g_submit parameters:
+ *   op        - V2G_OP_ENCODE or V2G_OP_DECODE
+ *   format    - V2G_FORMAT_JSON or V2G_FORMAT_NATIVE
+ *   items     - array of count descriptors, submitted together
+ *   count     - number of items (0 is allowed)
+ *   user_data - returned with the completion of every item; an integer,
+ *               so pass a pointer as (uintptr_t)ptr
+ *
+ * v2g_poll parameters:
+ *   completions - array of max entries receiving completed items
+ *   n           - receives the number of entries filled
+ *
+ * Returns:
+ *   v2g_queue_create returns a non-zero handle, or 0 if the descriptor
+ *   cannot be created. v2g_queue_fd returns the descriptor, or -1 for an
+ *   invalid queue; it stays owned by the queue. v2g_submit returns V2G_OK
+ *   when every item was queued, or V2G_ERR_BUSY when they do not all fit
+ *   until completions are polled, in which case none was queued.
+ *   V2G_ERR_INVALID_ARG is returned for arguments the batch calls reject,
+ *   an unknown op, or more items than depth. v2g_poll returns V2G_OK.
+ *
+ * Ownership:
+ *   Items and every buffer they point to stay owned by the caller, and
+ *   must stay valid and untouched from v2g_submit until their completion
+ *   is polled. The workers record error messages on their own threads, so
+ *   v2g_last_error() does not describe failed items; check each item's
+ *   status. A queue may be used by several threads at once, but not while
+ *   it is destroyed. v2g_queue_destroy waits for the submitted items to be
+ *   processed, discards their completions and closes the descriptor; it
+ *   ignores 0 and queues already destroyed, for which the other functions
+ *   fail with V2G_ERR_INVALID_ARG (v2g_queue_fd with -1).
+ */
+v2g_queue v2g_queue_create(size_t n_workers, size_t depth);
+void v2g_queue_destroy(v2g_queue queue);
+int v2g_queue_fd(v2g_queue queue);
+int v2g_submit(v2g_queue queue, int op, int format,
+               struct v2g_batch_item *items, size_t count,
+               uintptr_t user_data);
+int v2g_poll(v2g_queue queue, struct v2g_completion *completions, size_t max,
+             size_t *n);
+
+/*
+ * v2g_get_stats
+ *
+ * Per-message-type counters, for spotting a message type that got slower
+ * or started failing without attaching a profiler. They are collected only
+ * while the "stats" option is on (see v2g_set_option), and then cost two
+ * uncontended atomic adds per encode or decode; the latency of one call in
+ * sample_every on each context is also timed.
+ *
+ * messages[] is indexed by the V2G_MSG_* identifier and counts the encodes
+ * and decodes of that message type by every entry point: calls is the
+ * number of calls, errors the number that failed, bytes the EXI bytes
+ * written or read by the others, and latency[i] the sampled successful
+ * calls that took less than 2^i ns (and at least 2^(i-1) ns; the last
+ * bucket holds every longer call). A decode that ran out of input (an
+ * incomplete stream message, V2G_NEED_MORE) is not counted there.
+ *
+ * errors[s] counts the calls of any entry point that returned status s
+ * (errors[V2G_STATS_STATUS_SIZE - 1] for V2G_ERR_INTERNAL; errors[V2G_OK]
+ * stays 0). bytes_in and bytes_out are the totals of the decode and encode
+ * bytes.
+ *
+ * The counters keep changing while they are read, so the snapshot is not
+ * atomic across fields, but every value in it was held by its counter.
+ *
+ * Returns:
+ *   V2G_OK, or V2G_ERR_INVALID_ARG if stats is NULL.
+ */
+int v2g_get_stats(struct v2g_stats *stats);
+
 /*
  * v2g_message_type_name
  *
@@ -271,8 +717,9 @@ int v2g_decode_struct(int msg_type, const uint8_t *exi_data, size_t exi_len,
  *   msg_type - message type identifier
  *
  * Returns:
- *   NUL-terminated string with the message type name. The string is
- *   dynamically allocated and must be freed with v2g_free_buffer().
+ *   NUL-terminated string with the message type name, or "Unknown" for an
+ *   unused identifier. The string is statically allocated, valid for the
+ *   lifetime of the process and must NOT be freed by the caller.
  */
 const char *v2g_message_type_name(int msg_type);
 
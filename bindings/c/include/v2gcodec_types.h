@@ -0,0 +1,635 @@
+/*
+ * v2gcodec_types.h - Plain C message structures for the exi-go codec
+ *
+ * Copyright 2025
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *
+ * This header declares C structures mirroring the Go message types in
+ * pkg/v2g/generated. They are consumed by v2g_encode_native and filled by
+ * v2g_decode_native (declared in v2gcodec.h), which copy fields directly
+ * between these structures and the codec without any text serialization.
+ * The structures and their converters (v2gcodec_binary.go) are written by
+ * hand; TestNativeCoversGenerated fails when a generated field has no
+ * member here or does not survive a round trip at full capacity.
+ *
+ * Conventions:
+ *  - Every struct is named `struct v2g_<GoTypeName>`.
+ *  - Optional members are paired with a `<Name>_isUsed` flag (0 = absent).
+ *  - Fixed-capacity arrays are paired with a `<Name>Len` element count.
+ *  - Short strings (enum names, identifiers) use `struct v2g_string` with an
+ *    explicit length; they are not NUL-terminated.
+ *  - Booleans are represented as int (0 = false, non-zero = true).
+ *  - Variable-size binary data (certificates, keys, signatures) uses
+ *    `struct v2g_bytes`, which points into caller-owned memory. Before
+ *    decoding, set `bytes` and `bytesCap` for every such member you expect to
+ *    receive; if a member does not fit, v2g_decode_native returns
+ *    V2G_ERR_BUFFER_TOO_SMALL and stores the required size in `bytesLen`.
+ *  - v2g_decode_native sets every length, count and _isUsed member, so the
+ *    structure does not need to be cleared beforehand. The contents of an
+ *    optional member whose _isUsed flag is 0 are left unspecified.
+ */
+
+#ifndef EXIGO_V2GCODEC_TYPES_H
+#define EXIGO_V2GCODEC_TYPES_H
+
+#include <stddef.h> /* for size_t */
+#include <stdint.h> /* for fixed-width integers */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Capacities of fixed-size members */
+#define V2G_SESSION_ID_SIZE 8         /* SessionID (hexBinary, 8 bytes) */
+#define V2G_ID_SIZE 255               /* EVCCID, EVSEID */
+#define V2G_GEN_CHALLENGE_SIZE 16     /* GenChallenge */
+#define V2G_STRING_SIZE 80            /* struct v2g_string */
+#define V2G_SERVICE_LIST_SIZE 8       /* ServiceList.Services */
+#define V2G_PARAMETER_SET_SIZE 8      /* ServiceParameterList.ParameterSets */
+#define V2G_PARAMETER_SIZE 16         /* ParameterSet.Parameters */
+#define V2G_SELECTED_SERVICE_SIZE 16  /* SelectedServiceList */
+#define V2G_AUTHORIZATION_SERVICES_SIZE 2
+#define V2G_SUPPORTED_PROVIDERS_SIZE 16
+#define V2G_ROOT_CERTIFICATE_IDS_SIZE 20
+#define V2G_CERTIFICATE_CHAIN_SIZE 4  /* CertificateChain.Certificates */
+#define V2G_POWER_PROFILE_SIZE 64     /* EVPowerProfile.Entries */
+
+/* Length-prefixed short string (UTF-8, not NUL-terminated). */
+struct v2g_string {
+  char characters[V2G_STRING_SIZE];
+  uint16_t charactersLen;
+};
+
+/* Caller-owned binary buffer. */
+struct v2g_bytes {
+  uint8_t *bytes;  /* data (encode) or destination (decode) */
+  size_t bytesLen; /* number of valid bytes */
+  size_t bytesCap; /* capacity of bytes, used when decoding */
+};
+
+/* Shared building blocks ------------------------------------------------- */
+
+struct v2g_MessageHeaderType {
+  uint8_t SessionID[V2G_SESSION_ID_SIZE];
+  uint16_t SessionIDLen;
+  uint64_t TimeStamp;
+};
+
+struct v2g_RationalNumber {
+  int8_t Exponent;
+  int16_t Value;
+};
+
+struct v2g_CertificateChain {
+  struct v2g_bytes Certificates[V2G_CERTIFICATE_CHAIN_SIZE];
+  uint16_t CertificatesLen;
+};
+
+struct v2g_ServiceType {
+  uint16_t ServiceID;
+  int FreeService;
+};
+
+struct v2g_ServiceList {
+  struct v2g_ServiceType Services[V2G_SERVICE_LIST_SIZE];
+  uint16_t ServicesLen;
+};
+
+struct v2g_Parameter {
+  struct v2g_string Name;
+  int16_t IntValue;
+  uint8_t IntValue_isUsed;
+  struct v2g_string StrValue;
+  uint8_t StrValue_isUsed;
+  int BoolValue;
+  uint8_t BoolValue_isUsed;
+};
+
+struct v2g_ParameterSet {
+  uint16_t ParameterSetID;
+  struct v2g_Parameter Parameters[V2G_PARAMETER_SIZE];
+  uint16_t ParametersLen;
+};
+
+struct v2g_ServiceParameterList {
+  struct v2g_ParameterSet ParameterSets[V2G_PARAMETER_SET_SIZE];
+  uint16_t ParameterSetsLen;
+};
+
+struct v2g_PnC_AReqAuthorizationMode {
+  uint8_t GenChallenge[V2G_GEN_CHALLENGE_SIZE];
+  uint16_t GenChallengeLen; /* 0 = absent */
+  struct v2g_CertificateChain ContractCertificateChain;
+  uint8_t ContractCertificateChain_isUsed;
+};
+
+struct v2g_PnC_ASResAuthorizationMode {
+  uint8_t GenChallenge[V2G_GEN_CHALLENGE_SIZE];
+  uint16_t GenChallengeLen;
+  struct v2g_string SupportedProviders[V2G_SUPPORTED_PROVIDERS_SIZE];
+  uint16_t SupportedProvidersLen;
+};
+
+struct v2g_SelectedService {
+  uint16_t ServiceID;
+  uint16_t ParameterSetID;
+  uint8_t ParameterSetID_isUsed;
+};
+
+struct v2g_SelectedServiceList {
+  struct v2g_SelectedService SelectedServices[V2G_SELECTED_SERVICE_SIZE];
+  uint16_t SelectedServicesLen;
+};
+
+struct v2g_EVPowerProfileEntry {
+  uint32_t Duration;
+  struct v2g_RationalNumber Power;
+};
+
+struct v2g_EVPowerProfile {
+  uint64_t TimeAnchor;
+  struct v2g_EVPowerProfileEntry Entries[V2G_POWER_PROFILE_SIZE];
+  uint16_t EntriesLen;
+};
+
+struct v2g_EVSEStatus {
+  uint16_t NotificationMaxDelay;
+  struct v2g_string EVSENotification;
+};
+
+struct v2g_WPT_MeterInfo {
+  struct v2g_string MeterID;
+  struct v2g_RationalNumber MeterReading;
+  uint64_t MeterTimestamp;
+  uint8_t MeterTimestamp_isUsed;
+  struct v2g_bytes MeterSignature; /* bytesLen 0 = absent */
+  int16_t MeterStatus;
+  uint8_t MeterStatus_isUsed;
+};
+
+struct v2g_DC_ACDP_MeterInfo {
+  struct v2g_string MeterID;
+  struct v2g_RationalNumber MeterReading;
+  uint64_t MeterTimestamp;
+  uint8_t MeterTimestamp_isUsed;
+  struct v2g_bytes MeterSignature; /* bytesLen 0 = absent */
+  int16_t MeterStatus;
+  uint8_t MeterStatus_isUsed;
+  int64_t TMeter;
+  uint8_t TMeter_isUsed;
+};
+
+struct v2g_DisplayParameters {
+  uint8_t PresentSOC;
+  uint8_t PresentSOC_isUsed;
+  uint8_t MinimumSOC;
+  uint8_t MinimumSOC_isUsed;
+  uint8_t TargetSOC;
+  uint8_t TargetSOC_isUsed;
+  uint8_t MaximumSOC;
+  uint8_t MaximumSOC_isUsed;
+  uint16_t RemainingTimeToMinSOC;
+  uint8_t RemainingTimeToMinSOC_isUsed;
+  uint16_t RemainingTimeToTargetSOC;
+  uint8_t RemainingTimeToTargetSOC_isUsed;
+  uint16_t RemainingTimeToMaxSOC;
+  uint8_t RemainingTimeToMaxSOC_isUsed;
+  int ChargingComplete;
+  uint8_t ChargingComplete_isUsed;
+  struct v2g_RationalNumber BatteryEnergyCapacity;
+  uint8_t BatteryEnergyCapacity_isUsed;
+  int InletHot;
+  uint8_t InletHot_isUsed;
+};
+
+/* Common messages -------------------------------------------------------- */
+
+struct v2g_SessionSetupReq {
+  struct v2g_MessageHeaderType Header;
+  uint8_t EVCCID[V2G_ID_SIZE];
+  uint16_t EVCCIDLen;
+};
+
+struct v2g_SessionSetupRes {
+  struct v2g_MessageHeaderType Header;
+  struct v2g_string ResponseCode;
+  uint8_t EVSEID[V2G_ID_SIZE];
+  uint16_t EVSEIDLen;
+  int64_t DateTimeNow;
+  uint8_t DateTimeNow_isUsed;
+};
+
+struct v2g_ServiceDiscoveryReq {
+  struct v2g_MessageHeaderType Header;
+  struct v2g_string ServiceScope;
+  uint8_t ServiceScope_isUsed;
+  struct v2g_string ServiceCategory;
+  uint8_t ServiceCategory_isUsed;
+};
+
+struct v2g_ServiceDiscoveryRes {
+  struct v2g_MessageHeaderType Header;
+  struct v2g_string ResponseCode;
+  int ServiceRenegotiationSupported;
+  struct v2g_ServiceList EnergyTransferServiceList;
+  struct v2g_ServiceList VASList;
+  uint8_t VASList_isUsed;
+};
+
+struct v2g_ServiceDetailReq {
+  struct v2g_MessageHeaderType Header;
+  uint16_t ServiceID;
+};
+
+struct v2g_ServiceDetailRes {
+  struct v2g_MessageHeaderType Header;
+  struct v2g_string ResponseCode;
+  uint16_t ServiceID;
+  struct v2g_ServiceParameterList ServiceParameterList;
+};
+
+struct v2g_AuthorizationReq {
+  struct v2g_MessageHeaderType Header;
+  struct v2g_string SelectedAuthorizationService;
+  uint8_t EIM_AReqAuthorizationMode_isUsed; /* EIM mode carries no fields */
+  struct v2g_PnC_AReqAuthorizationMode PnC_AReqAuthorizationMode;
+  uint8_t PnC_AReqAuthorizationMode_isUsed;
+};
+
+struct v2g_AuthorizationRes {
+  struct v2g_MessageHeaderType Header;
+  struct v2g_string ResponseCode;
+  struct v2g_string EVSEProcessing;
+};
+
+struct v2g_AuthorizationSetupReq {
+  struct v2g_MessageHeaderType Header;
+};
+
+struct v2g_AuthorizationSetupRes {
+  struct v2g_MessageHeaderType Header;
+  struct v2g_string ResponseCode;
+  struct v2g_string AuthorizationServices[V2G_AUTHORIZATION_SERVICES_SIZE];
+  uint16_t AuthorizationServicesLen;
+  int CertificateInstallationService;
+  uint8_t EIM_ASResAuthorizationMode_isUsed; /* EIM mode carries no fields */
+  struct v2g_PnC_ASResAuthorizationMode PnC_ASResAuthorizationMode;
+  uint8_t PnC_ASResAuthorizationMode_isUsed;
+};
+
+struct v2g_ServiceSelectionReq {
+  struct v2g_MessageHeaderType Header;
+  struct v2g_SelectedService SelectedEnergyTransferService;
+  struct v2g_SelectedServiceList SelectedVASList;
+  uint8_t SelectedVASList_isUsed;
+};
+
+struct v2g_ServiceSelectionRes {
+  struct v2g_MessageHeaderType Header;
+  struct v2g_string ResponseCode;
+};
+
+struct v2g_PowerDeliveryReq {
+  struct v2g_MessageHeaderType Header;
+  struct v2g_string EVProcessing;
+  struct v2g_string ChargeProgress;
+  struct v2g_EVPowerProfile EVPowerProfile;
+  uint8_t EVPowerProfile_isUsed;
+  struct v2g_string BPT_ChannelSelection;
+  uint8_t BPT_ChannelSelection_isUsed;
+};
+
+struct v2g_PowerDeliveryRes {
+  struct v2g_MessageHeaderType Header;
+  struct v2g_string ResponseCode;
+  struct v2g_EVSEStatus EVSEStatus;
+  uint8_t EVSEStatus_isUsed;
+};
+
+struct v2g_SessionStopReq {
+  struct v2g_MessageHeaderType Header;
+  struct v2g_string ChargingSession;
+  struct v2g_string EVTerminationCode;
+  uint8_t EVTerminationCode_isUsed;
+  struct v2g_string EVTerminationExplanation;
+  uint8_t EVTerminationExplanation_isUsed;
+};
+
+struct v2g_SessionStopRes {
+  struct v2g_MessageHeaderType Header;
+  struct v2g_string ResponseCode;
+};
+
+struct v2g_ScheduleExchangeReq {
+  struct v2g_MessageHeaderType Header;
+  uint16_t MaximumSupportingPoints;
+};
+
+struct v2g_ScheduleExchangeRes {
+  struct v2g_MessageHeaderType Header;
+  struct v2g_string ResponseCode;
+  struct v2g_string EVSEProcessing;
+};
+
+struct v2g_MeteringConfirmationReq {
+  struct v2g_MessageHeaderType Header;
+};
+
+struct v2g_MeteringConfirmationRes {
+  struct v2g_MessageHeaderType Header;
+  struct v2g_string ResponseCode;
+};
+
+struct v2g_CertificateInstallationReq {
+  struct v2g_MessageHeaderType Header;
+  struct v2g_CertificateChain OEMProvisioningCertChain;
+  struct v2g_string ListOfRootCertificateIDs[V2G_ROOT_CERTIFICATE_IDS_SIZE];
+  uint16_t ListOfRootCertificateIDsLen;
+};
+
+struct v2g_CertificateInstallationRes {
+  struct v2g_MessageHeaderType Header;
+  struct v2g_string ResponseCode;
+  struct v2g_string EVSEProcessing;
+  struct v2g_CertificateChain CPSCertificateChain;
+  struct v2g_bytes ContractSignatureEncryptedPrivateKey;
+  struct v2g_bytes DHPublicKey;
+  struct v2g_CertificateChain ContractCertificateChain;
+};
+
+struct v2g_VehicleCheckInReq {
+  struct v2g_MessageHeaderType Header;
+  struct v2g_string EVCheckInStatus;
+  struct v2g_string ParkingMethod;
+  uint8_t ParkingMethod_isUsed;
+};
+
+struct v2g_VehicleCheckInRes {
+  struct v2g_MessageHeaderType Header;
+  struct v2g_string ResponseCode;
+  struct v2g_string VehicleCheckInResult;
+  uint8_t VehicleCheckInResult_isUsed;
+};
+
+struct v2g_VehicleCheckOutReq {
+  struct v2g_MessageHeaderType Header;
+  struct v2g_string EVCheckOutStatus;
+  uint64_t CheckOutTime;
+};
+
+struct v2g_VehicleCheckOutRes {
+  struct v2g_MessageHeaderType Header;
+  struct v2g_string ResponseCode;
+  struct v2g_string EVSECheckOutStatus;
+};
+
+struct v2g_CLReqControlMode {
+  struct v2g_MessageHeaderType Header;
+};
+
+struct v2g_CLResControlMode {
+  struct v2g_MessageHeaderType Header;
+};
+
+/* WPT (Wireless Power Transfer) messages --------------------------------- */
+
+struct v2g_WPT_AlignmentCheckReq {
+  struct v2g_MessageHeaderType Header;
+};
+
+struct v2g_WPT_AlignmentCheckRes {
+  struct v2g_MessageHeaderType Header;
+  struct v2g_string ResponseCode;
+  struct v2g_string AlignmentStatus;
+  struct v2g_RationalNumber AlignmentOffset_X;
+  uint8_t AlignmentOffset_X_isUsed;
+  struct v2g_RationalNumber AlignmentOffset_Y;
+  uint8_t AlignmentOffset_Y_isUsed;
+  struct v2g_RationalNumber AlignmentOffset_Z;
+  uint8_t AlignmentOffset_Z_isUsed;
+};
+
+struct v2g_WPT_FinePositioningReq {
+  struct v2g_MessageHeaderType Header;
+};
+
+struct v2g_WPT_FinePositioningRes {
+  struct v2g_MessageHeaderType Header;
+  struct v2g_string ResponseCode;
+  struct v2g_string PositioningStatus;
+  struct v2g_string GuidanceDirection;
+  uint8_t GuidanceDirection_isUsed;
+  struct v2g_RationalNumber GuidanceDistance;
+  uint8_t GuidanceDistance_isUsed;
+  int16_t FinePositioningSignal;
+  uint8_t FinePositioningSignal_isUsed;
+};
+
+struct v2g_WPT_ChargeLoopReq {
+  struct v2g_MessageHeaderType Header;
+  struct v2g_string EVProcessing;
+  struct v2g_RationalNumber PowerRequest;
+  uint8_t PowerRequest_isUsed;
+  struct v2g_RationalNumber EVTargetEnergyRequest;
+  uint8_t EVTargetEnergyRequest_isUsed;
+  struct v2g_RationalNumber EVMaximumPowerLimit;
+  uint8_t EVMaximumPowerLimit_isUsed;
+  struct v2g_RationalNumber EVMinimumPowerLimit;
+  uint8_t EVMinimumPowerLimit_isUsed;
+  uint64_t DepartureTime;
+  uint8_t DepartureTime_isUsed;
+};
+
+struct v2g_WPT_ChargeLoopRes {
+  struct v2g_MessageHeaderType Header;
+  struct v2g_string ResponseCode;
+  struct v2g_string EVSEProcessing;
+  struct v2g_RationalNumber EVSEPresentPower;
+  uint8_t EVSEPresentPower_isUsed;
+  struct v2g_RationalNumber EVSEMaximumPowerLimit;
+  uint8_t EVSEMaximumPowerLimit_isUsed;
+  struct v2g_RationalNumber EVSEMinimumPowerLimit;
+  uint8_t EVSEMinimumPowerLimit_isUsed;
+  struct v2g_WPT_MeterInfo MeterInfo;
+  uint8_t MeterInfo_isUsed;
+  int ChargingComplete;
+  uint8_t ChargingComplete_isUsed;
+  struct v2g_RationalNumber EVSETargetFrequency;
+  uint8_t EVSETargetFrequency_isUsed;
+  int16_t LF_EVSEFinePositioning;
+  uint8_t LF_EVSEFinePositioning_isUsed;
+};
+
+/* ACDP (AC Dynamic Power) messages --------------------------------------- */
+
+struct v2g_DC_ACDPReq {
+  struct v2g_MessageHeaderType Header;
+  struct v2g_string EVProcessing;
+  struct v2g_RationalNumber EVTargetEnergyRequest;
+  struct v2g_RationalNumber EVMaximumEnergyRequest;
+  uint8_t EVMaximumEnergyRequest_isUsed;
+  struct v2g_RationalNumber EVMinimumEnergyRequest;
+  uint8_t EVMinimumEnergyRequest_isUsed;
+  struct v2g_DisplayParameters DisplayParameters;
+  uint8_t DisplayParameters_isUsed;
+  struct v2g_string DynamicControlMode;
+  uint8_t DynamicControlMode_isUsed;
+};
+
+struct v2g_DC_ACDPRes {
+  struct v2g_MessageHeaderType Header;
+  struct v2g_string ResponseCode;
+  struct v2g_string EVSEProcessing;
+  struct v2g_RationalNumber EVSEPresentActivePower;
+  uint8_t EVSEPresentActivePower_isUsed;
+  struct v2g_RationalNumber EVSEPresentReactivePower;
+  uint8_t EVSEPresentReactivePower_isUsed;
+  int EVSEPowerRampLimitation;
+  uint8_t EVSEPowerRampLimitation_isUsed;
+  struct v2g_DC_ACDP_MeterInfo MeterInfo;
+  uint8_t MeterInfo_isUsed;
+  int ReceiptRequired;
+  uint8_t ReceiptRequired_isUsed;
+};
+
+struct v2g_DC_ACDP_BPTReq {
+  struct v2g_MessageHeaderType Header;
+  struct v2g_string EVProcessing;
+  struct v2g_RationalNumber EVTargetEnergyRequest;
+  struct v2g_RationalNumber EVMaximumEnergyRequest;
+  uint8_t EVMaximumEnergyRequest_isUsed;
+  struct v2g_RationalNumber EVMinimumEnergyRequest;
+  uint8_t EVMinimumEnergyRequest_isUsed;
+  struct v2g_RationalNumber EVMaximumDischargePower;
+  uint8_t EVMaximumDischargePower_isUsed;
+  struct v2g_RationalNumber EVMinimumDischargePower;
+  uint8_t EVMinimumDischargePower_isUsed;
+  struct v2g_DisplayParameters DisplayParameters;
+  uint8_t DisplayParameters_isUsed;
+  struct v2g_string DynamicControlMode;
+  uint8_t DynamicControlMode_isUsed;
+  struct v2g_string BPT_ChannelSelection;
+  uint8_t BPT_ChannelSelection_isUsed;
+};
+
+struct v2g_DC_ACDP_BPTRes {
+  struct v2g_MessageHeaderType Header;
+  struct v2g_string ResponseCode;
+  struct v2g_string EVSEProcessing;
+  struct v2g_RationalNumber EVSEPresentActivePower;
+  uint8_t EVSEPresentActivePower_isUsed;
+  struct v2g_RationalNumber EVSEPresentReactivePower;
+  uint8_t EVSEPresentReactivePower_isUsed;
+  int EVSEPowerRampLimitation;
+  uint8_t EVSEPowerRampLimitation_isUsed;
+  struct v2g_DC_ACDP_MeterInfo MeterInfo;
+  uint8_t MeterInfo_isUsed;
+  int ReceiptRequired;
+  uint8_t ReceiptRequired_isUsed;
+  struct v2g_RationalNumber EVSEMaximumDischargePower;
+  uint8_t EVSEMaximumDischargePower_isUsed;
+  struct v2g_RationalNumber EVSEMinimumDischargePower;
+  uint8_t EVSEMinimumDischargePower_isUsed;
+};
+
+/* Batch descriptors ------------------------------------------------------ */
+
+/* Payload representation used by v2g_encode_batch / v2g_decode_batch. */
+enum v2g_batch_format {
+  V2G_FORMAT_JSON = 0,  /* JSON text, as v2g_encode_struct/v2g_decode_struct */
+  V2G_FORMAT_NATIVE = 1 /* struct v2g_<MessageType>, as v2g_*_native */
+};
+
+/*
+ * One message in a batch call. The caller fills msg_type, in, in_len, out and
+ * out_cap; the library fills out_len and status.
+ *
+ *  encode: in is the JSON text or the struct (in_len may then be 0 or
+ *          sizeof the struct); out receives EXI bytes.
+ *  decode: in is EXI bytes; out receives NUL-terminated JSON or is the struct
+ *          to fill (out_cap must be at least sizeof the struct).
+ *
+ * out_len is the number of bytes produced (JSON excludes the NUL), or the
+ * capacity required when status is V2G_ERR_BUFFER_TOO_SMALL.
+ */
+struct v2g_batch_item {
+  int msg_type;
+  const void *in;
+  size_t in_len;
+  void *out;
+  size_t out_cap;
+  size_t out_len;
+  int status;
+};
+
+/* Statistics ------------------------------------------------------------- */
+
+/* Filled by v2g_get_stats, which describes the fields. */
+#define V2G_STATS_MESSAGES 64
+#define V2G_STATS_LATENCY_BUCKETS 32
+#define V2G_STATS_STATUS_SIZE 16
+
+struct v2g_op_stats {
+  uint64_t calls;
+  uint64_t errors;
+  uint64_t bytes;
+  uint64_t latency[V2G_STATS_LATENCY_BUCKETS];
+};
+
+struct v2g_message_stats {
+  struct v2g_op_stats encode;
+  struct v2g_op_stats decode;
+};
+
+struct v2g_stats {
+  int enabled;           /* the "stats" option is on */
+  uint32_t sample_every; /* one call in sample_every is timed */
+  uint64_t bytes_in;
+  uint64_t bytes_out;
+  uint64_t errors[V2G_STATS_STATUS_SIZE];
+  struct v2g_message_stats messages[V2G_STATS_MESSAGES];
+};
+
+/*
+ * Opaque handle to a reusable codec context (see v2g_ctx_create). 0 is never
+ * a valid handle.
+ */
+typedef uintptr_t v2g_ctx;
+
+/* Completion queue ------------------------------------------------------- */
+
+/*
+ * Opaque handle to a completion queue (see v2g_queue_create). 0 is never a
+ * valid handle.
+ */
+typedef uintptr_t v2g_queue;
+
+/* Operation of the items passed to v2g_submit. */
+enum v2g_queue_op {
+  V2G_OP_ENCODE = 0, /* as v2g_encode_batch */
+  V2G_OP_DECODE = 1  /* as v2g_decode_batch */
+};
+
+/*
+ * A processed item, returned by v2g_poll. Its out_len and status are set as
+ * by the batch call for the operation.
+ */
+struct v2g_completion {
+  struct v2g_batch_item *item; /* the submitted item */
+  uintptr_t user_data;         /* as passed to v2g_submit */
+};
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* EXIGO_V2GCODEC_TYPES_H */
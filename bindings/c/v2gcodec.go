@@ -15,34 +15,42 @@ License: Apache-2.0 (match repository)
 package main
 
 /*
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 */
 import "C"
 
 import (
-	"fmt"
+	"os"
 	"sync"
+	"sync/atomic"
 	"unsafe"
 
 	"example.com/exi-go/pkg/exi"
+	"example.com/exi-go/pkg/schema"
 )
 
 // Global runtime state -----------------------------------------------------
 
 var (
-	// codec is the shared EXI codec instance used by C calls.
-	// It is protected by stateMu when being replaced.
-	codec   *exi.Codec
+	// codec is the shared EXI codec instance used by C calls. Encode and
+	// decode only Load it; v2g_init, v2g_load_schemas, v2g_set_option and
+	// v2g_shutdown publish a replacement with Store/Swap (serialized by
+	// stateMu) and shut the old one down. Calls already holding the old
+	// codec finish with it, which is safe because Codec.Shutdown releases
+	// nothing that encode/decode use.
+	codec   atomic.Pointer[exi.Codec]
 	stateMu sync.Mutex
 
-	// lastErr stores the last human-readable error message. Protected by errMu.
-	errMu      sync.Mutex
-	lastErrStr string
-	lastErrC   *C.char
+	// grammarCachePath is the grammar cache v2g_init and v2g_load_schemas
+	// prefer over parsing XSDs: $V2G_GRAMMAR_CACHE, or the "grammar-cache"
+	// option. Empty means no cache. Guarded by stateMu.
+	grammarCachePath = os.Getenv("V2G_GRAMMAR_CACHE")
 
-	// versionC is a statically allocated C string for v2g_version.
-	versionC *C.char
+	// versionC is allocated once and never freed, so the pointer returned by
+	// v2g_version stays valid for the lifetime of the process.
+	versionC = C.CString("dev")
 )
 
 const (
@@ -55,49 +63,46 @@ const (
 	_v2g_err_decode   = 5
 	_v2g_err_schema   = 6
 	_v2g_err_oom      = 7
-	_v2g_err_internal = 254
+	// _v2g_err_buffer_too_small is returned by the *_into variants when the
+	// caller-provided buffer cannot hold the result; *written holds the
+	// required size.
+	_v2g_err_buffer_too_small = 8
+	_v2g_need_more            = 9
+	_v2g_err_busy             = 10 // v2g_submit: queue full until polled
+	_v2g_err_internal         = 254
 )
 
-// helper: set last error string (thread-safe). Keeps a C copy in lastErrC.
-func setLastError(format string, a ...interface{}) {
-	errMu.Lock()
-	defer errMu.Unlock()
-	lastErrStr = fmt.Sprintf(format, a...)
-	// free previous C allocation if any
-	if lastErrC != nil {
-		C.free(unsafe.Pointer(lastErrC))
-		lastErrC = nil
+// cBytesView returns a Go slice aliasing n bytes of C memory at p without
+// copying. The slice must not be retained past the current call.
+func cBytesView(p unsafe.Pointer, n C.size_t) []byte {
+	if p == nil || n == 0 {
+		return nil
 	}
-	lastErrC = C.CString(lastErrStr)
-}
-
-// getLastErrorC returns the last error C string (may be nil).
-func getLastErrorC() *C.char {
-	errMu.Lock()
-	defer errMu.Unlock()
-	return lastErrC
+	return unsafe.Slice((*byte)(p), int(n))
 }
 
-// init prepares a version string and ensures no previous allocation leak.
-func init() {
-	version := "dev"
-	versionC = C.CString(version)
-	// lastErrC starts nil
-}
-
-// cleanup releases C allocations created by this package.
-// Called on program exit or when needed.
-func cleanup() {
-	errMu.Lock()
-	if lastErrC != nil {
-		C.free(unsafe.Pointer(lastErrC))
-		lastErrC = nil
+// copyToCaller copies result into the caller-owned buffer out of capacity
+// outCap and stores the number of bytes produced in *written. When nulTerm is
+// set a trailing NUL is appended (not counted in *written) and must fit as
+// well. If the buffer is too small nothing is copied, *written is set to the
+// required capacity and _v2g_err_buffer_too_small is returned.
+func copyToCaller(result []byte, out unsafe.Pointer, outCap C.size_t, written *C.size_t, nulTerm bool) int {
+	need := len(result)
+	if nulTerm {
+		need++
+	}
+	if out == nil || int(outCap) < need {
+		*written = C.size_t(need)
+		setLastError("output buffer too small: need %d bytes, have %d", need, int(outCap))
+		return _v2g_err_buffer_too_small
 	}
-	errMu.Unlock()
-	if versionC != nil {
-		C.free(unsafe.Pointer(versionC))
-		versionC = nil
+	dst := unsafe.Slice((*byte)(out), need)
+	copy(dst, result)
+	if nulTerm {
+		dst[len(result)] = 0
 	}
+	*written = C.size_t(len(result))
+	return _v2g_ok
 }
 
 // EXPORTS ------------------------------------------------------------------
@@ -111,18 +116,31 @@ func v2g_init() C.int {
 	defer stateMu.Unlock()
 
 	// If already initialized, return success.
-	if codec != nil {
-		return C.int(_v2g_ok)
+	if codec.Load() != nil {
+		return cStatus(_v2g_ok)
 	}
 
-	// Create codec with default config (using stub by default).
-	c := exi.NewCodec(nil)
+	// Default to the schema-informed XML path; "use-stub" selects the
+	// minify+gzip stub.
+	cfg := &exi.Config{}
+	if grammarCachePath != "" {
+		// With no paths, LoadGrammar checks the sources recorded in the
+		// cache and parses them only if they changed.
+		g, _, err := schema.LoadGrammar(grammarCachePath, nil, schema.GrammarOptions{})
+		if err != nil {
+			setLastError("init: %v", err)
+			return cStatus(_v2g_err_schema)
+		}
+		cfg.SchemaPaths = g.Sources
+		cfg.Grammar = g.Table
+	}
+	c := exi.NewCodec(cfg)
 	if err := c.Init(); err != nil {
 		setLastError("init: %v", err)
-		return C.int(_v2g_err_init)
+		return cStatus(_v2g_err_init)
 	}
-	codec = c
-	return C.int(_v2g_ok)
+	codec.Store(c)
+	return cStatus(_v2g_ok)
 }
 
 //export v2g_shutdown
@@ -130,18 +148,16 @@ func v2g_shutdown() C.int {
 	stateMu.Lock()
 	defer stateMu.Unlock()
 
-	if codec == nil {
+	old := codec.Swap(nil)
+	if old == nil {
 		// Nothing to do
-		return C.int(_v2g_ok)
+		return cStatus(_v2g_ok)
 	}
-	if err := codec.Shutdown(); err != nil {
+	if err := old.Shutdown(); err != nil {
 		setLastError("shutdown: %v", err)
-		return C.int(_v2g_err_shutdown)
+		return cStatus(_v2g_err_shutdown)
 	}
-	codec = nil
-	// cleanup any C-allocated strings
-	cleanup()
-	return C.int(_v2g_ok)
+	return cStatus(_v2g_ok)
 }
 
 // cStringsToGoStrings converts a C array of *C.char (paths) into a Go []string.
@@ -172,96 +188,107 @@ func v2g_load_schemas(paths **C.char, count C.size_t) C.int {
 	goPaths := cStringsToGoStrings(paths, count)
 	if len(goPaths) == 0 {
 		setLastError("v2g_load_schemas: no schema paths provided")
-		return C.int(_v2g_err_invalid)
+		return cStatus(_v2g_err_invalid)
 	}
 
-	// For this scaffold, store the schema paths by creating a codec configured
-	// with the provided paths and initialize it.
 	stateMu.Lock()
-	defer stateMu.Unlock()
-
-	// Shutdown existing codec if any
-	if codec != nil {
-		_ = codec.Shutdown()
-		codec = nil
+	cachePath := grammarCachePath
+	stateMu.Unlock()
+	g, _, err := schema.LoadGrammar(cachePath, goPaths, schema.GrammarOptions{})
+	if err != nil {
+		setLastError("load_schemas: %v", err)
+		return cStatus(_v2g_err_schema)
 	}
-
 	cfg := &exi.Config{
 		SchemaPaths: goPaths,
-		UseStub:     true, // generator will later switch as needed
+		Grammar:     g.Table,
 	}
+	if status := replaceCodec("load_schemas", cfg); status != _v2g_ok {
+		if status == _v2g_err_internal {
+			status = _v2g_err_schema
+		}
+		return cStatus(status)
+	}
+	return cStatus(_v2g_ok)
+}
+
+// replaceCodec initializes a codec for cfg and publishes it in place of the
+// current one (RCU-style: in-flight calls keep using the codec they loaded).
+// On failure the current codec is left untouched.
+func replaceCodec(fn string, cfg *exi.Config) int {
 	c := exi.NewCodec(cfg)
 	if err := c.Init(); err != nil {
-		setLastError("load_schemas: init failed: %v", err)
-		return C.int(_v2g_err_schema)
+		setLastError("%s: init failed: %v", fn, err)
+		return _v2g_err_internal
+	}
+	stateMu.Lock()
+	old := codec.Swap(c)
+	stateMu.Unlock()
+	if old != nil {
+		_ = old.Shutdown()
 	}
-	codec = c
-	return C.int(_v2g_ok)
+	return _v2g_ok
 }
 
 //export v2g_encode_xml
 func v2g_encode_xml(xml *C.uint8_t, xml_len C.size_t, out_exi **C.uint8_t, out_len *C.size_t) C.int {
 	if xml == nil || xml_len == 0 || out_exi == nil || out_len == nil {
 		setLastError("v2g_encode_xml: invalid arguments")
-		return C.int(_v2g_err_invalid)
+		return cStatus(_v2g_err_invalid)
 	}
 
 	// Ensure codec initialized
-	stateMu.Lock()
-	c := codec
-	stateMu.Unlock()
+	c := codec.Load()
 	if c == nil {
 		setLastError("v2g_encode_xml: codec not initialized")
-		return C.int(_v2g_err_init)
+		return cStatus(_v2g_err_init)
 	}
 
-	// Copy input bytes from C to Go
-	input := C.GoBytes(unsafe.Pointer(xml), C.int(xml_len))
+	// The codec does not retain its input, so read the C buffer in place.
+	input := cBytesView(unsafe.Pointer(xml), xml_len)
 
 	// Perform encoding
 	result, err := c.EncodeXML(input)
 	if err != nil {
 		setLastError("encode failed: %v", err)
 		// map errors to encode error code
-		return C.int(_v2g_err_encode)
+		return cStatus(_v2g_err_encode)
 	}
 
 	// Allocate C memory and copy result into it. Use C.CBytes which allocates via malloc.
 	cbuf := C.CBytes(result) // returns void*
 	if cbuf == nil {
 		setLastError("encode: out of memory")
-		return C.int(_v2g_err_oom)
+		return cStatus(_v2g_err_oom)
 	}
 
 	// Assign output parameters
 	*out_exi = (*C.uint8_t)(cbuf)
 	*out_len = C.size_t(len(result))
-	return C.int(_v2g_ok)
+	return cStatus(_v2g_ok)
 }
 
 //export v2g_decode_exi
 func v2g_decode_exi(exiBuf *C.uint8_t, exi_len C.size_t, out_xml **C.char, out_len *C.size_t) C.int {
 	if exiBuf == nil || exi_len == 0 || out_xml == nil || out_len == nil {
 		setLastError("v2g_decode_exi: invalid arguments")
-		return C.int(_v2g_err_invalid)
+		return cStatus(_v2g_err_invalid)
 	}
 
 	// Ensure codec initialized
-	stateMu.Lock()
-	c := codec
-	stateMu.Unlock()
+	c := codec.Load()
 	if c == nil {
 		setLastError("v2g_decode_exi: codec not initialized")
-		return C.int(_v2g_err_init)
+		return cStatus(_v2g_err_init)
 	}
 
-	input := C.GoBytes(unsafe.Pointer(exiBuf), C.int(exi_len))
+	input := cBytesView(unsafe.Pointer(exiBuf), exi_len)
 
 	// Perform decode
 	xmlBytes, err := c.DecodeEXI(input)
 	if err != nil {
 		setLastError("decode failed: %v", err)
-		return C.int(_v2g_err_decode)
+		return cStatus(_v2g_err_decode)
 	}
 
 	// Allocate C memory for NUL-terminated string
@@ -270,7 +297,7 @@ func v2g_decode_exi(exiBuf *C.uint8_t, exi_len C.size_t, out_xml **C.char, out_l
 	cptr := C.malloc(clen)
 	if cptr == nil {
 		setLastError("decode: out of memory")
-		return C.int(_v2g_err_oom)
+		return cStatus(_v2g_err_oom)
 	}
 
 	// Copy bytes into allocated memory
@@ -281,7 +308,7 @@ func v2g_decode_exi(exiBuf *C.uint8_t, exi_len C.size_t, out_xml **C.char, out_l
 
 	*out_xml = (*C.char)(cptr)
 	*out_len = C.size_t(len(xmlBytes))
-	return C.int(_v2g_ok)
+	return cStatus(_v2g_ok)
 }
 
 //export v2g_free_buffer
@@ -307,7 +334,7 @@ func v2g_version() *C.char {
 func v2g_set_option(name *C.char, value *C.char) C.int {
 	if name == nil {
 		setLastError("v2g_set_option: name is nil")
-		return C.int(_v2g_err_invalid)
+		return cStatus(_v2g_err_invalid)
 	}
 	n := C.GoString(name)
 	v := ""
@@ -319,38 +346,17 @@ func v2g_set_option(name *C.char, value *C.char) C.int {
 	switch n {
 	case "use-stub":
 		// expect "true"/"false"
+		return cStatus(replaceCodec("set_option(use-stub)", &exi.Config{UseStub: v != "false"}))
+	case "stats":
+		return cStatus(setStatsOption(v))
+	case "grammar-cache":
 		stateMu.Lock()
-		if codec == nil {
-			// no codec yet; create one with specified option
-			cfg := &exi.Config{UseStub: v != "false"}
-			c := exi.NewCodec(cfg)
-			if err := c.Init(); err != nil {
-				stateMu.Unlock()
-				setLastError("set_option(use-stub): init failed: %v", err)
-				return C.int(_v2g_err_internal)
-			}
-			codec = c
-			stateMu.Unlock()
-			return C.int(_v2g_ok)
-		}
-		// codec exists: try to update config via re-create (safe approach)
-		_ = codec.Shutdown()
-		cfg := &exi.Config{UseStub: v != "false"}
-		c := exi.NewCodec(cfg)
-		if err := c.Init(); err != nil {
-			// attempt to restore previous codec by re-init default
-			codec = exi.NewCodec(nil)
-			_ = codec.Init()
-			stateMu.Unlock()
-			setLastError("set_option(use-stub): reinit failed: %v", err)
-			return C.int(_v2g_err_internal)
-		}
-		codec = c
+		grammarCachePath = v
 		stateMu.Unlock()
-		return C.int(_v2g_ok)
+		return cStatus(_v2g_ok)
 	default:
 		setLastError("unknown option: %s", n)
-		return C.int(_v2g_err_invalid)
+		return cStatus(_v2g_err_invalid)
 	}
 }
 
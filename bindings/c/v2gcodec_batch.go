@@ -0,0 +1,147 @@
+/*
+cgo bridge for exi-go - Batch encode/decode
+
+This file implements v2g_encode_batch / v2g_decode_batch, which process an
+array of struct v2g_batch_item descriptors (see include/v2gcodec_types.h) in
+a single call so the cgo transition is paid once per batch instead of once
+per message. Each item is handled exactly like the corresponding single
+message _into / _native call and receives its own status. One pooled codec
+context is used for the whole batch.
+
+License: Apache-2.0 (match repository)
+*/
+package main
+
+/*
+#cgo CFLAGS: -I${SRCDIR}/include
+#include <stdint.h>
+#include "v2gcodec_types.h"
+*/
+import "C"
+
+import (
+	"unsafe"
+)
+
+//export v2g_encode_batch
+func v2g_encode_batch(format C.int, items *C.struct_v2g_batch_item, count C.size_t, failed *C.size_t) C.int {
+	batch, status := batchItems("v2g_encode_batch", format, items, count)
+	if status != _v2g_ok {
+		return cStatus(status)
+	}
+	cx := acquireCtx()
+	defer releaseCtx(cx)
+	var nfailed C.size_t
+	for i := range batch {
+		it := &batch[i]
+		it.status = C.int(encodeBatchItem(cx, int(format), it))
+		if it.status != _v2g_ok {
+			nfailed++
+		}
+	}
+	if failed != nil {
+		*failed = nfailed
+	}
+	return cStatus(_v2g_ok)
+}
+
+//export v2g_decode_batch
+func v2g_decode_batch(format C.int, items *C.struct_v2g_batch_item, count C.size_t, failed *C.size_t) C.int {
+	batch, status := batchItems("v2g_decode_batch", format, items, count)
+	if status != _v2g_ok {
+		return cStatus(status)
+	}
+	cx := acquireCtx()
+	defer releaseCtx(cx)
+	var nfailed C.size_t
+	for i := range batch {
+		it := &batch[i]
+		it.status = C.int(decodeBatchItem(cx, int(format), it))
+		if it.status != _v2g_ok {
+			nfailed++
+		}
+	}
+	if failed != nil {
+		*failed = nfailed
+	}
+	return cStatus(_v2g_ok)
+}
+
+// batchItems validates the batch arguments and views the descriptor array.
+func batchItems(fn string, format C.int, items *C.struct_v2g_batch_item, count C.size_t) ([]C.struct_v2g_batch_item, int) {
+	if items == nil && count > 0 {
+		setLastError("%s: invalid arguments", fn)
+		return nil, _v2g_err_invalid
+	}
+	if format != C.V2G_FORMAT_JSON && format != C.V2G_FORMAT_NATIVE {
+		setLastError("%s: unsupported format %d", fn, int(format))
+		return nil, _v2g_err_invalid
+	}
+	if count == 0 {
+		return nil, _v2g_ok
+	}
+	return unsafe.Slice(items, int(count)), _v2g_ok
+}
+
+func encodeBatchItem(cx *codecCtx, format int, it *C.struct_v2g_batch_item) int {
+	it.out_len = 0
+	if it.in == nil || (it.out == nil && it.out_cap > 0) {
+		setLastError("v2g_encode_batch: invalid item arguments")
+		return _v2g_err_invalid
+	}
+
+	var result []byte
+	var status int
+	switch format {
+	case C.V2G_FORMAT_NATIVE:
+		if it.in_len != 0 && it.in_len != v2g_native_struct_size(it.msg_type) {
+			setLastError("v2g_encode_batch: in_len %d does not match struct size %d", int(it.in_len), int(v2g_native_struct_size(it.msg_type)))
+			return _v2g_err_invalid
+		}
+		result, status = encodeNative(cx, int(it.msg_type), it.in)
+	default:
+		if it.in_len == 0 {
+			setLastError("v2g_encode_batch: empty JSON input")
+			return _v2g_err_invalid
+		}
+		result, status = encodeStructJSON(cx, int(it.msg_type), cBytesView(it.in, it.in_len))
+	}
+	if status != _v2g_ok {
+		return status
+	}
+	return copyToCaller(result, it.out, it.out_cap, &it.out_len, false)
+}
+
+func decodeBatchItem(cx *codecCtx, format int, it *C.struct_v2g_batch_item) int {
+	it.out_len = 0
+	if it.in == nil || it.in_len == 0 || (it.out == nil && it.out_cap > 0) {
+		setLastError("v2g_decode_batch: invalid item arguments")
+		return _v2g_err_invalid
+	}
+	data := cBytesView(it.in, it.in_len)
+
+	switch format {
+	case C.V2G_FORMAT_NATIVE:
+		size := v2g_native_struct_size(it.msg_type)
+		if size == 0 {
+			setLastError("v2g_decode_batch: unsupported message type %d", int(it.msg_type))
+			return _v2g_err_invalid
+		}
+		if it.out == nil || it.out_cap < size {
+			it.out_len = size
+			setLastError("output buffer too small: need %d bytes, have %d", int(size), int(it.out_cap))
+			return _v2g_err_buffer_too_small
+		}
+		status := decodeNative(cx, int(it.msg_type), data, it.out)
+		if status == _v2g_ok {
+			it.out_len = size
+		}
+		return status
+	default:
+		jsonBytes, status := decodeStructJSON(cx, int(it.msg_type), data)
+		if status != _v2g_ok {
+			return status
+		}
+		return copyToCaller(jsonBytes, it.out, it.out_cap, &it.out_len, true)
+	}
+}
@@ -0,0 +1,1926 @@
+/*
+cgo bridge for exi-go - Binary struct ABI
+
+This file implements v2g_encode_native / v2g_decode_native, which exchange
+messages with C callers as plain C structs (see include/v2gcodec_types.h)
+instead of JSON. Fields are copied directly between the C structs and the
+Go types in pkg/v2g/generated; strings and binary inputs are viewed in place
+for the duration of the call rather than copied.
+
+License: Apache-2.0 (match repository)
+*/
+package main
+
+/*
+#cgo CFLAGS: -I${SRCDIR}/include
+#include <stdlib.h>
+#include <stdint.h>
+#include "v2gcodec_types.h"
+*/
+import "C"
+
+import (
+	"errors"
+	"fmt"
+	"reflect"
+	"unsafe"
+
+	"example.com/exi-go/pkg/exi"
+	"example.com/exi-go/pkg/v2g/generated"
+)
+
+// errNativeTooSmall marks a conversion failure caused by a destination that
+// cannot hold the decoded value; it maps to V2G_ERR_BUFFER_TOO_SMALL.
+var errNativeTooSmall = errors.New("destination too small")
+
+// nativeCodec converts one message type between its C struct and Go form.
+type nativeCodec struct {
+	// typ is the C struct type; nil for an unused slot.
+	typ reflect.Type
+	// toGo builds the Go message from the C struct at p.
+	toGo func(p unsafe.Pointer) (interface{}, error)
+	// toC fills the C struct at p from a decoded Go message.
+	toC func(msg interface{}, p unsafe.Pointer) error
+}
+
+// nativeEntry adapts a typed pair of converters to a nativeCodec.
+func nativeEntry[T any, CT any](in func(*CT) (*T, error), out func(*CT, *T) error) nativeCodec {
+	return nativeCodec{
+		typ: reflect.TypeOf((*CT)(nil)).Elem(),
+		toGo: func(p unsafe.Pointer) (interface{}, error) {
+			return in((*CT)(p))
+		},
+		toC: func(msg interface{}, p unsafe.Pointer) error {
+			v, ok := msg.(*T)
+			if !ok {
+				var want T
+				return fmt.Errorf("decoded %T, expected %T", msg, &want)
+			}
+			return out((*CT)(p), v)
+		},
+	}
+}
+
+// nativeCodecs is indexed by V2G_MSG_* identifier; unused slots have a nil
+// type.
+var nativeCodecs = [64]nativeCodec{
+	V2G_MSG_AuthorizationReq:           nativeEntry(authorizationReqIn, authorizationReqOut),
+	V2G_MSG_AuthorizationRes:           nativeEntry(authorizationResIn, authorizationResOut),
+	V2G_MSG_AuthorizationSetupReq:      nativeEntry(authorizationSetupReqIn, authorizationSetupReqOut),
+	V2G_MSG_AuthorizationSetupRes:      nativeEntry(authorizationSetupResIn, authorizationSetupResOut),
+	V2G_MSG_CLReqControlMode:           nativeEntry(clReqControlModeIn, clReqControlModeOut),
+	V2G_MSG_CLResControlMode:           nativeEntry(clResControlModeIn, clResControlModeOut),
+	V2G_MSG_CertificateInstallationReq: nativeEntry(certificateInstallationReqIn, certificateInstallationReqOut),
+	V2G_MSG_CertificateInstallationRes: nativeEntry(certificateInstallationResIn, certificateInstallationResOut),
+	V2G_MSG_MeteringConfirmationReq:    nativeEntry(meteringConfirmationReqIn, meteringConfirmationReqOut),
+	V2G_MSG_MeteringConfirmationRes:    nativeEntry(meteringConfirmationResIn, meteringConfirmationResOut),
+	V2G_MSG_PowerDeliveryReq:           nativeEntry(powerDeliveryReqIn, powerDeliveryReqOut),
+	V2G_MSG_PowerDeliveryRes:           nativeEntry(powerDeliveryResIn, powerDeliveryResOut),
+	V2G_MSG_ScheduleExchangeReq:        nativeEntry(scheduleExchangeReqIn, scheduleExchangeReqOut),
+	V2G_MSG_ScheduleExchangeRes:        nativeEntry(scheduleExchangeResIn, scheduleExchangeResOut),
+	V2G_MSG_ServiceDetailReq:           nativeEntry(serviceDetailReqIn, serviceDetailReqOut),
+	V2G_MSG_ServiceDetailRes:           nativeEntry(serviceDetailResIn, serviceDetailResOut),
+	V2G_MSG_ServiceDiscoveryReq:        nativeEntry(serviceDiscoveryReqIn, serviceDiscoveryReqOut),
+	V2G_MSG_ServiceDiscoveryRes:        nativeEntry(serviceDiscoveryResIn, serviceDiscoveryResOut),
+	V2G_MSG_ServiceSelectionReq:        nativeEntry(serviceSelectionReqIn, serviceSelectionReqOut),
+	V2G_MSG_ServiceSelectionRes:        nativeEntry(serviceSelectionResIn, serviceSelectionResOut),
+	V2G_MSG_SessionSetupReq:            nativeEntry(sessionSetupReqIn, sessionSetupReqOut),
+	V2G_MSG_SessionSetupRes:            nativeEntry(sessionSetupResIn, sessionSetupResOut),
+	V2G_MSG_SessionStopReq:             nativeEntry(sessionStopReqIn, sessionStopReqOut),
+	V2G_MSG_SessionStopRes:             nativeEntry(sessionStopResIn, sessionStopResOut),
+	V2G_MSG_VehicleCheckInReq:          nativeEntry(vehicleCheckInReqIn, vehicleCheckInReqOut),
+	V2G_MSG_VehicleCheckInRes:          nativeEntry(vehicleCheckInResIn, vehicleCheckInResOut),
+	V2G_MSG_VehicleCheckOutReq:         nativeEntry(vehicleCheckOutReqIn, vehicleCheckOutReqOut),
+	V2G_MSG_VehicleCheckOutRes:         nativeEntry(vehicleCheckOutResIn, vehicleCheckOutResOut),
+	V2G_MSG_WPT_AlignmentCheckReq:      nativeEntry(wptAlignmentCheckReqIn, wptAlignmentCheckReqOut),
+	V2G_MSG_WPT_AlignmentCheckRes:      nativeEntry(wptAlignmentCheckResIn, wptAlignmentCheckResOut),
+	V2G_MSG_WPT_FinePositioningReq:     nativeEntry(wptFinePositioningReqIn, wptFinePositioningReqOut),
+	V2G_MSG_WPT_FinePositioningRes:     nativeEntry(wptFinePositioningResIn, wptFinePositioningResOut),
+	V2G_MSG_WPT_ChargeLoopReq:          nativeEntry(wptChargeLoopReqIn, wptChargeLoopReqOut),
+	V2G_MSG_WPT_ChargeLoopRes:          nativeEntry(wptChargeLoopResIn, wptChargeLoopResOut),
+	V2G_MSG_DC_ACDPReq:                 nativeEntry(dcACDPReqIn, dcACDPReqOut),
+	V2G_MSG_DC_ACDPRes:                 nativeEntry(dcACDPResIn, dcACDPResOut),
+	V2G_MSG_DC_ACDP_BPTReq:             nativeEntry(dcACDPBPTReqIn, dcACDPBPTReqOut),
+	V2G_MSG_DC_ACDP_BPTRes:             nativeEntry(dcACDPBPTResIn, dcACDPBPTResOut),
+}
+
+//export v2g_encode_native
+func v2g_encode_native(msg_type C.int, msg unsafe.Pointer, out *C.uint8_t, out_cap C.size_t, written *C.size_t) C.int {
+	if msg == nil || written == nil || (out == nil && out_cap > 0) {
+		setLastError("v2g_encode_native: invalid arguments")
+		return cStatus(_v2g_err_invalid)
+	}
+	cx := acquireCtx()
+	defer releaseCtx(cx)
+	result, status := encodeNative(cx, int(msg_type), msg)
+	if status != _v2g_ok {
+		return cStatus(status)
+	}
+	return cStatus(copyToCaller(result, unsafe.Pointer(out), out_cap, written, false))
+}
+
+//export v2g_encoded_size_native
+func v2g_encoded_size_native(msg_type C.int, msg unsafe.Pointer, size *C.size_t) C.int {
+	if msg == nil || size == nil {
+		setLastError("v2g_encoded_size_native: invalid arguments")
+		return cStatus(_v2g_err_invalid)
+	}
+	v, status := nativeToGo(int(msg_type), msg)
+	if status != _v2g_ok {
+		return cStatus(status)
+	}
+	cx := acquireCtx()
+	defer releaseCtx(cx)
+	n, err := cx.enc.EncodedSize(v)
+	if err != nil {
+		setLastError("encode failed: %v", err)
+		return cStatus(_v2g_err_encode)
+	}
+	*size = C.size_t(n)
+	return cStatus(_v2g_ok)
+}
+
+//export v2g_decode_native
+func v2g_decode_native(msg_type C.int, exi_data *C.uint8_t, exi_len C.size_t, msg unsafe.Pointer) C.int {
+	if exi_data == nil || exi_len == 0 || msg == nil {
+		setLastError("v2g_decode_native: invalid arguments")
+		return cStatus(_v2g_err_invalid)
+	}
+	cx := acquireCtx()
+	defer releaseCtx(cx)
+	return cStatus(decodeNative(cx, int(msg_type), cBytesView(unsafe.Pointer(exi_data), exi_len), msg))
+}
+
+//export v2g_peek_header
+func v2g_peek_header(exi_data *C.uint8_t, exi_len C.size_t, msg_type *C.int, header *C.struct_v2g_MessageHeaderType) C.int {
+	if exi_data == nil || exi_len == 0 || msg_type == nil || header == nil {
+		setLastError("v2g_peek_header: invalid arguments")
+		return cStatus(_v2g_err_invalid)
+	}
+	m, h, err := exi.PeekMessageHeader(cBytesView(unsafe.Pointer(exi_data), exi_len))
+	if err != nil {
+		setLastError("decode failed: %v", err)
+		return cStatus(_v2g_err_decode)
+	}
+	if err := headerOut(header, &h); err != nil {
+		setLastError("v2g_peek_header: %v", err)
+		return cStatus(_v2g_err_buffer_too_small)
+	}
+	*msg_type = C.int(m.Code)
+	return cStatus(_v2g_ok)
+}
+
+//export v2g_validate_exi
+func v2g_validate_exi(exi_data *C.uint8_t, exi_len C.size_t, msg_type *C.int, consumed *C.size_t) C.int {
+	if exi_data == nil || exi_len == 0 {
+		setLastError("v2g_validate_exi: invalid arguments")
+		return cStatus(_v2g_err_invalid)
+	}
+	m, n, err := exi.Validate(cBytesView(unsafe.Pointer(exi_data), exi_len))
+	if err != nil {
+		setLastError("validate failed: %v", err)
+		return cStatus(_v2g_err_decode)
+	}
+	if msg_type != nil {
+		*msg_type = C.int(m.Code)
+	}
+	if consumed != nil {
+		*consumed = C.size_t(n)
+	}
+	return cStatus(_v2g_ok)
+}
+
+// encodeNative encodes the C struct at msg as msgType and returns the EXI
+// bytes with a v2g status code. The bytes alias cx's scratch buffer.
+func encodeNative(cx *codecCtx, msgType int, msg unsafe.Pointer) ([]byte, int) {
+	v, status := nativeToGo(msgType, msg)
+	if status != _v2g_ok {
+		return nil, status
+	}
+	result, err := cx.enc.Encode(v)
+	if err != nil {
+		setLastError("encode failed: %v", err)
+		return nil, _v2g_err_encode
+	}
+	return result, _v2g_ok
+}
+
+// nativeToGo converts the C struct at msg to the Go message for msgType.
+func nativeToGo(msgType int, msg unsafe.Pointer) (interface{}, int) {
+	nc, ok := nativeCodecFor(msgType)
+	if !ok {
+		setLastError("v2g_encode_native: unsupported message type %d", msgType)
+		return nil, _v2g_err_invalid
+	}
+	v, err := nc.toGo(msg)
+	if err != nil {
+		setLastError("v2g_encode_native: %v", err)
+		return nil, _v2g_err_invalid
+	}
+	return v, _v2g_ok
+}
+
+// decodeNative decodes data as msgType into the C struct at msg and returns
+// a v2g status code.
+func decodeNative(cx *codecCtx, msgType int, data []byte, msg unsafe.Pointer) int {
+	nc, ok := nativeCodecFor(msgType)
+	if !ok {
+		setLastError("v2g_decode_native: unsupported message type %d", msgType)
+		return _v2g_err_invalid
+	}
+	v, err := cx.decode(data)
+	if err != nil {
+		setLastError("decode failed: %v", err)
+		return _v2g_err_decode
+	}
+	if err := nc.toC(v, msg); err != nil {
+		setLastError("v2g_decode_native: %v", err)
+		if errors.Is(err, errNativeTooSmall) {
+			return _v2g_err_buffer_too_small
+		}
+		return _v2g_err_decode
+	}
+	return _v2g_ok
+}
+
+//export v2g_native_struct_size
+func v2g_native_struct_size(msg_type C.int) C.size_t {
+	nc, ok := nativeCodecFor(int(msg_type))
+	if !ok {
+		return 0
+	}
+	return C.size_t(nc.typ.Size())
+}
+
+func nativeCodecFor(msgType int) (*nativeCodec, bool) {
+	if msgType < 0 || msgType >= len(nativeCodecs) || nativeCodecs[msgType].typ == nil {
+		return nil, false
+	}
+	return &nativeCodecs[msgType], true
+}
+
+// Field helpers ------------------------------------------------------------
+
+func boolToC(b bool) C.int {
+	if b {
+		return 1
+	}
+	return 0
+}
+
+// optIn returns a pointer to v when the isUsed flag is set, nil otherwise.
+func optIn[T any](used C.uint8_t, v T) *T {
+	if used == 0 {
+		return nil
+	}
+	return &v
+}
+
+// optOut sets the isUsed flag from v and returns the value to store (or the
+// zero value when v is nil).
+func optOut[T any](used *C.uint8_t, v *T) T {
+	if v == nil {
+		*used = 0
+		var zero T
+		return zero
+	}
+	*used = 1
+	return *v
+}
+
+// fixedIn views the first n bytes of a fixed-size C array.
+func fixedIn(p unsafe.Pointer, n C.uint16_t, capacity int, field string) ([]byte, error) {
+	if int(n) > capacity {
+		return nil, fmt.Errorf("%s: length %d exceeds capacity %d", field, int(n), capacity)
+	}
+	if n == 0 {
+		return nil, nil
+	}
+	return unsafe.Slice((*byte)(p), int(n)), nil
+}
+
+// fixedOut copies b into a fixed-size C array and records its length.
+func fixedOut(p unsafe.Pointer, capacity int, n *C.uint16_t, b []byte, field string) error {
+	if len(b) > capacity {
+		*n = 0
+		return fmt.Errorf("%s: %d bytes exceed capacity %d: %w", field, len(b), capacity, errNativeTooSmall)
+	}
+	copy(unsafe.Slice((*byte)(p), capacity), b)
+	*n = C.uint16_t(len(b))
+	return nil
+}
+
+func stringIn(s *C.struct_v2g_string, field string) (string, error) {
+	b, err := fixedIn(unsafe.Pointer(&s.characters[0]), s.charactersLen, C.V2G_STRING_SIZE, field)
+	if err != nil || len(b) == 0 {
+		return "", err
+	}
+	return unsafe.String(&b[0], len(b)), nil
+}
+
+func stringOut(s *C.struct_v2g_string, v string, field string) error {
+	return fixedOut(unsafe.Pointer(&s.characters[0]), C.V2G_STRING_SIZE, &s.charactersLen, []byte(v), field)
+}
+
+func optStringIn(s *C.struct_v2g_string, used C.uint8_t, field string) (*string, error) {
+	if used == 0 {
+		return nil, nil
+	}
+	v, err := stringIn(s, field)
+	return &v, err
+}
+
+func optStringOut(s *C.struct_v2g_string, used *C.uint8_t, v *string, field string) error {
+	return stringOut(s, optOut(used, v), field)
+}
+
+func stringArrayIn(p *C.struct_v2g_string, n C.uint16_t, capacity int, field string) ([]string, error) {
+	if int(n) > capacity {
+		return nil, fmt.Errorf("%s: count %d exceeds capacity %d", field, int(n), capacity)
+	}
+	if n == 0 {
+		return nil, nil
+	}
+	elems := unsafe.Slice(p, int(n))
+	out := make([]string, len(elems))
+	for i := range elems {
+		s, err := stringIn(&elems[i], field)
+		if err != nil {
+			return nil, err
+		}
+		out[i] = s
+	}
+	return out, nil
+}
+
+func stringArrayOut(p *C.struct_v2g_string, capacity int, n *C.uint16_t, v []string, field string) error {
+	if len(v) > capacity {
+		*n = 0
+		return fmt.Errorf("%s: %d entries exceed capacity %d: %w", field, len(v), capacity, errNativeTooSmall)
+	}
+	elems := unsafe.Slice(p, capacity)
+	for i, s := range v {
+		if err := stringOut(&elems[i], s, field); err != nil {
+			return err
+		}
+	}
+	*n = C.uint16_t(len(v))
+	return nil
+}
+
+// bytesIn views the caller-owned buffer described by b.
+func bytesIn(b *C.struct_v2g_bytes, field string) ([]byte, error) {
+	if b.bytesLen == 0 {
+		return nil, nil
+	}
+	if b.bytes == nil {
+		return nil, fmt.Errorf("%s: NULL bytes with length %d", field, int(b.bytesLen))
+	}
+	return unsafe.Slice((*byte)(unsafe.Pointer(b.bytes)), int(b.bytesLen)), nil
+}
+
+// bytesOut copies v into the caller-owned buffer described by b. bytesLen is
+// always set to len(v) so callers can size a retry buffer.
+func bytesOut(b *C.struct_v2g_bytes, v []byte, field string) error {
+	b.bytesLen = C.size_t(len(v))
+	if len(v) == 0 {
+		return nil
+	}
+	if b.bytes == nil || int(b.bytesCap) < len(v) {
+		return fmt.Errorf("%s: need %d bytes, have %d: %w", field, len(v), int(b.bytesCap), errNativeTooSmall)
+	}
+	copy(unsafe.Slice((*byte)(unsafe.Pointer(b.bytes)), len(v)), v)
+	return nil
+}
+
+func headerIn(h *C.struct_v2g_MessageHeaderType) (generated.MessageHeaderType, error) {
+	sid, err := fixedIn(unsafe.Pointer(&h.SessionID[0]), h.SessionIDLen, C.V2G_SESSION_ID_SIZE, "Header.SessionID")
+	if err != nil {
+		return generated.MessageHeaderType{}, err
+	}
+	return generated.MessageHeaderType{SessionID: sid, TimeStamp: uint64(h.TimeStamp)}, nil
+}
+
+func headerOut(h *C.struct_v2g_MessageHeaderType, v *generated.MessageHeaderType) error {
+	h.TimeStamp = C.uint64_t(v.TimeStamp)
+	return fixedOut(unsafe.Pointer(&h.SessionID[0]), C.V2G_SESSION_ID_SIZE, &h.SessionIDLen, v.SessionID, "Header.SessionID")
+}
+
+func rationalIn(r *C.struct_v2g_RationalNumber) generated.RationalNumber {
+	return generated.RationalNumber{Exponent: int8(r.Exponent), Value: int16(r.Value)}
+}
+
+func rationalOut(r *C.struct_v2g_RationalNumber, v generated.RationalNumber) {
+	r.Exponent = C.int8_t(v.Exponent)
+	r.Value = C.int16_t(v.Value)
+}
+
+func optRationalIn(r *C.struct_v2g_RationalNumber, used C.uint8_t) *generated.RationalNumber {
+	return optIn(used, rationalIn(r))
+}
+
+func optRationalOut(r *C.struct_v2g_RationalNumber, used *C.uint8_t, v *generated.RationalNumber) {
+	rationalOut(r, optOut(used, v))
+}
+
+func certificateChainIn(c *C.struct_v2g_CertificateChain, field string) (generated.CertificateChain, error) {
+	if int(c.CertificatesLen) > C.V2G_CERTIFICATE_CHAIN_SIZE {
+		return generated.CertificateChain{}, fmt.Errorf("%s: count %d exceeds capacity %d", field, int(c.CertificatesLen), C.V2G_CERTIFICATE_CHAIN_SIZE)
+	}
+	var chain generated.CertificateChain
+	if c.CertificatesLen > 0 {
+		chain.Certificates = make([][]byte, int(c.CertificatesLen))
+	}
+	for i := range chain.Certificates {
+		b, err := bytesIn(&c.Certificates[i], field)
+		if err != nil {
+			return generated.CertificateChain{}, err
+		}
+		chain.Certificates[i] = b
+	}
+	return chain, nil
+}
+
+func certificateChainOut(c *C.struct_v2g_CertificateChain, v *generated.CertificateChain, field string) error {
+	if len(v.Certificates) > C.V2G_CERTIFICATE_CHAIN_SIZE {
+		c.CertificatesLen = 0
+		return fmt.Errorf("%s: %d certificates exceed capacity %d: %w", field, len(v.Certificates), C.V2G_CERTIFICATE_CHAIN_SIZE, errNativeTooSmall)
+	}
+	c.CertificatesLen = C.uint16_t(len(v.Certificates))
+	for i, cert := range v.Certificates {
+		if err := bytesOut(&c.Certificates[i], cert, field); err != nil {
+			return err
+		}
+	}
+	return nil
+}
+
+func serviceListIn(l *C.struct_v2g_ServiceList, field string) (generated.ServiceList, error) {
+	if int(l.ServicesLen) > C.V2G_SERVICE_LIST_SIZE {
+		return generated.ServiceList{}, fmt.Errorf("%s: count %d exceeds capacity %d", field, int(l.ServicesLen), C.V2G_SERVICE_LIST_SIZE)
+	}
+	var out generated.ServiceList
+	if l.ServicesLen > 0 {
+		out.Services = make([]generated.ServiceType, int(l.ServicesLen))
+	}
+	for i := range out.Services {
+		out.Services[i] = generated.ServiceType{
+			ServiceID:   uint16(l.Services[i].ServiceID),
+			FreeService: l.Services[i].FreeService != 0,
+		}
+	}
+	return out, nil
+}
+
+func serviceListOut(l *C.struct_v2g_ServiceList, v *generated.ServiceList, field string) error {
+	if len(v.Services) > C.V2G_SERVICE_LIST_SIZE {
+		l.ServicesLen = 0
+		return fmt.Errorf("%s: %d services exceed capacity %d: %w", field, len(v.Services), C.V2G_SERVICE_LIST_SIZE, errNativeTooSmall)
+	}
+	for i, s := range v.Services {
+		l.Services[i].ServiceID = C.uint16_t(s.ServiceID)
+		l.Services[i].FreeService = boolToC(s.FreeService)
+	}
+	l.ServicesLen = C.uint16_t(len(v.Services))
+	return nil
+}
+
+func parameterSetIn(s *C.struct_v2g_ParameterSet) (generated.ParameterSet, error) {
+	if int(s.ParametersLen) > C.V2G_PARAMETER_SIZE {
+		return generated.ParameterSet{}, fmt.Errorf("Parameters: count %d exceeds capacity %d", int(s.ParametersLen), C.V2G_PARAMETER_SIZE)
+	}
+	out := generated.ParameterSet{ParameterSetID: uint16(s.ParameterSetID)}
+	if s.ParametersLen > 0 {
+		out.Parameters = make([]generated.Parameter, int(s.ParametersLen))
+	}
+	for i := range out.Parameters {
+		p := &s.Parameters[i]
+		name, err := stringIn(&p.Name, "Parameter.Name")
+		if err != nil {
+			return generated.ParameterSet{}, err
+		}
+		strValue, err := optStringIn(&p.StrValue, p.StrValue_isUsed, "Parameter.StrValue")
+		if err != nil {
+			return generated.ParameterSet{}, err
+		}
+		out.Parameters[i] = generated.Parameter{
+			Name:      name,
+			IntValue:  optIn(p.IntValue_isUsed, int16(p.IntValue)),
+			StrValue:  strValue,
+			BoolValue: optIn(p.BoolValue_isUsed, p.BoolValue != 0),
+		}
+	}
+	return out, nil
+}
+
+func parameterSetOut(s *C.struct_v2g_ParameterSet, v *generated.ParameterSet) error {
+	if len(v.Parameters) > C.V2G_PARAMETER_SIZE {
+		s.ParametersLen = 0
+		return fmt.Errorf("Parameters: %d entries exceed capacity %d: %w", len(v.Parameters), C.V2G_PARAMETER_SIZE, errNativeTooSmall)
+	}
+	s.ParameterSetID = C.uint16_t(v.ParameterSetID)
+	for i := range v.Parameters {
+		src := &v.Parameters[i]
+		p := &s.Parameters[i]
+		if err := stringOut(&p.Name, src.Name, "Parameter.Name"); err != nil {
+			return err
+		}
+		p.IntValue = C.int16_t(optOut(&p.IntValue_isUsed, src.IntValue))
+		if err := optStringOut(&p.StrValue, &p.StrValue_isUsed, src.StrValue, "Parameter.StrValue"); err != nil {
+			return err
+		}
+		p.BoolValue = boolToC(optOut(&p.BoolValue_isUsed, src.BoolValue))
+	}
+	s.ParametersLen = C.uint16_t(len(v.Parameters))
+	return nil
+}
+
+func selectedServiceIn(s *C.struct_v2g_SelectedService) generated.SelectedService {
+	return generated.SelectedService{
+		ServiceID:      uint16(s.ServiceID),
+		ParameterSetID: optIn(s.ParameterSetID_isUsed, uint16(s.ParameterSetID)),
+	}
+}
+
+func selectedServiceOut(s *C.struct_v2g_SelectedService, v *generated.SelectedService) {
+	s.ServiceID = C.uint16_t(v.ServiceID)
+	s.ParameterSetID = C.uint16_t(optOut(&s.ParameterSetID_isUsed, v.ParameterSetID))
+}
+
+func displayParametersIn(d *C.struct_v2g_DisplayParameters) *generated.DisplayParameters {
+	return &generated.DisplayParameters{
+		PresentSOC:               optIn(d.PresentSOC_isUsed, uint8(d.PresentSOC)),
+		MinimumSOC:               optIn(d.MinimumSOC_isUsed, uint8(d.MinimumSOC)),
+		TargetSOC:                optIn(d.TargetSOC_isUsed, uint8(d.TargetSOC)),
+		MaximumSOC:               optIn(d.MaximumSOC_isUsed, uint8(d.MaximumSOC)),
+		RemainingTimeToMinSOC:    optIn(d.RemainingTimeToMinSOC_isUsed, uint16(d.RemainingTimeToMinSOC)),
+		RemainingTimeToTargetSOC: optIn(d.RemainingTimeToTargetSOC_isUsed, uint16(d.RemainingTimeToTargetSOC)),
+		RemainingTimeToMaxSOC:    optIn(d.RemainingTimeToMaxSOC_isUsed, uint16(d.RemainingTimeToMaxSOC)),
+		ChargingComplete:         optIn(d.ChargingComplete_isUsed, d.ChargingComplete != 0),
+		BatteryEnergyCapacity:    optRationalIn(&d.BatteryEnergyCapacity, d.BatteryEnergyCapacity_isUsed),
+		InletHot:                 optIn(d.InletHot_isUsed, d.InletHot != 0),
+	}
+}
+
+func displayParametersOut(d *C.struct_v2g_DisplayParameters, v *generated.DisplayParameters) {
+	d.PresentSOC = C.uint8_t(optOut(&d.PresentSOC_isUsed, v.PresentSOC))
+	d.MinimumSOC = C.uint8_t(optOut(&d.MinimumSOC_isUsed, v.MinimumSOC))
+	d.TargetSOC = C.uint8_t(optOut(&d.TargetSOC_isUsed, v.TargetSOC))
+	d.MaximumSOC = C.uint8_t(optOut(&d.MaximumSOC_isUsed, v.MaximumSOC))
+	d.RemainingTimeToMinSOC = C.uint16_t(optOut(&d.RemainingTimeToMinSOC_isUsed, v.RemainingTimeToMinSOC))
+	d.RemainingTimeToTargetSOC = C.uint16_t(optOut(&d.RemainingTimeToTargetSOC_isUsed, v.RemainingTimeToTargetSOC))
+	d.RemainingTimeToMaxSOC = C.uint16_t(optOut(&d.RemainingTimeToMaxSOC_isUsed, v.RemainingTimeToMaxSOC))
+	d.ChargingComplete = boolToC(optOut(&d.ChargingComplete_isUsed, v.ChargingComplete))
+	optRationalOut(&d.BatteryEnergyCapacity, &d.BatteryEnergyCapacity_isUsed, v.BatteryEnergyCapacity)
+	d.InletHot = boolToC(optOut(&d.InletHot_isUsed, v.InletHot))
+}
+
+// Common messages ----------------------------------------------------------
+
+func sessionSetupReqIn(m *C.struct_v2g_SessionSetupReq) (*generated.SessionSetupReq, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	evccid, err := fixedIn(unsafe.Pointer(&m.EVCCID[0]), m.EVCCIDLen, C.V2G_ID_SIZE, "EVCCID")
+	if err != nil {
+		return nil, err
+	}
+	return &generated.SessionSetupReq{Header: h, EVCCID: evccid}, nil
+}
+
+func sessionSetupReqOut(m *C.struct_v2g_SessionSetupReq, v *generated.SessionSetupReq) error {
+	if err := headerOut(&m.Header, &v.Header); err != nil {
+		return err
+	}
+	return fixedOut(unsafe.Pointer(&m.EVCCID[0]), C.V2G_ID_SIZE, &m.EVCCIDLen, v.EVCCID, "EVCCID")
+}
+
+func sessionSetupResIn(m *C.struct_v2g_SessionSetupRes) (*generated.SessionSetupRes, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	rc, err := stringIn(&m.ResponseCode, "ResponseCode")
+	if err != nil {
+		return nil, err
+	}
+	evseid, err := fixedIn(unsafe.Pointer(&m.EVSEID[0]), m.EVSEIDLen, C.V2G_ID_SIZE, "EVSEID")
+	if err != nil {
+		return nil, err
+	}
+	return &generated.SessionSetupRes{
+		Header:       h,
+		ResponseCode: rc,
+		EVSEID:       evseid,
+		DateTimeNow:  optIn(m.DateTimeNow_isUsed, int64(m.DateTimeNow)),
+	}, nil
+}
+
+func sessionSetupResOut(m *C.struct_v2g_SessionSetupRes, v *generated.SessionSetupRes) error {
+	if err := headerOut(&m.Header, &v.Header); err != nil {
+		return err
+	}
+	if err := stringOut(&m.ResponseCode, v.ResponseCode, "ResponseCode"); err != nil {
+		return err
+	}
+	if err := fixedOut(unsafe.Pointer(&m.EVSEID[0]), C.V2G_ID_SIZE, &m.EVSEIDLen, v.EVSEID, "EVSEID"); err != nil {
+		return err
+	}
+	m.DateTimeNow = C.int64_t(optOut(&m.DateTimeNow_isUsed, v.DateTimeNow))
+	return nil
+}
+
+func serviceDiscoveryReqIn(m *C.struct_v2g_ServiceDiscoveryReq) (*generated.ServiceDiscoveryReq, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	scope, err := optStringIn(&m.ServiceScope, m.ServiceScope_isUsed, "ServiceScope")
+	if err != nil {
+		return nil, err
+	}
+	category, err := optStringIn(&m.ServiceCategory, m.ServiceCategory_isUsed, "ServiceCategory")
+	if err != nil {
+		return nil, err
+	}
+	return &generated.ServiceDiscoveryReq{Header: h, ServiceScope: scope, ServiceCategory: category}, nil
+}
+
+func serviceDiscoveryReqOut(m *C.struct_v2g_ServiceDiscoveryReq, v *generated.ServiceDiscoveryReq) error {
+	if err := headerOut(&m.Header, &v.Header); err != nil {
+		return err
+	}
+	if err := optStringOut(&m.ServiceScope, &m.ServiceScope_isUsed, v.ServiceScope, "ServiceScope"); err != nil {
+		return err
+	}
+	return optStringOut(&m.ServiceCategory, &m.ServiceCategory_isUsed, v.ServiceCategory, "ServiceCategory")
+}
+
+func serviceDiscoveryResIn(m *C.struct_v2g_ServiceDiscoveryRes) (*generated.ServiceDiscoveryRes, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	rc, err := stringIn(&m.ResponseCode, "ResponseCode")
+	if err != nil {
+		return nil, err
+	}
+	energy, err := serviceListIn(&m.EnergyTransferServiceList, "EnergyTransferServiceList")
+	if err != nil {
+		return nil, err
+	}
+	out := &generated.ServiceDiscoveryRes{
+		Header:                        h,
+		ResponseCode:                  rc,
+		ServiceRenegotiationSupported: m.ServiceRenegotiationSupported != 0,
+		EnergyTransferServiceList:     energy,
+	}
+	if m.VASList_isUsed != 0 {
+		vas, err := serviceListIn(&m.VASList, "VASList")
+		if err != nil {
+			return nil, err
+		}
+		out.VASList = &vas
+	}
+	return out, nil
+}
+
+func serviceDiscoveryResOut(m *C.struct_v2g_ServiceDiscoveryRes, v *generated.ServiceDiscoveryRes) error {
+	if err := headerOut(&m.Header, &v.Header); err != nil {
+		return err
+	}
+	if err := stringOut(&m.ResponseCode, v.ResponseCode, "ResponseCode"); err != nil {
+		return err
+	}
+	m.ServiceRenegotiationSupported = boolToC(v.ServiceRenegotiationSupported)
+	if err := serviceListOut(&m.EnergyTransferServiceList, &v.EnergyTransferServiceList, "EnergyTransferServiceList"); err != nil {
+		return err
+	}
+	m.VASList_isUsed = 0
+	m.VASList.ServicesLen = 0
+	if v.VASList != nil {
+		m.VASList_isUsed = 1
+		return serviceListOut(&m.VASList, v.VASList, "VASList")
+	}
+	return nil
+}
+
+func serviceDetailReqIn(m *C.struct_v2g_ServiceDetailReq) (*generated.ServiceDetailReq, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	return &generated.ServiceDetailReq{Header: h, ServiceID: uint16(m.ServiceID)}, nil
+}
+
+func serviceDetailReqOut(m *C.struct_v2g_ServiceDetailReq, v *generated.ServiceDetailReq) error {
+	m.ServiceID = C.uint16_t(v.ServiceID)
+	return headerOut(&m.Header, &v.Header)
+}
+
+func serviceDetailResIn(m *C.struct_v2g_ServiceDetailRes) (*generated.ServiceDetailRes, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	rc, err := stringIn(&m.ResponseCode, "ResponseCode")
+	if err != nil {
+		return nil, err
+	}
+	l := &m.ServiceParameterList
+	if int(l.ParameterSetsLen) > C.V2G_PARAMETER_SET_SIZE {
+		return nil, fmt.Errorf("ParameterSets: count %d exceeds capacity %d", int(l.ParameterSetsLen), C.V2G_PARAMETER_SET_SIZE)
+	}
+	out := &generated.ServiceDetailRes{Header: h, ResponseCode: rc, ServiceID: uint16(m.ServiceID)}
+	if l.ParameterSetsLen > 0 {
+		out.ServiceParameterList.ParameterSets = make([]generated.ParameterSet, int(l.ParameterSetsLen))
+	}
+	for i := range out.ServiceParameterList.ParameterSets {
+		ps, err := parameterSetIn(&l.ParameterSets[i])
+		if err != nil {
+			return nil, err
+		}
+		out.ServiceParameterList.ParameterSets[i] = ps
+	}
+	return out, nil
+}
+
+func serviceDetailResOut(m *C.struct_v2g_ServiceDetailRes, v *generated.ServiceDetailRes) error {
+	if err := headerOut(&m.Header, &v.Header); err != nil {
+		return err
+	}
+	if err := stringOut(&m.ResponseCode, v.ResponseCode, "ResponseCode"); err != nil {
+		return err
+	}
+	m.ServiceID = C.uint16_t(v.ServiceID)
+	l := &m.ServiceParameterList
+	sets := v.ServiceParameterList.ParameterSets
+	if len(sets) > C.V2G_PARAMETER_SET_SIZE {
+		l.ParameterSetsLen = 0
+		return fmt.Errorf("ParameterSets: %d entries exceed capacity %d: %w", len(sets), C.V2G_PARAMETER_SET_SIZE, errNativeTooSmall)
+	}
+	for i := range sets {
+		if err := parameterSetOut(&l.ParameterSets[i], &sets[i]); err != nil {
+			return err
+		}
+	}
+	l.ParameterSetsLen = C.uint16_t(len(sets))
+	return nil
+}
+
+func authorizationReqIn(m *C.struct_v2g_AuthorizationReq) (*generated.AuthorizationReq, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	svc, err := stringIn(&m.SelectedAuthorizationService, "SelectedAuthorizationService")
+	if err != nil {
+		return nil, err
+	}
+	out := &generated.AuthorizationReq{Header: h, SelectedAuthorizationService: svc}
+	if m.EIM_AReqAuthorizationMode_isUsed != 0 {
+		out.EIM_AReqAuthorizationMode = &generated.EIM_AReqAuthorizationMode{}
+	}
+	if m.PnC_AReqAuthorizationMode_isUsed != 0 {
+		p := &m.PnC_AReqAuthorizationMode
+		gc, err := fixedIn(unsafe.Pointer(&p.GenChallenge[0]), p.GenChallengeLen, C.V2G_GEN_CHALLENGE_SIZE, "GenChallenge")
+		if err != nil {
+			return nil, err
+		}
+		pnc := &generated.PnC_AReqAuthorizationMode{GenChallenge: gc}
+		if p.ContractCertificateChain_isUsed != 0 {
+			chain, err := certificateChainIn(&p.ContractCertificateChain, "ContractCertificateChain")
+			if err != nil {
+				return nil, err
+			}
+			pnc.ContractCertificateChain = &chain
+		}
+		out.PnC_AReqAuthorizationMode = pnc
+	}
+	return out, nil
+}
+
+func authorizationReqOut(m *C.struct_v2g_AuthorizationReq, v *generated.AuthorizationReq) error {
+	if err := headerOut(&m.Header, &v.Header); err != nil {
+		return err
+	}
+	if err := stringOut(&m.SelectedAuthorizationService, v.SelectedAuthorizationService, "SelectedAuthorizationService"); err != nil {
+		return err
+	}
+	m.EIM_AReqAuthorizationMode_isUsed = 0
+	if v.EIM_AReqAuthorizationMode != nil {
+		m.EIM_AReqAuthorizationMode_isUsed = 1
+	}
+	m.PnC_AReqAuthorizationMode_isUsed = 0
+	if v.PnC_AReqAuthorizationMode == nil {
+		return nil
+	}
+	m.PnC_AReqAuthorizationMode_isUsed = 1
+	p := &m.PnC_AReqAuthorizationMode
+	src := v.PnC_AReqAuthorizationMode
+	if err := fixedOut(unsafe.Pointer(&p.GenChallenge[0]), C.V2G_GEN_CHALLENGE_SIZE, &p.GenChallengeLen, src.GenChallenge, "GenChallenge"); err != nil {
+		return err
+	}
+	p.ContractCertificateChain_isUsed = 0
+	if src.ContractCertificateChain != nil {
+		p.ContractCertificateChain_isUsed = 1
+		return certificateChainOut(&p.ContractCertificateChain, src.ContractCertificateChain, "ContractCertificateChain")
+	}
+	return nil
+}
+
+func authorizationResIn(m *C.struct_v2g_AuthorizationRes) (*generated.AuthorizationRes, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	rc, err := stringIn(&m.ResponseCode, "ResponseCode")
+	if err != nil {
+		return nil, err
+	}
+	proc, err := stringIn(&m.EVSEProcessing, "EVSEProcessing")
+	if err != nil {
+		return nil, err
+	}
+	return &generated.AuthorizationRes{Header: h, ResponseCode: rc, EVSEProcessing: proc}, nil
+}
+
+func authorizationResOut(m *C.struct_v2g_AuthorizationRes, v *generated.AuthorizationRes) error {
+	if err := headerOut(&m.Header, &v.Header); err != nil {
+		return err
+	}
+	if err := stringOut(&m.ResponseCode, v.ResponseCode, "ResponseCode"); err != nil {
+		return err
+	}
+	return stringOut(&m.EVSEProcessing, v.EVSEProcessing, "EVSEProcessing")
+}
+
+func authorizationSetupReqIn(m *C.struct_v2g_AuthorizationSetupReq) (*generated.AuthorizationSetupReq, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	return &generated.AuthorizationSetupReq{Header: h}, nil
+}
+
+func authorizationSetupReqOut(m *C.struct_v2g_AuthorizationSetupReq, v *generated.AuthorizationSetupReq) error {
+	return headerOut(&m.Header, &v.Header)
+}
+
+func authorizationSetupResIn(m *C.struct_v2g_AuthorizationSetupRes) (*generated.AuthorizationSetupRes, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	rc, err := stringIn(&m.ResponseCode, "ResponseCode")
+	if err != nil {
+		return nil, err
+	}
+	services, err := stringArrayIn(&m.AuthorizationServices[0], m.AuthorizationServicesLen, C.V2G_AUTHORIZATION_SERVICES_SIZE, "AuthorizationServices")
+	if err != nil {
+		return nil, err
+	}
+	out := &generated.AuthorizationSetupRes{
+		Header:                         h,
+		ResponseCode:                   rc,
+		AuthorizationServices:          services,
+		CertificateInstallationService: m.CertificateInstallationService != 0,
+	}
+	if m.EIM_ASResAuthorizationMode_isUsed != 0 {
+		out.EIM_ASResAuthorizationMode = &generated.EIM_ASResAuthorizationMode{}
+	}
+	if m.PnC_ASResAuthorizationMode_isUsed != 0 {
+		p := &m.PnC_ASResAuthorizationMode
+		gc, err := fixedIn(unsafe.Pointer(&p.GenChallenge[0]), p.GenChallengeLen, C.V2G_GEN_CHALLENGE_SIZE, "GenChallenge")
+		if err != nil {
+			return nil, err
+		}
+		providers, err := stringArrayIn(&p.SupportedProviders[0], p.SupportedProvidersLen, C.V2G_SUPPORTED_PROVIDERS_SIZE, "SupportedProviders")
+		if err != nil {
+			return nil, err
+		}
+		out.PnC_ASResAuthorizationMode = &generated.PnC_ASResAuthorizationMode{GenChallenge: gc, SupportedProviders: providers}
+	}
+	return out, nil
+}
+
+func authorizationSetupResOut(m *C.struct_v2g_AuthorizationSetupRes, v *generated.AuthorizationSetupRes) error {
+	if err := headerOut(&m.Header, &v.Header); err != nil {
+		return err
+	}
+	if err := stringOut(&m.ResponseCode, v.ResponseCode, "ResponseCode"); err != nil {
+		return err
+	}
+	if err := stringArrayOut(&m.AuthorizationServices[0], C.V2G_AUTHORIZATION_SERVICES_SIZE, &m.AuthorizationServicesLen, v.AuthorizationServices, "AuthorizationServices"); err != nil {
+		return err
+	}
+	m.CertificateInstallationService = boolToC(v.CertificateInstallationService)
+	m.EIM_ASResAuthorizationMode_isUsed = 0
+	if v.EIM_ASResAuthorizationMode != nil {
+		m.EIM_ASResAuthorizationMode_isUsed = 1
+	}
+	m.PnC_ASResAuthorizationMode_isUsed = 0
+	if v.PnC_ASResAuthorizationMode == nil {
+		return nil
+	}
+	m.PnC_ASResAuthorizationMode_isUsed = 1
+	p := &m.PnC_ASResAuthorizationMode
+	src := v.PnC_ASResAuthorizationMode
+	if err := fixedOut(unsafe.Pointer(&p.GenChallenge[0]), C.V2G_GEN_CHALLENGE_SIZE, &p.GenChallengeLen, src.GenChallenge, "GenChallenge"); err != nil {
+		return err
+	}
+	return stringArrayOut(&p.SupportedProviders[0], C.V2G_SUPPORTED_PROVIDERS_SIZE, &p.SupportedProvidersLen, src.SupportedProviders, "SupportedProviders")
+}
+
+func serviceSelectionReqIn(m *C.struct_v2g_ServiceSelectionReq) (*generated.ServiceSelectionReq, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	out := &generated.ServiceSelectionReq{
+		Header:                        h,
+		SelectedEnergyTransferService: selectedServiceIn(&m.SelectedEnergyTransferService),
+	}
+	if m.SelectedVASList_isUsed != 0 {
+		l := &m.SelectedVASList
+		if int(l.SelectedServicesLen) > C.V2G_SELECTED_SERVICE_SIZE {
+			return nil, fmt.Errorf("SelectedVASList: count %d exceeds capacity %d", int(l.SelectedServicesLen), C.V2G_SELECTED_SERVICE_SIZE)
+		}
+		list := &generated.SelectedServiceList{}
+		if l.SelectedServicesLen > 0 {
+			list.SelectedServices = make([]generated.SelectedService, int(l.SelectedServicesLen))
+		}
+		for i := range list.SelectedServices {
+			list.SelectedServices[i] = selectedServiceIn(&l.SelectedServices[i])
+		}
+		out.SelectedVASList = list
+	}
+	return out, nil
+}
+
+func serviceSelectionReqOut(m *C.struct_v2g_ServiceSelectionReq, v *generated.ServiceSelectionReq) error {
+	if err := headerOut(&m.Header, &v.Header); err != nil {
+		return err
+	}
+	selectedServiceOut(&m.SelectedEnergyTransferService, &v.SelectedEnergyTransferService)
+	m.SelectedVASList_isUsed = 0
+	m.SelectedVASList.SelectedServicesLen = 0
+	if v.SelectedVASList == nil {
+		return nil
+	}
+	services := v.SelectedVASList.SelectedServices
+	if len(services) > C.V2G_SELECTED_SERVICE_SIZE {
+		return fmt.Errorf("SelectedVASList: %d entries exceed capacity %d: %w", len(services), C.V2G_SELECTED_SERVICE_SIZE, errNativeTooSmall)
+	}
+	m.SelectedVASList_isUsed = 1
+	for i := range services {
+		selectedServiceOut(&m.SelectedVASList.SelectedServices[i], &services[i])
+	}
+	m.SelectedVASList.SelectedServicesLen = C.uint16_t(len(services))
+	return nil
+}
+
+func serviceSelectionResIn(m *C.struct_v2g_ServiceSelectionRes) (*generated.ServiceSelectionRes, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	rc, err := stringIn(&m.ResponseCode, "ResponseCode")
+	if err != nil {
+		return nil, err
+	}
+	return &generated.ServiceSelectionRes{Header: h, ResponseCode: rc}, nil
+}
+
+func serviceSelectionResOut(m *C.struct_v2g_ServiceSelectionRes, v *generated.ServiceSelectionRes) error {
+	if err := headerOut(&m.Header, &v.Header); err != nil {
+		return err
+	}
+	return stringOut(&m.ResponseCode, v.ResponseCode, "ResponseCode")
+}
+
+func powerDeliveryReqIn(m *C.struct_v2g_PowerDeliveryReq) (*generated.PowerDeliveryReq, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	proc, err := stringIn(&m.EVProcessing, "EVProcessing")
+	if err != nil {
+		return nil, err
+	}
+	progress, err := stringIn(&m.ChargeProgress, "ChargeProgress")
+	if err != nil {
+		return nil, err
+	}
+	bpt, err := optStringIn(&m.BPT_ChannelSelection, m.BPT_ChannelSelection_isUsed, "BPT_ChannelSelection")
+	if err != nil {
+		return nil, err
+	}
+	out := &generated.PowerDeliveryReq{
+		Header:               h,
+		EVProcessing:         proc,
+		ChargeProgress:       progress,
+		BPT_ChannelSelection: bpt,
+	}
+	if m.EVPowerProfile_isUsed != 0 {
+		p := &m.EVPowerProfile
+		if int(p.EntriesLen) > C.V2G_POWER_PROFILE_SIZE {
+			return nil, fmt.Errorf("EVPowerProfile: count %d exceeds capacity %d", int(p.EntriesLen), C.V2G_POWER_PROFILE_SIZE)
+		}
+		profile := &generated.EVPowerProfile{TimeAnchor: uint64(p.TimeAnchor)}
+		if p.EntriesLen > 0 {
+			profile.Entries = make([]generated.EVPowerProfileEntry, int(p.EntriesLen))
+		}
+		for i := range profile.Entries {
+			profile.Entries[i] = generated.EVPowerProfileEntry{
+				Duration: uint32(p.Entries[i].Duration),
+				Power:    rationalIn(&p.Entries[i].Power),
+			}
+		}
+		out.EVPowerProfile = profile
+	}
+	return out, nil
+}
+
+func powerDeliveryReqOut(m *C.struct_v2g_PowerDeliveryReq, v *generated.PowerDeliveryReq) error {
+	if err := headerOut(&m.Header, &v.Header); err != nil {
+		return err
+	}
+	if err := stringOut(&m.EVProcessing, v.EVProcessing, "EVProcessing"); err != nil {
+		return err
+	}
+	if err := stringOut(&m.ChargeProgress, v.ChargeProgress, "ChargeProgress"); err != nil {
+		return err
+	}
+	if err := optStringOut(&m.BPT_ChannelSelection, &m.BPT_ChannelSelection_isUsed, v.BPT_ChannelSelection, "BPT_ChannelSelection"); err != nil {
+		return err
+	}
+	m.EVPowerProfile_isUsed = 0
+	m.EVPowerProfile.EntriesLen = 0
+	if v.EVPowerProfile == nil {
+		return nil
+	}
+	entries := v.EVPowerProfile.Entries
+	if len(entries) > C.V2G_POWER_PROFILE_SIZE {
+		return fmt.Errorf("EVPowerProfile: %d entries exceed capacity %d: %w", len(entries), C.V2G_POWER_PROFILE_SIZE, errNativeTooSmall)
+	}
+	m.EVPowerProfile_isUsed = 1
+	m.EVPowerProfile.TimeAnchor = C.uint64_t(v.EVPowerProfile.TimeAnchor)
+	for i, e := range entries {
+		m.EVPowerProfile.Entries[i].Duration = C.uint32_t(e.Duration)
+		rationalOut(&m.EVPowerProfile.Entries[i].Power, e.Power)
+	}
+	m.EVPowerProfile.EntriesLen = C.uint16_t(len(entries))
+	return nil
+}
+
+func powerDeliveryResIn(m *C.struct_v2g_PowerDeliveryRes) (*generated.PowerDeliveryRes, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	rc, err := stringIn(&m.ResponseCode, "ResponseCode")
+	if err != nil {
+		return nil, err
+	}
+	out := &generated.PowerDeliveryRes{Header: h, ResponseCode: rc}
+	if m.EVSEStatus_isUsed != 0 {
+		n, err := stringIn(&m.EVSEStatus.EVSENotification, "EVSENotification")
+		if err != nil {
+			return nil, err
+		}
+		out.EVSEStatus = &generated.EVSEStatus{
+			NotificationMaxDelay: uint16(m.EVSEStatus.NotificationMaxDelay),
+			EVSENotification:     n,
+		}
+	}
+	return out, nil
+}
+
+func powerDeliveryResOut(m *C.struct_v2g_PowerDeliveryRes, v *generated.PowerDeliveryRes) error {
+	if err := headerOut(&m.Header, &v.Header); err != nil {
+		return err
+	}
+	if err := stringOut(&m.ResponseCode, v.ResponseCode, "ResponseCode"); err != nil {
+		return err
+	}
+	m.EVSEStatus_isUsed = 0
+	if v.EVSEStatus == nil {
+		return nil
+	}
+	m.EVSEStatus_isUsed = 1
+	m.EVSEStatus.NotificationMaxDelay = C.uint16_t(v.EVSEStatus.NotificationMaxDelay)
+	return stringOut(&m.EVSEStatus.EVSENotification, v.EVSEStatus.EVSENotification, "EVSENotification")
+}
+
+func sessionStopReqIn(m *C.struct_v2g_SessionStopReq) (*generated.SessionStopReq, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	cs, err := stringIn(&m.ChargingSession, "ChargingSession")
+	if err != nil {
+		return nil, err
+	}
+	code, err := optStringIn(&m.EVTerminationCode, m.EVTerminationCode_isUsed, "EVTerminationCode")
+	if err != nil {
+		return nil, err
+	}
+	expl, err := optStringIn(&m.EVTerminationExplanation, m.EVTerminationExplanation_isUsed, "EVTerminationExplanation")
+	if err != nil {
+		return nil, err
+	}
+	return &generated.SessionStopReq{
+		Header:                   h,
+		ChargingSession:          cs,
+		EVTerminationCode:        code,
+		EVTerminationExplanation: expl,
+	}, nil
+}
+
+func sessionStopReqOut(m *C.struct_v2g_SessionStopReq, v *generated.SessionStopReq) error {
+	if err := headerOut(&m.Header, &v.Header); err != nil {
+		return err
+	}
+	if err := stringOut(&m.ChargingSession, v.ChargingSession, "ChargingSession"); err != nil {
+		return err
+	}
+	if err := optStringOut(&m.EVTerminationCode, &m.EVTerminationCode_isUsed, v.EVTerminationCode, "EVTerminationCode"); err != nil {
+		return err
+	}
+	return optStringOut(&m.EVTerminationExplanation, &m.EVTerminationExplanation_isUsed, v.EVTerminationExplanation, "EVTerminationExplanation")
+}
+
+func sessionStopResIn(m *C.struct_v2g_SessionStopRes) (*generated.SessionStopRes, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	rc, err := stringIn(&m.ResponseCode, "ResponseCode")
+	if err != nil {
+		return nil, err
+	}
+	return &generated.SessionStopRes{Header: h, ResponseCode: rc}, nil
+}
+
+func sessionStopResOut(m *C.struct_v2g_SessionStopRes, v *generated.SessionStopRes) error {
+	if err := headerOut(&m.Header, &v.Header); err != nil {
+		return err
+	}
+	return stringOut(&m.ResponseCode, v.ResponseCode, "ResponseCode")
+}
+
+func scheduleExchangeReqIn(m *C.struct_v2g_ScheduleExchangeReq) (*generated.ScheduleExchangeReq, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	return &generated.ScheduleExchangeReq{Header: h, MaximumSupportingPoints: uint16(m.MaximumSupportingPoints)}, nil
+}
+
+func scheduleExchangeReqOut(m *C.struct_v2g_ScheduleExchangeReq, v *generated.ScheduleExchangeReq) error {
+	m.MaximumSupportingPoints = C.uint16_t(v.MaximumSupportingPoints)
+	return headerOut(&m.Header, &v.Header)
+}
+
+func scheduleExchangeResIn(m *C.struct_v2g_ScheduleExchangeRes) (*generated.ScheduleExchangeRes, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	rc, err := stringIn(&m.ResponseCode, "ResponseCode")
+	if err != nil {
+		return nil, err
+	}
+	proc, err := stringIn(&m.EVSEProcessing, "EVSEProcessing")
+	if err != nil {
+		return nil, err
+	}
+	return &generated.ScheduleExchangeRes{Header: h, ResponseCode: rc, EVSEProcessing: proc}, nil
+}
+
+func scheduleExchangeResOut(m *C.struct_v2g_ScheduleExchangeRes, v *generated.ScheduleExchangeRes) error {
+	if err := headerOut(&m.Header, &v.Header); err != nil {
+		return err
+	}
+	if err := stringOut(&m.ResponseCode, v.ResponseCode, "ResponseCode"); err != nil {
+		return err
+	}
+	return stringOut(&m.EVSEProcessing, v.EVSEProcessing, "EVSEProcessing")
+}
+
+func meteringConfirmationReqIn(m *C.struct_v2g_MeteringConfirmationReq) (*generated.MeteringConfirmationReq, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	return &generated.MeteringConfirmationReq{Header: h}, nil
+}
+
+func meteringConfirmationReqOut(m *C.struct_v2g_MeteringConfirmationReq, v *generated.MeteringConfirmationReq) error {
+	return headerOut(&m.Header, &v.Header)
+}
+
+func meteringConfirmationResIn(m *C.struct_v2g_MeteringConfirmationRes) (*generated.MeteringConfirmationRes, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	rc, err := stringIn(&m.ResponseCode, "ResponseCode")
+	if err != nil {
+		return nil, err
+	}
+	return &generated.MeteringConfirmationRes{Header: h, ResponseCode: rc}, nil
+}
+
+func meteringConfirmationResOut(m *C.struct_v2g_MeteringConfirmationRes, v *generated.MeteringConfirmationRes) error {
+	if err := headerOut(&m.Header, &v.Header); err != nil {
+		return err
+	}
+	return stringOut(&m.ResponseCode, v.ResponseCode, "ResponseCode")
+}
+
+func certificateInstallationReqIn(m *C.struct_v2g_CertificateInstallationReq) (*generated.CertificateInstallationReq, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	chain, err := certificateChainIn(&m.OEMProvisioningCertChain, "OEMProvisioningCertChain")
+	if err != nil {
+		return nil, err
+	}
+	ids, err := stringArrayIn(&m.ListOfRootCertificateIDs[0], m.ListOfRootCertificateIDsLen, C.V2G_ROOT_CERTIFICATE_IDS_SIZE, "ListOfRootCertificateIDs")
+	if err != nil {
+		return nil, err
+	}
+	return &generated.CertificateInstallationReq{Header: h, OEMProvisioningCertChain: chain, ListOfRootCertificateIDs: ids}, nil
+}
+
+func certificateInstallationReqOut(m *C.struct_v2g_CertificateInstallationReq, v *generated.CertificateInstallationReq) error {
+	if err := headerOut(&m.Header, &v.Header); err != nil {
+		return err
+	}
+	if err := certificateChainOut(&m.OEMProvisioningCertChain, &v.OEMProvisioningCertChain, "OEMProvisioningCertChain"); err != nil {
+		return err
+	}
+	return stringArrayOut(&m.ListOfRootCertificateIDs[0], C.V2G_ROOT_CERTIFICATE_IDS_SIZE, &m.ListOfRootCertificateIDsLen, v.ListOfRootCertificateIDs, "ListOfRootCertificateIDs")
+}
+
+func certificateInstallationResIn(m *C.struct_v2g_CertificateInstallationRes) (*generated.CertificateInstallationRes, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	rc, err := stringIn(&m.ResponseCode, "ResponseCode")
+	if err != nil {
+		return nil, err
+	}
+	proc, err := stringIn(&m.EVSEProcessing, "EVSEProcessing")
+	if err != nil {
+		return nil, err
+	}
+	cps, err := certificateChainIn(&m.CPSCertificateChain, "CPSCertificateChain")
+	if err != nil {
+		return nil, err
+	}
+	key, err := bytesIn(&m.ContractSignatureEncryptedPrivateKey, "ContractSignatureEncryptedPrivateKey")
+	if err != nil {
+		return nil, err
+	}
+	dh, err := bytesIn(&m.DHPublicKey, "DHPublicKey")
+	if err != nil {
+		return nil, err
+	}
+	contract, err := certificateChainIn(&m.ContractCertificateChain, "ContractCertificateChain")
+	if err != nil {
+		return nil, err
+	}
+	out := &generated.CertificateInstallationRes{
+		Header:                   h,
+		ResponseCode:             rc,
+		EVSEProcessing:           proc,
+		CPSCertificateChain:      cps,
+		DHPublicKey:              dh,
+		ContractCertificateChain: contract,
+	}
+	if len(key) > 0 {
+		out.ContractSignatureEncryptedPrivateKey = unsafe.String(&key[0], len(key))
+	}
+	return out, nil
+}
+
+func certificateInstallationResOut(m *C.struct_v2g_CertificateInstallationRes, v *generated.CertificateInstallationRes) error {
+	if err := headerOut(&m.Header, &v.Header); err != nil {
+		return err
+	}
+	if err := stringOut(&m.ResponseCode, v.ResponseCode, "ResponseCode"); err != nil {
+		return err
+	}
+	if err := stringOut(&m.EVSEProcessing, v.EVSEProcessing, "EVSEProcessing"); err != nil {
+		return err
+	}
+	if err := certificateChainOut(&m.CPSCertificateChain, &v.CPSCertificateChain, "CPSCertificateChain"); err != nil {
+		return err
+	}
+	if err := bytesOut(&m.ContractSignatureEncryptedPrivateKey, []byte(v.ContractSignatureEncryptedPrivateKey), "ContractSignatureEncryptedPrivateKey"); err != nil {
+		return err
+	}
+	if err := bytesOut(&m.DHPublicKey, v.DHPublicKey, "DHPublicKey"); err != nil {
+		return err
+	}
+	return certificateChainOut(&m.ContractCertificateChain, &v.ContractCertificateChain, "ContractCertificateChain")
+}
+
+func vehicleCheckInReqIn(m *C.struct_v2g_VehicleCheckInReq) (*generated.VehicleCheckInReq, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	status, err := stringIn(&m.EVCheckInStatus, "EVCheckInStatus")
+	if err != nil {
+		return nil, err
+	}
+	parking, err := optStringIn(&m.ParkingMethod, m.ParkingMethod_isUsed, "ParkingMethod")
+	if err != nil {
+		return nil, err
+	}
+	return &generated.VehicleCheckInReq{Header: h, EVCheckInStatus: status, ParkingMethod: parking}, nil
+}
+
+func vehicleCheckInReqOut(m *C.struct_v2g_VehicleCheckInReq, v *generated.VehicleCheckInReq) error {
+	if err := headerOut(&m.Header, &v.Header); err != nil {
+		return err
+	}
+	if err := stringOut(&m.EVCheckInStatus, v.EVCheckInStatus, "EVCheckInStatus"); err != nil {
+		return err
+	}
+	return optStringOut(&m.ParkingMethod, &m.ParkingMethod_isUsed, v.ParkingMethod, "ParkingMethod")
+}
+
+func vehicleCheckInResIn(m *C.struct_v2g_VehicleCheckInRes) (*generated.VehicleCheckInRes, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	rc, err := stringIn(&m.ResponseCode, "ResponseCode")
+	if err != nil {
+		return nil, err
+	}
+	result, err := optStringIn(&m.VehicleCheckInResult, m.VehicleCheckInResult_isUsed, "VehicleCheckInResult")
+	if err != nil {
+		return nil, err
+	}
+	return &generated.VehicleCheckInRes{Header: h, ResponseCode: rc, VehicleCheckInResult: result}, nil
+}
+
+func vehicleCheckInResOut(m *C.struct_v2g_VehicleCheckInRes, v *generated.VehicleCheckInRes) error {
+	if err := headerOut(&m.Header, &v.Header); err != nil {
+		return err
+	}
+	if err := stringOut(&m.ResponseCode, v.ResponseCode, "ResponseCode"); err != nil {
+		return err
+	}
+	return optStringOut(&m.VehicleCheckInResult, &m.VehicleCheckInResult_isUsed, v.VehicleCheckInResult, "VehicleCheckInResult")
+}
+
+func vehicleCheckOutReqIn(m *C.struct_v2g_VehicleCheckOutReq) (*generated.VehicleCheckOutReq, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	status, err := stringIn(&m.EVCheckOutStatus, "EVCheckOutStatus")
+	if err != nil {
+		return nil, err
+	}
+	return &generated.VehicleCheckOutReq{Header: h, EVCheckOutStatus: status, CheckOutTime: uint64(m.CheckOutTime)}, nil
+}
+
+func vehicleCheckOutReqOut(m *C.struct_v2g_VehicleCheckOutReq, v *generated.VehicleCheckOutReq) error {
+	if err := headerOut(&m.Header, &v.Header); err != nil {
+		return err
+	}
+	m.CheckOutTime = C.uint64_t(v.CheckOutTime)
+	return stringOut(&m.EVCheckOutStatus, v.EVCheckOutStatus, "EVCheckOutStatus")
+}
+
+func vehicleCheckOutResIn(m *C.struct_v2g_VehicleCheckOutRes) (*generated.VehicleCheckOutRes, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	rc, err := stringIn(&m.ResponseCode, "ResponseCode")
+	if err != nil {
+		return nil, err
+	}
+	status, err := stringIn(&m.EVSECheckOutStatus, "EVSECheckOutStatus")
+	if err != nil {
+		return nil, err
+	}
+	return &generated.VehicleCheckOutRes{Header: h, ResponseCode: rc, EVSECheckOutStatus: status}, nil
+}
+
+func vehicleCheckOutResOut(m *C.struct_v2g_VehicleCheckOutRes, v *generated.VehicleCheckOutRes) error {
+	if err := headerOut(&m.Header, &v.Header); err != nil {
+		return err
+	}
+	if err := stringOut(&m.ResponseCode, v.ResponseCode, "ResponseCode"); err != nil {
+		return err
+	}
+	return stringOut(&m.EVSECheckOutStatus, v.EVSECheckOutStatus, "EVSECheckOutStatus")
+}
+
+func clReqControlModeIn(m *C.struct_v2g_CLReqControlMode) (*generated.CLReqControlMode, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	return &generated.CLReqControlMode{Header: h}, nil
+}
+
+func clReqControlModeOut(m *C.struct_v2g_CLReqControlMode, v *generated.CLReqControlMode) error {
+	return headerOut(&m.Header, &v.Header)
+}
+
+func clResControlModeIn(m *C.struct_v2g_CLResControlMode) (*generated.CLResControlMode, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	return &generated.CLResControlMode{Header: h}, nil
+}
+
+func clResControlModeOut(m *C.struct_v2g_CLResControlMode, v *generated.CLResControlMode) error {
+	return headerOut(&m.Header, &v.Header)
+}
+
+// WPT messages -------------------------------------------------------------
+
+func wptAlignmentCheckReqIn(m *C.struct_v2g_WPT_AlignmentCheckReq) (*generated.WPT_AlignmentCheckReq, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	return &generated.WPT_AlignmentCheckReq{Header: h}, nil
+}
+
+func wptAlignmentCheckReqOut(m *C.struct_v2g_WPT_AlignmentCheckReq, v *generated.WPT_AlignmentCheckReq) error {
+	return headerOut(&m.Header, &v.Header)
+}
+
+func wptAlignmentCheckResIn(m *C.struct_v2g_WPT_AlignmentCheckRes) (*generated.WPT_AlignmentCheckRes, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	rc, err := stringIn(&m.ResponseCode, "ResponseCode")
+	if err != nil {
+		return nil, err
+	}
+	status, err := stringIn(&m.AlignmentStatus, "AlignmentStatus")
+	if err != nil {
+		return nil, err
+	}
+	return &generated.WPT_AlignmentCheckRes{
+		Header:            h,
+		ResponseCode:      rc,
+		AlignmentStatus:   status,
+		AlignmentOffset_X: optRationalIn(&m.AlignmentOffset_X, m.AlignmentOffset_X_isUsed),
+		AlignmentOffset_Y: optRationalIn(&m.AlignmentOffset_Y, m.AlignmentOffset_Y_isUsed),
+		AlignmentOffset_Z: optRationalIn(&m.AlignmentOffset_Z, m.AlignmentOffset_Z_isUsed),
+	}, nil
+}
+
+func wptAlignmentCheckResOut(m *C.struct_v2g_WPT_AlignmentCheckRes, v *generated.WPT_AlignmentCheckRes) error {
+	if err := headerOut(&m.Header, &v.Header); err != nil {
+		return err
+	}
+	if err := stringOut(&m.ResponseCode, v.ResponseCode, "ResponseCode"); err != nil {
+		return err
+	}
+	if err := stringOut(&m.AlignmentStatus, v.AlignmentStatus, "AlignmentStatus"); err != nil {
+		return err
+	}
+	optRationalOut(&m.AlignmentOffset_X, &m.AlignmentOffset_X_isUsed, v.AlignmentOffset_X)
+	optRationalOut(&m.AlignmentOffset_Y, &m.AlignmentOffset_Y_isUsed, v.AlignmentOffset_Y)
+	optRationalOut(&m.AlignmentOffset_Z, &m.AlignmentOffset_Z_isUsed, v.AlignmentOffset_Z)
+	return nil
+}
+
+func wptFinePositioningReqIn(m *C.struct_v2g_WPT_FinePositioningReq) (*generated.WPT_FinePositioningReq, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	return &generated.WPT_FinePositioningReq{Header: h}, nil
+}
+
+func wptFinePositioningReqOut(m *C.struct_v2g_WPT_FinePositioningReq, v *generated.WPT_FinePositioningReq) error {
+	return headerOut(&m.Header, &v.Header)
+}
+
+func wptFinePositioningResIn(m *C.struct_v2g_WPT_FinePositioningRes) (*generated.WPT_FinePositioningRes, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	rc, err := stringIn(&m.ResponseCode, "ResponseCode")
+	if err != nil {
+		return nil, err
+	}
+	status, err := stringIn(&m.PositioningStatus, "PositioningStatus")
+	if err != nil {
+		return nil, err
+	}
+	dir, err := optStringIn(&m.GuidanceDirection, m.GuidanceDirection_isUsed, "GuidanceDirection")
+	if err != nil {
+		return nil, err
+	}
+	return &generated.WPT_FinePositioningRes{
+		Header:                h,
+		ResponseCode:          rc,
+		PositioningStatus:     status,
+		GuidanceDirection:     dir,
+		GuidanceDistance:      optRationalIn(&m.GuidanceDistance, m.GuidanceDistance_isUsed),
+		FinePositioningSignal: optIn(m.FinePositioningSignal_isUsed, int16(m.FinePositioningSignal)),
+	}, nil
+}
+
+func wptFinePositioningResOut(m *C.struct_v2g_WPT_FinePositioningRes, v *generated.WPT_FinePositioningRes) error {
+	if err := headerOut(&m.Header, &v.Header); err != nil {
+		return err
+	}
+	if err := stringOut(&m.ResponseCode, v.ResponseCode, "ResponseCode"); err != nil {
+		return err
+	}
+	if err := stringOut(&m.PositioningStatus, v.PositioningStatus, "PositioningStatus"); err != nil {
+		return err
+	}
+	if err := optStringOut(&m.GuidanceDirection, &m.GuidanceDirection_isUsed, v.GuidanceDirection, "GuidanceDirection"); err != nil {
+		return err
+	}
+	optRationalOut(&m.GuidanceDistance, &m.GuidanceDistance_isUsed, v.GuidanceDistance)
+	m.FinePositioningSignal = C.int16_t(optOut(&m.FinePositioningSignal_isUsed, v.FinePositioningSignal))
+	return nil
+}
+
+func wptChargeLoopReqIn(m *C.struct_v2g_WPT_ChargeLoopReq) (*generated.WPT_ChargeLoopReq, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	proc, err := stringIn(&m.EVProcessing, "EVProcessing")
+	if err != nil {
+		return nil, err
+	}
+	return &generated.WPT_ChargeLoopReq{
+		Header:                h,
+		EVProcessing:          proc,
+		PowerRequest:          optRationalIn(&m.PowerRequest, m.PowerRequest_isUsed),
+		EVTargetEnergyRequest: optRationalIn(&m.EVTargetEnergyRequest, m.EVTargetEnergyRequest_isUsed),
+		EVMaximumPowerLimit:   optRationalIn(&m.EVMaximumPowerLimit, m.EVMaximumPowerLimit_isUsed),
+		EVMinimumPowerLimit:   optRationalIn(&m.EVMinimumPowerLimit, m.EVMinimumPowerLimit_isUsed),
+		DepartureTime:         optIn(m.DepartureTime_isUsed, uint64(m.DepartureTime)),
+	}, nil
+}
+
+func wptChargeLoopReqOut(m *C.struct_v2g_WPT_ChargeLoopReq, v *generated.WPT_ChargeLoopReq) error {
+	if err := headerOut(&m.Header, &v.Header); err != nil {
+		return err
+	}
+	if err := stringOut(&m.EVProcessing, v.EVProcessing, "EVProcessing"); err != nil {
+		return err
+	}
+	optRationalOut(&m.PowerRequest, &m.PowerRequest_isUsed, v.PowerRequest)
+	optRationalOut(&m.EVTargetEnergyRequest, &m.EVTargetEnergyRequest_isUsed, v.EVTargetEnergyRequest)
+	optRationalOut(&m.EVMaximumPowerLimit, &m.EVMaximumPowerLimit_isUsed, v.EVMaximumPowerLimit)
+	optRationalOut(&m.EVMinimumPowerLimit, &m.EVMinimumPowerLimit_isUsed, v.EVMinimumPowerLimit)
+	m.DepartureTime = C.uint64_t(optOut(&m.DepartureTime_isUsed, v.DepartureTime))
+	return nil
+}
+
+func wptMeterInfoIn(mi *C.struct_v2g_WPT_MeterInfo) (*generated.WPT_MeterInfo, error) {
+	id, err := stringIn(&mi.MeterID, "MeterInfo.MeterID")
+	if err != nil {
+		return nil, err
+	}
+	sig, err := bytesIn(&mi.MeterSignature, "MeterInfo.MeterSignature")
+	if err != nil {
+		return nil, err
+	}
+	return &generated.WPT_MeterInfo{
+		MeterID:        id,
+		MeterReading:   rationalIn(&mi.MeterReading),
+		MeterTimestamp: optIn(mi.MeterTimestamp_isUsed, uint64(mi.MeterTimestamp)),
+		MeterSignature: sig,
+		MeterStatus:    optIn(mi.MeterStatus_isUsed, int16(mi.MeterStatus)),
+	}, nil
+}
+
+func wptMeterInfoOut(mi *C.struct_v2g_WPT_MeterInfo, v *generated.WPT_MeterInfo) error {
+	if err := stringOut(&mi.MeterID, v.MeterID, "MeterInfo.MeterID"); err != nil {
+		return err
+	}
+	rationalOut(&mi.MeterReading, v.MeterReading)
+	mi.MeterTimestamp = C.uint64_t(optOut(&mi.MeterTimestamp_isUsed, v.MeterTimestamp))
+	mi.MeterStatus = C.int16_t(optOut(&mi.MeterStatus_isUsed, v.MeterStatus))
+	return bytesOut(&mi.MeterSignature, v.MeterSignature, "MeterInfo.MeterSignature")
+}
+
+func wptChargeLoopResIn(m *C.struct_v2g_WPT_ChargeLoopRes) (*generated.WPT_ChargeLoopRes, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	rc, err := stringIn(&m.ResponseCode, "ResponseCode")
+	if err != nil {
+		return nil, err
+	}
+	proc, err := stringIn(&m.EVSEProcessing, "EVSEProcessing")
+	if err != nil {
+		return nil, err
+	}
+	out := &generated.WPT_ChargeLoopRes{
+		Header:                 h,
+		ResponseCode:           rc,
+		EVSEProcessing:         proc,
+		EVSEPresentPower:       optRationalIn(&m.EVSEPresentPower, m.EVSEPresentPower_isUsed),
+		EVSEMaximumPowerLimit:  optRationalIn(&m.EVSEMaximumPowerLimit, m.EVSEMaximumPowerLimit_isUsed),
+		EVSEMinimumPowerLimit:  optRationalIn(&m.EVSEMinimumPowerLimit, m.EVSEMinimumPowerLimit_isUsed),
+		ChargingComplete:       optIn(m.ChargingComplete_isUsed, m.ChargingComplete != 0),
+		EVSETargetFrequency:    optRationalIn(&m.EVSETargetFrequency, m.EVSETargetFrequency_isUsed),
+		LF_EVSEFinePositioning: optIn(m.LF_EVSEFinePositioning_isUsed, int16(m.LF_EVSEFinePositioning)),
+	}
+	if m.MeterInfo_isUsed != 0 {
+		if out.MeterInfo, err = wptMeterInfoIn(&m.MeterInfo); err != nil {
+			return nil, err
+		}
+	}
+	return out, nil
+}
+
+func wptChargeLoopResOut(m *C.struct_v2g_WPT_ChargeLoopRes, v *generated.WPT_ChargeLoopRes) error {
+	if err := headerOut(&m.Header, &v.Header); err != nil {
+		return err
+	}
+	if err := stringOut(&m.ResponseCode, v.ResponseCode, "ResponseCode"); err != nil {
+		return err
+	}
+	if err := stringOut(&m.EVSEProcessing, v.EVSEProcessing, "EVSEProcessing"); err != nil {
+		return err
+	}
+	optRationalOut(&m.EVSEPresentPower, &m.EVSEPresentPower_isUsed, v.EVSEPresentPower)
+	optRationalOut(&m.EVSEMaximumPowerLimit, &m.EVSEMaximumPowerLimit_isUsed, v.EVSEMaximumPowerLimit)
+	optRationalOut(&m.EVSEMinimumPowerLimit, &m.EVSEMinimumPowerLimit_isUsed, v.EVSEMinimumPowerLimit)
+	m.ChargingComplete = boolToC(optOut(&m.ChargingComplete_isUsed, v.ChargingComplete))
+	optRationalOut(&m.EVSETargetFrequency, &m.EVSETargetFrequency_isUsed, v.EVSETargetFrequency)
+	m.LF_EVSEFinePositioning = C.int16_t(optOut(&m.LF_EVSEFinePositioning_isUsed, v.LF_EVSEFinePositioning))
+	m.MeterInfo_isUsed = 0
+	if v.MeterInfo != nil {
+		m.MeterInfo_isUsed = 1
+		return wptMeterInfoOut(&m.MeterInfo, v.MeterInfo)
+	}
+	return nil
+}
+
+// ACDP messages ------------------------------------------------------------
+
+func acdpMeterInfoIn(mi *C.struct_v2g_DC_ACDP_MeterInfo) (*generated.DC_ACDP_MeterInfo, error) {
+	id, err := stringIn(&mi.MeterID, "MeterInfo.MeterID")
+	if err != nil {
+		return nil, err
+	}
+	sig, err := bytesIn(&mi.MeterSignature, "MeterInfo.MeterSignature")
+	if err != nil {
+		return nil, err
+	}
+	return &generated.DC_ACDP_MeterInfo{
+		MeterID:        id,
+		MeterReading:   rationalIn(&mi.MeterReading),
+		MeterTimestamp: optIn(mi.MeterTimestamp_isUsed, uint64(mi.MeterTimestamp)),
+		MeterSignature: sig,
+		MeterStatus:    optIn(mi.MeterStatus_isUsed, int16(mi.MeterStatus)),
+		TMeter:         optIn(mi.TMeter_isUsed, int64(mi.TMeter)),
+	}, nil
+}
+
+func acdpMeterInfoOut(mi *C.struct_v2g_DC_ACDP_MeterInfo, v *generated.DC_ACDP_MeterInfo) error {
+	if err := stringOut(&mi.MeterID, v.MeterID, "MeterInfo.MeterID"); err != nil {
+		return err
+	}
+	rationalOut(&mi.MeterReading, v.MeterReading)
+	mi.MeterTimestamp = C.uint64_t(optOut(&mi.MeterTimestamp_isUsed, v.MeterTimestamp))
+	mi.MeterStatus = C.int16_t(optOut(&mi.MeterStatus_isUsed, v.MeterStatus))
+	mi.TMeter = C.int64_t(optOut(&mi.TMeter_isUsed, v.TMeter))
+	return bytesOut(&mi.MeterSignature, v.MeterSignature, "MeterInfo.MeterSignature")
+}
+
+func dcACDPReqIn(m *C.struct_v2g_DC_ACDPReq) (*generated.DC_ACDPReq, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	proc, err := stringIn(&m.EVProcessing, "EVProcessing")
+	if err != nil {
+		return nil, err
+	}
+	mode, err := optStringIn(&m.DynamicControlMode, m.DynamicControlMode_isUsed, "DynamicControlMode")
+	if err != nil {
+		return nil, err
+	}
+	out := &generated.DC_ACDPReq{
+		Header:                 h,
+		EVProcessing:           proc,
+		EVTargetEnergyRequest:  rationalIn(&m.EVTargetEnergyRequest),
+		EVMaximumEnergyRequest: optRationalIn(&m.EVMaximumEnergyRequest, m.EVMaximumEnergyRequest_isUsed),
+		EVMinimumEnergyRequest: optRationalIn(&m.EVMinimumEnergyRequest, m.EVMinimumEnergyRequest_isUsed),
+		DynamicControlMode:     mode,
+	}
+	if m.DisplayParameters_isUsed != 0 {
+		out.DisplayParameters = displayParametersIn(&m.DisplayParameters)
+	}
+	return out, nil
+}
+
+func dcACDPReqOut(m *C.struct_v2g_DC_ACDPReq, v *generated.DC_ACDPReq) error {
+	if err := headerOut(&m.Header, &v.Header); err != nil {
+		return err
+	}
+	if err := stringOut(&m.EVProcessing, v.EVProcessing, "EVProcessing"); err != nil {
+		return err
+	}
+	rationalOut(&m.EVTargetEnergyRequest, v.EVTargetEnergyRequest)
+	optRationalOut(&m.EVMaximumEnergyRequest, &m.EVMaximumEnergyRequest_isUsed, v.EVMaximumEnergyRequest)
+	optRationalOut(&m.EVMinimumEnergyRequest, &m.EVMinimumEnergyRequest_isUsed, v.EVMinimumEnergyRequest)
+	m.DisplayParameters_isUsed = 0
+	if v.DisplayParameters != nil {
+		m.DisplayParameters_isUsed = 1
+		displayParametersOut(&m.DisplayParameters, v.DisplayParameters)
+	}
+	return optStringOut(&m.DynamicControlMode, &m.DynamicControlMode_isUsed, v.DynamicControlMode, "DynamicControlMode")
+}
+
+func dcACDPResIn(m *C.struct_v2g_DC_ACDPRes) (*generated.DC_ACDPRes, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	rc, err := stringIn(&m.ResponseCode, "ResponseCode")
+	if err != nil {
+		return nil, err
+	}
+	proc, err := stringIn(&m.EVSEProcessing, "EVSEProcessing")
+	if err != nil {
+		return nil, err
+	}
+	out := &generated.DC_ACDPRes{
+		Header:                   h,
+		ResponseCode:             rc,
+		EVSEProcessing:           proc,
+		EVSEPresentActivePower:   optRationalIn(&m.EVSEPresentActivePower, m.EVSEPresentActivePower_isUsed),
+		EVSEPresentReactivePower: optRationalIn(&m.EVSEPresentReactivePower, m.EVSEPresentReactivePower_isUsed),
+		EVSEPowerRampLimitation:  optIn(m.EVSEPowerRampLimitation_isUsed, m.EVSEPowerRampLimitation != 0),
+		ReceiptRequired:          optIn(m.ReceiptRequired_isUsed, m.ReceiptRequired != 0),
+	}
+	if m.MeterInfo_isUsed != 0 {
+		if out.MeterInfo, err = acdpMeterInfoIn(&m.MeterInfo); err != nil {
+			return nil, err
+		}
+	}
+	return out, nil
+}
+
+func dcACDPResOut(m *C.struct_v2g_DC_ACDPRes, v *generated.DC_ACDPRes) error {
+	if err := headerOut(&m.Header, &v.Header); err != nil {
+		return err
+	}
+	if err := stringOut(&m.ResponseCode, v.ResponseCode, "ResponseCode"); err != nil {
+		return err
+	}
+	if err := stringOut(&m.EVSEProcessing, v.EVSEProcessing, "EVSEProcessing"); err != nil {
+		return err
+	}
+	optRationalOut(&m.EVSEPresentActivePower, &m.EVSEPresentActivePower_isUsed, v.EVSEPresentActivePower)
+	optRationalOut(&m.EVSEPresentReactivePower, &m.EVSEPresentReactivePower_isUsed, v.EVSEPresentReactivePower)
+	m.EVSEPowerRampLimitation = boolToC(optOut(&m.EVSEPowerRampLimitation_isUsed, v.EVSEPowerRampLimitation))
+	m.ReceiptRequired = boolToC(optOut(&m.ReceiptRequired_isUsed, v.ReceiptRequired))
+	m.MeterInfo_isUsed = 0
+	if v.MeterInfo != nil {
+		m.MeterInfo_isUsed = 1
+		return acdpMeterInfoOut(&m.MeterInfo, v.MeterInfo)
+	}
+	return nil
+}
+
+func dcACDPBPTReqIn(m *C.struct_v2g_DC_ACDP_BPTReq) (*generated.DC_ACDP_BPTReq, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	proc, err := stringIn(&m.EVProcessing, "EVProcessing")
+	if err != nil {
+		return nil, err
+	}
+	mode, err := optStringIn(&m.DynamicControlMode, m.DynamicControlMode_isUsed, "DynamicControlMode")
+	if err != nil {
+		return nil, err
+	}
+	bpt, err := optStringIn(&m.BPT_ChannelSelection, m.BPT_ChannelSelection_isUsed, "BPT_ChannelSelection")
+	if err != nil {
+		return nil, err
+	}
+	out := &generated.DC_ACDP_BPTReq{
+		Header:                  h,
+		EVProcessing:            proc,
+		EVTargetEnergyRequest:   rationalIn(&m.EVTargetEnergyRequest),
+		EVMaximumEnergyRequest:  optRationalIn(&m.EVMaximumEnergyRequest, m.EVMaximumEnergyRequest_isUsed),
+		EVMinimumEnergyRequest:  optRationalIn(&m.EVMinimumEnergyRequest, m.EVMinimumEnergyRequest_isUsed),
+		EVMaximumDischargePower: optRationalIn(&m.EVMaximumDischargePower, m.EVMaximumDischargePower_isUsed),
+		EVMinimumDischargePower: optRationalIn(&m.EVMinimumDischargePower, m.EVMinimumDischargePower_isUsed),
+		DynamicControlMode:      mode,
+		BPT_ChannelSelection:    bpt,
+	}
+	if m.DisplayParameters_isUsed != 0 {
+		out.DisplayParameters = displayParametersIn(&m.DisplayParameters)
+	}
+	return out, nil
+}
+
+func dcACDPBPTReqOut(m *C.struct_v2g_DC_ACDP_BPTReq, v *generated.DC_ACDP_BPTReq) error {
+	if err := headerOut(&m.Header, &v.Header); err != nil {
+		return err
+	}
+	if err := stringOut(&m.EVProcessing, v.EVProcessing, "EVProcessing"); err != nil {
+		return err
+	}
+	rationalOut(&m.EVTargetEnergyRequest, v.EVTargetEnergyRequest)
+	optRationalOut(&m.EVMaximumEnergyRequest, &m.EVMaximumEnergyRequest_isUsed, v.EVMaximumEnergyRequest)
+	optRationalOut(&m.EVMinimumEnergyRequest, &m.EVMinimumEnergyRequest_isUsed, v.EVMinimumEnergyRequest)
+	optRationalOut(&m.EVMaximumDischargePower, &m.EVMaximumDischargePower_isUsed, v.EVMaximumDischargePower)
+	optRationalOut(&m.EVMinimumDischargePower, &m.EVMinimumDischargePower_isUsed, v.EVMinimumDischargePower)
+	m.DisplayParameters_isUsed = 0
+	if v.DisplayParameters != nil {
+		m.DisplayParameters_isUsed = 1
+		displayParametersOut(&m.DisplayParameters, v.DisplayParameters)
+	}
+	if err := optStringOut(&m.DynamicControlMode, &m.DynamicControlMode_isUsed, v.DynamicControlMode, "DynamicControlMode"); err != nil {
+		return err
+	}
+	return optStringOut(&m.BPT_ChannelSelection, &m.BPT_ChannelSelection_isUsed, v.BPT_ChannelSelection, "BPT_ChannelSelection")
+}
+
+func dcACDPBPTResIn(m *C.struct_v2g_DC_ACDP_BPTRes) (*generated.DC_ACDP_BPTRes, error) {
+	h, err := headerIn(&m.Header)
+	if err != nil {
+		return nil, err
+	}
+	rc, err := stringIn(&m.ResponseCode, "ResponseCode")
+	if err != nil {
+		return nil, err
+	}
+	proc, err := stringIn(&m.EVSEProcessing, "EVSEProcessing")
+	if err != nil {
+		return nil, err
+	}
+	out := &generated.DC_ACDP_BPTRes{
+		Header:                    h,
+		ResponseCode:              rc,
+		EVSEProcessing:            proc,
+		EVSEPresentActivePower:    optRationalIn(&m.EVSEPresentActivePower, m.EVSEPresentActivePower_isUsed),
+		EVSEPresentReactivePower:  optRationalIn(&m.EVSEPresentReactivePower, m.EVSEPresentReactivePower_isUsed),
+		EVSEPowerRampLimitation:   optIn(m.EVSEPowerRampLimitation_isUsed, m.EVSEPowerRampLimitation != 0),
+		ReceiptRequired:           optIn(m.ReceiptRequired_isUsed, m.ReceiptRequired != 0),
+		EVSEMaximumDischargePower: optRationalIn(&m.EVSEMaximumDischargePower, m.EVSEMaximumDischargePower_isUsed),
+		EVSEMinimumDischargePower: optRationalIn(&m.EVSEMinimumDischargePower, m.EVSEMinimumDischargePower_isUsed),
+	}
+	if m.MeterInfo_isUsed != 0 {
+		if out.MeterInfo, err = acdpMeterInfoIn(&m.MeterInfo); err != nil {
+			return nil, err
+		}
+	}
+	return out, nil
+}
+
+func dcACDPBPTResOut(m *C.struct_v2g_DC_ACDP_BPTRes, v *generated.DC_ACDP_BPTRes) error {
+	if err := headerOut(&m.Header, &v.Header); err != nil {
+		return err
+	}
+	if err := stringOut(&m.ResponseCode, v.ResponseCode, "ResponseCode"); err != nil {
+		return err
+	}
+	if err := stringOut(&m.EVSEProcessing, v.EVSEProcessing, "EVSEProcessing"); err != nil {
+		return err
+	}
+	optRationalOut(&m.EVSEPresentActivePower, &m.EVSEPresentActivePower_isUsed, v.EVSEPresentActivePower)
+	optRationalOut(&m.EVSEPresentReactivePower, &m.EVSEPresentReactivePower_isUsed, v.EVSEPresentReactivePower)
+	m.EVSEPowerRampLimitation = boolToC(optOut(&m.EVSEPowerRampLimitation_isUsed, v.EVSEPowerRampLimitation))
+	m.ReceiptRequired = boolToC(optOut(&m.ReceiptRequired_isUsed, v.ReceiptRequired))
+	optRationalOut(&m.EVSEMaximumDischargePower, &m.EVSEMaximumDischargePower_isUsed, v.EVSEMaximumDischargePower)
+	optRationalOut(&m.EVSEMinimumDischargePower, &m.EVSEMinimumDischargePower_isUsed, v.EVSEMinimumDischargePower)
+	m.MeterInfo_isUsed = 0
+	if v.MeterInfo != nil {
+		m.MeterInfo_isUsed = 1
+		return acdpMeterInfoOut(&m.MeterInfo, v.MeterInfo)
+	}
+	return nil
+}
@@ -0,0 +1,170 @@
+package main
+
+import (
+	"fmt"
+	"reflect"
+	"strings"
+	"testing"
+	"unsafe"
+
+	"example.com/exi-go/pkg/exi"
+)
+
+// The C structs in include/v2gcodec_types.h and their converters are
+// written by hand. TestNativeCoversGenerated keeps them in step with the
+// generated Go types: every message has a native struct, every Go field
+// has a C field of the same name (with a _isUsed flag when optional), and a
+// message filled to the capacity of every C array survives the trip
+// through its native struct unchanged.
+
+// nativeFiller fills a Go message from the shape of its C struct.
+type nativeFiller struct {
+	t    *testing.T
+	next int
+	errs int
+}
+
+func (f *nativeFiller) errorf(format string, args ...interface{}) {
+	f.t.Helper()
+	f.t.Errorf(format, args...)
+	f.errs++
+}
+
+// fillStruct fills every field of the struct v, checking that ct has a
+// field for each.
+func (f *nativeFiller) fillStruct(v reflect.Value, ct reflect.Type, path string) {
+	for i := 0; i < v.NumField(); i++ {
+		sf := v.Type().Field(i)
+		if sf.Name == "XMLName" {
+			continue
+		}
+		name := path + "." + sf.Name
+		fv := v.Field(i)
+		if sf.Type.Kind() == reflect.Pointer {
+			if _, ok := ct.FieldByName(sf.Name + "_isUsed"); !ok {
+				f.errorf("%s: optional, but struct %s has no %s_isUsed", name, ct, sf.Name)
+				continue
+			}
+			fv.Set(reflect.New(sf.Type.Elem()))
+			fv = fv.Elem()
+			if fv.Kind() == reflect.Struct && fv.NumField() == 0 {
+				continue // the flag is all there is
+			}
+		}
+		cf, ok := ct.FieldByName(sf.Name)
+		if !ok {
+			f.errorf("%s: no field in struct %s", name, ct)
+			continue
+		}
+		f.fill(fv, cf.Type, name)
+	}
+}
+
+// fill sets v, held in a field of C type ct, to a value that differs from
+// every other one and uses all of ct's capacity.
+func (f *nativeFiller) fill(v reflect.Value, ct reflect.Type, path string) {
+	f.next++
+	switch v.Kind() {
+	case reflect.Struct:
+		f.fillStruct(v, ct, path)
+	case reflect.String:
+		n := 0
+		switch ct {
+		case reflect.TypeOf(cString{}):
+			n = len(cString{}.characters)
+		case reflect.TypeOf(cBytes{}):
+			n = 3
+		default:
+			f.errorf("%s: string held in %s", path, ct)
+			return
+		}
+		v.SetString(strings.Repeat(string(rune('a'+f.next%26)), n))
+	case reflect.Slice:
+		n := 0
+		switch {
+		case v.Type().Elem().Kind() == reflect.Uint8 && ct == reflect.TypeOf(cBytes{}):
+			n = 3
+		case ct.Kind() == reflect.Array:
+			n = ct.Len()
+		default:
+			f.errorf("%s: list held in %s", path, ct)
+			return
+		}
+		v.Set(reflect.MakeSlice(v.Type(), n, n))
+		for i := 0; i < n; i++ {
+			if v.Type().Elem().Kind() == reflect.Uint8 {
+				v.Index(i).SetUint(uint64(f.next + i))
+			} else {
+				f.fill(v.Index(i), ct.Elem(), fmt.Sprintf("%s[%d]", path, i))
+			}
+		}
+	case reflect.Bool:
+		v.SetBool(true)
+	case reflect.Int, reflect.Int8, reflect.Int16, reflect.Int32, reflect.Int64:
+		v.SetInt(int64(f.next%100 + 1))
+	case reflect.Uint, reflect.Uint8, reflect.Uint16, reflect.Uint32, reflect.Uint64:
+		v.SetUint(uint64(f.next%100 + 1))
+	default:
+		f.errorf("%s: unsupported %s", path, v.Type())
+	}
+}
+
+// provideBytes points every struct v2g_bytes in the C value v at a fresh
+// buffer, as a caller of v2g_decode_native would.
+func provideBytes(v reflect.Value) {
+	switch v.Kind() {
+	case reflect.Struct:
+		if v.Type() == reflect.TypeOf(cBytes{}) {
+			b := (*cBytes)(unsafe.Pointer(v.UnsafeAddr()))
+			buf := make([]byte, 64)
+			b.bytes = (*cUint8)(unsafe.Pointer(&buf[0]))
+			b.bytesCap = cSize(len(buf))
+			return
+		}
+		for i := 0; i < v.NumField(); i++ {
+			provideBytes(v.Field(i))
+		}
+	case reflect.Array:
+		for i := 0; i < v.Len(); i++ {
+			provideBytes(v.Index(i))
+		}
+	}
+}
+
+func TestNativeCoversGenerated(t *testing.T) {
+	for code := range nativeCodecs {
+		m := exi.Message(code)
+		nc := &nativeCodecs[code]
+		if m == nil || int(m.Code) != code {
+			if nc.typ != nil {
+				t.Errorf("code %d: native struct %s for no message", code, nc.typ)
+			}
+			continue
+		}
+		if nc.typ == nil {
+			t.Errorf("%s: no native struct", m.Name)
+			continue
+		}
+		msg := m.New()
+		f := &nativeFiller{t: t}
+		f.fillStruct(reflect.ValueOf(msg).Elem(), nc.typ, m.Name)
+		if f.errs > 0 {
+			continue
+		}
+
+		c := reflect.New(nc.typ)
+		provideBytes(c.Elem())
+		if err := nc.toC(msg, c.UnsafePointer()); err != nil {
+			t.Errorf("%s: to C: %v", m.Name, err)
+			continue
+		}
+		back, err := nc.toGo(c.UnsafePointer())
+		if err != nil {
+			t.Errorf("%s: from C: %v", m.Name, err)
+			continue
+		}
+		if !reflect.DeepEqual(back, msg) {
+			t.Errorf("%s: changed on the way through struct %s:\n got %+v\nwant %+v", m.Name, nc.typ, back, msg)
+		}
+	}
+}
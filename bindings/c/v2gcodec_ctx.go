@@ -0,0 +1,211 @@
+/*
+cgo bridge for exi-go - Reusable codec contexts
+
+This file implements v2g_ctx_create / v2g_ctx_destroy and the v2g_ctx_*
+encode/decode entry points. A context owns an exi.Encoder and exi.Decoder,
+so the BitStream and scratch buffer are reused across calls instead of being
+allocated per message. Contexts are not thread-safe; create one per thread.
+
+The context-free entry points (v2g_encode_struct_into, v2g_encode_native,
+the batch calls, ...) borrow a context from an internal pool for the
+duration of the call, so they benefit from the same reuse.
+
+License: Apache-2.0 (match repository)
+*/
+package main
+
+/*
+#cgo CFLAGS: -I${SRCDIR}/include
+#include <stdint.h>
+#include "v2gcodec_types.h"
+*/
+import "C"
+
+import (
+	"sync"
+	"sync/atomic"
+	"unsafe"
+
+	"example.com/exi-go/pkg/exi"
+)
+
+// codecCtx bundles the per-thread encoder and decoder state.
+type codecCtx struct {
+	enc *exi.Encoder
+	dec *exi.Decoder
+	// msgs caches one message value per event code for the JSON encode
+	// path, so unmarshalling does not allocate the top-level struct.
+	msgs [64]interface{}
+	// stream and streamMsg back v2g_stream_*; streamMsg is the completed
+	// message not yet fetched.
+	stream    *exi.StreamDecoder
+	streamMsg interface{}
+}
+
+// newCodecCtx returns a context whose decoder aliases its input and copies
+// everything else into an arena. Every decode entry point converts the
+// decoded message to JSON or to the caller's C struct before returning, so
+// aliased fields never outlive the C buffer, which stays pinned by the
+// caller for the duration of the call, and the arena can be reset by the
+// next decode.
+func newCodecCtx() *codecCtx {
+	dec := exi.NewDecoder()
+	dec.Options.AliasInput = true
+	dec.Options.Arena = exi.NewArena(0)
+	return &codecCtx{enc: exi.NewEncoder(), dec: dec}
+}
+
+// decode decodes data into cx's arena, releasing the previous message.
+func (cx *codecCtx) decode(data []byte) (interface{}, error) {
+	cx.dec.Options.Arena.Reset()
+	return cx.dec.Decode(data)
+}
+
+// message returns cx's zeroed message value for m.
+func (cx *codecCtx) message(m *exi.MessageInfo) interface{} {
+	v := cx.msgs[m.Code]
+	if v == nil {
+		v = m.New()
+		cx.msgs[m.Code] = v
+		return v
+	}
+	m.Reset(v)
+	return v
+}
+
+var ctxPool = sync.Pool{New: func() interface{} { return newCodecCtx() }}
+
+// acquireCtx borrows a context from the pool; pair with releaseCtx.
+func acquireCtx() *codecCtx {
+	return ctxPool.Get().(*codecCtx)
+}
+
+func releaseCtx(cx *codecCtx) {
+	ctxPool.Put(cx)
+}
+
+// handleTable maps the handles given out to C, which are never 0, to the Go
+// values behind them. Unlike a cgo.Handle, a handle that was never issued or
+// is already released is not found rather than a panic that takes down the
+// host process. Lookups take no lock once a handle is published.
+type handleTable[T any] struct {
+	next atomic.Uintptr
+	vals sync.Map // uintptr -> T
+}
+
+// add publishes v under a new handle.
+func (t *handleTable[T]) add(v T) uintptr {
+	h := t.next.Add(1)
+	t.vals.Store(h, v)
+	return h
+}
+
+// get returns the value of handle h.
+func (t *handleTable[T]) get(h uintptr) (T, bool) {
+	v, ok := t.vals.Load(h)
+	if !ok {
+		var zero T
+		return zero, false
+	}
+	return v.(T), true
+}
+
+// remove releases handle h and returns its value. Of several removals of
+// the same handle, only the first finds it.
+func (t *handleTable[T]) remove(h uintptr) (T, bool) {
+	v, ok := t.vals.LoadAndDelete(h)
+	if !ok {
+		var zero T
+		return zero, false
+	}
+	return v.(T), true
+}
+
+var ctxHandles handleTable[*codecCtx]
+
+// ctxFromHandle resolves a handle returned by v2g_ctx_create.
+func ctxFromHandle(fn string, ctx C.v2g_ctx) (*codecCtx, bool) {
+	cx, ok := ctxHandles.get(uintptr(ctx))
+	if !ok {
+		setLastError("%s: invalid context", fn)
+		return nil, false
+	}
+	return cx, true
+}
+
+//export v2g_ctx_create
+func v2g_ctx_create() C.v2g_ctx {
+	return C.v2g_ctx(ctxHandles.add(newCodecCtx()))
+}
+
+//export v2g_ctx_destroy
+func v2g_ctx_destroy(ctx C.v2g_ctx) {
+	ctxHandles.remove(uintptr(ctx))
+}
+
+//export v2g_ctx_encode_struct_into
+func v2g_ctx_encode_struct_into(ctx C.v2g_ctx, msg_type C.int, json_data *C.char, json_len C.size_t, out *C.uint8_t, out_cap C.size_t, written *C.size_t) C.int {
+	cx, ok := ctxFromHandle("v2g_ctx_encode_struct_into", ctx)
+	if !ok {
+		return cStatus(_v2g_err_invalid)
+	}
+	if json_data == nil || json_len == 0 || written == nil || (out == nil && out_cap > 0) {
+		setLastError("v2g_ctx_encode_struct_into: invalid arguments")
+		return cStatus(_v2g_err_invalid)
+	}
+
+	result, status := encodeStructJSON(cx, int(msg_type), cBytesView(unsafe.Pointer(json_data), json_len))
+	if status != _v2g_ok {
+		return cStatus(status)
+	}
+	return cStatus(copyToCaller(result, unsafe.Pointer(out), out_cap, written, false))
+}
+
+//export v2g_ctx_decode_struct_into
+func v2g_ctx_decode_struct_into(ctx C.v2g_ctx, msg_type C.int, exi_data *C.uint8_t, exi_len C.size_t, out *C.char, out_cap C.size_t, written *C.size_t) C.int {
+	cx, ok := ctxFromHandle("v2g_ctx_decode_struct_into", ctx)
+	if !ok {
+		return cStatus(_v2g_err_invalid)
+	}
+	if exi_data == nil || exi_len == 0 || written == nil || (out == nil && out_cap > 0) {
+		setLastError("v2g_ctx_decode_struct_into: invalid arguments")
+		return cStatus(_v2g_err_invalid)
+	}
+
+	jsonBytes, status := decodeStructJSON(cx, int(msg_type), cBytesView(unsafe.Pointer(exi_data), exi_len))
+	if status != _v2g_ok {
+		return cStatus(status)
+	}
+	return cStatus(copyToCaller(jsonBytes, unsafe.Pointer(out), out_cap, written, true))
+}
+
+//export v2g_ctx_encode_native
+func v2g_ctx_encode_native(ctx C.v2g_ctx, msg_type C.int, msg unsafe.Pointer, out *C.uint8_t, out_cap C.size_t, written *C.size_t) C.int {
+	cx, ok := ctxFromHandle("v2g_ctx_encode_native", ctx)
+	if !ok {
+		return cStatus(_v2g_err_invalid)
+	}
+	if msg == nil || written == nil || (out == nil && out_cap > 0) {
+		setLastError("v2g_ctx_encode_native: invalid arguments")
+		return cStatus(_v2g_err_invalid)
+	}
+
+	result, status := encodeNative(cx, int(msg_type), msg)
+	if status != _v2g_ok {
+		return cStatus(status)
+	}
+	return cStatus(copyToCaller(result, unsafe.Pointer(out), out_cap, written, false))
+}
+
+//export v2g_ctx_decode_native
+func v2g_ctx_decode_native(ctx C.v2g_ctx, msg_type C.int, exi_data *C.uint8_t, exi_len C.size_t, msg unsafe.Pointer) C.int {
+	cx, ok := ctxFromHandle("v2g_ctx_decode_native", ctx)
+	if !ok {
+		return cStatus(_v2g_err_invalid)
+	}
+	if exi_data == nil || exi_len == 0 || msg == nil {
+		setLastError("v2g_ctx_decode_native: invalid arguments")
+		return cStatus(_v2g_err_invalid)
+	}
+	return cStatus(decodeNative(cx, int(msg_type), cBytesView(unsafe.Pointer(exi_data), exi_len), msg))
+}
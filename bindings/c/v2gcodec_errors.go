@@ -0,0 +1,50 @@
+/*
+cgo bridge for exi-go - Per-thread last error
+
+v2g_last_error reports the error of the most recent failed call on the
+calling thread. The message is kept in a thread-local buffer on the C side,
+so threads neither share nor lock anything to record or read it. This
+works because Go code run for an exported function executes on the OS
+thread of the C caller, and so do the C calls it makes. No exported
+function may therefore record an error from another goroutine.
+
+License: Apache-2.0 (match repository)
+*/
+package main
+
+/*
+#include <stddef.h>
+#include <string.h>
+
+// Longer messages are truncated.
+#define V2G_LAST_ERROR_SIZE 512
+
+static __thread char v2g_last_error_buf[V2G_LAST_ERROR_SIZE];
+
+static void v2g_store_last_error(_GoString_ msg) {
+	size_t n = _GoStringLen(msg);
+	if (n >= V2G_LAST_ERROR_SIZE) {
+		n = V2G_LAST_ERROR_SIZE - 1;
+	}
+	memcpy(v2g_last_error_buf, _GoStringPtr(msg), n);
+	v2g_last_error_buf[n] = '\0';
+}
+
+static const char *v2g_load_last_error(void) {
+	return v2g_last_error_buf[0] != '\0' ? v2g_last_error_buf : NULL;
+}
+*/
+import "C"
+
+import "fmt"
+
+// setLastError records the calling thread's last error message.
+func setLastError(format string, a ...interface{}) {
+	C.v2g_store_last_error(fmt.Sprintf(format, a...))
+}
+
+// getLastErrorC returns the calling thread's last error C string, or nil.
+// The buffer is owned by the thread and overwritten by its next error.
+func getLastErrorC() *C.char {
+	return C.v2g_load_last_error()
+}
@@ -0,0 +1,252 @@
+/*
+cgo bridge for exi-go - Completion queue
+
+This file implements v2g_queue_create / v2g_submit / v2g_poll, which run
+batch items (struct v2g_batch_item) on Go worker goroutines so that an
+event loop never blocks on a heavy message such as a certificate chain.
+v2g_submit hands items to the workers and returns at once; each worker
+processes an item exactly like v2g_encode_batch / v2g_decode_batch with a
+codec context of its own, fills its out_len and status, and posts a
+completion. The queue's file descriptor becomes readable when completions
+are pending, and v2g_poll collects them without blocking.
+
+The request and completion queues are buffered channels, as in
+exi.Executor. v2g_submit reserves a slot for every item first and refuses
+items beyond the queue depth with V2G_ERR_BUSY, so neither channel is ever
+full and neither side blocks. Workers run on threads of their own, so the
+error messages they record never reach v2g_last_error of the submitting
+thread; a completion carries only the item's status.
+
+License: Apache-2.0 (match repository)
+*/
+package main
+
+/*
+#cgo CFLAGS: -I${SRCDIR}/include
+#include <stdint.h>
+#include "v2gcodec_types.h"
+*/
+import "C"
+
+import (
+	"runtime"
+	"sync"
+	"sync/atomic"
+	"unsafe"
+)
+
+// defaultQueueDepth is the number of items a queue holds when created with
+// depth 0.
+const defaultQueueDepth = 256
+
+// queueJob is one submitted item.
+type queueJob struct {
+	op, format int
+	item       *C.struct_v2g_batch_item
+	// userData is opaque to the queue and need not be a valid pointer, so
+	// it is never held as one.
+	userData uintptr
+}
+
+// notifier makes the file descriptor of a queue readable when completions
+// are posted; there is one implementation per kind of descriptor.
+type notifier interface {
+	fd() int
+	// signal makes the descriptor readable.
+	signal()
+	// drain makes the descriptor unreadable until the next signal.
+	drain()
+	close()
+}
+
+// completionQueue is the state behind a v2g_queue handle.
+type completionQueue struct {
+	jobs chan queueJob
+	done chan queueJob
+	// pending counts the items submitted and not yet polled; it never
+	// exceeds depth, the capacity of jobs and done.
+	pending atomic.Int64
+	depth   int64
+	// armed is set while a wakeup is pending on the notifier, so a burst of
+	// completions costs one write to it.
+	armed  atomic.Bool
+	notify notifier
+
+	mu     sync.RWMutex
+	closed bool
+	wg     sync.WaitGroup
+}
+
+var queueHandles handleTable[*completionQueue]
+
+// queueFromHandle resolves a handle returned by v2g_queue_create.
+func queueFromHandle(fn string, queue C.v2g_queue) (*completionQueue, bool) {
+	q, ok := queueHandles.get(uintptr(queue))
+	if !ok {
+		setLastError("%s: invalid queue", fn)
+		return nil, false
+	}
+	return q, true
+}
+
+//export v2g_queue_create
+func v2g_queue_create(n_workers C.size_t, depth C.size_t) C.v2g_queue {
+	n := int(n_workers)
+	if n == 0 {
+		n = runtime.GOMAXPROCS(0)
+	}
+	d := int(depth)
+	if d == 0 {
+		d = defaultQueueDepth
+	}
+	nf, err := newNotifier()
+	if err != nil {
+		setLastError("v2g_queue_create: %v", err)
+		return 0
+	}
+	q := &completionQueue{
+		jobs:   make(chan queueJob, d),
+		done:   make(chan queueJob, d),
+		depth:  int64(d),
+		notify: nf,
+	}
+	for i := 0; i < n; i++ {
+		q.wg.Add(1)
+		go q.work()
+	}
+	return C.v2g_queue(queueHandles.add(q))
+}
+
+//export v2g_queue_destroy
+func v2g_queue_destroy(queue C.v2g_queue) {
+	// Removing the handle first means one destroy of a queue gets past
+	// here, however many race; calls still holding q see closed.
+	q, ok := queueHandles.remove(uintptr(queue))
+	if !ok {
+		return
+	}
+	q.mu.Lock()
+	q.closed = true
+	close(q.jobs)
+	q.mu.Unlock()
+	q.wg.Wait()
+	q.notify.close()
+}
+
+//export v2g_queue_fd
+func v2g_queue_fd(queue C.v2g_queue) C.int {
+	q, ok := queueFromHandle("v2g_queue_fd", queue)
+	if !ok {
+		return -1
+	}
+	return C.int(q.notify.fd())
+}
+
+//export v2g_submit
+func v2g_submit(queue C.v2g_queue, op C.int, format C.int, items *C.struct_v2g_batch_item, count C.size_t, user_data C.uintptr_t) C.int {
+	q, ok := queueFromHandle("v2g_submit", queue)
+	if !ok {
+		return cStatus(_v2g_err_invalid)
+	}
+	if op != C.V2G_OP_ENCODE && op != C.V2G_OP_DECODE {
+		setLastError("v2g_submit: unsupported operation %d", int(op))
+		return cStatus(_v2g_err_invalid)
+	}
+	batch, status := batchItems("v2g_submit", format, items, count)
+	if status != _v2g_ok || len(batch) == 0 {
+		return cStatus(status)
+	}
+	if int64(len(batch)) > q.depth {
+		setLastError("v2g_submit: %d items exceed the queue depth %d", len(batch), q.depth)
+		return cStatus(_v2g_err_invalid)
+	}
+	if !q.reserve(int64(len(batch))) {
+		setLastError("v2g_submit: queue full; poll completions first")
+		return cStatus(_v2g_err_busy)
+	}
+	q.mu.RLock()
+	defer q.mu.RUnlock()
+	if q.closed {
+		q.pending.Add(-int64(len(batch)))
+		setLastError("v2g_submit: queue destroyed")
+		return cStatus(_v2g_err_shutdown)
+	}
+	for i := range batch {
+		q.jobs <- queueJob{op: int(op), format: int(format), item: &batch[i], userData: uintptr(user_data)}
+	}
+	return cStatus(_v2g_ok)
+}
+
+//export v2g_poll
+func v2g_poll(queue C.v2g_queue, completions *C.struct_v2g_completion, max C.size_t, n *C.size_t) C.int {
+	q, ok := queueFromHandle("v2g_poll", queue)
+	if !ok {
+		return cStatus(_v2g_err_invalid)
+	}
+	if n == nil || (completions == nil && max > 0) {
+		setLastError("v2g_poll: invalid arguments")
+		return cStatus(_v2g_err_invalid)
+	}
+	*n = 0
+	if max == 0 {
+		return cStatus(_v2g_ok)
+	}
+	// Consume the wakeup before collecting, so that a completion posted
+	// from here on arms the notifier again.
+	q.notify.drain()
+	q.armed.Store(false)
+	out := unsafe.Slice(completions, int(max))
+	got := 0
+collect:
+	for got < len(out) {
+		select {
+		case j := <-q.done:
+			out[got].item = j.item
+			out[got].user_data = C.uintptr_t(j.userData)
+			got++
+		default:
+			break collect
+		}
+	}
+	q.pending.Add(-int64(got))
+	*n = C.size_t(got)
+	if len(q.done) > 0 {
+		q.wake() // what did not fit in completions
+	}
+	return cStatus(_v2g_ok)
+}
+
+// reserve takes n of the queue's slots, or none if fewer are free.
+func (q *completionQueue) reserve(n int64) bool {
+	for {
+		p := q.pending.Load()
+		if p+n > q.depth {
+			return false
+		}
+		if q.pending.CompareAndSwap(p, p+n) {
+			return true
+		}
+	}
+}
+
+// work processes items until the queue is destroyed.
+func (q *completionQueue) work() {
+	defer q.wg.Done()
+	cx := newCodecCtx()
+	for j := range q.jobs {
+		if j.op == C.V2G_OP_ENCODE {
+			j.item.status = C.int(encodeBatchItem(cx, j.format, j.item))
+		} else {
+			j.item.status = C.int(decodeBatchItem(cx, j.format, j.item))
+		}
+		q.done <- j
+		q.wake()
+	}
+}
+
+// wake makes the queue's file descriptor readable unless it already is.
+func (q *completionQueue) wake() {
+	if q.armed.CompareAndSwap(false, true) {
+		q.notify.signal()
+	}
+}
@@ -0,0 +1,44 @@
+/*
+cgo bridge for exi-go - Completion queue notifier (Linux)
+
+The file descriptor of a v2g_queue is an eventfd, which is readable while
+its counter is non-zero.
+
+License: Apache-2.0 (match repository)
+*/
+package main
+
+import (
+	"syscall"
+	"unsafe"
+)
+
+// eventNotifier is the notifier of a queue on an eventfd.
+type eventNotifier struct {
+	efd int
+}
+
+func newNotifier() (notifier, error) {
+	const efdCloexec, efdNonblock = 0x80000, 0x800 // EFD_CLOEXEC, EFD_NONBLOCK
+	fd, _, errno := syscall.RawSyscall(syscall.SYS_EVENTFD2, 0, efdCloexec|efdNonblock, 0)
+	if errno != 0 {
+		return nil, errno
+	}
+	return &eventNotifier{efd: int(fd)}, nil
+}
+
+func (n *eventNotifier) fd() int { return n.efd }
+
+func (n *eventNotifier) signal() {
+	one := uint64(1)
+	syscall.Write(n.efd, (*[8]byte)(unsafe.Pointer(&one))[:])
+}
+
+func (n *eventNotifier) drain() {
+	var count uint64
+	syscall.Read(n.efd, (*[8]byte)(unsafe.Pointer(&count))[:])
+}
+
+func (n *eventNotifier) close() {
+	syscall.Close(n.efd)
+}
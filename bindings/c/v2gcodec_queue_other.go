@@ -0,0 +1,17 @@
+//go:build !unix
+
+/*
+cgo bridge for exi-go - Completion queue notifier (unsupported systems)
+
+A v2g_queue needs a pollable file descriptor, so v2g_queue_create fails on
+systems without one.
+
+License: Apache-2.0 (match repository)
+*/
+package main
+
+import "errors"
+
+func newNotifier() (notifier, error) {
+	return nil, errors.New("completion queues need a Unix system")
+}
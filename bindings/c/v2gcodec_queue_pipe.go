@@ -0,0 +1,55 @@
+//go:build unix
+
+/*
+cgo bridge for exi-go - Completion queue notifier (pipe)
+
+Where there is no eventfd, the file descriptor of a v2g_queue is the read
+end of a non-blocking pipe, which is readable while a byte is in it. The
+queue writes at most one byte per wakeup, so the pipe never fills.
+
+License: Apache-2.0 (match repository)
+*/
+package main
+
+import "syscall"
+
+// pipeNotifier is the notifier of a queue on a pipe.
+type pipeNotifier struct {
+	r, w int
+}
+
+func newPipeNotifier() (notifier, error) {
+	var p [2]int
+	if err := syscall.Pipe(p[:]); err != nil {
+		return nil, err
+	}
+	for _, fd := range p {
+		syscall.CloseOnExec(fd)
+		if err := syscall.SetNonblock(fd, true); err != nil {
+			syscall.Close(p[0])
+			syscall.Close(p[1])
+			return nil, err
+		}
+	}
+	return &pipeNotifier{r: p[0], w: p[1]}, nil
+}
+
+func (n *pipeNotifier) fd() int { return n.r }
+
+func (n *pipeNotifier) signal() {
+	syscall.Write(n.w, []byte{1})
+}
+
+func (n *pipeNotifier) drain() {
+	var buf [64]byte
+	for {
+		if k, err := syscall.Read(n.r, buf[:]); k <= 0 || err != nil {
+			return
+		}
+	}
+}
+
+func (n *pipeNotifier) close() {
+	syscall.Close(n.r)
+	syscall.Close(n.w)
+}
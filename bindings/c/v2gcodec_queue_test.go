@@ -0,0 +1,233 @@
+//go:build unix
+
+package main
+
+import (
+	"os"
+	"path/filepath"
+	"syscall"
+	"testing"
+	"time"
+	"unsafe"
+
+	"example.com/exi-go/pkg/exi"
+)
+
+// queueVectors returns the golden vectors with their message types.
+func queueVectors(t *testing.T) (data [][]byte, types []int) {
+	t.Helper()
+	files, err := filepath.Glob(filepath.Join("..", "..", "testvectors", "*.exi"))
+	if err != nil || len(files) == 0 {
+		t.Fatalf("no test vectors: %v", err)
+	}
+	for _, f := range files {
+		b, err := os.ReadFile(f)
+		if err != nil {
+			t.Fatal(err)
+		}
+		m, _, err := exi.Validate(b)
+		if err != nil {
+			continue
+		}
+		data = append(data, b)
+		types = append(types, int(m.Code))
+	}
+	return data, types
+}
+
+// decodeItems returns one JSON decode item per vector, repeated n times,
+// with a status no call returns.
+func decodeItems(data [][]byte, types []int, n int) []cBatchItem {
+	items := make([]cBatchItem, 0, n*len(data))
+	for r := 0; r < n; r++ {
+		for i, b := range data {
+			out := make([]byte, 64<<10)
+			items = append(items, cBatchItem{
+				msg_type: cInt(types[i]),
+				in:       unsafe.Pointer(&b[0]),
+				in_len:   cSize(len(b)),
+				out:      unsafe.Pointer(&out[0]),
+				out_cap:  cSize(len(out)),
+				status:   -1,
+			})
+		}
+	}
+	return items
+}
+
+// waitReadable waits for fd to become readable and consumes the wakeup.
+// It reads a duplicate of fd so that the runtime poller can wait on it.
+func waitReadable(t *testing.T, fd int) {
+	t.Helper()
+	dup, err := syscall.Dup(fd)
+	if err != nil {
+		t.Fatal(err)
+	}
+	f := os.NewFile(uintptr(dup), "queue")
+	defer f.Close()
+	if err := f.SetReadDeadline(time.Now().Add(10 * time.Second)); err != nil {
+		t.Fatal(err)
+	}
+	var buf [8]byte
+	if _, err := f.Read(buf[:]); err != nil {
+		t.Fatalf("descriptor not readable: %v", err)
+	}
+}
+
+// pollN waits on the queue's descriptor and polls until n completions are
+// collected.
+func pollN(t *testing.T, q cQueue, n int) []cCompletion {
+	t.Helper()
+	fd := int(v2g_queue_fd(q))
+	if fd < 0 {
+		t.Fatal("v2g_queue_fd failed")
+	}
+	var got []cCompletion
+	buf := make([]cCompletion, 3) // fewer than are posted, to poll again
+	for len(got) < n {
+		waitReadable(t, fd)
+		var k cSize
+		if rc := v2g_poll(q, &buf[0], cSize(len(buf)), &k); rc != _v2g_ok {
+			t.Fatalf("v2g_poll = %d", rc)
+		}
+		got = append(got, buf[:k]...)
+	}
+	return got
+}
+
+func TestQueueOrder(t *testing.T) {
+	data, types := queueVectors(t)
+	items := decodeItems(data, types, 1)
+	// One worker completes the items in the order they were submitted.
+	q := v2g_queue_create(1, cSize(len(items)))
+	if q == 0 {
+		t.Fatal("v2g_queue_create failed")
+	}
+	defer v2g_queue_destroy(q)
+
+	half := len(items) / 2
+	if rc := v2g_submit(q, cOpDecode, cFormatJSON, &items[0], cSize(half), 1); rc != _v2g_ok {
+		t.Fatalf("v2g_submit = %d", rc)
+	}
+	if rc := v2g_submit(q, cOpDecode, cFormatJSON, &items[half], cSize(len(items)-half), 2); rc != _v2g_ok {
+		t.Fatalf("v2g_submit = %d", rc)
+	}
+	got := pollN(t, q, len(items))
+	for i, c := range got {
+		if c.item != &items[i] {
+			t.Fatalf("completion %d is item %d", i, (uintptr(unsafe.Pointer(c.item))-uintptr(unsafe.Pointer(&items[0])))/unsafe.Sizeof(items[0]))
+		}
+		want := uintptr(1)
+		if i >= half {
+			want = 2
+		}
+		if uintptr(c.user_data) != want {
+			t.Errorf("completion %d: user_data %d, want %d", i, c.user_data, want)
+		}
+		if c.item.status != _v2g_ok || c.item.out_len == 0 {
+			t.Errorf("item %d: status %d, out_len %d", i, c.item.status, c.item.out_len)
+		}
+	}
+}
+
+func TestQueueBusy(t *testing.T) {
+	data, types := queueVectors(t)
+	items := decodeItems(data[:1], types[:1], 8)
+	const depth = 4
+	q := v2g_queue_create(1, depth)
+	if q == 0 {
+		t.Fatal("v2g_queue_create failed")
+	}
+	defer v2g_queue_destroy(q)
+
+	submit := func(i, n int) cInt {
+		return v2g_submit(q, cOpDecode, cFormatJSON, &items[i], cSize(n), 0)
+	}
+	// Items count against the depth until they are polled, done or not.
+	for _, c := range []struct {
+		i, n int
+		want cInt
+	}{
+		{0, 3, _v2g_ok},
+		{3, 2, _v2g_err_busy},
+		{3, 1, _v2g_ok},
+		{4, 1, _v2g_err_busy},
+		{0, depth + 1, _v2g_err_invalid},
+	} {
+		if rc := submit(c.i, c.n); rc != c.want {
+			t.Errorf("submit of %d items = %d, want %d", c.n, rc, c.want)
+		}
+	}
+	pollN(t, q, depth)
+	if rc := submit(4, depth); rc != _v2g_ok {
+		t.Errorf("submit after poll = %d", rc)
+	}
+	pollN(t, q, depth)
+}
+
+func TestQueueDestroy(t *testing.T) {
+	data, types := queueVectors(t)
+	items := decodeItems(data, types, 4)
+	q := v2g_queue_create(2, cSize(len(items)))
+	if q == 0 {
+		t.Fatal("v2g_queue_create failed")
+	}
+	if rc := v2g_submit(q, cOpDecode, cFormatJSON, &items[0], cSize(len(items)), 0); rc != _v2g_ok {
+		t.Fatalf("v2g_submit = %d", rc)
+	}
+	// Destroy waits for every submitted item, polled or not.
+	v2g_queue_destroy(q)
+	for i := range items {
+		if items[i].status != _v2g_ok {
+			t.Fatalf("item %d: status %d after destroy", i, items[i].status)
+		}
+	}
+
+	// The handle is dead: calls fail and destroy is a no-op.
+	v2g_queue_destroy(q)
+	var k cSize
+	var c cCompletion
+	if fd := v2g_queue_fd(q); fd != -1 {
+		t.Errorf("v2g_queue_fd = %d after destroy", fd)
+	}
+	if rc := v2g_poll(q, &c, 1, &k); rc != _v2g_err_invalid {
+		t.Errorf("v2g_poll = %d after destroy", rc)
+	}
+	if rc := v2g_submit(q, cOpDecode, cFormatJSON, &items[0], 1, 0); rc != _v2g_err_invalid {
+		t.Errorf("v2g_submit = %d after destroy", rc)
+	}
+	if rc := v2g_poll(cQueue(12345), &c, 1, &k); rc != _v2g_err_invalid {
+		t.Errorf("v2g_poll of a handle never issued = %d", rc)
+	}
+}
+
+// TestQueueNotifiers checks each kind of descriptor the queue may use on
+// this system.
+func TestQueueNotifiers(t *testing.T) {
+	for name, create := range map[string]func() (notifier, error){
+		"default": newNotifier,
+		"pipe":    newPipeNotifier,
+	} {
+		n, err := create()
+		if err != nil {
+			t.Fatalf("%s: %v", name, err)
+		}
+		readable := func() bool {
+			var buf [8]byte
+			k, _ := syscall.Read(n.fd(), buf[:])
+			return k > 0
+		}
+		if readable() {
+			t.Errorf("%s: readable before any signal", name)
+		}
+		n.signal()
+		waitReadable(t, n.fd())
+		n.signal()
+		n.signal()
+		n.drain()
+		if readable() {
+			t.Errorf("%s: readable after drain", name)
+		}
+		n.close()
+	}
+}
@@ -0,0 +1,15 @@
+//go:build unix && !linux
+
+/*
+cgo bridge for exi-go - Completion queue notifier (other Unix systems)
+
+Unix systems other than Linux have no eventfd, so queues notify through a
+pipe (see v2gcodec_queue_pipe.go).
+
+License: Apache-2.0 (match repository)
+*/
+package main
+
+func newNotifier() (notifier, error) {
+	return newPipeNotifier()
+}
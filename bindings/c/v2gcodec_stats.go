@@ -0,0 +1,103 @@
+/*
+cgo bridge for exi-go - Codec statistics
+
+This file implements v2g_get_stats on top of exi.Stats, and counts the
+statuses returned by the exported functions: every one of them returns
+through cStatus, which adds a failed status to statusCounts while the
+"stats" option is on.
+
+License: Apache-2.0 (match repository)
+*/
+package main
+
+/*
+#cgo CFLAGS: -I${SRCDIR}/include
+#include <stdint.h>
+#include "v2gcodec_types.h"
+*/
+import "C"
+
+import (
+	"sync/atomic"
+
+	"example.com/exi-go/pkg/exi"
+)
+
+var (
+	// statsOn mirrors exi.EnableStats for cStatus.
+	statsOn atomic.Bool
+	// statusCounts[s] counts the calls that returned status s; the last
+	// slot counts _v2g_err_internal.
+	statusCounts [C.V2G_STATS_STATUS_SIZE]atomic.Uint64
+)
+
+// cStatus returns status to C, counting it if it is an error and the
+// statistics are on.
+func cStatus(status int) C.int {
+	if status != _v2g_ok && statsOn.Load() {
+		i := status
+		if i < 0 || i >= len(statusCounts) {
+			i = len(statusCounts) - 1
+		}
+		statusCounts[i].Add(1)
+	}
+	return C.int(status)
+}
+
+// setStatsOption implements v2g_set_option("stats", value).
+func setStatsOption(value string) int {
+	switch value {
+	case "true":
+		exi.EnableStats(true)
+		statsOn.Store(true)
+	case "false":
+		statsOn.Store(false)
+		exi.EnableStats(false)
+	case "reset":
+		exi.ResetStats()
+		for i := range statusCounts {
+			statusCounts[i].Store(0)
+		}
+	default:
+		setLastError("v2g_set_option: stats: invalid value %q (want true, false or reset)", value)
+		return _v2g_err_invalid
+	}
+	return _v2g_ok
+}
+
+//export v2g_get_stats
+func v2g_get_stats(stats *C.struct_v2g_stats) C.int {
+	if stats == nil {
+		setLastError("v2g_get_stats: stats is nil")
+		return cStatus(_v2g_err_invalid)
+	}
+	s := exi.Stats()
+	*stats = C.struct_v2g_stats{}
+	stats.enabled = boolToC(s.Enabled)
+	stats.sample_every = C.uint32_t(s.SampleEvery)
+	for i := range statusCounts {
+		stats.errors[i] = C.uint64_t(statusCounts[i].Load())
+	}
+	for code := range stats.messages {
+		if code >= len(s.Messages) {
+			break
+		}
+		m := &s.Messages[code]
+		copyOpStats(&stats.messages[code].encode, &m.Encode)
+		copyOpStats(&stats.messages[code].decode, &m.Decode)
+		stats.bytes_out += C.uint64_t(m.Encode.Bytes)
+		stats.bytes_in += C.uint64_t(m.Decode.Bytes)
+	}
+	return cStatus(_v2g_ok)
+}
+
+func copyOpStats(dst *C.struct_v2g_op_stats, src *exi.OpStats) {
+	dst.calls = C.uint64_t(src.Calls)
+	dst.errors = C.uint64_t(src.Errors)
+	dst.bytes = C.uint64_t(src.Bytes)
+	for i := range dst.latency {
+		if i < len(src.Latency) {
+			dst.latency[i] = C.uint64_t(src.Latency[i])
+		}
+	}
+}
@@ -0,0 +1,93 @@
+/*
+cgo bridge for exi-go - Incremental stream decoding
+
+This file implements v2g_stream_feed / v2g_stream_decode_native /
+v2g_stream_reset on top of exi.StreamDecoder. Each codec context owns one
+stream, created on first use. The decoder never aliases its input: chunks
+are C memory that is only valid during the feed call, and the completed
+message is fetched by a later call.
+
+License: Apache-2.0 (match repository)
+*/
+package main
+
+/*
+#cgo CFLAGS: -I${SRCDIR}/include
+#include <stdint.h>
+#include "v2gcodec_types.h"
+*/
+import "C"
+
+import (
+	"errors"
+	"unsafe"
+
+	"example.com/exi-go/pkg/exi"
+)
+
+//export v2g_stream_feed
+func v2g_stream_feed(ctx C.v2g_ctx, chunk *C.uint8_t, chunk_len C.size_t, consumed *C.size_t, msg_type *C.int) C.int {
+	cx, ok := ctxFromHandle("v2g_stream_feed", ctx)
+	if !ok {
+		return cStatus(_v2g_err_invalid)
+	}
+	if consumed == nil || msg_type == nil || (chunk == nil && chunk_len > 0) {
+		setLastError("v2g_stream_feed: invalid arguments")
+		return cStatus(_v2g_err_invalid)
+	}
+	if cx.stream == nil {
+		cx.stream = exi.NewStreamDecoder()
+	}
+	cx.streamMsg = nil
+
+	msg, n, err := cx.stream.Feed(cBytesView(unsafe.Pointer(chunk), chunk_len))
+	*consumed = C.size_t(n)
+	if errors.Is(err, exi.ErrNeedMoreData) {
+		return cStatus(_v2g_need_more)
+	}
+	if err != nil {
+		setLastError("decode failed: %v", err)
+		return cStatus(_v2g_err_decode)
+	}
+	cx.streamMsg = msg
+	*msg_type = C.int(exi.MessageOf(msg).Code)
+	return cStatus(_v2g_ok)
+}
+
+//export v2g_stream_decode_native
+func v2g_stream_decode_native(ctx C.v2g_ctx, msg unsafe.Pointer) C.int {
+	cx, ok := ctxFromHandle("v2g_stream_decode_native", ctx)
+	if !ok {
+		return cStatus(_v2g_err_invalid)
+	}
+	if msg == nil || cx.streamMsg == nil {
+		setLastError("v2g_stream_decode_native: invalid arguments or no completed message")
+		return cStatus(_v2g_err_invalid)
+	}
+	code := int(exi.MessageOf(cx.streamMsg).Code)
+	nc, ok := nativeCodecFor(code)
+	if !ok {
+		setLastError("v2g_stream_decode_native: unsupported message type %d", code)
+		return cStatus(_v2g_err_invalid)
+	}
+	if err := nc.toC(cx.streamMsg, msg); err != nil {
+		setLastError("v2g_stream_decode_native: %v", err)
+		if errors.Is(err, errNativeTooSmall) {
+			return cStatus(_v2g_err_buffer_too_small)
+		}
+		return cStatus(_v2g_err_decode)
+	}
+	return cStatus(_v2g_ok)
+}
+
+//export v2g_stream_reset
+func v2g_stream_reset(ctx C.v2g_ctx) {
+	cx, ok := ctxFromHandle("v2g_stream_reset", ctx)
+	if !ok {
+		return
+	}
+	if cx.stream != nil {
+		cx.stream.Reset()
+	}
+	cx.streamMsg = nil
+}
@@ -0,0 +1,33 @@
+/*
+cgo bridge for exi-go - C type names for the tests
+
+A _test.go file cannot import "C", so the tests that call the exported
+functions directly name the C types they pass through these aliases.
+
+License: Apache-2.0 (match repository)
+*/
+package main
+
+/*
+#cgo CFLAGS: -I${SRCDIR}/include
+#include <stdint.h>
+#include "v2gcodec_types.h"
+*/
+import "C"
+
+type (
+	cInt        = C.int
+	cQueue      = C.v2g_queue
+	cSize       = C.size_t
+	cBatchItem  = C.struct_v2g_batch_item
+	cCompletion = C.struct_v2g_completion
+	cString     = C.struct_v2g_string
+	cBytes      = C.struct_v2g_bytes
+	cUint8      = C.uint8_t
+)
+
+const (
+	cOpEncode   = C.V2G_OP_ENCODE
+	cOpDecode   = C.V2G_OP_DECODE
+	cFormatJSON = C.V2G_FORMAT_JSON
+)
@@ -0,0 +1,132 @@
+/*
+cgo bridge for exi-go - V2GTP framing
+
+This file implements the v2g_*_v2gtp entry points on top of the framing
+helpers in pkg/exi/v2gtp.go. Encoding writes the EXI body straight into the
+caller's buffer after an 8-byte header slot and fills the header in last,
+so a packet goes from codec to socket without an intermediate copy.
+Parsing reads the header in place; the payload is the bytes that follow it.
+
+License: Apache-2.0 (match repository)
+*/
+package main
+
+/*
+#cgo CFLAGS: -I${SRCDIR}/include
+#include <stdint.h>
+#include <sys/uio.h>
+#include "v2gcodec_types.h"
+*/
+import "C"
+
+import (
+	"errors"
+	"unsafe"
+
+	"example.com/exi-go/pkg/exi"
+)
+
+//export v2g_v2gtp_parse_header
+func v2g_v2gtp_parse_header(data *C.uint8_t, data_len C.size_t, payload_type *C.uint16_t, payload_len *C.uint32_t) C.int {
+	if (data == nil && data_len > 0) || payload_type == nil || payload_len == nil {
+		setLastError("v2g_v2gtp_parse_header: invalid arguments")
+		return cStatus(_v2g_err_invalid)
+	}
+	h, err := exi.ParseV2GTPHeader(cBytesView(unsafe.Pointer(data), data_len))
+	if errors.Is(err, exi.ErrNeedMoreData) {
+		return cStatus(_v2g_need_more)
+	}
+	if err != nil {
+		setLastError("v2g_v2gtp_parse_header: %v", err)
+		return cStatus(_v2g_err_decode)
+	}
+	*payload_type = C.uint16_t(h.PayloadType)
+	*payload_len = C.uint32_t(h.PayloadLength)
+	return cStatus(_v2g_ok)
+}
+
+//export v2g_v2gtp_iov
+func v2g_v2gtp_iov(payload_type C.uint16_t, payload *C.uint8_t, payload_len C.size_t, header *C.uint8_t, iov *C.struct_iovec) C.int {
+	if header == nil || iov == nil || (payload == nil && payload_len > 0) || uint64(payload_len) > 0xFFFFFFFF {
+		setLastError("v2g_v2gtp_iov: invalid arguments")
+		return cStatus(_v2g_err_invalid)
+	}
+	exi.PutV2GTPHeader(cBytesView(unsafe.Pointer(header), exi.V2GTPHeaderSize), uint16(payload_type), uint32(payload_len))
+	vec := unsafe.Slice(iov, 2)
+	vec[0].iov_base = unsafe.Pointer(header)
+	vec[0].iov_len = exi.V2GTPHeaderSize
+	vec[1].iov_base = unsafe.Pointer(payload)
+	vec[1].iov_len = payload_len
+	return cStatus(_v2g_ok)
+}
+
+//export v2g_encode_struct_v2gtp
+func v2g_encode_struct_v2gtp(msg_type C.int, json_data *C.char, json_len C.size_t, payload_type C.uint16_t, out *C.uint8_t, out_cap C.size_t, written *C.size_t) C.int {
+	if json_data == nil || json_len == 0 || written == nil || (out == nil && out_cap > 0) {
+		setLastError("v2g_encode_struct_v2gtp: invalid arguments")
+		return cStatus(_v2g_err_invalid)
+	}
+	cx := acquireCtx()
+	defer releaseCtx(cx)
+	v, status := structFromJSON(cx, int(msg_type), cBytesView(unsafe.Pointer(json_data), json_len))
+	if status != _v2g_ok {
+		return cStatus(status)
+	}
+	return cStatus(encodeV2GTPToCaller(cx, v, uint16(payload_type), unsafe.Pointer(out), out_cap, written))
+}
+
+//export v2g_encode_native_v2gtp
+func v2g_encode_native_v2gtp(msg_type C.int, msg unsafe.Pointer, payload_type C.uint16_t, out *C.uint8_t, out_cap C.size_t, written *C.size_t) C.int {
+	if msg == nil || written == nil || (out == nil && out_cap > 0) {
+		setLastError("v2g_encode_native_v2gtp: invalid arguments")
+		return cStatus(_v2g_err_invalid)
+	}
+	cx := acquireCtx()
+	defer releaseCtx(cx)
+	return cStatus(encodeNativeV2GTP(cx, int(msg_type), msg, uint16(payload_type), unsafe.Pointer(out), out_cap, written))
+}
+
+//export v2g_ctx_encode_native_v2gtp
+func v2g_ctx_encode_native_v2gtp(ctx C.v2g_ctx, msg_type C.int, msg unsafe.Pointer, payload_type C.uint16_t, out *C.uint8_t, out_cap C.size_t, written *C.size_t) C.int {
+	cx, ok := ctxFromHandle("v2g_ctx_encode_native_v2gtp", ctx)
+	if !ok {
+		return cStatus(_v2g_err_invalid)
+	}
+	if msg == nil || written == nil || (out == nil && out_cap > 0) {
+		setLastError("v2g_ctx_encode_native_v2gtp: invalid arguments")
+		return cStatus(_v2g_err_invalid)
+	}
+	return cStatus(encodeNativeV2GTP(cx, int(msg_type), msg, uint16(payload_type), unsafe.Pointer(out), out_cap, written))
+}
+
+func encodeNativeV2GTP(cx *codecCtx, msgType int, msg unsafe.Pointer, payloadType uint16, out unsafe.Pointer, outCap C.size_t, written *C.size_t) int {
+	v, status := nativeToGo(msgType, msg)
+	if status != _v2g_ok {
+		return status
+	}
+	return encodeV2GTPToCaller(cx, v, payloadType, out, outCap, written)
+}
+
+// encodeV2GTPToCaller encodes v as a V2GTP packet directly into out. If out
+// is too small, the packet is measured with EncodedSize so *written can
+// report the capacity needed, as copyToCaller does.
+func encodeV2GTPToCaller(cx *codecCtx, v interface{}, payloadType uint16, out unsafe.Pointer, outCap C.size_t, written *C.size_t) int {
+	n, err := cx.enc.EncodeV2GTPInto(cBytesView(out, outCap), payloadType, v)
+	if err == nil {
+		*written = C.size_t(n)
+		return _v2g_ok
+	}
+	if !errors.Is(err, exi.ErrBitstreamOverflow) {
+		setLastError("encode failed: %v", err)
+		return _v2g_err_encode
+	}
+	size, err := cx.enc.EncodedSize(v)
+	if err != nil {
+		setLastError("encode failed: %v", err)
+		return _v2g_err_encode
+	}
+	need := exi.V2GTPHeaderSize + size
+	*written = C.size_t(need)
+	setLastError("output buffer too small: need %d bytes, have %d", need, int(outCap))
+	return _v2g_err_buffer_too_small
+}
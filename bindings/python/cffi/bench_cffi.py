@@ -0,0 +1,167 @@
+"""
+Corpus benchmark for the cffi wrapper.
+
+Runs every message in testvectors/*.exi through V2GCodec.decode_struct and
+V2GCodec.encode_struct, the two JSON operations the wrapper exposes, and
+times every call. Each message is measured on one thread; the mixed corpus
+(all messages in turn) is measured at 1, 2, 4, ... --threads threads, which
+shows how far the GIL, released by cffi during the C call, limits scaling.
+
+The output is one JSON object per result, in the same format as
+bindings/c/bench/corpus_bench.cpp, for cmd/benchreport. Compared with the C
+driver's decode_json and encode_json, the difference is the cost of the
+wrapper: cffi argument conversion, the malloc'd result and json.loads or
+json.dumps.
+
+Usage (from bindings/python/cffi, after bindings/c/build.sh):
+    V2G_CODEC_LIBRARY=../../c/lib/libv2gcodec.so \\
+        python3 bench_cffi.py ../../../testvectors --threads 4 > corpus_python.jsonl
+"""
+
+import argparse
+import glob
+import json
+import os
+import sys
+import threading
+import time
+
+from v2gcodec_cffi import MessageType, V2GCodec
+
+# MAX_SAMPLES bounds the latency samples kept per thread and run; calls past
+# it are still counted.
+MAX_SAMPLES = 1 << 20
+
+
+def load_corpus(codec, directory):
+    """Return (name, msg_type, exi, message dict) for every test vector."""
+    corpus = []
+    for path in sorted(glob.glob(os.path.join(directory, "*.exi"))):
+        name = os.path.splitext(os.path.basename(path))[0]
+        msg_type = getattr(MessageType, name, None)
+        if msg_type is None:
+            print(f"{path}: skipped: unknown message type", file=sys.stderr)
+            continue
+        with open(path, "rb") as f:
+            exi = f.read()
+        corpus.append((name, msg_type, exi, codec.decode_struct(msg_type, exi)))
+    return corpus
+
+
+OPS = {
+    "decode_json": ("V2GCodec.decode_struct", lambda c, v: c.decode_struct(v[1], v[2])),
+    "encode_json": ("V2GCodec.encode_struct", lambda c, v: c.encode_struct(v[1], v[3])),
+}
+
+
+def run(codec, vectors, op, threads, millis):
+    """Call op on threads threads for millis; return (calls, seconds, samples)."""
+    call = OPS[op][1]
+    start = threading.Barrier(threads + 1)
+    stop = threading.Event()
+    counts = [0] * threads
+    samples = [None] * threads
+
+    def worker(t):
+        local = []
+        n = 0
+        clock = time.perf_counter_ns
+        start.wait()
+        while not stop.is_set():
+            v = vectors[n % len(vectors)]
+            t0 = clock()
+            call(codec, v)
+            t1 = clock()
+            if len(local) < MAX_SAMPLES:
+                local.append(t1 - t0)
+            n += 1
+        counts[t] = n
+        samples[t] = local
+
+    pool = [threading.Thread(target=worker, args=(t,)) for t in range(threads)]
+    for th in pool:
+        th.start()
+    start.wait()
+    t0 = time.perf_counter()
+    time.sleep(millis / 1000)
+    stop.set()
+    for th in pool:
+        th.join()
+    seconds = time.perf_counter() - t0
+    merged = sorted(s for local in samples for s in local)
+    return sum(counts), seconds, merged
+
+
+def report(op, message, nbytes, threads, calls, seconds, samples):
+    def at(q):
+        return samples[int(q * (len(samples) - 1))] if samples else 0
+
+    rate = calls / seconds
+    result = {
+        "driver": "python",
+        "op": op,
+        "api": OPS[op][0],
+        "message": message,
+        "bytes": nbytes,
+        "threads": threads,
+        "calls": calls,
+        "seconds": round(seconds, 6),
+        "calls_per_sec": round(rate, 1),
+        "ns_per_call": round(1e9 * threads / rate, 1) if rate else 0,
+        "p50_ns": at(0.50),
+        "p99_ns": at(0.99),
+    }
+    print(json.dumps(result, separators=(",", ":")), flush=True)
+    print(
+        f"{message:<28} {op:<12} {threads:7d} {rate:12.0f} {at(0.50):9d} {at(0.99):9d}",
+        file=sys.stderr,
+    )
+
+
+def main():
+    parser = argparse.ArgumentParser(description="v2gcodec cffi corpus benchmark")
+    parser.add_argument("testvectors", nargs="?", default="../../../testvectors")
+    parser.add_argument("--lib", help="path to v2g codec shared library")
+    parser.add_argument("--threads", type=int, default=os.cpu_count() or 1)
+    parser.add_argument("--millis", type=int, default=200, help="duration of each run")
+    args = parser.parse_args()
+
+    codec = V2GCodec(lib_path=args.lib) if args.lib else V2GCodec()
+    codec.init()
+    try:
+        corpus = load_corpus(codec, args.testvectors)
+        if not corpus:
+            print(f"no test vectors in {args.testvectors}", file=sys.stderr)
+            return 1
+        print(
+            f"{codec.version()}, {len(corpus)} messages, {args.millis} ms per run",
+            file=sys.stderr,
+        )
+        print(
+            f"{'message':<28} {'op':<12} {'threads':>7} {'calls/s':>12} "
+            f"{'p50 ns':>9} {'p99 ns':>9}",
+            file=sys.stderr,
+        )
+        for v in corpus:
+            for op in OPS:
+                calls, seconds, samples = run(codec, [v], op, 1, args.millis)
+                report(op, v[0], len(v[2]), 1, calls, seconds, samples)
+
+        counts = []
+        t = 1
+        while t < max(args.threads, 1):
+            counts.append(t)
+            t *= 2
+        counts.append(max(args.threads, 1))
+        avg = sum(len(v[2]) for v in corpus) // len(corpus)
+        for op in OPS:
+            for t in counts:
+                calls, seconds, samples = run(codec, corpus, op, t, args.millis)
+                report(op, "corpus", avg, t, calls, seconds, samples)
+    finally:
+        codec.shutdown()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
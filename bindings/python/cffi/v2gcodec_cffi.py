@@ -12,10 +12,21 @@ Usage (example):
     codec = V2GCodec()            # loads the shared library
     codec.init()
     codec.load_schemas(['/path/to/iso15118.xsd'])
-    exi = codec.encode_xml(b'<SomeXml>...</SomeXml>')
+    exi = codec.encode_xml(b'<SessionSetupReq>...</SessionSetupReq>')
     xml = codec.decode_exi(exi)
     codec.shutdown()
 
+For bulk work the *_into methods and decode_many write into buffers the
+caller allocates once and reuses (bytearray, memoryview, numpy arrays, ...),
+so a call allocates no result buffer and copies nothing on the Python side:
+
+    out = bytearray(64 * 1024)
+    n = codec.decode_struct_into(MessageType.SessionStopReq, exi, out)
+    doc = json.loads(memoryview(out)[:n].tobytes())
+
+cffi releases the GIL for the duration of every library call, so threads
+calling the codec decode in parallel.
+
 The wrapper looks for the shared library in the following order:
   - Path in environment variable V2G_CODEC_LIBRARY
   - libv2gcodec.so (Linux)
@@ -26,6 +37,7 @@ You can pass an explicit path when constructing V2GCodec.
 
 import os
 import sys
+import threading
 
 from cffi import FFI
 
@@ -46,6 +58,25 @@ ffi.cdef("""
                           unsigned char** out_exi, size_t* out_len);
     int v2g_decode_struct(int msg_type, const unsigned char* exi_data, size_t exi_len,
                           char** out_json, size_t* out_len);
+    int v2g_encode_struct_into(int msg_type, const char* json_data, size_t json_len,
+                               unsigned char* out, size_t out_cap, size_t* written);
+    int v2g_decode_struct_into(int msg_type, const unsigned char* exi_data,
+                               size_t exi_len, char* out, size_t out_cap,
+                               size_t* written);
+
+    struct v2g_batch_item {
+        int msg_type;
+        const void* in;
+        size_t in_len;
+        void* out;
+        size_t out_cap;
+        size_t out_len;
+        int status;
+    };
+    int v2g_encode_batch(int format, struct v2g_batch_item* items, size_t count,
+                         size_t* failed);
+    int v2g_decode_batch(int format, struct v2g_batch_item* items, size_t count,
+                         size_t* failed);
     const char* v2g_message_type_name(int msg_type);
     void v2g_free_buffer(void* buf);
     const char* v2g_last_error(void);
@@ -61,6 +92,14 @@ _DEFAULT_LIB_CANDIDATES = [
 ]
 
 
+# v2g_status values the wrapper acts on (see enum v2g_status).
+V2G_OK = 0
+V2G_ERR_BUFFER_TOO_SMALL = 8
+
+# Payload format of the batch calls (enum v2g_batch_format).
+_V2G_FORMAT_JSON = 0
+
+
 # ISO 15118-20 message type constants
 class MessageType:
     """Message type constants for ISO 15118-20."""
@@ -113,6 +152,22 @@ class MessageType:
 class V2GError(RuntimeError):
     """Base exception for v2g codec errors."""
 
+    def __init__(self, message: str, status: int = None):
+        super().__init__(message)
+        self.status = status
+
+
+class V2GBufferTooSmall(V2GError):
+    """The output buffer of an *_into call or decode_many slot is too small.
+
+    ``required`` is the capacity the result needs, so the caller can grow
+    the buffer once and retry.
+    """
+
+    def __init__(self, message: str, required: int):
+        super().__init__(message, V2G_ERR_BUFFER_TOO_SMALL)
+        self.required = required
+
 
 class V2GCodec:
     """
@@ -149,6 +204,9 @@ class V2GCodec:
                     continue
         if self._lib is None:
             raise V2GError(f"could not load v2g codec library; tried: {tried}")
+        # Per-thread out-parameters and batch descriptors, reused so the
+        # *_into calls and decode_many allocate nothing once warmed up.
+        self._tls = threading.local()
 
     # ---- low-level helpers ----
     def _last_error(self) -> str:
@@ -166,8 +224,22 @@ class V2GCodec:
         # obtain last error from library if available
         msg = self._last_error()
         if context:
-            raise V2GError(f"{context}: {msg} (code {code})")
-        raise V2GError(f"{msg} (code {code})")
+            raise V2GError(f"{context}: {msg} (code {code})", code)
+        raise V2GError(f"{msg} (code {code})", code)
+
+    def _written(self):
+        """Return this thread's size_t out-parameter."""
+        p = getattr(self._tls, "written", None)
+        if p is None:
+            p = self._tls.written = ffi.new("size_t*")
+        return p
+
+    def _batch_items(self, count: int):
+        """Return this thread's batch descriptor array, grown to count."""
+        items = getattr(self._tls, "items", None)
+        if items is None or len(items) < count:
+            items = self._tls.items = ffi.new("struct v2g_batch_item[]", max(count, 64))
+        return items
 
     # ---- lifecycle ----
     def init(self):
@@ -214,7 +286,8 @@ class V2GCodec:
     # ---- encode / decode ----
     def encode_xml(self, xml_bytes: bytes) -> bytes:
         """
-        Encode XML bytes into EXI bytes.
+        Encode an ISO 15118-20 XML message (root element names the type)
+        into EXI bytes.
 
         :param xml_bytes: bytes containing UTF-8 XML
         :returns: EXI payload as bytes
@@ -343,6 +416,118 @@ class V2GCodec:
         finally:
             self._lib.v2g_free_buffer(out_ptr)
 
+    # ---- caller-buffer encode/decode ----
+    def encode_struct_into(self, msg_type: int, json_data, out) -> int:
+        """
+        Encode a message given as JSON text into a caller-owned buffer.
+
+        :param msg_type: Message type constant from MessageType class
+        :param json_data: bytes-like object holding the JSON document
+        :param out: writable bytes-like object that receives the EXI bytes
+        :returns: number of bytes written to out
+        :raises V2GBufferTooSmall if out cannot hold the message
+        :raises V2GError on other failures
+        """
+        src = ffi.from_buffer(json_data)
+        dst = ffi.from_buffer(out, require_writable=True)
+        written = self._written()
+        rc = self._lib.v2g_encode_struct_into(
+            msg_type, src, len(src), dst, len(dst), written
+        )
+        return self._into_result(rc, written, "v2g_encode_struct_into")
+
+    def decode_struct_into(self, msg_type: int, exi_data, out) -> int:
+        """
+        Decode EXI bytes into JSON text written to a caller-owned buffer.
+
+        The JSON is NUL-terminated, so out needs one byte more than the
+        returned length; memoryview(out)[:n] is the document.
+
+        :param msg_type: Message type constant from MessageType class
+        :param exi_data: bytes-like object holding the EXI payload
+        :param out: writable bytes-like object that receives the JSON
+        :returns: length of the JSON in bytes, excluding the NUL
+        :raises V2GBufferTooSmall if out cannot hold the document
+        :raises V2GError on other failures
+        """
+        src = ffi.from_buffer(exi_data)
+        dst = ffi.from_buffer(out, require_writable=True)
+        written = self._written()
+        rc = self._lib.v2g_decode_struct_into(
+            msg_type, src, len(src), dst, len(dst), written
+        )
+        return self._into_result(rc, written, "v2g_decode_struct_into")
+
+    def _into_result(self, rc: int, written, context: str) -> int:
+        if rc == V2G_ERR_BUFFER_TOO_SMALL:
+            need = int(written[0])
+            raise V2GBufferTooSmall(f"{context}: output buffer too small, need {need} bytes", need)
+        self._check_status(rc, context)
+        return int(written[0])
+
+    def decode_many(self, msg_types, buffers, out=None, slot_size: int = 16384):
+        """
+        Decode many EXI payloads to JSON in a single library call.
+
+        The messages go to v2g_decode_batch together, so the cost of
+        crossing into the library is paid once per batch. Message i is
+        written to out[i * slot_size:(i + 1) * slot_size]; pass the same out
+        to every call to avoid allocating it.
+
+        :param msg_types: one message type for every buffer, or a sequence
+                          with one type per buffer
+        :param buffers: sequence of bytes-like EXI payloads
+        :param out: writable bytes-like object of at least
+                    len(buffers) * slot_size bytes, or None to allocate one
+        :param slot_size: bytes reserved for each JSON document (with NUL)
+        :returns: a list with, for each buffer, a memoryview of its JSON in
+                  out, or the V2GError describing why it failed (a
+                  V2GBufferTooSmall carries the slot size it needs). A
+                  failing message does not stop the others.
+        """
+        count = len(buffers)
+        if out is None:
+            out = bytearray(count * slot_size)
+        view = memoryview(out).cast("B")
+        if len(view) < count * slot_size:
+            raise ValueError(f"out holds {len(view)} bytes, need {count * slot_size}")
+        if isinstance(msg_types, int):
+            msg_types = (msg_types,) * count
+        elif len(msg_types) != count:
+            raise ValueError("msg_types and buffers differ in length")
+
+        items = self._batch_items(count)
+        dst = ffi.from_buffer(view, require_writable=True)
+        # Keep the input views alive until the call has returned.
+        srcs = [ffi.from_buffer(b) for b in buffers]
+        for i, src in enumerate(srcs):
+            it = items[i]
+            it.msg_type = msg_types[i]
+            setattr(it, "in", src)  # "in" is a Python keyword
+            it.in_len = len(src)
+            it.out = dst + i * slot_size
+            it.out_cap = slot_size
+        failed = self._written()
+        rc = self._lib.v2g_decode_batch(_V2G_FORMAT_JSON, items, count, failed)
+        self._check_status(rc, "v2g_decode_batch")
+
+        results = []
+        for i in range(count):
+            it = items[i]
+            if it.status == V2G_OK:
+                start = i * slot_size
+                results.append(view[start : start + it.out_len])
+            elif it.status == V2G_ERR_BUFFER_TOO_SMALL:
+                results.append(
+                    V2GBufferTooSmall(
+                        f"decode_many: item {i}: slot too small, need {it.out_len} bytes",
+                        it.out_len,
+                    )
+                )
+            else:
+                results.append(V2GError(f"decode_many: item {i} failed (code {it.status})", it.status))
+        return results
+
     def message_type_name(self, msg_type: int) -> str:
         """
         Get the human-readable name for a message type.
@@ -350,14 +535,11 @@ class V2GCodec:
         :param msg_type: Message type constant
         :returns: Message type name string
         """
+        # The returned string is static; it must not be freed.
         p = self._lib.v2g_message_type_name(msg_type)
         if p == ffi.NULL:
             return f"Unknown({msg_type})"
-        try:
-            name = ffi.string(p).decode("utf-8", errors="replace")
-            return name
-        finally:
-            self._lib.v2g_free_buffer(p)
+        return ffi.string(p).decode("utf-8", errors="replace")
 
 
 # Simple CLI demonstration when executed directly
@@ -378,7 +560,11 @@ def _demo():
         if args.schema:
             print("Loading schemas:", args.schema)
             codec.load_schemas(args.schema)
-        sample_xml = b"<Sample>hello</Sample>"
+        sample_xml = (
+            b"<SessionSetupReq><Header><SessionID>01020304</SessionID>"
+            b"<TimeStamp>1234567890</TimeStamp></Header>"
+            b"<EVCCID>0A1B2C3D4E5F</EVCCID></SessionSetupReq>"
+        )
         print("Encoding sample XML:", sample_xml)
         exi = codec.encode_xml(sample_xml)
         print("Encoded EXI (len=%d) hex: %s" % (len(exi), exi.hex()[:256]))
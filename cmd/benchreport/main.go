@@ -0,0 +1,459 @@
+// Command benchreport merges the results of the corpus benchmarks into one
+// machine-readable report and renders it into PERFORMANCE.md.
+//
+// The inputs are the JSON lines written by the C and Python drivers
+// (bindings/c/bench/corpus_bench.cpp, bindings/python/cffi/bench_cffi.py)
+// and the text output of the Go corpus benchmarks
+// (pkg/exi/corpus_bench_test.go). Every result describes one operation
+// (decode, decode_json, encode, encode_json) on one message, or on the
+// mixed "corpus", at some number of threads.
+//
+// Usage:
+//
+//	go run ./cmd/benchreport -c corpus_c.jsonl -python corpus_python.jsonl \
+//		-go corpus_go.txt -json bench_report.json -update PERFORMANCE.md
+//
+//	# re-render PERFORMANCE.md from a saved report
+//	go run ./cmd/benchreport -in bench_report.json -update PERFORMANCE.md
+//
+// The generated section sits between the beginReport and endReport markers;
+// if PERFORMANCE.md has none yet, it is inserted before "## Performance
+// Characteristics".
+package main
+
+import (
+	"bufio"
+	"bytes"
+	"encoding/json"
+	"errors"
+	"flag"
+	"fmt"
+	"log"
+	"os"
+	"runtime"
+	"sort"
+	"strconv"
+	"strings"
+	"time"
+)
+
+const (
+	beginReport = "<!-- benchreport:begin -->"
+	endReport   = "<!-- benchreport:end -->"
+	// insertBefore is where a missing section is added to PERFORMANCE.md.
+	insertBefore = "## Performance Characteristics"
+)
+
+// Result is one measurement. The C and Python drivers write it as is; Go
+// results are converted from the benchmark output.
+type Result struct {
+	Driver      string  `json:"driver"` // "go", "c" or "python"
+	Op          string  `json:"op"`     // decode, decode_json, encode, encode_json
+	API         string  `json:"api"`    // function measured, e.g. v2g_ctx_decode_native
+	Message     string  `json:"message"`
+	Bytes       int     `json:"bytes"` // EXI size (average for "corpus")
+	Threads     int     `json:"threads"`
+	Calls       int64   `json:"calls"`
+	Seconds     float64 `json:"seconds,omitempty"`
+	CallsPerSec float64 `json:"calls_per_sec"`
+	NsPerCall   float64 `json:"ns_per_call"` // mean latency of one call
+	P50Ns       int64   `json:"p50_ns,omitempty"`
+	P99Ns       int64   `json:"p99_ns,omitempty"`
+	BytesPerOp  int64   `json:"bytes_per_op,omitempty"` // Go only
+	AllocsPerOp int64   `json:"allocs_per_op,omitempty"`
+}
+
+// Report is the file written by -json and read by -in.
+type Report struct {
+	Generated string   `json:"generated"`
+	CPU       string   `json:"cpu,omitempty"`
+	GoVersion string   `json:"go_version"`
+	Results   []Result `json:"results"`
+}
+
+func main() {
+	log.SetFlags(0)
+	cPath := flag.String("c", "", "JSON lines from the C driver")
+	pyPath := flag.String("python", "", "JSON lines from the Python driver")
+	goPath := flag.String("go", "", "output of the Go corpus benchmarks")
+	inPath := flag.String("in", "", "read a report written by -json instead of raw results")
+	jsonPath := flag.String("json", "", "write the merged report to this file")
+	update := flag.String("update", "", "render the report into this Markdown file (e.g. PERFORMANCE.md)")
+	flag.Parse()
+
+	var rep Report
+	if *inPath != "" {
+		data, err := os.ReadFile(*inPath)
+		if err != nil {
+			log.Fatal(err)
+		}
+		if err := json.Unmarshal(data, &rep); err != nil {
+			log.Fatalf("%s: %v", *inPath, err)
+		}
+	} else {
+		rep = Report{Generated: time.Now().UTC().Format("2006-01-02"), GoVersion: runtime.Version()}
+		for _, path := range []string{*cPath, *pyPath} {
+			if path == "" {
+				continue
+			}
+			results, err := readJSONLines(path)
+			if err != nil {
+				log.Fatal(err)
+			}
+			rep.Results = append(rep.Results, results...)
+		}
+		if *goPath != "" {
+			results, cpu, err := readGoBench(*goPath)
+			if err != nil {
+				log.Fatal(err)
+			}
+			rep.Results = append(rep.Results, results...)
+			rep.CPU = cpu
+		}
+	}
+	if len(rep.Results) == 0 {
+		log.Fatal("benchreport: no results; pass -c, -python, -go or -in")
+	}
+
+	if *jsonPath != "" {
+		data, err := json.MarshalIndent(&rep, "", "  ")
+		if err != nil {
+			log.Fatal(err)
+		}
+		if err := os.WriteFile(*jsonPath, append(data, '\n'), 0o644); err != nil {
+			log.Fatal(err)
+		}
+	}
+	section := renderMarkdown(&rep)
+	if *update == "" {
+		fmt.Print(section)
+		return
+	}
+	if err := updateFile(*update, section); err != nil {
+		log.Fatal(err)
+	}
+}
+
+func readJSONLines(path string) ([]Result, error) {
+	f, err := os.Open(path)
+	if err != nil {
+		return nil, err
+	}
+	defer f.Close()
+	var results []Result
+	sc := bufio.NewScanner(f)
+	for line := 1; sc.Scan(); line++ {
+		text := bytes.TrimSpace(sc.Bytes())
+		if len(text) == 0 {
+			continue
+		}
+		var r Result
+		if err := json.Unmarshal(text, &r); err != nil {
+			return nil, fmt.Errorf("%s:%d: %v", path, line, err)
+		}
+		results = append(results, r)
+	}
+	return results, sc.Err()
+}
+
+// goOps maps the Go benchmark names to the driver operations.
+var goOps = map[string]string{
+	"Decode":     "decode",
+	"DecodeJSON": "decode_json",
+	"Encode":     "encode",
+	"EncodeJSON": "encode_json",
+}
+
+// readGoBench parses `go test -bench` output for BenchmarkCorpus and
+// BenchmarkCorpusParallel. It also returns the "cpu:" line, if any.
+func readGoBench(path string) ([]Result, string, error) {
+	data, err := os.ReadFile(path)
+	if err != nil {
+		return nil, "", err
+	}
+	var results []Result
+	var cpu string
+	for _, line := range strings.Split(string(data), "\n") {
+		if strings.HasPrefix(line, "cpu: ") {
+			cpu = strings.TrimPrefix(line, "cpu: ")
+			continue
+		}
+		fields := strings.Fields(line)
+		if len(fields) < 4 || !strings.HasPrefix(fields[0], "BenchmarkCorpus") {
+			continue
+		}
+		r, err := parseGoBench(fields)
+		if err != nil {
+			return nil, "", fmt.Errorf("%s: %q: %v", path, line, err)
+		}
+		if r != nil {
+			results = append(results, *r)
+		}
+	}
+	return results, cpu, nil
+}
+
+func parseGoBench(fields []string) (*Result, error) {
+	name, threads := fields[0], 1
+	if i := strings.LastIndexByte(name, '-'); i > 0 {
+		if n, err := strconv.Atoi(name[i+1:]); err == nil {
+			name, threads = name[:i], n
+		}
+	}
+	parts := strings.Split(name, "/")
+	r := &Result{Driver: "go", Threads: threads}
+	switch {
+	case parts[0] == "BenchmarkCorpus" && len(parts) == 3:
+		r.Message, r.Op = parts[1], goOps[parts[2]]
+		r.API = "BenchmarkCorpus/" + parts[2]
+	case parts[0] == "BenchmarkCorpusParallel" && len(parts) == 2:
+		r.Message, r.Op = "corpus", goOps[parts[1]]
+		r.API = "BenchmarkCorpusParallel/" + parts[1]
+	default:
+		return nil, nil
+	}
+	if r.Op == "" {
+		return nil, nil
+	}
+	calls, err := strconv.ParseInt(fields[1], 10, 64)
+	if err != nil {
+		return nil, err
+	}
+	r.Calls = calls
+	var nsPerOp float64
+	for i := 2; i+1 < len(fields); i += 2 {
+		v, unit := fields[i], fields[i+1]
+		switch unit {
+		case "ns/op":
+			nsPerOp, err = strconv.ParseFloat(v, 64)
+		case "MB/s":
+			var mbs float64
+			if mbs, err = strconv.ParseFloat(v, 64); err == nil && nsPerOp > 0 {
+				r.Bytes = int(mbs*nsPerOp/1e3 + 0.5)
+			}
+		case "B/op":
+			r.BytesPerOp, err = strconv.ParseInt(v, 10, 64)
+		case "allocs/op":
+			r.AllocsPerOp, err = strconv.ParseInt(v, 10, 64)
+		}
+		if err != nil {
+			return nil, err
+		}
+	}
+	if nsPerOp <= 0 {
+		return nil, errors.New("no ns/op")
+	}
+	// In a parallel benchmark ns/op is wall time per operation across all
+	// goroutines; each call takes threads times as long.
+	r.CallsPerSec = 1e9 / nsPerOp
+	r.NsPerCall = nsPerOp * float64(threads)
+	r.Seconds = nsPerOp * float64(calls) / 1e9
+	return r, nil
+}
+
+// updateFile replaces the generated section of the Markdown file at path.
+func updateFile(path, section string) error {
+	data, err := os.ReadFile(path)
+	if err != nil {
+		return err
+	}
+	doc := string(data)
+	begin, end := strings.Index(doc, beginReport), strings.Index(doc, endReport)
+	switch {
+	case begin >= 0 && end > begin:
+		doc = doc[:begin] + section + doc[end+len(endReport)+1:]
+	case begin < 0 && end < 0:
+		i := strings.Index(doc, insertBefore)
+		if i < 0 {
+			i = len(doc)
+		}
+		doc = doc[:i] + section + "\n" + doc[i:]
+	default:
+		return fmt.Errorf("%s: unbalanced %s / %s markers", path, beginReport, endReport)
+	}
+	return os.WriteFile(path, []byte(doc), 0o644)
+}
+
+// index looks results up by driver, op, message and threads.
+type index map[string]*Result
+
+func key(driver, op, message string, threads int) string {
+	return fmt.Sprintf("%s|%s|%s|%d", driver, op, message, threads)
+}
+
+func (ix index) get(driver, op, message string, threads int) *Result {
+	return ix[key(driver, op, message, threads)]
+}
+
+func renderMarkdown(rep *Report) string {
+	ix := index{}
+	var messages []string
+	seen := map[string]bool{}
+	threadSet := map[int]bool{}
+	for i := range rep.Results {
+		r := &rep.Results[i]
+		ix[key(r.Driver, r.Op, r.Message, r.Threads)] = r
+		if r.Message == "corpus" {
+			threadSet[r.Threads] = true
+		} else if !seen[r.Message] {
+			seen[r.Message] = true
+			messages = append(messages, r.Message)
+		}
+	}
+	sort.Strings(messages)
+	var threads []int
+	for t := range threadSet {
+		threads = append(threads, t)
+	}
+	sort.Ints(threads)
+
+	var b strings.Builder
+	b.WriteString(beginReport + "\n")
+	b.WriteString("### Cross-Language Corpus Benchmarks\n\n")
+	intro := "Generated by `cmd/benchreport` on " + rep.Generated
+	if rep.CPU != "" {
+		intro += fmt.Sprintf(" (%s, %s)", rep.CPU, rep.GoVersion)
+	}
+	intro += " from the `testvectors/*.exi` corpus; run `bindings/c/bench/corpus.sh` to refresh it. " +
+		"Go is the codec alone (`pkg/exi` corpus benchmarks), C calls `libv2gcodec` through a `v2g_ctx` per thread " +
+		"and Python calls the cffi wrapper. Cells are the mean ns per call; C and Python cells add the p99 after the slash. " +
+		"The C and Python drivers time every call, which adds a few tens of ns to their means."
+	b.WriteString(wrap(intro) + "\n")
+
+	for _, dir := range []struct{ title, op string }{{"Decode", "decode"}, {"Encode", "encode"}} {
+		fmt.Fprintf(&b, "#### %s, one thread\n\n", dir.title)
+		b.WriteString("| Message | Bytes | Go | C native | Go + JSON | C JSON | Python JSON |\n")
+		b.WriteString("|---|---:|---:|---:|---:|---:|---:|\n")
+		for _, m := range messages {
+			size := 0
+			for _, d := range []string{"c", "go", "python"} {
+				if r := ix.get(d, dir.op+"_json", m, 1); r != nil && r.Bytes > 0 {
+					size = r.Bytes
+					break
+				}
+			}
+			fmt.Fprintf(&b, "| %s | %d | %s | %s | %s | %s | %s |\n", m, size,
+				cell(ix.get("go", dir.op, m, 1), false),
+				cell(ix.get("c", dir.op, m, 1), true),
+				cell(ix.get("go", dir.op+"_json", m, 1), false),
+				cell(ix.get("c", dir.op+"_json", m, 1), true),
+				cell(ix.get("python", dir.op+"_json", m, 1), true))
+		}
+		b.WriteString("\n")
+	}
+
+	b.WriteString("#### Where the time goes\n\n")
+	b.WriteString(wrap("Mean ns per call over the mixed corpus on one thread, split by taking differences between the drivers.") + "\n")
+	b.WriteString("| Step | Decode | Encode |\n|---|---:|---:|\n")
+	steps := []struct {
+		name       string
+		minus, sub func(op string) *Result
+	}{
+		{"Codec (Go)", func(op string) *Result { return ix.get("go", op, "corpus", 1) }, nil},
+		{"cgo call and C struct conversion", func(op string) *Result { return ix.get("c", op, "corpus", 1) },
+			func(op string) *Result { return ix.get("go", op, "corpus", 1) }},
+		{"JSON instead of C structs", func(op string) *Result { return ix.get("c", op+"_json", "corpus", 1) },
+			func(op string) *Result { return ix.get("c", op, "corpus", 1) }},
+		{"Python wrapper (cffi, json module)", func(op string) *Result { return ix.get("python", op+"_json", "corpus", 1) },
+			func(op string) *Result { return ix.get("c", op+"_json", "corpus", 1) }},
+	}
+	for _, s := range steps {
+		fmt.Fprintf(&b, "| %s | %s | %s |\n", s.name, diff(s.minus, s.sub, "decode"), diff(s.minus, s.sub, "encode"))
+	}
+	b.WriteString("\n")
+
+	if len(threads) > 0 {
+		b.WriteString("#### Thread scaling\n\n")
+		b.WriteString(wrap("Calls per second over the mixed corpus, all threads together.") + "\n")
+		cols := []struct{ driver, op string }{
+			{"go", "decode"}, {"c", "decode"}, {"c", "decode_json"}, {"python", "decode_json"},
+			{"go", "encode"}, {"c", "encode"}, {"c", "encode_json"}, {"python", "encode_json"},
+		}
+		b.WriteString("| Threads |")
+		for _, c := range cols {
+			fmt.Fprintf(&b, " %s %s |", driverName(c.driver), c.op)
+		}
+		b.WriteString("\n|---:|" + strings.Repeat("---:|", len(cols)) + "\n")
+		for _, t := range threads {
+			fmt.Fprintf(&b, "| %d |", t)
+			for _, c := range cols {
+				if r := ix.get(c.driver, c.op, "corpus", t); r != nil {
+					fmt.Fprintf(&b, " %s |", thousands(r.CallsPerSec))
+				} else {
+					b.WriteString(" – |")
+				}
+			}
+			b.WriteString("\n")
+		}
+		b.WriteString("\n")
+	}
+	b.WriteString(endReport + "\n")
+	return b.String()
+}
+
+func driverName(d string) string {
+	switch d {
+	case "go":
+		return "Go"
+	case "c":
+		return "C"
+	}
+	return "Python"
+}
+
+func cell(r *Result, p99 bool) string {
+	if r == nil {
+		return "–"
+	}
+	if p99 && r.P99Ns > 0 {
+		return thousands(r.NsPerCall) + " / " + thousands(float64(r.P99Ns))
+	}
+	return thousands(r.NsPerCall)
+}
+
+func diff(minus, sub func(string) *Result, op string) string {
+	a := minus(op)
+	if a == nil {
+		return "–"
+	}
+	if sub == nil {
+		return thousands(a.NsPerCall)
+	}
+	s := sub(op)
+	if s == nil {
+		return "–"
+	}
+	return fmt.Sprintf("%+.0f", a.NsPerCall-s.NsPerCall)
+}
+
+// wrap breaks s into lines of at most 76 columns and ends it with a blank
+// line.
+func wrap(s string) string {
+	var b strings.Builder
+	n := 0
+	for _, w := range strings.Fields(s) {
+		if n > 0 && n+1+len(w) > 76 {
+			b.WriteByte('\n')
+			n = 0
+		} else if n > 0 {
+			b.WriteByte(' ')
+			n++
+		}
+		b.WriteString(w)
+		n += len(w)
+	}
+	return b.String() + "\n"
+}
+
+// thousands formats v rounded to an integer with comma separators.
+func thousands(v float64) string {
+	s := strconv.FormatInt(int64(v+0.5), 10)
+	var b strings.Builder
+	for i, c := range s {
+		if i > 0 && (len(s)-i)%3 == 0 {
+			b.WriteByte(',')
+		}
+		b.WriteRune(c)
+	}
+	return b.String()
+}
@@ -0,0 +1,415 @@
+package main
+
+import (
+	"bufio"
+	"bytes"
+	"encoding/binary"
+	"encoding/hex"
+	"encoding/json"
+	"errors"
+	"flag"
+	"fmt"
+	"io"
+	"os"
+	"runtime"
+	"sort"
+	"strconv"
+	"time"
+
+	"example.com/exi-go/internal/mmap"
+	"example.com/exi-go/pkg/exi"
+)
+
+// Input framings accepted by the batch subcommand.
+const (
+	formatHex   = "hex"   // one hex-encoded message per line
+	formatLen   = "len"   // 4-byte big-endian length, then the message
+	formatV2GTP = "v2gtp" // V2GTP packets (8-byte header, then the message)
+)
+
+const (
+	// batchJobFrames is how many frames a worker decodes per job; large
+	// enough that handing out jobs costs little next to decoding them.
+	batchJobFrames = 256
+	// maxErrorKinds bounds the distinct error messages counted in the
+	// statistics; further kinds are counted under "other".
+	maxErrorKinds = 100
+)
+
+// batchStats accumulates the statistics printed at the end of a batch run.
+type batchStats struct {
+	frames  int
+	decoded int
+	bytes   int64
+	byType  [64]int
+	errors  map[string]int
+}
+
+func (s *batchStats) fail(err error) {
+	if s.errors == nil {
+		s.errors = make(map[string]int)
+	}
+	msg := err.Error()
+	if _, ok := s.errors[msg]; !ok && len(s.errors) >= maxErrorKinds {
+		msg = "other"
+	}
+	s.errors[msg]++
+}
+
+func (s *batchStats) add(o *batchStats) {
+	s.frames += o.frames
+	s.decoded += o.decoded
+	s.bytes += o.bytes
+	for i, n := range o.byType {
+		s.byType[i] += n
+	}
+	for msg, n := range o.errors {
+		if s.errors == nil {
+			s.errors = make(map[string]int)
+		}
+		s.errors[msg] += n
+	}
+}
+
+// batchJob is a run of consecutive frames decoded by one worker. Jobs are
+// recycled, so their buffers are reused across the run.
+type batchJob struct {
+	first  int // index of frames[0] in the input
+	frames [][]byte
+	out    []byte // NDJSON lines for frames, in order
+	stats  batchStats
+	done   chan struct{}
+}
+
+// runBatch handles the `batch` subcommand.
+func runBatch(args []string) error {
+	fs := flag.NewFlagSet("batch", flag.ContinueOnError)
+	inPath := fs.String("in", "-", "Input file of captured frames. Use '-' for stdin")
+	outPath := fs.String("out", "-", "Output file (NDJSON, one line per frame). Use '-' for stdout")
+	format := fs.String("format", "auto", "Input framing: hex, len, v2gtp or auto")
+	workers := fs.Int("workers", runtime.GOMAXPROCS(0), "Number of decode workers")
+	showStats := fs.Bool("stats", true, "Print throughput and error statistics to stderr")
+	if err := fs.Parse(args); err != nil {
+		return err
+	}
+	if *workers < 1 {
+		*workers = 1
+	}
+
+	var data []byte
+	if *inPath == "-" || *inPath == "" {
+		var err error
+		if data, err = io.ReadAll(os.Stdin); err != nil {
+			return err
+		}
+	} else {
+		var unmap func() error
+		var err error
+		if data, unmap, err = mapFile(*inPath); err != nil {
+			return err
+		}
+		defer unmap()
+	}
+	if *format == "auto" {
+		*format = detectFrameFormat(data)
+	}
+	frames, err := newFrameReader(data, *format)
+	if err != nil {
+		return err
+	}
+
+	out, outIsFile, err := openOutput(*outPath)
+	if err != nil {
+		return err
+	}
+	if outIsFile {
+		defer closeIfFile(out)
+	}
+
+	start := time.Now()
+	stats, err := decodeFrames(frames, *format == formatHex, *workers, out)
+	elapsed := time.Since(start)
+	if *showStats {
+		printBatchStats(os.Stderr, &stats, elapsed, *workers)
+	}
+	return err
+}
+
+// decodeFrames decodes every frame of r on a pool of workers and writes one
+// NDJSON line per frame to w, in input order.
+func decodeFrames(r *frameReader, hexFrames bool, workers int, w io.Writer) (batchStats, error) {
+	// A fixed set of jobs bounds the work in flight: the reader waits for a
+	// free job, so a slow writer holds back decoding rather than memory.
+	free := make(chan *batchJob, 4*workers)
+	for i := 0; i < cap(free); i++ {
+		free <- &batchJob{done: make(chan struct{}, 1)}
+	}
+	jobs := make(chan *batchJob, cap(free))
+	order := make(chan *batchJob, cap(free))
+	for i := 0; i < workers; i++ {
+		go batchWorker(jobs, hexFrames)
+	}
+
+	var total batchStats
+	written := make(chan error, 1)
+	go func() {
+		bw := bufio.NewWriterSize(w, 1<<20)
+		var werr error
+		for job := range order {
+			<-job.done
+			if werr == nil {
+				_, werr = bw.Write(job.out)
+			}
+			total.add(&job.stats)
+			free <- job
+		}
+		if werr == nil {
+			werr = bw.Flush()
+		}
+		written <- werr
+	}()
+
+	var readErr error
+	for index := 0; readErr == nil; {
+		job := <-free
+		job.first = index
+		job.frames = job.frames[:0]
+		for len(job.frames) < batchJobFrames {
+			frame, ok, err := r.next()
+			if err != nil {
+				readErr = fmt.Errorf("frame %d: %w", index+len(job.frames), err)
+				break
+			}
+			if !ok {
+				readErr = io.EOF
+				break
+			}
+			job.frames = append(job.frames, frame)
+		}
+		if len(job.frames) == 0 {
+			free <- job
+			continue
+		}
+		index += len(job.frames)
+		order <- job
+		jobs <- job
+	}
+	close(jobs)
+	close(order)
+	werr := <-written
+	if readErr != io.EOF {
+		return total, readErr
+	}
+	return total, werr
+}
+
+// batchWorker decodes jobs until jobs is closed. Each worker owns its
+// decoder, arena and scratch buffers, so decoding takes no locks.
+func batchWorker(jobs <-chan *batchJob, hexFrames bool) {
+	dec := exi.NewDecoder()
+	dec.Options.AliasInput = true
+	dec.Options.Arena = exi.NewArena(0)
+	var raw []byte
+	for job := range jobs {
+		job.out = job.out[:0]
+		job.stats = batchStats{}
+		for i, frame := range job.frames {
+			index := job.first + i
+			data := frame
+			if hexFrames {
+				if cap(raw) < len(frame)/2 {
+					raw = make([]byte, len(frame))
+				}
+				n, err := hex.Decode(raw[:len(frame)/2], frame)
+				if err != nil {
+					job.out = appendFrameError(job.out, index, &job.stats, fmt.Errorf("invalid hex: %w", err))
+					continue
+				}
+				data = raw[:n]
+			}
+			job.stats.frames++
+			job.stats.bytes += int64(len(data))
+
+			dec.Options.Arena.Reset()
+			msg, err := dec.Decode(data)
+			if err != nil {
+				job.out = appendFrameError(job.out, index, nil, err)
+				job.stats.fail(err)
+				continue
+			}
+			body, err := json.Marshal(msg)
+			if err != nil {
+				job.out = appendFrameError(job.out, index, nil, err)
+				job.stats.fail(err)
+				continue
+			}
+			m := exi.MessageOf(msg)
+			if m == nil {
+				err := fmt.Errorf("decoded %T, which is not a top-level message", msg)
+				job.out = appendFrameError(job.out, index, nil, err)
+				job.stats.fail(err)
+				continue
+			}
+			job.stats.decoded++
+			job.stats.byType[m.Code]++
+			job.out = append(job.out, `{"frame":`...)
+			job.out = strconv.AppendInt(job.out, int64(index), 10)
+			job.out = append(job.out, `,"type":"`...)
+			job.out = append(job.out, m.Name...)
+			job.out = append(job.out, `","message":`...)
+			job.out = append(job.out, body...)
+			job.out = append(job.out, "}\n"...)
+		}
+		job.done <- struct{}{}
+	}
+}
+
+// appendFrameError appends the NDJSON line reporting that frame index failed.
+// Errors found before decoding are also counted in stats, if set.
+func appendFrameError(dst []byte, index int, stats *batchStats, err error) []byte {
+	if stats != nil {
+		stats.frames++
+		stats.fail(err)
+	}
+	msg, _ := json.Marshal(err.Error())
+	dst = append(dst, `{"frame":`...)
+	dst = strconv.AppendInt(dst, int64(index), 10)
+	dst = append(dst, `,"error":`...)
+	dst = append(dst, msg...)
+	return append(dst, "}\n"...)
+}
+
+// printBatchStats writes the end-of-run summary.
+func printBatchStats(w io.Writer, s *batchStats, elapsed time.Duration, workers int) {
+	secs := elapsed.Seconds()
+	if secs <= 0 {
+		secs = 1e-9
+	}
+	failed := s.frames - s.decoded
+	fmt.Fprintf(w, "batch: %d frames (%d decoded, %d failed), %.1f MB in %v with %d workers\n",
+		s.frames, s.decoded, failed, float64(s.bytes)/1e6, elapsed.Round(time.Millisecond), workers)
+	fmt.Fprintf(w, "batch: %.0f frames/s, %.1f MB/s\n", float64(s.frames)/secs, float64(s.bytes)/1e6/secs)
+
+	type count struct {
+		name string
+		n    int
+	}
+	var types []count
+	for code, n := range s.byType {
+		if n > 0 {
+			types = append(types, count{exi.Message(code).Name, n})
+		}
+	}
+	var errs []count
+	for msg, n := range s.errors {
+		errs = append(errs, count{msg, n})
+	}
+	for _, list := range [][]count{types, errs} {
+		sort.Slice(list, func(i, j int) bool {
+			if list[i].n != list[j].n {
+				return list[i].n > list[j].n
+			}
+			return list[i].name < list[j].name
+		})
+	}
+	for _, c := range types {
+		fmt.Fprintf(w, "  %10d  %s\n", c.n, c.name)
+	}
+	if len(errs) > 0 {
+		fmt.Fprintf(w, "errors:\n")
+		for _, c := range errs {
+			fmt.Fprintf(w, "  %10d  %s\n", c.n, c.name)
+		}
+	}
+}
+
+// detectFrameFormat guesses the framing of data from its first bytes: V2GTP
+// packets start with the protocol version and its inverse, hex input is
+// printable, and anything else is taken to be length-prefixed.
+func detectFrameFormat(data []byte) string {
+	if len(data) >= 2 && data[0] == exi.V2GTPVersion && data[1] == ^byte(exi.V2GTPVersion) {
+		return formatV2GTP
+	}
+	line := data
+	if i := bytes.IndexByte(line, '\n'); i >= 0 {
+		line = line[:i]
+	}
+	if line = bytes.TrimSpace(line); len(line) == 0 || line[0] == '#' || isHexString(string(line)) {
+		return formatHex
+	}
+	return formatLen
+}
+
+// frameReader splits the input into frames, which are sub-slices of it.
+type frameReader struct {
+	data   []byte
+	pos    int
+	format string
+}
+
+func newFrameReader(data []byte, format string) (*frameReader, error) {
+	switch format {
+	case formatHex, formatLen, formatV2GTP:
+		return &frameReader{data: data, format: format}, nil
+	}
+	return nil, fmt.Errorf("unknown input format %q (want hex, len, v2gtp or auto)", format)
+}
+
+// next returns the next frame, or ok == false at the end of the input. An
+// error means the rest of the input cannot be framed.
+func (r *frameReader) next() (frame []byte, ok bool, err error) {
+	rest := r.data[r.pos:]
+	switch r.format {
+	case formatHex:
+		// Blank lines and lines starting with '#' are skipped.
+		for len(rest) > 0 {
+			line := rest
+			n := len(rest)
+			if i := bytes.IndexByte(rest, '\n'); i >= 0 {
+				line, n = rest[:i], i+1
+			}
+			rest = rest[n:]
+			r.pos += n
+			if line = bytes.TrimSpace(line); len(line) > 0 && line[0] != '#' {
+				return line, true, nil
+			}
+		}
+		return nil, false, nil
+	case formatLen:
+		if len(rest) == 0 {
+			return nil, false, nil
+		}
+		if len(rest) < 4 {
+			return nil, false, errors.New("truncated length prefix")
+		}
+		n := binary.BigEndian.Uint32(rest)
+		if uint64(n) > uint64(len(rest)-4) {
+			return nil, false, fmt.Errorf("length %d exceeds the %d bytes left", n, len(rest)-4)
+		}
+		r.pos += 4 + int(n)
+		return rest[4 : 4+n : 4+n], true, nil
+	default: // formatV2GTP
+		if len(rest) == 0 {
+			return nil, false, nil
+		}
+		_, payload, err := exi.ParseV2GTP(rest)
+		if errors.Is(err, exi.ErrNeedMoreData) {
+			return nil, false, errors.New("truncated V2GTP packet")
+		}
+		if err != nil {
+			return nil, false, err
+		}
+		r.pos += exi.V2GTPHeaderSize + len(payload)
+		return payload, true, nil
+	}
+}
+
+// mapFile maps the file at path read-only; the returned function unmaps it.
+func mapFile(path string) ([]byte, func() error, error) {
+	f, err := os.Open(path)
+	if err != nil {
+		return nil, nil, err
+	}
+	defer f.Close()
+	return mmap.Map(f)
+}
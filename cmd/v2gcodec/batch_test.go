@@ -0,0 +1,188 @@
+package main
+
+import (
+	"bufio"
+	"bytes"
+	"encoding/binary"
+	"encoding/hex"
+	"encoding/json"
+	"os"
+	"path/filepath"
+	"strconv"
+	"strings"
+	"testing"
+
+	"example.com/exi-go/pkg/exi"
+)
+
+// batchCorpus returns a mix of golden vectors and corrupt frames, long
+// enough to span several batch jobs, and the message type expected for each
+// frame ("" for a frame that must fail to decode).
+func batchCorpus(t *testing.T) (frames [][]byte, want []string) {
+	t.Helper()
+	files, err := filepath.Glob(filepath.Join("..", "..", "testvectors", "*.exi"))
+	if err != nil || len(files) == 0 {
+		t.Fatalf("no test vectors: %v", err)
+	}
+	var vectors [][]byte
+	var names []string
+	for _, f := range files {
+		data, err := os.ReadFile(f)
+		if err != nil {
+			t.Fatal(err)
+		}
+		msg, err := exi.DecodeStruct(data, nil)
+		if err != nil {
+			continue
+		}
+		vectors = append(vectors, data)
+		names = append(names, exi.MessageOf(msg).Name)
+	}
+	// The event code survives, the body does not.
+	bad := append([]byte(nil), vectors[0]...)
+	for i := 2; i < len(bad); i++ {
+		bad[i] = 0xFF
+	}
+	if _, err := exi.DecodeStruct(bad, nil); err == nil {
+		t.Fatal("corrupt frame decodes")
+	}
+	for i := 0; len(frames) < 3*batchJobFrames+7; i++ {
+		if i%13 == 5 {
+			frames = append(frames, bad)
+			want = append(want, "")
+			continue
+		}
+		frames = append(frames, vectors[i%len(vectors)])
+		want = append(want, names[i%len(vectors)])
+	}
+	return frames, want
+}
+
+// frameInput writes frames in the given framing.
+func frameInput(frames [][]byte, format string) []byte {
+	var b bytes.Buffer
+	for _, f := range frames {
+		switch format {
+		case formatHex:
+			b.WriteString(hex.EncodeToString(f))
+			b.WriteByte('\n')
+		case formatLen:
+			var n [4]byte
+			binary.BigEndian.PutUint32(n[:], uint32(len(f)))
+			b.Write(n[:])
+			b.Write(f)
+		case formatV2GTP:
+			var h [exi.V2GTPHeaderSize]byte
+			exi.PutV2GTPHeader(h[:], exi.V2GTPPayloadMain, uint32(len(f)))
+			b.Write(h[:])
+			b.Write(f)
+		}
+	}
+	return b.Bytes()
+}
+
+// runBatchOn runs the batch subcommand on input, read from a file or from
+// stdin, and returns what it wrote.
+func runBatchOn(t *testing.T, input []byte, stdin bool, args ...string) ([]byte, error) {
+	t.Helper()
+	dir := t.TempDir()
+	in, out := filepath.Join(dir, "in"), filepath.Join(dir, "out.ndjson")
+	if err := os.WriteFile(in, input, 0o644); err != nil {
+		t.Fatal(err)
+	}
+	args = append(args, "-out", out, "-stats=false")
+	if stdin {
+		f, err := os.Open(in)
+		if err != nil {
+			t.Fatal(err)
+		}
+		defer f.Close()
+		saved := os.Stdin
+		os.Stdin = f
+		defer func() { os.Stdin = saved }()
+		args = append(args, "-in", "-")
+	} else {
+		args = append(args, "-in", in)
+	}
+	runErr := runBatch(args)
+	got, err := os.ReadFile(out)
+	if err != nil {
+		t.Fatal(err)
+	}
+	return got, runErr
+}
+
+// batchLine is one NDJSON output line.
+type batchLine struct {
+	Frame   int             `json:"frame"`
+	Type    string          `json:"type"`
+	Message json.RawMessage `json:"message"`
+	Error   string          `json:"error"`
+}
+
+func parseBatchOutput(t *testing.T, out []byte) []batchLine {
+	t.Helper()
+	var lines []batchLine
+	sc := bufio.NewScanner(bytes.NewReader(out))
+	sc.Buffer(nil, 1<<20)
+	for sc.Scan() {
+		var l batchLine
+		if err := json.Unmarshal(sc.Bytes(), &l); err != nil {
+			t.Fatalf("line %d: %v: %s", len(lines), err, sc.Bytes())
+		}
+		lines = append(lines, l)
+	}
+	return lines
+}
+
+func TestBatchOrder(t *testing.T) {
+	frames, want := batchCorpus(t)
+	var first []byte
+	for _, format := range []string{formatLen, formatV2GTP, formatHex} {
+		for _, stdin := range []bool{false, true} {
+			out, err := runBatchOn(t, frameInput(frames, format), stdin, "-workers", "3")
+			if err != nil {
+				t.Fatalf("%s, stdin %v: %v", format, stdin, err)
+			}
+			lines := parseBatchOutput(t, out)
+			if len(lines) != len(frames) {
+				t.Fatalf("%s, stdin %v: %d lines for %d frames", format, stdin, len(lines), len(frames))
+			}
+			for i, l := range lines {
+				if l.Frame != i {
+					t.Fatalf("%s, stdin %v: line %d is frame %d", format, stdin, i, l.Frame)
+				}
+				if want[i] == "" {
+					if l.Error == "" || l.Message != nil {
+						t.Errorf("%s: corrupt frame %d decoded: %+v", format, i, l)
+					}
+				} else if l.Type != want[i] || l.Error != "" || l.Message == nil {
+					t.Errorf("%s: frame %d: type %q, error %q; want %s", format, i, l.Type, l.Error, want[i])
+				}
+			}
+			// The framing and the input path do not change the output.
+			if first == nil {
+				first = out
+			} else if !bytes.Equal(out, first) {
+				t.Errorf("%s, stdin %v: output differs from the mapped len input", format, stdin)
+			}
+		}
+	}
+}
+
+// TestBatchTruncated checks that input which cannot be framed past some
+// frame is reported at that frame, after the frames before it.
+func TestBatchTruncated(t *testing.T) {
+	frames, _ := batchCorpus(t)
+	input := frameInput(frames, formatLen)
+	last := len(frames) - 1
+	for _, stdin := range []bool{false, true} {
+		out, err := runBatchOn(t, input[:len(input)-1], stdin, "-format", formatLen, "-workers", "2")
+		if err == nil || !strings.HasPrefix(err.Error(), "frame "+strconv.Itoa(last)+": ") {
+			t.Errorf("stdin %v: err = %v, want frame %d", stdin, err, last)
+		}
+		if lines := parseBatchOutput(t, out); len(lines) != last {
+			t.Errorf("stdin %v: %d lines, want the %d frames before", stdin, len(lines), last)
+		}
+	}
+}
@@ -52,6 +52,11 @@ func main() {
 			log.Println("decode:", err)
 			os.Exit(mapErrorToCode(err))
 		}
+	case "batch":
+		if err := runBatch(os.Args[2:]); err != nil {
+			log.Println("batch:", err)
+			os.Exit(mapErrorToCode(err))
+		}
 	case "generate":
 		if err := runGenerate(os.Args[2:]); err != nil {
 			log.Println("generate:", err)
@@ -75,6 +80,7 @@ Usage:
 Commands:
   encode    Encode JSON message into EXI binary (hex format)
   decode    Decode EXI binary (hex format) into JSON
+  batch     Decode a file of captured frames in parallel into NDJSON
   generate  Generate Go types and encoder/decoder stubs from XSDs
   version   Print version
   help      Print this help
@@ -102,6 +108,17 @@ Encode Examples:
   # encode to binary file (not hex)
   %s encode -type SessionSetupReq -hex=false -in message.json -out message.exi
 
+Batch Examples:
+  # decode one hex message per line, 8 workers, NDJSON to a file
+  %s batch -in capture.hex -workers 8 -out capture.ndjson
+
+  # decode a capture of V2GTP packets (framing is auto-detected)
+  %s batch -in capture.v2gtp > capture.ndjson
+
+Generate Examples:
+  # precompile the grammar so v2g_load_schemas can skip parsing the XSDs
+  %s generate -schema ./schemas -out "" -grammar-cache v2g.grammar
+
 Round-trip Example:
   # encode then decode
   %s encode -type SessionSetupReq '{"Header":{"SessionID":"ChssPQ==","TimeStamp":1672531200},"EVCCID":"ChssPU5f"}' | %s decode
@@ -115,7 +132,7 @@ Supported Message Types:
   CertificateInstallationReq, CertificateInstallationRes, VehicleCheckInReq,
   VehicleCheckInRes, VehicleCheckOutReq, VehicleCheckOutRes
 
-`, prog, prog, prog, prog, prog, prog, prog, prog, prog, prog, prog)
+`, prog, prog, prog, prog, prog, prog, prog, prog, prog, prog, prog, prog, prog, prog)
 }
 
 // mapErrorToCode converts an error into an exit code.
@@ -296,7 +313,8 @@ func runGenerate(args []string) error {
 	autoDownload := fs.Bool("auto-download", false, "Download public ISO 15118 XSDs into download-dir (must accept ISO terms)")
 	acceptISO := fs.Bool("accept-iso", false, "Accept ISO schema terms when using --auto-download")
 	downloadDir := fs.String("download-dir", "./schemas", "Destination directory for downloaded schemas")
-	outDir := fs.String("out", "./generated", "Output directory for generated Go code")
+	outDir := fs.String("out", "./generated", "Output directory for generated Go code (empty to skip)")
+	grammarCache := fs.String("grammar-cache", "", "Also write the compiled grammar to this cache file (see V2G_GRAMMAR_CACHE)")
 	if err := fs.Parse(args); err != nil {
 		return err
 	}
@@ -328,6 +346,21 @@ func runGenerate(args []string) error {
 		}
 	}
 
+	if *grammarCache != "" {
+		c, err := schema.CompileGrammar(schemaPaths, schema.GrammarOptions{})
+		if err != nil {
+			return fmt.Errorf("compile grammar: %w", err)
+		}
+		if err := schema.WriteGrammarCache(*grammarCache, c); err != nil {
+			return fmt.Errorf("write grammar cache: %w", err)
+		}
+		fmt.Fprintf(os.Stderr, "Grammar cache written to %s (%d types from %d files)\n",
+			*grammarCache, len(c.Table.Types), len(c.Sources))
+	}
+	if *outDir == "" {
+		return nil
+	}
+
 	// Ensure output directory exists
 	if err := os.MkdirAll(*outDir, 0o755); err != nil {
 		return fmt.Errorf("creating output dir: %w", err)
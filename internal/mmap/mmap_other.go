@@ -0,0 +1,23 @@
+//go:build !unix
+
+// Package mmap maps files read-only into memory, for the inputs the codec
+// reads in place: the batch files of the CLI and the grammar cache.
+package mmap
+
+import (
+	"io"
+	"os"
+)
+
+// Map reads the whole of f; memory mapping is only used on unix.
+func Map(f *os.File) ([]byte, func() error, error) {
+	fi, err := f.Stat()
+	if err != nil {
+		return nil, nil, err
+	}
+	data := make([]byte, fi.Size())
+	if _, err := io.ReadFull(f, data); err != nil {
+		return nil, nil, err
+	}
+	return data, func() error { return nil }, nil
+}
@@ -0,0 +1,32 @@
+//go:build unix
+
+// Package mmap maps files read-only into memory, for the inputs the codec
+// reads in place: the batch files of the CLI and the grammar cache.
+package mmap
+
+import (
+	"os"
+	"syscall"
+)
+
+// Map maps the whole of f read-only. The returned function unmaps it; f
+// itself may be closed as soon as Map returns. Empty files, which cannot be
+// mapped, are returned as an empty slice.
+func Map(f *os.File) ([]byte, func() error, error) {
+	fi, err := f.Stat()
+	if err != nil {
+		return nil, nil, err
+	}
+	size := fi.Size()
+	if size == 0 {
+		return nil, func() error { return nil }, nil
+	}
+	if int64(int(size)) != size {
+		return nil, nil, &os.PathError{Op: "mmap", Path: f.Name(), Err: syscall.EFBIG}
+	}
+	data, err := syscall.Mmap(int(f.Fd()), 0, int(size), syscall.PROT_READ, syscall.MAP_SHARED)
+	if err != nil {
+		return nil, nil, &os.PathError{Op: "mmap", Path: f.Name(), Err: err}
+	}
+	return data, func() error { return syscall.Munmap(data) }, nil
+}
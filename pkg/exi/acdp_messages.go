@@ -101,50 +101,56 @@ func EncodeDC_ACDPReq(bs *BitStream, v *generated.DC_ACDPReq) error {
 
 // DecodeDC_ACDPReq decodes the DC_ACDPReq body.
 func DecodeDC_ACDPReq(bs *BitStream) (*generated.DC_ACDPReq, error) {
+	return decodeNew(bs, decodeDC_ACDPReqInto)
+}
+
+// decodeDC_ACDPReqInto is DecodeDC_ACDPReq decoding into dst.
+func decodeDC_ACDPReqInto(bs *BitStream, dst *generated.DC_ACDPReq) error {
 	// START Header
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// EVProcessing
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	evProcVal, err := bs.ReadBits(2)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	evProcessing := mapEnumToEVProcessing(uint8(evProcVal))
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// EVTargetEnergyRequest
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	targetEnergy, err := decodeRationalNumber(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// Skip to END marker
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.DC_ACDPReq{
-		Header:                *header,
+	*dst = generated.DC_ACDPReq{
+		Header:                header,
 		EVProcessing:          evProcessing,
 		EVTargetEnergyRequest: *targetEnergy,
-	}, nil
+	}
+	return nil
 }
 
 // ========================== DC_ACDPRes ==========================
@@ -216,56 +222,62 @@ func EncodeDC_ACDPRes(bs *BitStream, v *generated.DC_ACDPRes) error {
 }
 
 func DecodeDC_ACDPRes(bs *BitStream) (*generated.DC_ACDPRes, error) {
+	return decodeNew(bs, decodeDC_ACDPResInto)
+}
+
+// decodeDC_ACDPResInto is DecodeDC_ACDPRes decoding into dst.
+func decodeDC_ACDPResInto(bs *BitStream, dst *generated.DC_ACDPRes) error {
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// ResponseCode
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	responseCodeVal, err := bs.ReadBits(6)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	responseCode := mapEnumToResponseCode(uint8(responseCodeVal))
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// EVSEProcessing
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	evseProcVal, err := bs.ReadBits(2)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	evseProcessing := mapEnumToEVSEProcessing(uint8(evseProcVal))
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Skip to END marker
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.DC_ACDPRes{
-		Header:         *header,
+	*dst = generated.DC_ACDPRes{
+		Header:         header,
 		ResponseCode:   responseCode,
 		EVSEProcessing: evseProcessing,
-	}, nil
+	}
+	return nil
 }
 
 // ========================== DC_ACDP_BPTReq ==========================
@@ -330,48 +342,54 @@ func EncodeDC_ACDP_BPTReq(bs *BitStream, v *generated.DC_ACDP_BPTReq) error {
 }
 
 func DecodeDC_ACDP_BPTReq(bs *BitStream) (*generated.DC_ACDP_BPTReq, error) {
+	return decodeNew(bs, decodeDC_ACDP_BPTReqInto)
+}
+
+// decodeDC_ACDP_BPTReqInto is DecodeDC_ACDP_BPTReq decoding into dst.
+func decodeDC_ACDP_BPTReqInto(bs *BitStream, dst *generated.DC_ACDP_BPTReq) error {
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// EVProcessing
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	evProcVal, err := bs.ReadBits(2)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	evProcessing := mapEnumToEVProcessing(uint8(evProcVal))
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	targetEnergy, err := decodeRationalNumber(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// Skip to END marker
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.DC_ACDP_BPTReq{
-		Header:                *header,
+	*dst = generated.DC_ACDP_BPTReq{
+		Header:                header,
 		EVProcessing:          evProcessing,
 		EVTargetEnergyRequest: *targetEnergy,
-	}, nil
+	}
+	return nil
 }
 
 // ========================== DC_ACDP_BPTRes ==========================
@@ -443,54 +461,60 @@ func EncodeDC_ACDP_BPTRes(bs *BitStream, v *generated.DC_ACDP_BPTRes) error {
 }
 
 func DecodeDC_ACDP_BPTRes(bs *BitStream) (*generated.DC_ACDP_BPTRes, error) {
+	return decodeNew(bs, decodeDC_ACDP_BPTResInto)
+}
+
+// decodeDC_ACDP_BPTResInto is DecodeDC_ACDP_BPTRes decoding into dst.
+func decodeDC_ACDP_BPTResInto(bs *BitStream, dst *generated.DC_ACDP_BPTRes) error {
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// ResponseCode
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	responseCodeVal, err := bs.ReadBits(6)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	responseCode := mapEnumToResponseCode(uint8(responseCodeVal))
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// EVSEProcessing
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	evseProcVal, err := bs.ReadBits(2)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	evseProcessing := mapEnumToEVSEProcessing(uint8(evseProcVal))
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Skip to END marker
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.DC_ACDP_BPTRes{
-		Header:         *header,
+	*dst = generated.DC_ACDP_BPTRes{
+		Header:         header,
 		ResponseCode:   responseCode,
 		EVSEProcessing: evseProcessing,
-	}, nil
+	}
+	return nil
 }
@@ -0,0 +1,210 @@
+package exi
+
+import "example.com/exi-go/pkg/v2g/generated"
+
+// defaultArenaBlockSize is the size of the first byte block of an Arena.
+const defaultArenaBlockSize = 16 << 10
+
+// minSlabLen is the length of the first block of each typed slab.
+const minSlabLen = 16
+
+// Arena is caller-owned backing storage for decoded messages (see
+// DecodeOptions.Arena). Binary content (SessionID, EVCCID, certificates,
+// ...) is copied into one contiguous byte block instead of a heap object
+// per field, and the element arrays of decoded lists (certificate chains,
+// service lists, schedule entries, parameter sets) come from typed blocks.
+// A decoded message is then a few large objects for the garbage collector
+// rather than one per field, and its contents sit next to each other.
+//
+// Reset makes the memory available again, so steady-state decoding through
+// an Arena allocates only the top-level message: every message decoded
+// since the previous Reset must be dead by then, because the next decode
+// overwrites it. A block that fills up is replaced by one twice its size
+// and Reset keeps only the newest, so after a few requests each block fits
+// a whole request. Strings are still allocated individually, since Go
+// strings must not change. An Arena is not safe for concurrent use.
+type Arena struct {
+	blockSize int
+	block     []byte
+
+	binaries  slab[[]byte]
+	strings   slab[string]
+	services  slab[generated.ServiceType]
+	selected  slab[generated.SelectedService]
+	entries   slab[generated.EVPowerProfileEntry]
+	paramSets slab[generated.ParameterSet]
+	params    slab[generated.Parameter]
+
+	// serviceScratch collects a service list before its length is known.
+	serviceScratch []generated.ServiceType
+}
+
+// NewArena returns an Arena whose first byte block holds blockSize bytes;
+// blockSize <= 0 selects a 16 KiB default.
+func NewArena(blockSize int) *Arena {
+	if blockSize <= 0 {
+		blockSize = defaultArenaBlockSize
+	}
+	return &Arena{blockSize: blockSize}
+}
+
+// Reset releases everything allocated from a since the previous Reset.
+// Messages decoded into a must not be used afterwards.
+func (a *Arena) Reset() {
+	a.block = a.block[:0]
+	a.binaries.reset()
+	a.strings.reset()
+	a.services.reset()
+	a.selected.reset()
+	a.entries.reset()
+	a.paramSets.reset()
+	a.params.reset()
+}
+
+// bytes returns n bytes from the current block, capped so that appending to
+// the result reallocates instead of overwriting the next field.
+func (a *Arena) bytes(n int) []byte {
+	if n == 0 {
+		return []byte{} // like make, never nil
+	}
+	if n > cap(a.block)-len(a.block) {
+		size := 2 * cap(a.block)
+		if size < a.blockSize {
+			size = a.blockSize
+		}
+		if size < n {
+			size = n
+		}
+		a.block = make([]byte, 0, size)
+	}
+	i := len(a.block)
+	a.block = a.block[:i+n]
+	return a.block[i : i+n : i+n]
+}
+
+// slab hands out zeroed []T from a shared block.
+type slab[T any] struct {
+	buf []T
+}
+
+func (s *slab[T]) alloc(n int) []T {
+	if n == 0 {
+		return []T{}
+	}
+	if n > cap(s.buf)-len(s.buf) {
+		size := 2 * cap(s.buf)
+		if size < minSlabLen {
+			size = minSlabLen
+		}
+		if size < n {
+			size = n
+		}
+		s.buf = make([]T, 0, size)
+	}
+	i := len(s.buf)
+	s.buf = s.buf[:i+n]
+	return s.buf[i : i+n : i+n]
+}
+
+// reset zeroes the handed-out elements, so the block neither keeps old
+// messages reachable nor returns stale fields, and rewinds it.
+func (s *slab[T]) reset() {
+	var zero T
+	for i := range s.buf {
+		s.buf[i] = zero
+	}
+	s.buf = s.buf[:0]
+}
+
+// byteSlice returns n bytes for a decoded binary field.
+func (a *Arena) byteSlice(n int) []byte {
+	if a == nil {
+		return make([]byte, n)
+	}
+	return a.bytes(n)
+}
+
+// The list constructors below return make([]T, n) when a is nil, so the
+// decoders call them unconditionally with the stream's arena.
+
+func (a *Arena) binaryList(n int) [][]byte {
+	if a == nil {
+		return make([][]byte, n)
+	}
+	return a.binaries.alloc(n)
+}
+
+func (a *Arena) stringList(n int) []string {
+	if a == nil {
+		return make([]string, n)
+	}
+	return a.strings.alloc(n)
+}
+
+func (a *Arena) selectedServiceList(n int) []generated.SelectedService {
+	if a == nil {
+		return make([]generated.SelectedService, n)
+	}
+	return a.selected.alloc(n)
+}
+
+func (a *Arena) powerProfileEntryList(n int) []generated.EVPowerProfileEntry {
+	if a == nil {
+		return make([]generated.EVPowerProfileEntry, n)
+	}
+	return a.entries.alloc(n)
+}
+
+func (a *Arena) parameterSetList(n int) []generated.ParameterSet {
+	if a == nil {
+		return make([]generated.ParameterSet, n)
+	}
+	return a.paramSets.alloc(n)
+}
+
+func (a *Arena) parameterList(n int) []generated.Parameter {
+	if a == nil {
+		return make([]generated.Parameter, n)
+	}
+	return a.params.alloc(n)
+}
+
+// serviceList returns the services collected in scratch as a list from a.
+// Without an arena it returns scratch itself.
+func (a *Arena) serviceList(scratch []generated.ServiceType) []generated.ServiceType {
+	if a == nil {
+		return scratch
+	}
+	if len(scratch) == 0 {
+		return nil
+	}
+	out := a.services.alloc(len(scratch))
+	copy(out, scratch)
+	a.serviceScratch = scratch[:0]
+	return out
+}
+
+// serviceListScratch returns an empty slice to collect a service list in.
+func (a *Arena) serviceListScratch() []generated.ServiceType {
+	if a == nil {
+		return nil
+	}
+	return a.serviceScratch[:0]
+}
+
+// reuseList returns old resliced to n entries for DecodeInto to refill in
+// place, or nil when old cannot hold them and the caller should allocate the
+// list as Decode does. The entries keep their old values, so that reuse can
+// reach the lists nested in them, and must all be overwritten; those past n
+// are cleared so they keep nothing alive. Lists are never reused with an
+// arena, whose lists are handed out again after Reset.
+func reuseList[T any](bs *BitStream, old []T, n int) []T {
+	if bs.arena != nil || n == 0 || cap(old) < n {
+		return nil
+	}
+	var zero T
+	for i := n; i < len(old); i++ {
+		old[i] = zero
+	}
+	return old[:n]
+}
@@ -0,0 +1,117 @@
+package exi
+
+import (
+	"bytes"
+	"os"
+	"path/filepath"
+	"reflect"
+	"testing"
+
+	"example.com/exi-go/pkg/v2g/generated"
+)
+
+func TestArenaDecodeMatchesHeap(t *testing.T) {
+	files, err := filepath.Glob(filepath.Join("..", "..", "testvectors", "*.exi"))
+	if err != nil || len(files) == 0 {
+		t.Fatalf("no test vectors: %v", err)
+	}
+	arena := NewArena(64) // small blocks, so decodes span several of them
+	d := NewDecoder()
+	d.Options.Arena = arena
+	for _, f := range files {
+		data, err := os.ReadFile(f)
+		if err != nil {
+			t.Fatal(err)
+		}
+		want, err := DecodeStruct(data, nil)
+		if err != nil {
+			continue // covered by the golden decode tests
+		}
+		for i := 0; i < 2; i++ {
+			arena.Reset()
+			got, err := d.Decode(data)
+			if err != nil {
+				t.Fatalf("%s: %v", filepath.Base(f), err)
+			}
+			if !reflect.DeepEqual(got, want) {
+				t.Fatalf("%s: arena decode = %+v, want %+v", filepath.Base(f), got, want)
+			}
+		}
+	}
+}
+
+func TestArenaReuse(t *testing.T) {
+	msg := certificateInstallationResWithChain(3)
+	data, err := EncodeStruct(msg)
+	if err != nil {
+		t.Fatal(err)
+	}
+	arena := NewArena(0)
+	d := NewDecoder()
+	d.Options.Arena = arena
+	v, err := d.Decode(data)
+	if err != nil {
+		t.Fatal(err)
+	}
+	certs := v.(*generated.CertificateInstallationRes).CPSCertificateChain.Certificates
+	if !reflect.DeepEqual(certs, msg.CPSCertificateChain.Certificates) {
+		t.Fatal("certificate chain mismatch")
+	}
+	// Fields are capped, so appending to one never overwrites the next.
+	next := append([]byte(nil), certs[1]...)
+	_ = append(certs[0], 0xFF)
+	if !bytes.Equal(certs[1], next) {
+		t.Fatal("append to an arena field overwrote its neighbour")
+	}
+
+	allocs := testing.AllocsPerRun(20, func() {
+		arena.Reset()
+		if _, err := d.Decode(data); err != nil {
+			t.Fatal(err)
+		}
+	})
+	heap := testing.AllocsPerRun(20, func() {
+		if _, err := DecodeStruct(data, nil); err != nil {
+			t.Fatal(err)
+		}
+	})
+	if allocs >= heap {
+		t.Fatalf("arena decode allocates %v objects, heap decode %v", allocs, heap)
+	}
+}
+
+func BenchmarkArenaDecode(b *testing.B) {
+	discovery, err := os.ReadFile(filepath.Join("..", "..", "testvectors", "ServiceDiscoveryRes.exi"))
+	if err != nil {
+		b.Fatal(err)
+	}
+	certs, err := EncodeStruct(certificateInstallationResWithChain(4))
+	if err != nil {
+		b.Fatal(err)
+	}
+	for _, in := range []struct {
+		name string
+		data []byte
+	}{{"ServiceDiscoveryRes", discovery}, {"CertificateInstallationRes", certs}} {
+		b.Run(in.name+"/Heap", func(b *testing.B) {
+			b.ReportAllocs()
+			d := NewDecoder()
+			for i := 0; i < b.N; i++ {
+				if _, err := d.Decode(in.data); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+		b.Run(in.name+"/Arena", func(b *testing.B) {
+			b.ReportAllocs()
+			d := NewDecoder()
+			d.Options.Arena = NewArena(0)
+			for i := 0; i < b.N; i++ {
+				d.Options.Arena.Reset()
+				if _, err := d.Decode(in.data); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+	}
+}
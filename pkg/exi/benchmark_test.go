@@ -50,6 +50,52 @@ func BenchmarkSessionSetupReq(b *testing.B) {
 			}
 		}
 	})
+
+	b.Run("EncoderReuse", func(b *testing.B) {
+		enc := NewEncoder()
+		dst := make([]byte, 0, 256)
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			_, err := enc.EncodeTo(dst, msg)
+			if err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
+
+	b.Run("DecoderReuse", func(b *testing.B) {
+		dec := NewDecoder()
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			_, err := dec.Decode(encoded)
+			if err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
+
+	b.Run("EncodeSpecialized", func(b *testing.B) {
+		buf := make([]byte, 256)
+		var bs BitStream
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			bs.Init(buf, 0)
+			if err := EncodeSpecializedSessionSetupReq(&bs, msg); err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
+
+	b.Run("DecodeSpecialized", func(b *testing.B) {
+		var bs BitStream
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			bs.Init(encoded, 0)
+			if _, err := DecodeSpecializedSessionSetupReq(&bs); err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
 }
 
 // BenchmarkSessionSetupRes benchmarks SessionSetupRes encoding/decoding
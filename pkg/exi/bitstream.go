@@ -1,7 +1,11 @@
 package exi
 
 import (
+	"encoding/binary"
 	"errors"
+	"fmt"
+	"math"
+	"math/bits"
 )
 
 // Bitstream error definitions
@@ -12,13 +16,14 @@ var (
 	ErrBitstreamNotInitial = errors.New("exi: bitstream not initialized")
 )
 
-// Maximum number of bits per byte
-const exiBitstreamMaxBitCount = 8
-
 // BitStream is a lightweight bit/byte stream abstraction intended to mirror
 // the functionality of the reference C exi_bitstream_t structure. It supports
 // writing/reading individual bits and octets and tracking position/length
 // within a backing buffer.
+//
+// Multi-bit reads and writes operate on a 64-bit big-endian window loaded
+// from the current byte position, so a field of up to 32 bits costs one
+// bounds check and one load/store instead of a loop over single bits.
 type BitStream struct {
 	// backing data buffer (mutable)
 	data     []byte
@@ -30,6 +35,37 @@ type BitStream struct {
 	// initialization flag and saved offset for reset
 	initCalled  bool
 	flagBytePos int
+	// aliasInput lets readOctetSlice return sub-slices of data instead of
+	// copies (see DecodeOptions.AliasInput). Cleared by Init.
+	aliasInput bool
+	// skipOctets makes readOctetSlice pass over the octets and return nil
+	// (see DecodeOptions.SkipBinary). Cleared by Init.
+	skipOctets bool
+	// arena, if set, backs the slices readOctetSlice copies into (see
+	// DecodeOptions.Arena). Cleared by Init.
+	arena *Arena
+	// need is the largest buffer size, in bytes, that a failed read asked
+	// for; StreamDecoder uses it to wait for enough input before retrying.
+	need int
+	// counting makes writes advance the position without storing anything
+	// (see initCounting). Cleared by Init.
+	counting bool
+	// session, if set, supplies the pre-encoded SessionID of the message
+	// header (see Encoder.EncodeSessionInto). Cleared by Init.
+	session *PreparedSession
+	// strings, if set, is the string table of the stream's string values
+	// (see UseStringTable). Cleared by Init.
+	strings *StringTable
+	// maxRepeats bounds the list entries the stream may declare, 0 meaning
+	// no bound, and repeats counts them (see readListCount). Cleared by Init.
+	maxRepeats int
+	repeats    int
+	// statsShard is the shard of the codec statistics this stream counts in,
+	// or 0 until its first counted call (see statsStart). Kept by Init.
+	statsShard uint32
+	// statsTick counts the stream's counted calls, to pick the ones that
+	// are timed (see statsStart). Kept by Init.
+	statsTick uint32
 	// optional status callback (not used here, placeholder)
 	StatusCallback func(messageID int, statusCode int, value1 int, value2 int)
 }
@@ -55,6 +91,46 @@ func (bs *BitStream) Init(data []byte, dataOffset int) {
 	bs.bitCount = 0
 	bs.initCalled = true
 	bs.flagBytePos = dataOffset
+	bs.aliasInput = false
+	bs.skipOctets = false
+	bs.arena = nil
+	bs.need = 0
+	bs.counting = false
+	bs.session = nil
+	bs.strings = nil
+	bs.maxRepeats = 0
+	bs.repeats = 0
+}
+
+// UseStringTable makes the string values encoded or decoded from here on
+// use the string table t (see StringTable), which it resets: call it after
+// Init, at the start of a stream. A nil t restores string literals, which
+// is the default.
+func (bs *BitStream) UseStringTable(t *StringTable) {
+	if t != nil {
+		t.Reset()
+	}
+	bs.strings = t
+}
+
+// initCounting sets up the stream to measure an encoding instead of storing
+// it: every write succeeds and only advances the position, so after running
+// an encoder Length returns exactly the number of bytes it would have
+// written. There is no backing buffer; the writers notice this on the nil
+// check they already do, so counting costs the normal path nothing.
+func (bs *BitStream) initCounting() {
+	bs.Init(nil, 0)
+	bs.counting = true
+}
+
+// noData handles a write of nbits to a stream without a buffer: in counting
+// mode it advances the position, otherwise the stream is uninitialized.
+func (bs *BitStream) noData(nbits int) error {
+	if !bs.counting {
+		return ErrBitstreamNotInitial
+	}
+	bs.advance(nbits)
+	return nil
 }
 
 // Reset resets the stream to the last saved init state (i.e., rewinds to the
@@ -86,74 +162,59 @@ func (bs *BitStream) Length() int {
 	return length
 }
 
-// internal helper: ensure there is space (or advance to next byte) before writing/reading a bit.
-func (bs *BitStream) ensureBitCapacity() error {
-	if bs.bitCount == exiBitstreamMaxBitCount {
-		// We've filled a byte; advance to next byte if possible.
-		if bs.bytePos < bs.dataSize {
-			bs.bytePos++
-			bs.bitCount = 0
-			// If bytePos equals dataSize, subsequent writes will overflow.
-			if bs.bytePos >= bs.dataSize {
-				// If we've consumed the last available byte, further writes will overflow.
-				// The caller will detect when attempting to write a bit.
-			}
-			return nil
-		}
-		return ErrBitstreamOverflow
-	}
-	return nil
-}
-
-// writeBit writes a single bit (0 or 1) to the stream.
-func (bs *BitStream) writeBit(bit uint8) error {
+// window returns the next 64 bits of the buffer starting at bytePos,
+// MSB-aligned, after checking that the first nbits of them (counted from
+// bytePos, i.e. including the bitCount bits already consumed) lie inside the
+// buffer. Bytes past the end of the buffer read as zero.
+func (bs *BitStream) window(nbits int) (uint64, error) {
 	if bs.data == nil {
-		return ErrBitstreamNotInitial
-	}
-	// Ensure we have capacity (advance byte if needed)
-	if bs.bitCount == exiBitstreamMaxBitCount {
-		if err := bs.ensureBitCapacity(); err != nil {
-			return err
-		}
+		return 0, ErrBitstreamNotInitial
 	}
-	// If byte position is beyond buffer, overflow
-	if bs.bytePos >= bs.dataSize {
-		return ErrBitstreamOverflow
+	if end := bs.bytePos + (nbits+7)>>3; end > bs.dataSize {
+		return 0, bs.short(end)
 	}
-	// Get pointer to current byte
-	current := &bs.data[bs.bytePos]
-	if bs.bitCount == 0 {
-		// Starting a fresh byte - clear it
-		*current = 0
+	if bs.bytePos+8 <= bs.dataSize {
+		return binary.BigEndian.Uint64(bs.data[bs.bytePos:]), nil
 	}
-	if bit != 0 {
-		// Set the appropriate bit: place bits from MSB to LSB
-		*current = *current | (1 << (exiBitstreamMaxBitCount - (bs.bitCount + 1)))
+	var w uint64
+	for i, b := range bs.data[bs.bytePos:bs.dataSize] {
+		w |= uint64(b) << (56 - 8*uint(i))
 	}
-	bs.bitCount++
-	return nil
+	return w, nil
 }
 
-// readBit reads a single bit from the stream and returns it (0 or 1).
-func (bs *BitStream) readBit() (uint8, error) {
-	if bs.data == nil {
-		return 0, ErrBitstreamNotInitial
+// short records that a read needed the buffer to extend to byte offset end
+// and returns ErrBitstreamOverflow.
+func (bs *BitStream) short(end int) error {
+	if end > bs.need {
+		bs.need = end
 	}
-	// If we've consumed full byte, advance
-	if bs.bitCount == exiBitstreamMaxBitCount {
-		if err := bs.ensureBitCapacity(); err != nil {
-			return 0, err
-		}
+	return ErrBitstreamOverflow
+}
+
+// shortBits is short for a field of n bits at the current position, where
+// n is a length read from the stream. A length no input could hold is
+// ErrInvalidEXI instead, so that StreamDecoder does not wait for it.
+func (bs *BitStream) shortBits(n uint64) error {
+	if n > math.MaxInt/4 {
+		return fmt.Errorf("%w: field of %d bits", ErrInvalidEXI, n)
 	}
-	// If byte position is beyond buffer, overflow
-	if bs.bytePos >= bs.dataSize {
-		return 0, ErrBitstreamOverflow
+	return bs.short(int((uint64(bs.bytePos)*8 + uint64(bs.bitCount) + n + 7) / 8))
+}
+
+// shortOctets is shortBits for a field of n octets.
+func (bs *BitStream) shortOctets(n uint64) error {
+	if n > math.MaxInt/32 {
+		return fmt.Errorf("%w: field of %d octets", ErrInvalidEXI, n)
 	}
-	current := bs.data[bs.bytePos]
-	shift := exiBitstreamMaxBitCount - (bs.bitCount + 1)
-	b := (current >> shift) & 1
-	bs.bitCount++
-	return b, nil
+	return bs.shortBits(8 * n)
+}
+
+// advance moves the position forward by n bits.
+func (bs *BitStream) advance(n int) {
+	total := int(bs.bitCount) + n
+	bs.bytePos += total >> 3
+	bs.bitCount = uint8(total & 7)
 }
 
 // WriteBits writes bitCount bits of value (most-significant-bit first) to the stream.
@@ -162,81 +223,392 @@ func (bs *BitStream) WriteBits(bitCount int, value uint32) error {
 	if bitCount <= 0 || bitCount > 32 {
 		return ErrBitCountTooLarge
 	}
-	// Write each bit from MSB to LSB
-	for n := 0; n < bitCount; n++ {
-		shift := uint(bitCount - n - 1)
-		bit := uint8((value >> shift) & 1)
-		if err := bs.writeBit(bit); err != nil {
-			return err
-		}
+	if bs.data == nil {
+		return bs.noData(bitCount)
+	}
+	total := int(bs.bitCount) + bitCount // at most 39 bits, i.e. 5 bytes
+	if bs.bytePos+(total+7)>>3 > bs.dataSize {
+		return ErrBitstreamOverflow
+	}
+	bs.PutBits(bitCount, value)
+	return nil
+}
+
+// Reserve returns ErrBitstreamOverflow unless at least nbits more bits fit
+// between the current position and the end of the buffer. Generated codecs
+// call it once per message with a worst-case size and then use the
+// unchecked Put* writers.
+func (bs *BitStream) Reserve(nbits int) error {
+	if nbits < 0 {
+		return ErrInvalidBitCount
+	}
+	if bs.data == nil {
+		return bs.noData(0)
+	}
+	if nbits > (bs.dataSize-bs.bytePos)*8-int(bs.bitCount) {
+		return ErrBitstreamOverflow
 	}
 	return nil
 }
 
-// WriteOctet writes one byte to the stream using WriteBits(8, value).
+// PutBits is WriteBits without the argument and capacity checks: bitCount
+// must be in 1..32 and the space must have been reserved. Writing past the
+// end of the buffer panics.
+func (bs *BitStream) PutBits(bitCount int, value uint32) {
+	if bs.data == nil { // counting
+		bs.advance(bitCount)
+		return
+	}
+	nbytes := (int(bs.bitCount) + bitCount + 7) >> 3
+
+	// Bits already written to the current byte are kept, everything after the
+	// new field within the last touched byte is cleared, and bytes beyond it
+	// are left alone.
+	v := (uint64(value) << (64 - bitCount)) >> bs.bitCount
+	if bs.bitCount > 0 {
+		v |= uint64(bs.data[bs.bytePos]&^(0xFF>>bs.bitCount)) << 56
+	}
+	if bs.bytePos+8 <= bs.dataSize {
+		p := bs.data[bs.bytePos:]
+		keep := ^uint64(0) >> (8 * nbytes)
+		binary.BigEndian.PutUint64(p, binary.BigEndian.Uint64(p)&keep|v)
+	} else {
+		for i := 0; i < nbytes; i++ {
+			bs.data[bs.bytePos+i] = byte(v >> (56 - 8*uint(i)))
+		}
+	}
+	bs.advance(bitCount)
+}
+
+// WriteOctet writes one byte to the stream.
 func (bs *BitStream) WriteOctet(value byte) error {
+	if bs.bitCount == 0 && bs.bytePos < bs.dataSize {
+		bs.data[bs.bytePos] = value
+		bs.bytePos++
+		return nil
+	}
 	return bs.WriteBits(8, uint32(value))
 }
 
-// ReadBits reads bitCount bits from the stream (MSB-first) and returns the
-// resulting uint32. bitCount must be between 1 and 32 inclusive.
-func (bs *BitStream) ReadBits(bitCount int) (uint32, error) {
+// PeekBits returns the next bitCount bits (MSB-first) without advancing the
+// stream. bitCount must be between 1 and 32 inclusive.
+func (bs *BitStream) PeekBits(bitCount int) (uint32, error) {
 	if bitCount <= 0 || bitCount > 32 {
 		return 0, ErrBitCountTooLarge
 	}
-	var value uint32
-	for i := 0; i < bitCount; i++ {
-		b, err := bs.readBit()
-		if err != nil {
-			return 0, err
-		}
-		value = (value << 1) | uint32(b)
+	w, err := bs.window(int(bs.bitCount) + bitCount)
+	if err != nil {
+		return 0, err
+	}
+	return uint32((w << bs.bitCount) >> (64 - bitCount)), nil
+}
+
+// SkipBits advances the stream by bitCount bits without reading them. Any
+// non-negative count is accepted as long as it stays within the buffer.
+func (bs *BitStream) SkipBits(bitCount int) error {
+	if bitCount < 0 {
+		return ErrInvalidBitCount
+	}
+	if bs.data == nil {
+		return ErrBitstreamNotInitial
+	}
+	remaining := (bs.dataSize-bs.bytePos)*8 - int(bs.bitCount)
+	if bitCount > remaining {
+		return bs.short(bs.bytePos + (int(bs.bitCount)+bitCount+7)>>3)
 	}
-	return value, nil
+	bs.advance(bitCount)
+	return nil
+}
+
+// ReadBits reads bitCount bits from the stream (MSB-first) and returns the
+// resulting uint32. bitCount must be between 1 and 32 inclusive.
+func (bs *BitStream) ReadBits(bitCount int) (uint32, error) {
+	v, err := bs.PeekBits(bitCount)
+	if err != nil {
+		return 0, err
+	}
+	bs.advance(bitCount)
+	return v, nil
 }
 
 // ReadOctet reads a single byte (8 bits) from the stream.
 func (bs *BitStream) ReadOctet() (byte, error) {
+	if bs.bitCount == 0 && bs.bytePos < bs.dataSize {
+		b := bs.data[bs.bytePos]
+		bs.bytePos++
+		return b, nil
+	}
 	v, err := bs.ReadBits(8)
 	if err != nil {
 		return 0, err
 	}
-	return byte(v & 0xFF), nil
+	return byte(v), nil
+}
+
+// WriteOctets writes p as a sequence of full octets. On a byte-aligned
+// stream this is a single copy; otherwise the octets are shift-merged across
+// the byte boundary eight at a time. Like WriteBits, the unused low bits of
+// the last touched byte are cleared.
+func (bs *BitStream) WriteOctets(p []byte) error {
+	n := len(p)
+	if n == 0 {
+		return nil
+	}
+	if bs.data == nil {
+		return bs.noData(8 * n)
+	}
+	if bs.bitCount == 0 {
+		if bs.bytePos+n > bs.dataSize {
+			return ErrBitstreamOverflow
+		}
+		copy(bs.data[bs.bytePos:], p)
+		bs.bytePos += n
+		return nil
+	}
+	if bs.bytePos+n+1 > bs.dataSize {
+		return ErrBitstreamOverflow
+	}
+	bs.PutOctets(p)
+	return nil
+}
+
+// PutOctets is WriteOctets without the capacity check; the space must have
+// been reserved. Writing past the end of the buffer panics.
+func (bs *BitStream) PutOctets(p []byte) {
+	n := len(p)
+	if bs.data == nil { // counting
+		bs.bytePos += n
+		return
+	}
+	if bs.bitCount == 0 {
+		copy(bs.data[bs.bytePos:bs.bytePos+n], p)
+		bs.bytePos += n
+		return
+	}
+	k := bs.bitCount
+	dst := bs.data[bs.bytePos : bs.bytePos+n+1]
+	carry := dst[0] &^ (0xFF >> k)
+	i := 0
+	for ; i+8 <= n; i += 8 {
+		w := binary.BigEndian.Uint64(p[i:])
+		binary.BigEndian.PutUint64(dst[i:], uint64(carry)<<56|w>>k)
+		carry = byte(w) << (8 - k)
+	}
+	for ; i < n; i++ {
+		b := p[i]
+		dst[i] = carry | b>>k
+		carry = b << (8 - k)
+	}
+	dst[n] = carry
+	bs.bytePos += n
+}
+
+// ReadOctets fills p with the next len(p) octets. On a byte-aligned stream
+// this is a single copy; otherwise the octets are shift-merged from adjacent
+// bytes eight at a time. Nothing is consumed if the stream is too short.
+func (bs *BitStream) ReadOctets(p []byte) error {
+	n := len(p)
+	if n == 0 {
+		return nil
+	}
+	if bs.data == nil {
+		return ErrBitstreamNotInitial
+	}
+	if bs.bitCount == 0 {
+		if bs.bytePos+n > bs.dataSize {
+			return bs.short(bs.bytePos + n)
+		}
+		copy(p, bs.data[bs.bytePos:])
+		bs.bytePos += n
+		return nil
+	}
+	if bs.bytePos+n+1 > bs.dataSize {
+		return bs.short(bs.bytePos + n + 1)
+	}
+	k := bs.bitCount
+	src := bs.data[bs.bytePos : bs.bytePos+n+1]
+	i := 0
+	for ; i+8 <= n; i += 8 {
+		w := binary.BigEndian.Uint64(src[i:])
+		binary.BigEndian.PutUint64(p[i:], w<<k|uint64(src[i+8])>>(8-k))
+	}
+	for ; i < n; i++ {
+		p[i] = src[i]<<k | src[i+1]>>(8-k)
+	}
+	bs.bytePos += n
+	return nil
+}
+
+// ReadOctetSlice returns the next n octets. The result aliases the input
+// only when the stream was set up by a Decoder with Options.AliasInput, and
+// is nil when Options.SkipBinary is set.
+func (bs *BitStream) ReadOctetSlice(n int) ([]byte, error) {
+	return bs.readOctetSlice(n)
+}
+
+// readOctetSlice returns the next n octets like sliceOctets, or skips them
+// and returns nil when skipOctets is set.
+func (bs *BitStream) readOctetSlice(n int) ([]byte, error) {
+	if bs.skipOctets && n >= 0 {
+		if err := bs.SkipBits(8 * n); err != nil {
+			return nil, err
+		}
+		return nil, nil
+	}
+	return bs.sliceOctets(n)
+}
+
+// sliceOctets returns the next n octets as a new slice (from the arena, if
+// one is set). If aliasInput is
+// set and the stream is byte-aligned, the result is instead a sub-slice of
+// the backing buffer, capped so that appending to it reallocates.
+func (bs *BitStream) sliceOctets(n int) ([]byte, error) {
+	if bs.data == nil {
+		return nil, ErrBitstreamNotInitial
+	}
+	// Check before allocating so a corrupt length cannot force a huge make.
+	if n < 0 {
+		return nil, ErrBitstreamOverflow
+	}
+	if n > bs.dataSize-bs.bytePos {
+		return nil, bs.short(bs.bytePos + n + int(bs.bitCount+7)>>3)
+	}
+	if bs.aliasInput && bs.bitCount == 0 {
+		p := bs.data[bs.bytePos : bs.bytePos+n : bs.bytePos+n]
+		bs.bytePos += n
+		return p, nil
+	}
+	p := bs.arena.byteSlice(n)
+	if err := bs.ReadOctets(p); err != nil {
+		return nil, err
+	}
+	return p, nil
 }
 
 // WriteUnsignedVar writes a variable-length unsigned integer using the EXI
 // octet-sequence format (7-bit groups with continuation flag in high bit).
 // This mirrors the behavior of the C exi_basetypes_convert_to_unsigned and
-// exi_basetypes_encoder_write_unsigned helpers.
+// exi_basetypes_encoder_write_unsigned helpers. Values below 128, which
+// covers most length prefixes, are a single octet write; longer values are
+// checked for space once and then written up to four octets at a time, so
+// nothing is written if they do not fit.
 func (bs *BitStream) WriteUnsignedVar(value uint64) error {
-	// Collect 7-bit groups, low-order first
-	var octs []byte
-	v := value
-	for {
-		b := byte(v & 0x7F)
-		v >>= 7
-		if v != 0 {
-			b |= 0x80
-		}
-		octs = append(octs, b)
-		if v == 0 {
-			break
-		}
+	if value < 0x80 && bs.bitCount == 0 && bs.bytePos < bs.dataSize {
+		bs.data[bs.bytePos] = byte(value)
+		bs.bytePos++
+		return nil
+	}
+	n := 1
+	if value >= 0x80 {
+		n = (bits.Len64(value) + 6) / 7
+	}
+	if bs.data == nil {
+		return bs.noData(8 * n)
+	}
+	end := bs.bytePos + n
+	if bs.bitCount > 0 {
+		end++
+	}
+	if end > bs.dataSize {
+		return ErrBitstreamOverflow
 	}
+	bs.putUnsignedVar(value, n)
+	return nil
+}
 
-	// Write each octet as a full octet in the same order produced (LSB-first)
-	for _, o := range octs {
-		if err := bs.WriteOctet(o); err != nil {
-			return err
+// PutUnsignedVar is WriteUnsignedVar without the capacity check; the space
+// (UnsignedVarBits(value)) must have been reserved.
+func (bs *BitStream) PutUnsignedVar(value uint64) {
+	if value < 0x80 {
+		bs.PutBits(8, uint32(value))
+		return
+	}
+	bs.putUnsignedVar(value, (bits.Len64(value)+6)/7)
+}
+
+// putUnsignedVar writes value as its n octets, low-order group first: byte
+// stores on an aligned stream, otherwise up to four octets per PutBits.
+func (bs *BitStream) putUnsignedVar(value uint64, n int) {
+	if bs.bitCount == 0 && bs.data != nil {
+		p := bs.data[bs.bytePos : bs.bytePos+n]
+		for i := range p[:n-1] {
+			p[i] = byte(value) | 0x80
+			value >>= 7
+		}
+		p[n-1] = byte(value)
+		bs.bytePos += n
+		return
+	}
+	for n > 0 {
+		k := n
+		if k > 4 {
+			k = 4
 		}
+		var w uint32
+		for i := 0; i < k; i++ {
+			o := uint32(value & 0x7F)
+			value >>= 7
+			if n-i > 1 {
+				o |= 0x80
+			}
+			w = w<<8 | o
+		}
+		bs.PutBits(8*k, w)
+		n -= k
 	}
+}
 
-	return nil
+// UnsignedVarBits returns the encoded size in bits of value written with
+// WriteUnsignedVar.
+func UnsignedVarBits(value uint64) int {
+	n := (bits.Len64(value) + 6) / 7
+	if n == 0 {
+		n = 1
+	}
+	return 8 * n
 }
 
 // ReadUnsignedVar reads a variable-length unsigned integer encoded as an
 // EXI octet-sequence (7-bit groups with continuation flag) and returns the value.
+//
+// On an aligned stream the octets are loaded directly, so a single-octet
+// value is one byte load. Otherwise, when eight bytes are available, the
+// terminating octet is located in one 64-bit load and the groups are gathered
+// from the same register. Values longer than that load (over 49 bits) and
+// reads near the end of the buffer take the octet-at-a-time loop.
 func (bs *BitStream) ReadUnsignedVar() (uint64, error) {
+	if bs.bitCount == 0 {
+		p := bs.data[bs.bytePos:bs.dataSize]
+		if len(p) > 10 {
+			p = p[:10]
+		}
+		var result uint64
+		for i, b := range p {
+			result |= uint64(b&0x7F) << (7 * uint(i))
+			if b < 0x80 {
+				bs.bytePos += i + 1
+				return result, nil
+			}
+		}
+	} else if bs.bytePos+8 <= bs.dataSize {
+		w := binary.BigEndian.Uint64(bs.data[bs.bytePos:]) << bs.bitCount
+		// High bits of the octets that end a value; the last octet of w is
+		// incomplete.
+		if ends := ^w & 0x8080808080808000; ends != 0 {
+			n := bits.LeadingZeros64(ends)>>3 + 1
+			var result uint64
+			for i := 0; i < n; i++ {
+				result |= (w >> (56 - 8*uint(i)) & 0x7F) << (7 * uint(i))
+			}
+			bs.bytePos += n
+			return result, nil
+		}
+	}
+	return bs.readUnsignedVarSlow()
+}
+
+// readUnsignedVarSlow is ReadUnsignedVar one octet at a time.
+func (bs *BitStream) readUnsignedVarSlow() (uint64, error) {
 	var shift uint
 	var result uint64
 	for {
@@ -1,6 +1,11 @@
 package exi
 
-import "testing"
+import (
+	"fmt"
+	"testing"
+
+	"example.com/exi-go/pkg/v2g/generated"
+)
 
 // BenchmarkBitStreamReadBits benchmarks the original ReadBits implementation
 func BenchmarkBitStreamReadBits(b *testing.B) {
@@ -116,3 +121,170 @@ func BenchmarkBitStreamWriteBits(b *testing.B) {
 		}
 	})
 }
+
+// certificateChain returns n DER-sized dummy certificates of size bytes each.
+func certificateChain(n, size int) [][]byte {
+	certs := make([][]byte, n)
+	for i := range certs {
+		c := make([]byte, size)
+		for j := range c {
+			c[j] = byte(i + j)
+		}
+		certs[i] = c
+	}
+	return certs
+}
+
+// BenchmarkCertificateChain measures bulk octet transfer for a multi-KB
+// certificate chain, both on the raw BitStream (aligned and unaligned) and
+// through a full CertificateInstallationRes encode/decode.
+func BenchmarkCertificateChain(b *testing.B) {
+	certs := certificateChain(3, 1500)
+	total := 0
+	for _, c := range certs {
+		total += len(c)
+	}
+	buf := make([]byte, total+16)
+
+	for _, offset := range []int{0, 3} {
+		name := "Aligned"
+		if offset != 0 {
+			name = "Unaligned"
+		}
+		b.Run("WriteOctets_"+name, func(b *testing.B) {
+			b.SetBytes(int64(total))
+			var bs BitStream
+			for i := 0; i < b.N; i++ {
+				bs.Init(buf, 0)
+				if offset != 0 {
+					_ = bs.WriteBits(offset, 0)
+				}
+				for _, c := range certs {
+					if err := bs.WriteOctets(c); err != nil {
+						b.Fatal(err)
+					}
+				}
+			}
+		})
+		b.Run("ReadOctets_"+name, func(b *testing.B) {
+			b.SetBytes(int64(total))
+			out := make([]byte, 1500)
+			var bs BitStream
+			for i := 0; i < b.N; i++ {
+				bs.Init(buf, 0)
+				if offset != 0 {
+					_ = bs.SkipBits(offset)
+				}
+				for range certs {
+					if err := bs.ReadOctets(out); err != nil {
+						b.Fatal(err)
+					}
+				}
+			}
+		})
+	}
+
+	msg := &generated.CertificateInstallationRes{
+		Header: generated.MessageHeaderType{
+			SessionID: []byte{0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08},
+			TimeStamp: 1234567890,
+		},
+		ResponseCode:             "OK",
+		EVSEProcessing:           "Finished",
+		CPSCertificateChain:      generated.CertificateChain{Certificates: certs},
+		DHPublicKey:              make([]byte, 65),
+		ContractCertificateChain: generated.CertificateChain{Certificates: certs},
+	}
+	enc := NewEncoder()
+	encoded, err := EncodeStruct(msg)
+	if err != nil {
+		b.Fatal(err)
+	}
+	b.Run("Encode_CertificateInstallationRes", func(b *testing.B) {
+		b.SetBytes(int64(len(encoded)))
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			if _, err := enc.Encode(msg); err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
+	b.Run("Decode_CertificateInstallationRes", func(b *testing.B) {
+		b.SetBytes(int64(len(encoded)))
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			if _, err := DecodeStruct(encoded, nil); err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
+}
+
+// unsignedVarBenchValues are typical varint payloads: short length prefixes,
+// a certificate length and a TimeStamp.
+var unsignedVarBenchValues = []struct {
+	name  string
+	value uint64
+}{
+	{"1byte", 19},
+	{"2bytes", 900},
+	{"5bytes", 1672531200},
+}
+
+// BenchmarkEncodeUnsignedVar writes 100 varints per iteration, byte-aligned
+// and one bit off alignment.
+func BenchmarkEncodeUnsignedVar(b *testing.B) {
+	buf := make([]byte, 1024)
+	for _, v := range unsignedVarBenchValues {
+		for _, offset := range []int{0, 1} {
+			b.Run(fmt.Sprintf("%s/offset%d", v.name, offset), func(b *testing.B) {
+				b.ReportAllocs()
+				var bs BitStream
+				for i := 0; i < b.N; i++ {
+					bs.Init(buf, 0)
+					if offset > 0 {
+						bs.PutBits(offset, 0)
+					}
+					for j := 0; j < 100; j++ {
+						if err := bs.WriteUnsignedVar(v.value); err != nil {
+							b.Fatal(err)
+						}
+					}
+				}
+			})
+		}
+	}
+}
+
+// BenchmarkDecodeUnsignedVar reads back what BenchmarkEncodeUnsignedVar writes.
+func BenchmarkDecodeUnsignedVar(b *testing.B) {
+	buf := make([]byte, 1024)
+	for _, v := range unsignedVarBenchValues {
+		for _, offset := range []int{0, 1} {
+			var w BitStream
+			w.Init(buf, 0)
+			if offset > 0 {
+				w.PutBits(offset, 0)
+			}
+			for j := 0; j < 100; j++ {
+				w.PutUnsignedVar(v.value)
+			}
+			data := append([]byte(nil), buf[:w.Length()]...)
+			b.Run(fmt.Sprintf("%s/offset%d", v.name, offset), func(b *testing.B) {
+				b.ReportAllocs()
+				var bs BitStream
+				for i := 0; i < b.N; i++ {
+					bs.Init(data, 0)
+					if offset > 0 {
+						_ = bs.SkipBits(offset)
+					}
+					for j := 0; j < 100; j++ {
+						if _, err := bs.ReadUnsignedVar(); err != nil {
+							b.Fatal(err)
+						}
+					}
+				}
+			})
+		}
+	}
+}
@@ -0,0 +1,352 @@
+package exi
+
+import (
+	"bytes"
+	"errors"
+	"math/rand"
+	"testing"
+)
+
+type bitField struct {
+	width int
+	value uint32
+}
+
+// packReference packs fields MSB-first one bit at a time, the way the
+// reference C exi_bitstream_t does, with trailing bits of the last byte zero.
+func packReference(fields []bitField) []byte {
+	var out []byte
+	nbits := 0
+	for _, f := range fields {
+		for i := f.width - 1; i >= 0; i-- {
+			if nbits%8 == 0 {
+				out = append(out, 0)
+			}
+			if f.value>>uint(i)&1 != 0 {
+				out[nbits/8] |= 0x80 >> uint(nbits%8)
+			}
+			nbits++
+		}
+	}
+	return out
+}
+
+func randomFields(r *rand.Rand, n int) []bitField {
+	fields := make([]bitField, n)
+	for i := range fields {
+		w := 1 + r.Intn(32)
+		fields[i] = bitField{width: w, value: r.Uint32() >> uint(32-w)}
+	}
+	return fields
+}
+
+func TestBitStreamMatchesReference(t *testing.T) {
+	r := rand.New(rand.NewSource(1))
+	for iter := 0; iter < 500; iter++ {
+		fields := randomFields(r, 1+r.Intn(40))
+		want := packReference(fields)
+
+		// An exactly sized buffer exercises the tail path near the end of
+		// the buffer; a larger, dirty one exercises the 64-bit window path.
+		for _, slack := range []int{0, 16} {
+			buf := bytes.Repeat([]byte{0xA5}, len(want)+slack)
+			var w BitStream
+			w.Init(buf, 0)
+			for _, f := range fields {
+				if err := w.WriteBits(f.width, f.value); err != nil {
+					t.Fatalf("iter %d: WriteBits(%d): %v", iter, f.width, err)
+				}
+			}
+			if w.Length() != len(want) {
+				t.Fatalf("iter %d: Length = %d, want %d", iter, w.Length(), len(want))
+			}
+			if !bytes.Equal(buf[:len(want)], want) {
+				t.Fatalf("iter %d slack %d: wrote %x, want %x", iter, slack, buf[:len(want)], want)
+			}
+			for i, b := range buf[len(want):] {
+				if b != 0xA5 {
+					t.Fatalf("iter %d: byte %d past the end clobbered: %#x", iter, len(want)+i, b)
+				}
+			}
+
+			var rd BitStream
+			rd.Init(buf[:len(want)+slack], 0)
+			for i, f := range fields {
+				peek, err := rd.PeekBits(f.width)
+				if err != nil {
+					t.Fatalf("iter %d field %d: PeekBits: %v", iter, i, err)
+				}
+				got, err := rd.ReadBits(f.width)
+				if err != nil {
+					t.Fatalf("iter %d field %d: ReadBits: %v", iter, i, err)
+				}
+				if got != f.value || peek != f.value {
+					t.Fatalf("iter %d field %d: read %#x peek %#x, want %#x", iter, i, got, peek, f.value)
+				}
+			}
+		}
+	}
+}
+
+func TestBitStreamWriteMasksValue(t *testing.T) {
+	buf := make([]byte, 2)
+	var bs BitStream
+	bs.Init(buf, 0)
+	if err := bs.WriteBits(3, 0xFFFFFFF8|0x5); err != nil {
+		t.Fatal(err)
+	}
+	if err := bs.WriteBits(5, 0); err != nil {
+		t.Fatal(err)
+	}
+	if buf[0] != 0xA0 {
+		t.Fatalf("buf[0] = %#x, want 0xa0", buf[0])
+	}
+}
+
+func TestBitStreamOverflow(t *testing.T) {
+	buf := make([]byte, 2)
+	var bs BitStream
+	bs.Init(buf, 0)
+	if err := bs.WriteBits(12, 0xABC); err != nil {
+		t.Fatal(err)
+	}
+	if err := bs.WriteBits(5, 0); !errors.Is(err, ErrBitstreamOverflow) {
+		t.Fatalf("WriteBits past end: err = %v, want ErrBitstreamOverflow", err)
+	}
+	// A failed write must not move the stream.
+	if err := bs.WriteBits(4, 0xD); err != nil {
+		t.Fatalf("WriteBits into remaining bits: %v", err)
+	}
+	if err := bs.WriteOctet(0); !errors.Is(err, ErrBitstreamOverflow) {
+		t.Fatalf("WriteOctet past end: err = %v, want ErrBitstreamOverflow", err)
+	}
+	if !bytes.Equal(buf, []byte{0xAB, 0xCD}) {
+		t.Fatalf("buf = %x, want abcd", buf)
+	}
+
+	bs.Init(buf, 0)
+	if _, err := bs.ReadBits(17); !errors.Is(err, ErrBitstreamOverflow) {
+		t.Fatalf("ReadBits past end: err = %v, want ErrBitstreamOverflow", err)
+	}
+	if v, err := bs.ReadBits(16); err != nil || v != 0xABCD {
+		t.Fatalf("ReadBits(16) = %#x, %v; want 0xabcd", v, err)
+	}
+	if _, err := bs.ReadOctet(); !errors.Is(err, ErrBitstreamOverflow) {
+		t.Fatalf("ReadOctet past end: err = %v, want ErrBitstreamOverflow", err)
+	}
+
+	var empty BitStream
+	if _, err := empty.ReadBits(1); !errors.Is(err, ErrBitstreamNotInitial) {
+		t.Fatalf("ReadBits on uninitialised stream: err = %v", err)
+	}
+	if err := empty.WriteOctet(1); !errors.Is(err, ErrBitstreamNotInitial) {
+		t.Fatalf("WriteOctet on uninitialised stream: err = %v", err)
+	}
+}
+
+func TestBitStreamSkipBits(t *testing.T) {
+	var bs BitStream
+	bs.Init([]byte{0x12, 0x34, 0x56}, 0)
+	if err := bs.SkipBits(4); err != nil {
+		t.Fatal(err)
+	}
+	if v, _ := bs.ReadBits(8); v != 0x23 {
+		t.Fatalf("after SkipBits(4): ReadBits(8) = %#x, want 0x23", v)
+	}
+	if err := bs.SkipBits(12); err != nil {
+		t.Fatal(err)
+	}
+	if err := bs.SkipBits(0); err != nil {
+		t.Fatal(err)
+	}
+	if err := bs.SkipBits(1); !errors.Is(err, ErrBitstreamOverflow) {
+		t.Fatalf("SkipBits past end: err = %v, want ErrBitstreamOverflow", err)
+	}
+	if err := bs.SkipBits(-1); !errors.Is(err, ErrInvalidBitCount) {
+		t.Fatalf("SkipBits(-1): err = %v, want ErrInvalidBitCount", err)
+	}
+	if bs.Length() != 3 {
+		t.Fatalf("Length = %d, want 3", bs.Length())
+	}
+}
+
+func TestBitStreamOffsetAndReset(t *testing.T) {
+	buf := make([]byte, 8)
+	var bs BitStream
+	bs.Init(buf, 3)
+	if err := bs.WriteBits(6, 0x2A); err != nil {
+		t.Fatal(err)
+	}
+	if bs.Length() != 1 {
+		t.Fatalf("Length = %d, want 1", bs.Length())
+	}
+	if buf[3] != 0xA8 {
+		t.Fatalf("buf[3] = %#x, want 0xa8", buf[3])
+	}
+	bs.Reset()
+	if v, _ := bs.ReadBits(6); v != 0x2A {
+		t.Fatalf("after Reset: ReadBits(6) = %#x, want 0x2a", v)
+	}
+}
+
+func TestBitStreamOctetsMatchReference(t *testing.T) {
+	r := rand.New(rand.NewSource(2))
+	for offset := 0; offset < 8; offset++ {
+		for n := 0; n <= 40; n++ {
+			payload := make([]byte, n)
+			r.Read(payload)
+
+			fields := []bitField{{width: 1 + offset, value: 1}}
+			for _, b := range payload {
+				fields = append(fields, bitField{width: 8, value: uint32(b)})
+			}
+			want := packReference(fields)
+
+			buf := bytes.Repeat([]byte{0xFF}, len(want)+1)
+			var w BitStream
+			w.Init(buf, 0)
+			if err := w.WriteBits(1+offset, 1); err != nil {
+				t.Fatal(err)
+			}
+			if err := w.WriteOctets(payload); err != nil {
+				t.Fatalf("offset %d n %d: WriteOctets: %v", offset, n, err)
+			}
+			if !bytes.Equal(buf[:len(want)], want) || buf[len(want)] != 0xFF {
+				t.Fatalf("offset %d n %d: wrote %x, want %x", offset, n, buf, want)
+			}
+
+			var rd BitStream
+			rd.Init(want, 0)
+			if err := rd.SkipBits(1 + offset); err != nil {
+				t.Fatal(err)
+			}
+			got := make([]byte, n)
+			if err := rd.ReadOctets(got); err != nil {
+				t.Fatalf("offset %d n %d: ReadOctets: %v", offset, n, err)
+			}
+			if !bytes.Equal(got, payload) {
+				t.Fatalf("offset %d n %d: read %x, want %x", offset, n, got, payload)
+			}
+			if err := rd.ReadOctets(make([]byte, 1)); !errors.Is(err, ErrBitstreamOverflow) {
+				t.Fatalf("offset %d n %d: ReadOctets past end: err = %v", offset, n, err)
+			}
+		}
+	}
+}
+
+func TestBitStreamUnsignedVarMatchesReference(t *testing.T) {
+	var values []uint64
+	for shift := uint(0); shift < 64; shift += 7 {
+		values = append(values, 1<<shift-1, 1<<shift, 1<<shift+1)
+	}
+	values = append(values, 0xFFFF, 1672531200, 1<<63, ^uint64(0))
+
+	for offset := 0; offset < 8; offset++ {
+		for _, v := range values {
+			fields := []bitField{{width: 1 + offset, value: 1}}
+			for x := v; ; {
+				o := uint32(x & 0x7F)
+				if x >>= 7; x != 0 {
+					o |= 0x80
+				}
+				fields = append(fields, bitField{width: 8, value: o})
+				if x == 0 {
+					break
+				}
+			}
+			want := packReference(fields)
+
+			for _, put := range []bool{false, true} {
+				buf := bytes.Repeat([]byte{0xFF}, len(want)+1)
+				var w BitStream
+				w.Init(buf, 0)
+				w.PutBits(1+offset, 1)
+				if put {
+					if err := w.Reserve(UnsignedVarBits(v)); err != nil {
+						t.Fatal(err)
+					}
+					w.PutUnsignedVar(v)
+				} else if err := w.WriteUnsignedVar(v); err != nil {
+					t.Fatalf("offset %d value %#x: WriteUnsignedVar: %v", offset, v, err)
+				}
+				if !bytes.Equal(buf[:len(want)], want) || buf[len(want)] != 0xFF || w.Length() != len(want) {
+					t.Fatalf("offset %d value %#x put %v: wrote %x, want %x", offset, v, put, buf, want)
+				}
+			}
+
+			var short BitStream
+			short.Init(make([]byte, len(want)-1), 0)
+			short.PutBits(1+offset, 1)
+			if err := short.WriteUnsignedVar(v); !errors.Is(err, ErrBitstreamOverflow) || short.Length() != 1 {
+				t.Fatalf("offset %d value %#x: short WriteUnsignedVar: err = %v, length %d", offset, v, err, short.Length())
+			}
+
+			// Exactly sized input takes the octet loop, padded input the
+			// 64-bit load.
+			for _, slack := range []int{0, 16} {
+				var rd BitStream
+				rd.Init(append(append([]byte(nil), want...), make([]byte, slack)...), 0)
+				if err := rd.SkipBits(1 + offset); err != nil {
+					t.Fatal(err)
+				}
+				got, err := rd.ReadUnsignedVar()
+				if err != nil || got != v || rd.Length() != len(want) {
+					t.Fatalf("offset %d value %#x slack %d: read %#x, %v, length %d", offset, v, slack, got, err, rd.Length())
+				}
+			}
+
+			var rd BitStream
+			rd.Init(want[:len(want)-1], 0)
+			if err := rd.SkipBits(1 + offset); err != nil {
+				t.Fatal(err)
+			}
+			if _, err := rd.ReadUnsignedVar(); !errors.Is(err, ErrBitstreamOverflow) || rd.need != len(want) {
+				t.Fatalf("offset %d value %#x: truncated read: err = %v, need %d, want %d", offset, v, err, rd.need, len(want))
+			}
+		}
+	}
+
+	// Eleven continuation octets do not fit in a uint64.
+	var rd BitStream
+	rd.Init(append(bytes.Repeat([]byte{0x80}, 10), 0x01, 0, 0, 0, 0, 0, 0, 0), 0)
+	if _, err := rd.ReadUnsignedVar(); !errors.Is(err, ErrBitCountTooLarge) {
+		t.Fatalf("overlong value: err = %v, want ErrBitCountTooLarge", err)
+	}
+}
+
+func TestBitStreamReadOctetSliceAlias(t *testing.T) {
+	data := []byte{0x11, 0x22, 0x33, 0x44, 0x55}
+
+	var bs BitStream
+	bs.Init(data, 0)
+	bs.aliasInput = true
+	p, err := bs.readOctetSlice(2)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if &p[0] != &data[0] || cap(p) != 2 {
+		t.Fatalf("aligned read did not alias input (cap %d)", cap(p))
+	}
+	if _, err := bs.readOctetSlice(4); !errors.Is(err, ErrBitstreamOverflow) {
+		t.Fatalf("aliased read past end: err = %v, want ErrBitstreamOverflow", err)
+	}
+
+	// Unaligned fields fall back to a copy.
+	if err := bs.SkipBits(4); err != nil {
+		t.Fatal(err)
+	}
+	p, err = bs.readOctetSlice(2)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !bytes.Equal(p, []byte{0x34, 0x45}) || &p[0] == &data[3] {
+		t.Fatalf("unaligned read = %x (aliased: %v)", p, &p[0] == &data[3])
+	}
+
+	// Init clears the alias flag.
+	bs.Init(data, 0)
+	p, _ = bs.readOctetSlice(1)
+	if &p[0] == &data[0] {
+		t.Fatal("readOctetSlice aliased input after Init")
+	}
+}
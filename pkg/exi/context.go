@@ -0,0 +1,166 @@
+package exi
+
+import (
+	"errors"
+	"fmt"
+
+	"example.com/exi-go/pkg/v2g/generated"
+)
+
+// maxEncodeBufferSize bounds the size of a message an Encoder will allocate
+// a buffer for. It is far above any legitimate ISO 15118-20 message and only
+// guards against a corrupt length making it allocate without limit.
+const maxEncodeBufferSize = 16 << 20
+
+// Encoder is a reusable encoding context. It owns a BitStream and a growable
+// scratch buffer that are kept across calls, so encoding in steady state does
+// not allocate. An Encoder is not safe for concurrent use; create one per
+// goroutine (or per C thread).
+type Encoder struct {
+	bs  BitStream
+	buf []byte
+	// Strings, if set, writes the string values that repeat within a
+	// message as string-table hits (see StringTable). Only decoders with a
+	// matching StringTable can read such messages, so it is off by default.
+	Strings *StringTable
+}
+
+// NewEncoder returns an Encoder. Its scratch buffer is sized on first use by
+// EncodedSize, so it is exactly as large as the largest message encoded.
+func NewEncoder() *Encoder {
+	return &Encoder{}
+}
+
+// EncodedSize returns the exact number of bytes EncodeInto writes for v. It
+// runs the same encoder over a counting BitStream that stores nothing, so it
+// costs less than an encode and never fails for lack of space; sizing a
+// buffer with it and then encoding cannot overflow.
+func (e *Encoder) EncodedSize(v interface{}) (int, error) {
+	return e.encodedSize(nil, v)
+}
+
+// encodedSize is EncodedSize for a message of session s, if set.
+func (e *Encoder) encodedSize(s *PreparedSession, v interface{}) (int, error) {
+	e.bs.initCounting()
+	e.bs.session = s
+	e.bs.UseStringTable(e.Strings)
+	if err := encodeTopLevel(&e.bs, v); err != nil {
+		return 0, err
+	}
+	return e.bs.Length(), nil
+}
+
+// Encode encodes v into the encoder's scratch buffer and returns the encoded
+// bytes. The returned slice aliases internal storage and is only valid until
+// the next call on e; copy it if it must be retained.
+func (e *Encoder) Encode(v interface{}) ([]byte, error) {
+	out, err := e.EncodeTo(e.buf[:0], v)
+	if err != nil {
+		return nil, err
+	}
+	// Keep a buffer that grew so later calls start large enough.
+	if cap(out) > cap(e.buf) {
+		e.buf = out[:cap(out)]
+	}
+	return out, nil
+}
+
+// EncodeTo appends the EXI encoding of v to dst and returns the extended
+// slice. The message is encoded directly into the spare capacity of dst; if
+// that is insufficient, dst is regrown once to exactly the size EncodedSize
+// reports and the encode retried, so callers that reuse a sufficiently large
+// dst never allocate.
+func (e *Encoder) EncodeTo(dst []byte, v interface{}) ([]byte, error) {
+	return e.appendTo(dst, v, nil, 0, false)
+}
+
+// appendTo implements EncodeTo, EncodeSessionTo when s is set, and
+// EncodeV2GTPTo when framed is set.
+func (e *Encoder) appendTo(dst []byte, v interface{}, s *PreparedSession, payloadType uint16, framed bool) ([]byte, error) {
+	encode := func(buf []byte) (int, error) {
+		if framed {
+			return e.EncodeV2GTPInto(buf, payloadType, v)
+		}
+		return e.encodeInto(buf, s, v)
+	}
+	if cap(dst) > len(dst) {
+		n, err := encode(dst[len(dst):cap(dst)])
+		if err == nil {
+			return dst[:len(dst)+n], nil
+		}
+		if !errors.Is(err, ErrBitstreamOverflow) {
+			return dst, err
+		}
+	}
+	size, err := e.encodedSize(s, v)
+	if err != nil {
+		return dst, err
+	}
+	if size > maxEncodeBufferSize {
+		return dst, fmt.Errorf("EncodeTo: message of %d bytes exceeds %d: %w", size, maxEncodeBufferSize, ErrBitstreamOverflow)
+	}
+	if framed {
+		size += V2GTPHeaderSize
+	}
+	grown := make([]byte, len(dst), len(dst)+size)
+	copy(grown, dst)
+	n, err := encode(grown[len(dst):cap(grown)])
+	if err != nil {
+		return dst, err
+	}
+	return grown[:len(dst)+n], nil
+}
+
+// EncodeInto encodes v into buf and returns the number of bytes written. It
+// never allocates a buffer: if buf is too small it returns an error wrapping
+// ErrBitstreamOverflow and the contents of buf are unspecified.
+func (e *Encoder) EncodeInto(buf []byte, v interface{}) (int, error) {
+	return e.encodeInto(buf, nil, v)
+}
+
+// encodeInto implements EncodeInto and EncodeSessionInto.
+func (e *Encoder) encodeInto(buf []byte, s *PreparedSession, v interface{}) (int, error) {
+	if len(buf) == 0 {
+		return 0, ErrBitstreamOverflow
+	}
+	e.bs.Init(buf, 0)
+	e.bs.session = s
+	e.bs.UseStringTable(e.Strings)
+	if err := encodeTopLevel(&e.bs, v); err != nil {
+		return 0, err
+	}
+	return e.bs.Length(), nil
+}
+
+// Decoder is a reusable decoding context. It owns the BitStream used to read
+// input so that decoding does not allocate one per call. A Decoder is not
+// safe for concurrent use.
+type Decoder struct {
+	bs BitStream
+	// Options applies to every Decode call; see DecodeOptions.
+	Options DecodeOptions
+}
+
+// NewDecoder returns a ready-to-use Decoder with default options.
+func NewDecoder() *Decoder {
+	return &Decoder{}
+}
+
+// Decode decodes a complete EXI document from data, dispatching on its event
+// code like DecodeStruct. Unless d.Options.AliasInput is set, the decoded
+// message does not reference data.
+func (d *Decoder) Decode(data []byte) (interface{}, error) {
+	d.bs.Init(data, 0)
+	d.Options.apply(&d.bs)
+	return decodeTopLevel(&d.bs)
+}
+
+// DecodeInto decodes a complete EXI document from data into dst, like the
+// package-level DecodeInto but with d.Options. With an Arena, the lists of
+// dst come from the Arena as with Decode instead of being refilled in
+// place.
+func (d *Decoder) DecodeInto(data []byte, dst generated.Message) error {
+	d.bs.Init(data, 0)
+	d.Options.apply(&d.bs)
+	return decodeTopLevelInto(&d.bs, dst)
+}
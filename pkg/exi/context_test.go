@@ -0,0 +1,262 @@
+package exi_test
+
+import (
+	"bytes"
+	"errors"
+	"os"
+	"path/filepath"
+	"reflect"
+	"testing"
+
+	"example.com/exi-go/pkg/exi"
+	"example.com/exi-go/pkg/v2g/generated"
+)
+
+// corpusDir holds the EXI test vectors checked into the repository root.
+const corpusDir = "../../testvectors"
+
+// loadCorpus reads every *.exi file in corpusDir, keyed by file name.
+func loadCorpus(t testing.TB) map[string][]byte {
+	t.Helper()
+	paths, err := filepath.Glob(filepath.Join(corpusDir, "*.exi"))
+	if err != nil {
+		t.Fatalf("glob corpus: %v", err)
+	}
+	if len(paths) == 0 {
+		t.Skipf("no test vectors found in %s", corpusDir)
+	}
+	corpus := make(map[string][]byte, len(paths))
+	for _, p := range paths {
+		data, err := os.ReadFile(p)
+		if err != nil {
+			t.Fatalf("read %s: %v", p, err)
+		}
+		corpus[filepath.Base(p)] = data
+	}
+	return corpus
+}
+
+// TestEncoderDecoderCorpus checks that a single reused Encoder/Decoder pair
+// reproduces every test vector bit-exactly, including after the scratch
+// buffer has been dirtied by previous messages.
+func TestEncoderDecoderCorpus(t *testing.T) {
+	corpus := loadCorpus(t)
+	enc := exi.NewEncoder()
+	dec := exi.NewDecoder()
+
+	for pass := 0; pass < 2; pass++ {
+		for name, data := range corpus {
+			msg, err := dec.Decode(data)
+			if err != nil {
+				t.Fatalf("%s: decode: %v", name, err)
+			}
+			got, err := enc.Encode(msg)
+			if err != nil {
+				t.Fatalf("%s: encode: %v", name, err)
+			}
+			if !bytes.Equal(got, data) {
+				t.Fatalf("%s: re-encoded bytes differ\n got  %x\n want %x", name, got, data)
+			}
+		}
+	}
+}
+
+func TestEncoderEncodeToAppends(t *testing.T) {
+	msg := &generated.SessionStopReq{
+		Header:          generated.MessageHeaderType{SessionID: []byte{1, 2, 3, 4, 5, 6, 7, 8}},
+		ChargingSession: "Terminate",
+	}
+	want, err := exi.EncodeStruct(msg)
+	if err != nil {
+		t.Fatal(err)
+	}
+
+	enc := exi.NewEncoder()
+	prefix := []byte{0xAA, 0xBB}
+
+	// Too little spare capacity: EncodeTo must grow and keep the prefix.
+	out, err := enc.EncodeTo(append([]byte(nil), prefix...), msg)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !bytes.Equal(out[:2], prefix) || !bytes.Equal(out[2:], want) {
+		t.Fatalf("EncodeTo (grow) = %x, want %x%x", out, prefix, want)
+	}
+
+	// Enough spare capacity: EncodeTo must write in place.
+	dst := make([]byte, 2, 64)
+	copy(dst, prefix)
+	out, err = enc.EncodeTo(dst, msg)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if &out[0] != &dst[0] || !bytes.Equal(out[2:], want) {
+		t.Fatalf("EncodeTo (in place) = %x, want %x%x", out, prefix, want)
+	}
+}
+
+func TestEncoderEncodeIntoTooSmall(t *testing.T) {
+	msg := &generated.SessionStopReq{ChargingSession: "Terminate"}
+	enc := exi.NewEncoder()
+	if _, err := enc.EncodeInto(make([]byte, 2), msg); !errors.Is(err, exi.ErrBitstreamOverflow) {
+		t.Fatalf("EncodeInto small buffer: err = %v, want ErrBitstreamOverflow", err)
+	}
+	if _, err := enc.EncodeInto(nil, msg); !errors.Is(err, exi.ErrBitstreamOverflow) {
+		t.Fatalf("EncodeInto nil buffer: err = %v, want ErrBitstreamOverflow", err)
+	}
+}
+
+// TestEncodedSize checks that EncodedSize predicts the encoded length of
+// every test vector and of a message too large for a small scratch buffer,
+// and that EncodeStruct allocates exactly that much.
+func TestEncodedSize(t *testing.T) {
+	corpus := loadCorpus(t)
+	chain := make([][]byte, 8)
+	for i := range chain {
+		chain[i] = bytes.Repeat([]byte{0x30, 0x82, byte(i)}, 400)
+	}
+	msgs := map[string]interface{}{
+		"CertificateInstallationRes (8 certs)": &generated.CertificateInstallationRes{
+			Header:                   generated.MessageHeaderType{SessionID: []byte{1, 2, 3, 4}},
+			ResponseCode:             "OK",
+			EVSEProcessing:           "Finished",
+			CPSCertificateChain:      generated.CertificateChain{Certificates: chain},
+			ContractCertificateChain: generated.CertificateChain{Certificates: chain},
+		},
+	}
+	for name, data := range corpus {
+		msg, err := exi.DecodeStruct(data, nil)
+		if err != nil {
+			t.Fatalf("%s: decode: %v", name, err)
+		}
+		msgs[name] = msg
+	}
+
+	enc := exi.NewEncoder()
+	for name, msg := range msgs {
+		size, err := exi.EncodedSize(msg)
+		if err != nil {
+			t.Fatalf("%s: EncodedSize: %v", name, err)
+		}
+		out, err := exi.EncodeStruct(msg)
+		if err != nil {
+			t.Fatalf("%s: EncodeStruct: %v", name, err)
+		}
+		if size != len(out) || cap(out) != len(out) {
+			t.Errorf("%s: EncodedSize = %d, EncodeStruct len %d cap %d", name, size, len(out), cap(out))
+		}
+		if data, ok := corpus[name]; ok && !bytes.Equal(out, data) {
+			t.Errorf("%s: EncodeStruct differs from the test vector", name)
+		}
+		if n, err := enc.EncodedSize(msg); err != nil || n != size {
+			t.Errorf("%s: Encoder.EncodedSize = %d, %v; want %d", name, n, err, size)
+		}
+		if _, err := enc.EncodeInto(make([]byte, size), msg); err != nil {
+			t.Errorf("%s: EncodeInto of EncodedSize bytes: %v", name, err)
+		}
+	}
+
+	if _, err := exi.EncodedSize(struct{}{}); err == nil {
+		t.Error("EncodedSize of an unsupported type succeeded")
+	}
+}
+
+// TestEncoderSteadyStateAllocs checks that, once warmed up, a reused Encoder
+// encodes every test vector message without allocating.
+func TestEncoderSteadyStateAllocs(t *testing.T) {
+	corpus := loadCorpus(t)
+	enc := exi.NewEncoder()
+	for name, data := range corpus {
+		msg, err := exi.DecodeStruct(data, nil)
+		if err != nil {
+			t.Fatalf("%s: decode: %v", name, err)
+		}
+		if _, err := enc.Encode(msg); err != nil {
+			t.Fatalf("%s: encode: %v", name, err)
+		}
+		allocs := testing.AllocsPerRun(20, func() {
+			if _, err := enc.Encode(msg); err != nil {
+				t.Fatal(err)
+			}
+		})
+		if allocs != 0 {
+			t.Errorf("%s: Encoder.Encode allocs/op = %v, want 0", name, allocs)
+		}
+	}
+}
+
+// TestDecodeAliasInputCorpus checks that AliasInput decodes every test vector
+// to the same message as the copying decoder.
+func TestDecodeAliasInputCorpus(t *testing.T) {
+	corpus := loadCorpus(t)
+	dec := exi.NewDecoder()
+	dec.Options.AliasInput = true
+	for name, data := range corpus {
+		want, err := exi.DecodeStruct(data, nil)
+		if err != nil {
+			t.Fatalf("%s: decode: %v", name, err)
+		}
+		got, err := exi.DecodeStructWithOptions(data, nil, exi.DecodeOptions{AliasInput: true})
+		if err != nil {
+			t.Fatalf("%s: decode with AliasInput: %v", name, err)
+		}
+		if !reflect.DeepEqual(got, want) {
+			t.Fatalf("%s: AliasInput decode differs\n got  %+v\n want %+v", name, got, want)
+		}
+		got, err = dec.Decode(data)
+		if err != nil || !reflect.DeepEqual(got, want) {
+			t.Fatalf("%s: Decoder with AliasInput differs (err %v)", name, err)
+		}
+	}
+}
+
+func BenchmarkEncodedSize(b *testing.B) {
+	chain := make([][]byte, 4)
+	for i := range chain {
+		chain[i] = bytes.Repeat([]byte{0x30, 0x82, byte(i)}, 300)
+	}
+	msgs := []struct {
+		name string
+		msg  interface{}
+	}{
+		{"SessionStopReq", &generated.SessionStopReq{
+			Header:          generated.MessageHeaderType{SessionID: []byte{1, 2, 3, 4, 5, 6, 7, 8}},
+			ChargingSession: "Terminate",
+		}},
+		{"CertificateInstallationRes", &generated.CertificateInstallationRes{
+			Header:                   generated.MessageHeaderType{SessionID: []byte{1, 2, 3, 4}},
+			ResponseCode:             "OK",
+			EVSEProcessing:           "Finished",
+			CPSCertificateChain:      generated.CertificateChain{Certificates: chain},
+			ContractCertificateChain: generated.CertificateChain{Certificates: chain},
+		}},
+	}
+	for _, m := range msgs {
+		b.Run(m.name+"/EncodedSize", func(b *testing.B) {
+			b.ReportAllocs()
+			enc := exi.NewEncoder()
+			for i := 0; i < b.N; i++ {
+				if _, err := enc.EncodedSize(m.msg); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+		b.Run(m.name+"/Encode", func(b *testing.B) {
+			b.ReportAllocs()
+			enc := exi.NewEncoder()
+			for i := 0; i < b.N; i++ {
+				if _, err := enc.Encode(m.msg); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+		b.Run(m.name+"/EncodeStruct", func(b *testing.B) {
+			b.ReportAllocs()
+			for i := 0; i < b.N; i++ {
+				if _, err := exi.EncodeStruct(m.msg); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+	}
+}
@@ -56,23 +56,29 @@ func EncodeCLReqControlMode(bs *BitStream, v *generated.CLReqControlMode) error
 
 // DecodeCLReqControlMode decodes the CLReqControlMode body.
 func DecodeCLReqControlMode(bs *BitStream) (*generated.CLReqControlMode, error) {
+	return decodeNew(bs, decodeCLReqControlModeInto)
+}
+
+// decodeCLReqControlModeInto is DecodeCLReqControlMode decoding into dst.
+func decodeCLReqControlModeInto(bs *BitStream, dst *generated.CLReqControlMode) error {
 	// START Header
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// END CLReqControlMode
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.CLReqControlMode{
-		Header: *header,
-	}, nil
+	*dst = generated.CLReqControlMode{
+		Header: header,
+	}
+	return nil
 }
 
 // --------------------------- CLResControlMode ------------------------------
@@ -119,21 +125,27 @@ func EncodeCLResControlMode(bs *BitStream, v *generated.CLResControlMode) error
 
 // DecodeCLResControlMode decodes the CLResControlMode body.
 func DecodeCLResControlMode(bs *BitStream) (*generated.CLResControlMode, error) {
+	return decodeNew(bs, decodeCLResControlModeInto)
+}
+
+// decodeCLResControlModeInto is DecodeCLResControlMode decoding into dst.
+func decodeCLResControlModeInto(bs *BitStream, dst *generated.CLResControlMode) error {
 	// START Header
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// END CLResControlMode
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.CLResControlMode{
-		Header: *header,
-	}, nil
+	*dst = generated.CLResControlMode{
+		Header: header,
+	}
+	return nil
 }
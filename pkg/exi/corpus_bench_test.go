@@ -0,0 +1,179 @@
+package exi_test
+
+import (
+	"encoding/json"
+	"sort"
+	"strings"
+	"testing"
+
+	"example.com/exi-go/pkg/exi"
+	"example.com/exi-go/pkg/v2g/generated"
+)
+
+// Corpus benchmarks run every test vector through the same four operations
+// as the C and Python drivers (bindings/c/bench/corpus_bench.cpp and
+// bindings/python/cffi/bench_cffi.py), so that cmd/benchreport can split
+// the cost of a C call into codec, JSON and cgo, and through DecodeInto,
+// which the drivers have no counterpart for:
+//
+//	Decode      EXI -> Go struct, aliasing decoder with an arena (the codec)
+//	DecodeInto  Decode into a reused message
+//	DecodeJSON  Decode, then json.Marshal (what v2g_decode_struct does)
+//	Encode      Go struct -> EXI into a reused buffer
+//	EncodeJSON  json.Unmarshal into a reused message, then Encode
+//
+// Run them with
+//
+//	go test ./pkg/exi -run '^$' -bench '^BenchmarkCorpus$' -benchmem
+//	go test ./pkg/exi -run '^$' -bench '^BenchmarkCorpusParallel$' -benchmem -cpu 1,2,4
+//
+// The Decode, DecodeInto and Encode results are checked in as a baseline, and their
+// allocations are gated per message (see corpus_budget_test.go).
+
+// corpusVector is one test vector and the values the benchmarks start from.
+type corpusVector struct {
+	name string // message name, e.g. "SessionSetupReq"
+	data []byte
+	info *exi.MessageInfo
+	msg  interface{}
+	json []byte
+}
+
+// loadCorpusVectors decodes every test vector once, sorted by name.
+func loadCorpusVectors(tb testing.TB) []corpusVector {
+	corpus := loadCorpus(tb)
+	vectors := make([]corpusVector, 0, len(corpus))
+	for file, data := range corpus {
+		msg, err := exi.NewDecoder().Decode(data)
+		if err != nil {
+			tb.Fatalf("%s: decode: %v", file, err)
+		}
+		js, err := json.Marshal(msg)
+		if err != nil {
+			tb.Fatalf("%s: marshal: %v", file, err)
+		}
+		vectors = append(vectors, corpusVector{
+			name: strings.TrimSuffix(file, ".exi"),
+			data: data,
+			info: exi.MessageOf(msg),
+			msg:  msg,
+			json: js,
+		})
+	}
+	sort.Slice(vectors, func(i, j int) bool { return vectors[i].name < vectors[j].name })
+	return vectors
+}
+
+// corpusOp runs one benchmarked operation on v. Each benchmark goroutine
+// gets its own state, as each C thread gets its own v2g_ctx.
+type corpusOp func(st *corpusState, v *corpusVector) error
+
+type corpusState struct {
+	dec  *exi.Decoder
+	enc  *exi.Encoder
+	buf  []byte
+	msgs map[uint8]interface{}
+}
+
+func newCorpusState() *corpusState {
+	dec := exi.NewDecoder()
+	dec.Options.AliasInput = true
+	dec.Options.Arena = exi.NewArena(0)
+	return &corpusState{dec: dec, enc: exi.NewEncoder(), buf: make([]byte, 64<<10), msgs: map[uint8]interface{}{}}
+}
+
+// message returns the message of v's type that st decodes into.
+func (st *corpusState) message(v *corpusVector) interface{} {
+	msg := st.msgs[v.info.Code]
+	if msg == nil {
+		msg = v.info.New()
+		st.msgs[v.info.Code] = msg
+	}
+	return msg
+}
+
+var corpusOps = []struct {
+	name string
+	run  corpusOp
+}{
+	{"Decode", func(st *corpusState, v *corpusVector) error {
+		st.dec.Options.Arena.Reset()
+		_, err := st.dec.Decode(v.data)
+		return err
+	}},
+	{"DecodeInto", func(st *corpusState, v *corpusVector) error {
+		st.dec.Options.Arena.Reset()
+		return st.dec.DecodeInto(v.data, st.message(v).(generated.Message))
+	}},
+	{"DecodeJSON", func(st *corpusState, v *corpusVector) error {
+		st.dec.Options.Arena.Reset()
+		msg, err := st.dec.Decode(v.data)
+		if err != nil {
+			return err
+		}
+		_, err = json.Marshal(msg)
+		return err
+	}},
+	{"Encode", func(st *corpusState, v *corpusVector) error {
+		_, err := st.enc.EncodeInto(st.buf, v.msg)
+		return err
+	}},
+	{"EncodeJSON", func(st *corpusState, v *corpusVector) error {
+		msg := st.message(v)
+		v.info.Reset(msg)
+		if err := json.Unmarshal(v.json, msg); err != nil {
+			return err
+		}
+		_, err := st.enc.EncodeInto(st.buf, msg)
+		return err
+	}},
+}
+
+// BenchmarkCorpus reports the per-message cost of each operation on one
+// goroutine, as BenchmarkCorpus/<message>/<op>.
+func BenchmarkCorpus(b *testing.B) {
+	vectors := loadCorpusVectors(b)
+	for i := range vectors {
+		v := &vectors[i]
+		for _, op := range corpusOps {
+			op := op
+			b.Run(v.name+"/"+op.name, func(b *testing.B) {
+				st := newCorpusState()
+				b.SetBytes(int64(len(v.data)))
+				b.ReportAllocs()
+				for i := 0; i < b.N; i++ {
+					if err := op.run(st, v); err != nil {
+						b.Fatal(err)
+					}
+				}
+			})
+		}
+	}
+}
+
+// BenchmarkCorpusParallel cycles through the whole corpus on GOMAXPROCS
+// goroutines, as BenchmarkCorpusParallel/<op>; run it with -cpu to measure
+// scaling. ns/op is per message, averaged over the corpus.
+func BenchmarkCorpusParallel(b *testing.B) {
+	vectors := loadCorpusVectors(b)
+	var size int
+	for _, v := range vectors {
+		size += len(v.data)
+	}
+	for _, op := range corpusOps {
+		op := op
+		b.Run(op.name, func(b *testing.B) {
+			b.SetBytes(int64(size / len(vectors)))
+			b.ReportAllocs()
+			b.RunParallel(func(pb *testing.PB) {
+				st := newCorpusState()
+				for i := 0; pb.Next(); i++ {
+					if err := op.run(st, &vectors[i%len(vectors)]); err != nil {
+						b.Error(err)
+						return
+					}
+				}
+			})
+		})
+	}
+}
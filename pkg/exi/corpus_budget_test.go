@@ -0,0 +1,142 @@
+package exi_test
+
+import (
+	"bufio"
+	"os"
+	"path/filepath"
+	"strconv"
+	"strings"
+	"testing"
+)
+
+// corpusBaseline is the checked-in output of the Decode, DecodeInto and
+// Encode corpus benchmarks, in the format benchstat reads. Regenerate it with
+//
+//	go test ./pkg/exi -run '^$' -bench '^BenchmarkCorpus$/./^(Decode|DecodeInto|Encode)$' \
+//		-benchmem -benchtime 200ms -count 5 > pkg/exi/testdata/corpus_baseline.txt
+//
+// and compare a change against it with
+//
+//	go test ./pkg/exi -run '^$' -bench '^BenchmarkCorpus$/./^(Decode|DecodeInto|Encode)$' \
+//		-benchmem -benchtime 200ms -count 5 > new.txt
+//	benchstat pkg/exi/testdata/corpus_baseline.txt new.txt
+const corpusBaseline = "testdata/corpus_baseline.txt"
+
+// allocBudget is the most allocations one Decode (aliasing, into an Arena),
+// one DecodeInto a reused message and one Encode (EncodeInto a caller
+// buffer) of a test vector may make, as measured by BenchmarkCorpus. The
+// one allocation of a Decode is the returned message, which DecodeInto
+// saves; the rest are its optional parts. Lower a budget when a change
+// saves allocations; raising one needs a reason in the commit.
+var allocBudget = map[string]struct{ Decode, DecodeInto, Encode float64 }{
+	"AuthorizationReq":           {1, 0, 0},
+	"AuthorizationRes":           {1, 0, 0},
+	"AuthorizationSetupReq":      {1, 0, 0},
+	"AuthorizationSetupRes":      {1, 0, 0},
+	"CLReqControlMode":           {1, 0, 0},
+	"CLResControlMode":           {1, 0, 0},
+	"CertificateInstallationReq": {3, 2, 0},
+	"CertificateInstallationRes": {3, 2, 0},
+	"MeteringConfirmationReq":    {1, 0, 0},
+	"MeteringConfirmationRes":    {1, 0, 0},
+	"PowerDeliveryReq":           {2, 1, 0},
+	"PowerDeliveryRes":           {1, 0, 0},
+	"ScheduleExchangeReq":        {1, 0, 0},
+	"ScheduleExchangeRes":        {1, 0, 0},
+	"ServiceDetailReq":           {1, 0, 0},
+	"ServiceDetailRes":           {2, 1, 0},
+	"ServiceDiscoveryReq":        {1, 0, 0},
+	"ServiceDiscoveryRes":        {3, 2, 0},
+	"ServiceSelectionReq":        {2, 1, 0},
+	"ServiceSelectionRes":        {1, 0, 0},
+	"SessionSetupReq":            {1, 0, 0},
+	"SessionSetupRes":            {1, 0, 0},
+	"SessionStopReq":             {1, 0, 0},
+	"SessionStopRes":             {1, 0, 0},
+	"VehicleCheckInReq":          {4, 3, 0},
+	"VehicleCheckInRes":          {3, 2, 0},
+	"VehicleCheckOutReq":         {2, 1, 0},
+	"VehicleCheckOutRes":         {1, 0, 0},
+}
+
+// TestCorpusAllocBudget fails when decoding or encoding a test vector
+// allocates more than its budget, or when a vector has no budget or is
+// missing from the baseline.
+func TestCorpusAllocBudget(t *testing.T) {
+	vectors := loadCorpusVectors(t)
+	baseline := readCorpusBaseline(t)
+	for i := range vectors {
+		v := &vectors[i]
+		budget, ok := allocBudget[v.name]
+		if !ok {
+			t.Errorf("%s: no allocation budget declared", v.name)
+			continue
+		}
+		for _, op := range corpusOps {
+			var limit float64
+			switch op.name {
+			case "Decode":
+				limit = budget.Decode
+			case "DecodeInto":
+				limit = budget.DecodeInto
+			case "Encode":
+				limit = budget.Encode
+			default:
+				continue
+			}
+			recorded, ok := baseline[v.name+"/"+op.name]
+			if !ok {
+				t.Errorf("%s/%s: missing from %s; regenerate it", v.name, op.name, corpusBaseline)
+			}
+			st := newCorpusState()
+			op.run(st, v) // grow the scratch state first
+			got := testing.AllocsPerRun(100, func() {
+				if err := op.run(st, v); err != nil {
+					t.Fatal(err)
+				}
+			})
+			if got > limit {
+				t.Errorf("%s/%s: %.0f allocs/op, budget %.0f", v.name, op.name, got, limit)
+			} else if ok && got != recorded {
+				t.Logf("%s/%s: %.0f allocs/op, baseline %.0f", v.name, op.name, got, recorded)
+			}
+		}
+	}
+}
+
+// readCorpusBaseline returns the allocs/op of every benchmark in the
+// baseline, by "<message>/<op>".
+func readCorpusBaseline(t *testing.T) map[string]float64 {
+	f, err := os.Open(filepath.FromSlash(corpusBaseline))
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer f.Close()
+	allocs := map[string]float64{}
+	sc := bufio.NewScanner(f)
+	for sc.Scan() {
+		fields := strings.Fields(sc.Text())
+		if len(fields) < 4 || !strings.HasPrefix(fields[0], "BenchmarkCorpus/") {
+			continue
+		}
+		name := strings.TrimPrefix(fields[0], "BenchmarkCorpus/")
+		if i := strings.LastIndexByte(name, '-'); i >= 0 {
+			if _, err := strconv.Atoi(name[i+1:]); err == nil {
+				name = name[:i] // GOMAXPROCS suffix
+			}
+		}
+		for i := 3; i < len(fields); i++ {
+			if fields[i] == "allocs/op" {
+				n, err := strconv.ParseFloat(fields[i-1], 64)
+				if err != nil {
+					t.Fatalf("%s: %v", corpusBaseline, err)
+				}
+				allocs[name] = n
+			}
+		}
+	}
+	if err := sc.Err(); err != nil {
+		t.Fatal(err)
+	}
+	return allocs
+}
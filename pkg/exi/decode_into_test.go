@@ -0,0 +1,145 @@
+package exi
+
+import (
+	"errors"
+	"os"
+	"path/filepath"
+	"reflect"
+	"testing"
+
+	"example.com/exi-go/pkg/v2g/generated"
+)
+
+// TestMessageNames checks that every registered message type implements
+// generated.Message with its registry name.
+func TestMessageNames(t *testing.T) {
+	for code := 0; code < 1<<messageCodeBits; code++ {
+		m := Message(code)
+		if m == nil {
+			continue
+		}
+		msg, ok := m.New().(generated.Message)
+		if !ok {
+			t.Errorf("%s does not implement generated.Message", m.Name)
+		} else if msg.MessageName() != m.Name {
+			t.Errorf("%s: MessageName() = %q", m.Name, msg.MessageName())
+		}
+	}
+}
+
+func TestDecodeIntoGoldenVectors(t *testing.T) {
+	files, err := filepath.Glob(filepath.Join("..", "..", "testvectors", "*.exi"))
+	if err != nil || len(files) == 0 {
+		t.Fatalf("no test vectors: %v", err)
+	}
+	for _, f := range files {
+		data, err := os.ReadFile(f)
+		if err != nil {
+			t.Fatal(err)
+		}
+		name := filepath.Base(f)
+		want, err := DecodeStruct(data, nil)
+		if err != nil {
+			continue
+		}
+		dst := MessageOf(want).New().(generated.Message)
+		// The second decode refills what the first left in dst.
+		for i := 0; i < 2; i++ {
+			if err := DecodeInto(data, dst); err != nil {
+				t.Fatalf("%s: DecodeInto: %v", name, err)
+			}
+			if !reflect.DeepEqual(dst, want) {
+				t.Errorf("%s: DecodeInto #%d = %+v, want %+v", name, i+1, dst, want)
+			}
+		}
+	}
+}
+
+// TestDecodeIntoReusesLists checks that DecodeInto refills the lists of dst
+// within their capacity and leaves nothing of the earlier message behind.
+func TestDecodeIntoReusesLists(t *testing.T) {
+	encode := func(v interface{}) []byte {
+		data, err := EncodeStruct(v)
+		if err != nil {
+			t.Fatal(err)
+		}
+		return data
+	}
+	large, small := encode(certificateInstallationResWithChain(4)), encode(certificateInstallationResWithChain(2))
+
+	var dst generated.CertificateInstallationRes
+	if err := DecodeInto(large, &dst); err != nil {
+		t.Fatal(err)
+	}
+	certs := dst.CPSCertificateChain.Certificates
+	if err := DecodeInto(small, &dst); err != nil {
+		t.Fatal(err)
+	}
+	if got := dst.CPSCertificateChain.Certificates; &got[0] != &certs[0] {
+		t.Error("CPSCertificateChain was not refilled in place")
+	}
+	if certs[2] != nil || certs[3] != nil {
+		t.Error("entries past the new length were not cleared")
+	}
+	want, err := DecodeStruct(small, nil)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !reflect.DeepEqual(&dst, want) {
+		t.Errorf("DecodeInto = %+v, want %+v", &dst, want)
+	}
+
+	// A longer list than dst holds is allocated anew.
+	if err := DecodeInto(large, &dst); err != nil {
+		t.Fatal(err)
+	}
+	if n := len(dst.CPSCertificateChain.Certificates); n != 4 {
+		t.Errorf("%d certificates, want 4", n)
+	}
+
+	// With an Arena, lists come from the arena and are never refilled.
+	d := NewDecoder()
+	d.Options.Arena = NewArena(0)
+	fresh := dst.CPSCertificateChain.Certificates
+	if err := d.DecodeInto(small, &dst); err != nil {
+		t.Fatal(err)
+	}
+	if &dst.CPSCertificateChain.Certificates[0] == &fresh[0] {
+		t.Error("a list was refilled in place with an Arena")
+	}
+}
+
+func TestDecodeIntoMessageType(t *testing.T) {
+	data, err := os.ReadFile(filepath.Join("..", "..", "testvectors", "SessionStopReq.exi"))
+	if err != nil {
+		t.Fatal(err)
+	}
+	if err := DecodeInto(data, &generated.SessionStopRes{}); !errors.Is(err, ErrMessageType) {
+		t.Errorf("DecodeInto(SessionStopRes) err = %v, want ErrMessageType", err)
+	}
+	if err := DecodeInto(data, (*generated.SessionStopReq)(nil)); err == nil {
+		t.Error("DecodeInto(nil) succeeded")
+	}
+}
+
+// TestDecodeIntoAllocs checks that a Decoder with an Arena decodes a
+// control-loop message into the same struct without allocating, where Decode
+// allocates the message.
+func TestDecodeIntoAllocs(t *testing.T) {
+	data, err := os.ReadFile(filepath.Join("..", "..", "testvectors", "CLReqControlMode.exi"))
+	if err != nil {
+		t.Fatal(err)
+	}
+	d := NewDecoder()
+	d.Options.Arena = NewArena(0)
+	var dst generated.CLReqControlMode
+	allocs := testing.AllocsPerRun(100, func() {
+		d.Options.Arena.Reset()
+		if err := d.DecodeInto(data, &dst); err != nil {
+			t.Fatal(err)
+		}
+	})
+	if allocs != 0 {
+		t.Errorf("%.0f allocs/op, want 0", allocs)
+	}
+}
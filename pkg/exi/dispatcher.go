@@ -1,224 +1,216 @@
 package exi
 
 import (
+	"errors"
 	"fmt"
+	"sync"
 
 	"example.com/exi-go/pkg/v2g/generated"
 )
 
 // EncodeStruct encodes any supported ISO 15118-20 message struct to EXI bytes.
 // This is a standalone function suitable for CGO bindings and external use.
+// It allocates a fresh result on every call; use an Encoder to reuse buffers.
+// The result is allocated once, at the exact size EncodedSize reports, so a
+// 20-byte message costs 20 bytes and a certificate chain never overflows.
 func EncodeStruct(v interface{}) ([]byte, error) {
-	buf := make([]byte, defaultEncodeBufferSize)
-	bs := &BitStream{}
-	bs.Init(buf, 0)
+	e := acquireEncoder()
+	out, err := e.EncodeTo(nil, v)
+	releaseEncoder(e)
+	if err != nil {
+		return nil, err
+	}
+	return out, nil
+}
 
-	switch val := v.(type) {
-	// Session management messages
-	case *generated.SessionSetupReq:
-		if err := EncodeTopLevelSessionSetupReq(bs, val); err != nil {
-			return nil, err
-		}
-	case *generated.SessionSetupRes:
-		if err := EncodeTopLevelSessionSetupRes(bs, val); err != nil {
-			return nil, err
-		}
-	case *generated.SessionStopReq:
-		if err := EncodeTopLevelSessionStopReq(bs, val); err != nil {
-			return nil, err
-		}
-	case *generated.SessionStopRes:
-		if err := EncodeTopLevelSessionStopRes(bs, val); err != nil {
-			return nil, err
-		}
+// EncodedSize returns the exact length in bytes of the EXI encoding of v,
+// computed from the grammar without writing anything. Use an Encoder's
+// EncodedSize to avoid allocating the encoding state.
+func EncodedSize(v interface{}) (int, error) {
+	e := acquireEncoder()
+	n, err := e.EncodedSize(v)
+	releaseEncoder(e)
+	return n, err
+}
 
-	// Service discovery and selection messages
-	case *generated.ServiceDiscoveryReq:
-		if err := EncodeTopLevelServiceDiscoveryReq(bs, val); err != nil {
-			return nil, err
-		}
-	case *generated.ServiceDiscoveryRes:
-		if err := EncodeTopLevelServiceDiscoveryRes(bs, val); err != nil {
-			return nil, err
-		}
-	case *generated.ServiceDetailReq:
-		if err := EncodeTopLevelServiceDetailReq(bs, val); err != nil {
-			return nil, err
-		}
-	case *generated.ServiceDetailRes:
-		if err := EncodeTopLevelServiceDetailRes(bs, val); err != nil {
-			return nil, err
-		}
-	case *generated.ServiceSelectionReq:
-		if err := EncodeTopLevelServiceSelectionReq(bs, val); err != nil {
-			return nil, err
-		}
-	case *generated.ServiceSelectionRes:
-		if err := EncodeTopLevelServiceSelectionRes(bs, val); err != nil {
-			return nil, err
-		}
+// The package-level entry points borrow their Encoder or Decoder from a
+// pool rather than declaring one per call, so that the stream state the
+// statistics keep (the shard a stream counts in and its sampling tick)
+// lives as long as the pooled value and stays mostly per-P.
+var (
+	encoderPool = sync.Pool{New: func() interface{} { return new(Encoder) }}
+	decoderPool = sync.Pool{New: func() interface{} { return new(Decoder) }}
+)
 
-	// Authorization messages
-	case *generated.AuthorizationReq:
-		if err := EncodeTopLevelAuthorizationReq(bs, val); err != nil {
-			return nil, err
-		}
-	case *generated.AuthorizationRes:
-		if err := EncodeTopLevelAuthorizationRes(bs, val); err != nil {
-			return nil, err
-		}
-	case *generated.AuthorizationSetupReq:
-		if err := EncodeTopLevelAuthorizationSetupReq(bs, val); err != nil {
-			return nil, err
-		}
-	case *generated.AuthorizationSetupRes:
-		if err := EncodeTopLevelAuthorizationSetupRes(bs, val); err != nil {
-			return nil, err
-		}
+func acquireEncoder() *Encoder {
+	return encoderPool.Get().(*Encoder)
+}
 
-	// Power delivery messages
-	case *generated.PowerDeliveryReq:
-		if err := EncodeTopLevelPowerDeliveryReq(bs, val); err != nil {
-			return nil, err
-		}
-	case *generated.PowerDeliveryRes:
-		if err := EncodeTopLevelPowerDeliveryRes(bs, val); err != nil {
-			return nil, err
-		}
+// releaseEncoder returns e to the pool without keeping the caller's
+// output alive.
+func releaseEncoder(e *Encoder) {
+	e.bs.Init(nil, 0)
+	encoderPool.Put(e)
+}
 
-	// Schedule exchange messages
-	case *generated.ScheduleExchangeReq:
-		if err := EncodeTopLevelScheduleExchangeReq(bs, val); err != nil {
-			return nil, err
-		}
-	case *generated.ScheduleExchangeRes:
-		if err := EncodeTopLevelScheduleExchangeRes(bs, val); err != nil {
-			return nil, err
-		}
+func acquireDecoder(opts DecodeOptions) *Decoder {
+	d := decoderPool.Get().(*Decoder)
+	d.Options = opts
+	return d
+}
 
-	// Metering confirmation messages
-	case *generated.MeteringConfirmationReq:
-		if err := EncodeTopLevelMeteringConfirmationReq(bs, val); err != nil {
-			return nil, err
-		}
-	case *generated.MeteringConfirmationRes:
-		if err := EncodeTopLevelMeteringConfirmationRes(bs, val); err != nil {
-			return nil, err
-		}
+// releaseDecoder returns d to the pool without keeping the input, arena
+// or string table of the call alive.
+func releaseDecoder(d *Decoder) {
+	d.bs.Init(nil, 0)
+	d.Options = DecodeOptions{}
+	decoderPool.Put(d)
+}
 
-	// Certificate installation messages
-	case *generated.CertificateInstallationReq:
-		if err := EncodeTopLevelCertificateInstallationReq(bs, val); err != nil {
-			return nil, err
-		}
-	case *generated.CertificateInstallationRes:
-		if err := EncodeTopLevelCertificateInstallationRes(bs, val); err != nil {
-			return nil, err
-		}
+// encodeTopLevel writes the complete EXI document (header, event code and
+// body) for v into bs.
+func encodeTopLevel(bs *BitStream, v interface{}) error {
+	if code, ok := messageCode(v); ok {
+		if codecStats.enabled.Load() && !bs.counting {
+			return encodeCounted(bs, code, v)
+		}
+		return messages[code].encode(bs, v)
+	}
+	// Certificate update messages (from original implementation) have no
+	// document event code and are written without a header.
+	switch val := v.(type) {
+	case *generated.CertificateUpdateReq:
+		return EncodeCertificateUpdateReq(bs, val)
+	case *generated.CertificateUpdateRes:
+		return EncodeCertificateUpdateRes(bs, val)
+	}
+	return fmt.Errorf("EncodeStruct: unsupported type %T", v)
+}
 
-	// Vehicle check in/out messages
-	case *generated.VehicleCheckInReq:
-		if err := EncodeTopLevelVehicleCheckInReq(bs, val); err != nil {
-			return nil, err
-		}
-	case *generated.VehicleCheckInRes:
-		if err := EncodeTopLevelVehicleCheckInRes(bs, val); err != nil {
-			return nil, err
-		}
-	case *generated.VehicleCheckOutReq:
-		if err := EncodeTopLevelVehicleCheckOutReq(bs, val); err != nil {
-			return nil, err
-		}
-	case *generated.VehicleCheckOutRes:
-		if err := EncodeTopLevelVehicleCheckOutRes(bs, val); err != nil {
-			return nil, err
-		}
+// DecodeStruct decodes EXI bytes into the appropriate message struct type.
+// The prototypeMsg parameter is used to determine the target type - pass an
+// empty instance of the desired type (e.g., &generated.SessionSetupReq{}).
+func DecodeStruct(data []byte, prototypeMsg interface{}) (interface{}, error) {
+	return DecodeStructWithOptions(data, prototypeMsg, DecodeOptions{})
+}
 
-	// Control loop messages
-	case *generated.CLReqControlMode:
-		if err := EncodeTopLevelCLReqControlMode(bs, val); err != nil {
-			return nil, err
-		}
-	case *generated.CLResControlMode:
-		if err := EncodeTopLevelCLResControlMode(bs, val); err != nil {
-			return nil, err
-		}
+// DecodeOptions controls optional decoder behaviour.
+type DecodeOptions struct {
+	// AliasInput makes byte-aligned binary fields of the decoded message
+	// (SessionID, EVCCID, certificates, ...) sub-slices of the input data
+	// instead of copies. Fields that are not byte-aligned in the stream are
+	// still copied, so callers must not rely on either outcome.
+	//
+	// The caller must keep data alive and unmodified for as long as the
+	// decoded message is used, and must treat aliased fields as read-only:
+	// writing to them writes to data. Appending to an aliased field never
+	// overwrites data, because its capacity ends at the field.
+	AliasInput bool
 
-	// Certificate update messages (from original implementation)
-	case *generated.CertificateUpdateReq:
-		if err := EncodeCertificateUpdateReq(bs, val); err != nil {
-			return nil, err
-		}
-	case *generated.CertificateUpdateRes:
-		if err := EncodeCertificateUpdateRes(bs, val); err != nil {
-			return nil, err
-		}
+	// SkipBinary leaves the binary and string fields of the message body
+	// empty: their length prefixes are read and the content is passed over
+	// without being copied. The Header (SessionID, TimeStamp), enumerations
+	// and numeric fields are still decoded, so routing on them costs about
+	// the same for a message with kilobytes of certificates as for an empty
+	// one. The result is not a faithful copy of the message; do not
+	// re-encode it.
+	SkipBinary bool
 
-	// WPT (Wireless Power Transfer) messages
-	case *generated.WPT_AlignmentCheckReq:
-		if err := EncodeTopLevelWPT_AlignmentCheckReq(bs, val); err != nil {
-			return nil, err
-		}
-	case *generated.WPT_AlignmentCheckRes:
-		if err := EncodeTopLevelWPT_AlignmentCheckRes(bs, val); err != nil {
-			return nil, err
-		}
-	case *generated.WPT_FinePositioningReq:
-		if err := EncodeTopLevelWPT_FinePositioningReq(bs, val); err != nil {
-			return nil, err
-		}
-	case *generated.WPT_FinePositioningRes:
-		if err := EncodeTopLevelWPT_FinePositioningRes(bs, val); err != nil {
-			return nil, err
-		}
-	case *generated.WPT_ChargeLoopReq:
-		if err := EncodeTopLevelWPT_ChargeLoopReq(bs, val); err != nil {
-			return nil, err
-		}
-	case *generated.WPT_ChargeLoopRes:
-		if err := EncodeTopLevelWPT_ChargeLoopRes(bs, val); err != nil {
-			return nil, err
-		}
+	// Arena, if set, holds the binary content and list arrays of decoded
+	// messages instead of individual heap objects. The messages are only
+	// valid until Arena.Reset; see Arena.
+	Arena *Arena
 
-	// ACDP (AC Dynamic Power) messages
-	case *generated.DC_ACDPReq:
-		if err := EncodeTopLevelDC_ACDPReq(bs, val); err != nil {
-			return nil, err
-		}
-	case *generated.DC_ACDPRes:
-		if err := EncodeTopLevelDC_ACDPRes(bs, val); err != nil {
-			return nil, err
-		}
-	case *generated.DC_ACDP_BPTReq:
-		if err := EncodeTopLevelDC_ACDP_BPTReq(bs, val); err != nil {
-			return nil, err
-		}
-	case *generated.DC_ACDP_BPTRes:
-		if err := EncodeTopLevelDC_ACDP_BPTRes(bs, val); err != nil {
-			return nil, err
-		}
+	// Strings, if set, resolves string-table hits in the decoded stream
+	// (see StringTable); without it a hit fails with ErrStringTableHit. It
+	// must have the capacity and maxLength the encoder used, and is reset
+	// for every message.
+	Strings *StringTable
 
-	default:
-		return nil, fmt.Errorf("EncodeStruct: unsupported type %T", v)
-	}
+	// MaxRepetitions, if > 0, bounds the number of list entries a message
+	// may declare, summed over all of its lists; a message that declares
+	// more fails with ErrRepetitionLimit before the entries are decoded.
+	// Whatever the setting, a list that declares more entries than there
+	// are bits left in the input fails with ErrBitstreamOverflow.
+	MaxRepetitions int
+}
+
+// apply configures bs for o; call it after bs.Init.
+func (o DecodeOptions) apply(bs *BitStream) {
+	bs.aliasInput = o.AliasInput
+	bs.skipOctets = o.SkipBinary
+	bs.UseStringTable(o.Strings)
+	bs.arena = o.Arena
+	bs.maxRepeats = o.MaxRepetitions
+}
 
-	// Return written bytes
-	outLen := bs.Length()
-	if outLen > len(buf) {
-		outLen = len(buf)
+// DecodeStructWithOptions is DecodeStruct with explicit DecodeOptions.
+func DecodeStructWithOptions(data []byte, prototypeMsg interface{}, opts DecodeOptions) (interface{}, error) {
+	d := acquireDecoder(opts)
+	msg, err := d.Decode(data)
+	releaseDecoder(d)
+	return msg, err
+}
+
+// ErrMessageType is returned (wrapped) by DecodeInto when the document holds
+// a message of another type than dst.
+var ErrMessageType = errors.New("exi: document holds another message type")
+
+// DecodeInto decodes the EXI document data into dst, which is reset and
+// refilled: every field is overwritten, and the lists of dst (certificate
+// chains, service lists, power profile entries, parameter sets) are refilled
+// in place when they have the capacity, so decoding every message of a
+// session into the same value allocates only what no earlier message needed.
+// The previous contents of dst, including those lists, must not be used
+// afterwards. If the document holds another message type, DecodeInto fails
+// with ErrMessageType; on any error dst holds unspecified contents.
+//
+// Unlike DecodeStruct, DecodeInto returns no interface{}, so decoding a
+// message without optional parts or content to copy allocates nothing.
+// Binary content is copied as with DecodeStruct; use a Decoder for
+// DecodeOptions such as AliasInput.
+func DecodeInto(data []byte, dst generated.Message) error {
+	d := acquireDecoder(DecodeOptions{})
+	err := d.DecodeInto(data, dst)
+	releaseDecoder(d)
+	return err
+}
+
+// decodeTopLevelInto is decodeTopLevel decoding into dst.
+func decodeTopLevelInto(bs *BitStream, dst generated.Message) error {
+	code, ok := messageCode(dst)
+	if !ok {
+		return fmt.Errorf("DecodeInto: unsupported type %T", dst)
 	}
-	out := make([]byte, outLen)
-	copy(out, buf[:outLen])
-	return out, nil
+	m, err := decodeDocumentStart(bs)
+	if err != nil {
+		return err
+	}
+	if m.Code != code {
+		return fmt.Errorf("DecodeInto: %w: %s, not %s", ErrMessageType, m.Name, messages[code].Name)
+	}
+	if codecStats.enabled.Load() {
+		return decodeCountedInto(bs, m, dst)
+	}
+	return m.decodeInto(bs, dst)
 }
 
-// DecodeStruct decodes EXI bytes into the appropriate message struct type.
-// The prototypeMsg parameter is used to determine the target type - pass an
-// empty instance of the desired type (e.g., &generated.SessionSetupReq{}).
-func DecodeStruct(data []byte, prototypeMsg interface{}) (interface{}, error) {
-	bs := &BitStream{}
-	bs.Init(data, 0)
+// decodeTopLevel reads a complete EXI document (header, event code and body)
+// from bs and returns the decoded message.
+func decodeTopLevel(bs *BitStream) (interface{}, error) {
+	m, err := decodeDocumentStart(bs)
+	if err != nil {
+		return nil, err
+	}
+	if codecStats.enabled.Load() {
+		return decodeCounted(bs, m)
+	}
+	return m.decode(bs)
+}
 
+// decodeDocumentStart reads the EXI header and the event code of the root
+// element and returns the message it selects.
+func decodeDocumentStart(bs *BitStream) (*MessageInfo, error) {
 	// Decode EXI header (8 bits)
 	exiHeader, err := bs.ReadBits(8)
 	if err != nil {
@@ -229,97 +221,76 @@ func DecodeStruct(data []byte, prototypeMsg interface{}) (interface{}, error) {
 	}
 
 	// Decode event code (6 bits) to determine message type
-	eventCode, err := bs.ReadBits(6)
+	eventCode, err := bs.ReadBits(messageCodeBits)
 	if err != nil {
 		return nil, fmt.Errorf("DecodeStruct: failed to read event code: %w", err)
 	}
+	if eventCode == legacyVehicleCheckOutResCode {
+		eventCode = 52 // VehicleCheckOutRes
+	}
+	m := &messages[eventCode]
+	if m.decode == nil {
+		return nil, fmt.Errorf("DecodeStruct: unsupported event code %d", eventCode)
+	}
+	return m, nil
+}
 
-	// Decode based on event code (the event codes match the ISO 15118-20 spec)
-	switch eventCode {
-	case 0: // AuthorizationReq
-		return DecodeAuthorizationReq(bs)
-	case 1: // AuthorizationRes
-		return DecodeAuthorizationRes(bs)
-	case 2: // AuthorizationSetupReq
-		return DecodeAuthorizationSetupReq(bs)
-	case 3: // AuthorizationSetupRes
-		return DecodeAuthorizationSetupRes(bs)
-	case 4: // CLReqControlMode
-		return DecodeCLReqControlMode(bs)
-	case 5: // CLResControlMode
-		return DecodeCLResControlMode(bs)
-	case 7: // CertificateInstallationReq
-		return DecodeCertificateInstallationReq(bs)
-	case 8: // CertificateInstallationRes
-		return DecodeCertificateInstallationRes(bs)
-	case 16: // MeteringConfirmationReq
-		return DecodeMeteringConfirmationReq(bs)
-	case 17: // MeteringConfirmationRes
-		return DecodeMeteringConfirmationRes(bs)
-	case 21: // PowerDeliveryReq
-		return DecodePowerDeliveryReq(bs)
-	case 22: // PowerDeliveryRes
-		return DecodePowerDeliveryRes(bs)
-	case 27: // ScheduleExchangeReq
-		return DecodeScheduleExchangeReq(bs)
-	case 28: // ScheduleExchangeRes
-		return DecodeScheduleExchangeRes(bs)
-	case 29: // ServiceDetailReq
-		return DecodeServiceDetailReq(bs)
-	case 30: // ServiceDetailRes
-		return DecodeServiceDetailRes(bs)
-	case 31: // ServiceDiscoveryReq
-		return DecodeServiceDiscoveryReq(bs)
-	case 32: // ServiceDiscoveryRes
-		return DecodeServiceDiscoveryRes(bs)
-	case 33: // ServiceSelectionReq
-		return DecodeServiceSelectionReq(bs)
-	case 34: // ServiceSelectionRes
-		return DecodeServiceSelectionRes(bs)
-	case 35: // SessionSetupReq
-		return DecodeSessionSetupReq(bs)
-	case 36: // SessionSetupRes
-		return DecodeSessionSetupRes(bs)
-	case 37: // SessionStopReq
-		return DecodeSessionStopReq(bs)
-	case 38: // SessionStopRes
-		return DecodeSessionStopRes(bs)
-	case 50: // VehicleCheckInRes
-		return DecodeVehicleCheckInRes(bs)
-	case 45: // VehicleCheckOutRes (legacy code, should be 52)
-		return DecodeVehicleCheckOutRes(bs)
-	case 49: // VehicleCheckInReq
-		return DecodeVehicleCheckInReq(bs)
-	case 51: // VehicleCheckOutReq
-		return DecodeVehicleCheckOutReq(bs)
-	case 52: // VehicleCheckOutRes
-		return DecodeVehicleCheckOutRes(bs)
-
-	// WPT (Wireless Power Transfer) messages
-	case 53: // WPT_AlignmentCheckReq
-		return DecodeWPT_AlignmentCheckReq(bs)
-	case 54: // WPT_AlignmentCheckRes
-		return DecodeWPT_AlignmentCheckRes(bs)
-	case 55: // WPT_FinePositioningReq
-		return DecodeWPT_FinePositioningReq(bs)
-	case 56: // WPT_FinePositioningRes
-		return DecodeWPT_FinePositioningRes(bs)
-	case 57: // WPT_ChargeLoopReq
-		return DecodeWPT_ChargeLoopReq(bs)
-	case 58: // WPT_ChargeLoopRes
-		return DecodeWPT_ChargeLoopRes(bs)
+// PeekMessageHeader decodes only the event code and the MessageHeaderType
+// that every ISO 15118-20 message starts with, and stops there: its cost
+// does not depend on the size of the body. It is meant for routing (by
+// SessionID) before, or instead of, a full decode. The SessionID is copied
+// unless it happens to be byte-aligned, in which case it aliases data as
+// with DecodeOptions.AliasInput.
+func PeekMessageHeader(data []byte) (*MessageInfo, generated.MessageHeaderType, error) {
+	var h generated.MessageHeaderType
+	var bs BitStream
+	m, err := startMessageHeader(&bs, data)
+	if err != nil {
+		return nil, h, err
+	}
+	bs.aliasInput = true
+	if err := decodeMessageHeaderInto(&bs, &h); err != nil {
+		return nil, h, fmt.Errorf("PeekMessageHeader: %s header: %w", m.Name, err)
+	}
+	return m, h, nil
+}
 
-	// ACDP (AC Dynamic Power) messages
-	case 59: // DC_ACDPReq
-		return DecodeDC_ACDPReq(bs)
-	case 60: // DC_ACDPRes
-		return DecodeDC_ACDPRes(bs)
-	case 61: // DC_ACDP_BPTReq
-		return DecodeDC_ACDP_BPTReq(bs)
-	case 62: // DC_ACDP_BPTRes
-		return DecodeDC_ACDP_BPTRes(bs)
+// peekSessionID is PeekMessageHeader for the SessionID alone: it passes the
+// octets of the ID to visit as they are read, so nothing is copied even
+// when the ID is not byte-aligned, and stops after the last one.
+func peekSessionID(data []byte, visit func(b byte)) error {
+	var bs BitStream
+	if _, err := startMessageHeader(&bs, data); err != nil {
+		return err
+	}
+	n, err := readSessionIDLength(&bs)
+	if err != nil {
+		return err
+	}
+	if n > len(data) {
+		return ErrBitstreamOverflow
+	}
+	for i := 0; i < n; i++ {
+		b, err := bs.ReadBits(8)
+		if err != nil {
+			return err
+		}
+		visit(byte(b))
+	}
+	return nil
+}
 
-	default:
-		return nil, fmt.Errorf("DecodeStruct: unsupported event code %d", eventCode)
+// startMessageHeader initializes bs on data and reads the document up to
+// the MessageHeaderType every message starts with.
+func startMessageHeader(bs *BitStream, data []byte) (*MessageInfo, error) {
+	bs.Init(data, 0)
+	m, err := decodeDocumentStart(bs)
+	if err != nil {
+		return nil, err
+	}
+	// START Header (1 bit): the first production of every message.
+	if _, err := bs.ReadBits(1); err != nil {
+		return nil, err
 	}
+	return m, nil
 }
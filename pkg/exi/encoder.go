@@ -56,16 +56,12 @@ import (
 //   bs.WriteOctet(value byte)
 //   bs.ReadBits(bitCount int) (uint32, error)
 //   bs.ReadOctet() (byte, error)
+//   bs.WriteOctets(p []byte) / bs.ReadOctets(p []byte)  (bulk, copy() when aligned)
 //   bs.Length() int
 //
 // The Codec methods below provide convenient wrappers to encode/decode the
 // generated types using a BitStream-backed buffer.
 
-const (
-	// recommended initial buffer size for encoded payloads
-	defaultEncodeBufferSize = 4096
-)
-
 // --- low-level helpers -----------------------------------------------------
 
 // writeUint16 writes a 16-bit unsigned integer as an EXI octet-sequence (variable-length)
@@ -93,12 +89,7 @@ func writeBytes(bs *BitStream, data []byte) error {
 	if err := writeUint16(bs, uint16(len(data))); err != nil {
 		return err
 	}
-	for _, b := range data {
-		if err := bs.WriteOctet(b); err != nil {
-			return err
-		}
-	}
-	return nil
+	return bs.WriteOctets(data)
 }
 
 // readBytes reads a length-prefixed byte slice.
@@ -110,15 +101,7 @@ func readBytes(bs *BitStream) ([]byte, error) {
 	if n == 0 {
 		return nil, nil
 	}
-	out := make([]byte, int(n))
-	for i := 0; i < int(n); i++ {
-		b, err := bs.ReadOctet()
-		if err != nil {
-			return nil, err
-		}
-		out[i] = b
-	}
-	return out, nil
+	return bs.readOctetSlice(int(n))
 }
 
 // writeString writes a length-prefixed string (UTF-8 bytes).
@@ -153,14 +136,14 @@ func writeStringArray(bs *BitStream, arr []string) error {
 
 // readStringArray reads an array of strings encoded by writeStringArray.
 func readStringArray(bs *BitStream) ([]string, error) {
-	cnt, err := readUint16(bs)
+	cnt, err := readListCount(bs)
 	if err != nil {
 		return nil, err
 	}
 	if cnt == 0 {
 		return nil, nil
 	}
-	out := make([]string, int(cnt))
+	out := bs.arena.stringList(int(cnt))
 	for i := 0; i < int(cnt); i++ {
 		s, err := readString(bs)
 		if err != nil {
@@ -189,14 +172,14 @@ func writeBinaryArray(bs *BitStream, arr [][]byte) error {
 
 // readBinaryArray reads a 16-bit count followed by that many length-prefixed byte slices.
 func readBinaryArray(bs *BitStream) ([][]byte, error) {
-	cnt, err := readUint16(bs)
+	cnt, err := readListCount(bs)
 	if err != nil {
 		return nil, err
 	}
 	if cnt == 0 {
 		return nil, nil
 	}
-	out := make([][]byte, int(cnt))
+	out := bs.arena.binaryList(int(cnt))
 	for i := 0; i < int(cnt); i++ {
 		b, err := readBytes(bs)
 		if err != nil {
@@ -211,15 +194,7 @@ func readBinaryArray(bs *BitStream) ([][]byte, error) {
 
 // writeRawBytes writes bytes without a length prefix.
 func writeRawBytes(bs *BitStream, data []byte) error {
-	if data == nil {
-		return nil
-	}
-	for _, b := range data {
-		if err := bs.WriteOctet(b); err != nil {
-			return err
-		}
-	}
-	return nil
+	return bs.WriteOctets(data)
 }
 
 // encodeMessageHeaderType encodes a MessageHeaderType following the C implementation.
@@ -237,109 +212,131 @@ func writeRawBytes(bs *BitStream, data []byte) error {
 //	END TimeStamp (1 bit, value 0)
 //	Grammar ID=279: Header END or Signature (2 bits, value 1 = END, no Signature)
 func encodeMessageHeaderType(bs *BitStream, h *generated.MessageHeaderType) error {
-	// Grammar ID=277: START SessionID (1 bit, value 0)
-	if err := bs.WriteBits(1, 0); err != nil {
+	if s := bs.session; s != nil {
+		// A PreparedSession supplies the SessionID, pre-encoded.
+		if err := writeSessionBlock(bs, s); err != nil {
+			return err
+		}
+	} else if err := encodeSessionIDBlock(bs, h.SessionID); err != nil {
 		return err
 	}
-	// hexBinary encoding flag (1 bit, value 0)
-	if err := bs.WriteBits(1, 0); err != nil {
+	// TimeStamp value (unsigned-var uint64)
+	if err := bs.WriteUnsignedVar(h.TimeStamp); err != nil {
 		return err
 	}
-	// SessionID length (unsigned-var)
-	if err := writeUint16(bs, uint16(len(h.SessionID))); err != nil {
+	// END TimeStamp (1 bit, value 0)
+	if err := bs.WriteBits(1, 0); err != nil {
 		return err
 	}
-	// SessionID bytes
-	if err := writeRawBytes(bs, h.SessionID); err != nil {
+
+	// Grammar ID=279: Header END or Signature (2 bits, value 1 = END, no Signature)
+	if err := bs.WriteBits(2, 1); err != nil {
 		return err
 	}
-	// END SessionID (1 bit, value 0)
+
+	return nil
+}
+
+// encodeSessionIDBlock writes the part of a MessageHeaderType that only
+// depends on the SessionID: the SessionID element and the start of the
+// TimeStamp element, up to its value.
+func encodeSessionIDBlock(bs *BitStream, sessionID []byte) error {
+	// Grammar ID=277: START SessionID (1 bit, value 0)
 	if err := bs.WriteBits(1, 0); err != nil {
 		return err
 	}
-
-	// Grammar ID=278: START TimeStamp (1 bit, value 0)
+	// hexBinary encoding flag (1 bit, value 0)
 	if err := bs.WriteBits(1, 0); err != nil {
 		return err
 	}
-	// TimeStamp encoding flag (1 bit, value 0)
-	if err := bs.WriteBits(1, 0); err != nil {
+	// SessionID length (unsigned-var)
+	if err := writeUint16(bs, uint16(len(sessionID))); err != nil {
 		return err
 	}
-	// TimeStamp value (unsigned-var uint64)
-	if err := bs.WriteUnsignedVar(h.TimeStamp); err != nil {
+	// SessionID bytes
+	if err := writeRawBytes(bs, sessionID); err != nil {
 		return err
 	}
-	// END TimeStamp (1 bit, value 0)
+	// END SessionID (1 bit, value 0)
 	if err := bs.WriteBits(1, 0); err != nil {
 		return err
 	}
 
-	// Grammar ID=279: Header END or Signature (2 bits, value 1 = END, no Signature)
-	if err := bs.WriteBits(2, 1); err != nil {
+	// Grammar ID=278: START TimeStamp (1 bit, value 0)
+	if err := bs.WriteBits(1, 0); err != nil {
 		return err
 	}
-
-	return nil
+	// TimeStamp encoding flag (1 bit, value 0)
+	return bs.WriteBits(1, 0)
 }
 
 // decodeMessageHeaderType decodes a MessageHeaderType following the C implementation.
 // This is the common header decoding shared by all ISO 15118-20 messages.
-func decodeMessageHeaderType(bs *BitStream) (*generated.MessageHeaderType, error) {
-	// Grammar ID=277: START SessionID (1 bit, expect 0)
-	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
-	}
-	// hexBinary encoding flag (1 bit, expect 0)
-	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
-	}
-	// SessionID length (unsigned-var)
-	sidLen, err := readUint16(bs)
+func decodeMessageHeaderType(bs *BitStream) (generated.MessageHeaderType, error) {
+	var h generated.MessageHeaderType
+	err := decodeMessageHeaderInto(bs, &h)
+	return h, err
+}
+
+// decodeMessageHeaderInto is decodeMessageHeaderType decoding into h. The
+// SessionID is read even in DecodeOptions.SkipBinary mode.
+func decodeMessageHeaderInto(bs *BitStream, h *generated.MessageHeaderType) error {
+	sidLen, err := readSessionIDLength(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	// SessionID bytes
-	sid := make([]byte, sidLen)
-	for i := 0; i < int(sidLen); i++ {
-		b, err := bs.ReadOctet()
-		if err != nil {
-			return nil, err
-		}
-		sid[i] = b
+	sid, err := bs.sliceOctets(sidLen)
+	if err != nil {
+		return err
 	}
 	// END SessionID (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Grammar ID=278: START TimeStamp (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// TimeStamp encoding flag (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// TimeStamp value (unsigned-var uint64)
 	ts, err := bs.ReadUnsignedVar()
 	if err != nil {
-		return nil, err
+		return err
 	}
 	// END TimeStamp (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Grammar ID=279: Header END or Signature (2 bits, expect 1 = END)
 	if _, err := bs.ReadBits(2); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.MessageHeaderType{
-		SessionID: sid,
-		TimeStamp: ts,
-	}, nil
+	h.SessionID = sid
+	h.TimeStamp = ts
+	return nil
+}
+
+// readSessionIDLength reads a MessageHeaderType up to the octets of its
+// SessionID and returns their number.
+func readSessionIDLength(bs *BitStream) (int, error) {
+	// Grammar ID=277: START SessionID (1 bit, expect 0)
+	if _, err := bs.ReadBits(1); err != nil {
+		return 0, err
+	}
+	// hexBinary encoding flag (1 bit, expect 0)
+	if _, err := bs.ReadBits(1); err != nil {
+		return 0, err
+	}
+	// SessionID length (unsigned-var)
+	n, err := readUint16(bs)
+	return int(n), err
 }
 
 // EncodeTopLevelSessionSetupReq writes an EXI simple header and the top-level
@@ -407,13 +404,8 @@ func EncodeSessionSetupReq(bs *BitStream, v *generated.SessionSetupReq) error {
 	if err := bs.WriteBits(1, 0); err != nil {
 		return err
 	}
-	// EVCCID length (unsigned-var, +2 for string table semantics)
-	evLen := uint16(len(v.EVCCID))
-	if err := writeUint16(bs, evLen+2); err != nil {
-		return err
-	}
-	// EVCCID bytes
-	if err := writeRawBytes(bs, v.EVCCID); err != nil {
+	// EVCCID value (length+2 and bytes, or a string-table hit)
+	if err := writeStringValue(bs, "EVCCID", v.EVCCID); err != nil {
 		return err
 	}
 	// END EVCCID (1 bit, value 0)
@@ -432,54 +424,50 @@ func EncodeSessionSetupReq(bs *BitStream, v *generated.SessionSetupReq) error {
 // DecodeSessionSetupReq decodes a SessionSetupReq from BitStream matching C decoder.
 // This follows the exact grammar path from the C implementation.
 func DecodeSessionSetupReq(bs *BitStream) (*generated.SessionSetupReq, error) {
+	return decodeNew(bs, decodeSessionSetupReqInto)
+}
+
+// decodeSessionSetupReqInto is DecodeSessionSetupReq decoding into dst.
+func decodeSessionSetupReqInto(bs *BitStream, dst *generated.SessionSetupReq) error {
 	// Grammar ID=404: START Header (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Decode MessageHeaderType (Grammar ID=277-279)
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// Grammar ID=405: START EVCCID (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// String encoding flag (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
-	// EVCCID length (unsigned-var, subtract 2 for string table semantics)
-	evccidLen, err := readUint16(bs)
+	// EVCCID value (length+2 and bytes, or a string-table hit)
+	evccid, err := readStringValue(bs, "EVCCID")
 	if err != nil {
-		return nil, err
-	}
-	evccidLen -= 2 // Remove the +2 added during encoding
-	// EVCCID bytes
-	evccid := make([]byte, evccidLen)
-	for i := 0; i < int(evccidLen); i++ {
-		b, err := bs.ReadOctet()
-		if err != nil {
-			return nil, err
-		}
-		evccid[i] = b
+		return err
 	}
 	// END EVCCID (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Grammar ID=2: END SessionSetupReq (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.SessionSetupReq{
-		Header: *header,
+	*dst = generated.SessionSetupReq{
+		Header: header,
 		EVCCID: evccid,
-	}, nil
+	}
+	return nil
 }
 
 // EncodeServiceDiscoveryReq encodes ServiceDiscoveryReq matching C encoder bit-for-bit.
@@ -513,35 +501,41 @@ func EncodeServiceDiscoveryReq(bs *BitStream, v *generated.ServiceDiscoveryReq)
 // DecodeServiceDiscoveryReq decodes ServiceDiscoveryReq from BitStream matching C decoder.
 // This follows the exact grammar path from the C implementation.
 func DecodeServiceDiscoveryReq(bs *BitStream) (*generated.ServiceDiscoveryReq, error) {
+	return decodeNew(bs, decodeServiceDiscoveryReqInto)
+}
+
+// decodeServiceDiscoveryReqInto is DecodeServiceDiscoveryReq decoding into dst.
+func decodeServiceDiscoveryReqInto(bs *BitStream, dst *generated.ServiceDiscoveryReq) error {
 	// Grammar ID=422: START Header (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Decode MessageHeaderType (Grammar ID=277-279)
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// Grammar ID=423: SupportedServiceIDs or END (2 bits)
 	// For now we only handle the END case (value 1)
 	endOrSupported, err := bs.ReadBits(2)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// If endOrSupported == 0, there are SupportedServiceIDs to decode
 	// If endOrSupported == 1, it's END Element
 	if endOrSupported != 1 {
-		return nil, fmt.Errorf("DecodeServiceDiscoveryReq: SupportedServiceIDs decoding not yet implemented")
+		return fmt.Errorf("DecodeServiceDiscoveryReq: SupportedServiceIDs decoding not yet implemented")
 	}
 
-	return &generated.ServiceDiscoveryReq{
-		Header:          *header,
+	*dst = generated.ServiceDiscoveryReq{
+		Header:          header,
 		ServiceScope:    nil,
 		ServiceCategory: nil,
-	}, nil
+	}
+	return nil
 }
 
 // EncodeTopLevelServiceDetailReq writes EXI header and event code for ServiceDetailReq.
@@ -604,44 +598,50 @@ func EncodeServiceDetailReq(bs *BitStream, v *generated.ServiceDetailReq) error
 
 // DecodeServiceDetailReq decodes ServiceDetailReq from BitStream matching C decoder.
 func DecodeServiceDetailReq(bs *BitStream) (*generated.ServiceDetailReq, error) {
+	return decodeNew(bs, decodeServiceDetailReqInto)
+}
+
+// decodeServiceDetailReqInto is DecodeServiceDetailReq decoding into dst.
+func decodeServiceDetailReqInto(bs *BitStream, dst *generated.ServiceDetailReq) error {
 	// Grammar ID=429: START Header (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Decode MessageHeaderType (Grammar ID=277-279)
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// Grammar ID=430: START ServiceID (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// ServiceID encoding flag (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// ServiceID value (uint16)
 	serviceID, err := readUint16(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	// END ServiceID (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Grammar ID=2: END ServiceDetailReq (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.ServiceDetailReq{
-		Header:    *header,
+	*dst = generated.ServiceDetailReq{
+		Header:    header,
 		ServiceID: serviceID,
-	}, nil
+	}
+	return nil
 }
 
 // EncodeTopLevelSessionStopReq writes EXI header and event code for SessionStopReq.
@@ -705,11 +705,8 @@ func EncodeSessionStopReq(bs *BitStream, v *generated.SessionStopReq) error {
 		if err := bs.WriteBits(1, 0); err != nil {
 			return err
 		}
-		// EVTerminationCode string (+2 for string table)
-		if err := writeUint16(bs, uint16(len(*v.EVTerminationCode))+2); err != nil {
-			return err
-		}
-		if err := writeRawBytes(bs, []byte(*v.EVTerminationCode)); err != nil {
+		// EVTerminationCode string (length+2, or a string-table hit)
+		if err := writeStringValue(bs, "EVTerminationCode", []byte(*v.EVTerminationCode)); err != nil {
 			return err
 		}
 		// END EVTerminationCode (1 bit, value 0)
@@ -727,11 +724,8 @@ func EncodeSessionStopReq(bs *BitStream, v *generated.SessionStopReq) error {
 			if err := bs.WriteBits(1, 0); err != nil {
 				return err
 			}
-			// EVTerminationExplanation string (+2 for string table)
-			if err := writeUint16(bs, uint16(len(*v.EVTerminationExplanation))+2); err != nil {
-				return err
-			}
-			if err := writeRawBytes(bs, []byte(*v.EVTerminationExplanation)); err != nil {
+			// EVTerminationExplanation string (length+2, or a string-table hit)
+			if err := writeStringValue(bs, "EVTerminationExplanation", []byte(*v.EVTerminationExplanation)); err != nil {
 				return err
 			}
 			// END EVTerminationExplanation (1 bit, value 0)
@@ -757,11 +751,8 @@ func EncodeSessionStopReq(bs *BitStream, v *generated.SessionStopReq) error {
 		if err := bs.WriteBits(1, 0); err != nil {
 			return err
 		}
-		// EVTerminationExplanation string (+2 for string table)
-		if err := writeUint16(bs, uint16(len(*v.EVTerminationExplanation))+2); err != nil {
-			return err
-		}
-		if err := writeRawBytes(bs, []byte(*v.EVTerminationExplanation)); err != nil {
+		// EVTerminationExplanation string (length+2, or a string-table hit)
+		if err := writeStringValue(bs, "EVTerminationExplanation", []byte(*v.EVTerminationExplanation)); err != nil {
 			return err
 		}
 		// END EVTerminationExplanation (1 bit, value 0)
@@ -784,40 +775,45 @@ func EncodeSessionStopReq(bs *BitStream, v *generated.SessionStopReq) error {
 
 // DecodeSessionStopReq decodes SessionStopReq from BitStream matching C decoder.
 func DecodeSessionStopReq(bs *BitStream) (*generated.SessionStopReq, error) {
+	return decodeNew(bs, decodeSessionStopReqInto)
+}
+
+// decodeSessionStopReqInto is DecodeSessionStopReq decoding into dst.
+func decodeSessionStopReqInto(bs *BitStream, dst *generated.SessionStopReq) error {
 	// Grammar ID=460: START Header (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Decode MessageHeaderType (Grammar ID=277-279)
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// Grammar ID=461: START ChargingSession (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// ChargingSession encoding flag (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// ChargingSession enum value (2 bits)
 	chargingSessionEnum, err := bs.ReadBits(2)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	chargingSession := mapEnumToChargingSession(uint8(chargingSessionEnum))
 	// END ChargingSession (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Grammar ID=462: Optional EVTerminationCode, EVTerminationExplanation, or END (2 bits)
 	choice, err := bs.ReadBits(2)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	var evTerminationCode *string
@@ -827,66 +823,46 @@ func DecodeSessionStopReq(bs *BitStream) (*generated.SessionStopReq, error) {
 		// EVTerminationCode present
 		// String encoding flag (1 bit, expect 0)
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
-		// Read string length (subtract 2 for string table)
-		length, err := readUint16(bs)
+		// Read string (length+2, or a string-table hit)
+		termCodeBytes, err := readStringValue(bs, "EVTerminationCode")
 		if err != nil {
-			return nil, err
-		}
-		length -= 2
-		// Read string bytes
-		termCodeBytes := make([]byte, length)
-		for i := 0; i < int(length); i++ {
-			b, err := bs.ReadOctet()
-			if err != nil {
-				return nil, err
-			}
-			termCodeBytes[i] = b
+			return err
 		}
 		termCode := string(termCodeBytes)
 		evTerminationCode = &termCode
 		// END EVTerminationCode (1 bit, expect 0)
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
 
 		// Grammar ID=463: Optional EVTerminationExplanation or END (2 bits)
 		choice2, err := bs.ReadBits(2)
 		if err != nil {
-			return nil, err
+			return err
 		}
 
 		if choice2 == 0 {
 			// EVTerminationExplanation present
 			// String encoding flag (1 bit, expect 0)
 			if _, err := bs.ReadBits(1); err != nil {
-				return nil, err
+				return err
 			}
-			// Read string length (subtract 2)
-			length2, err := readUint16(bs)
+			// Read string (length+2, or a string-table hit)
+			termExplBytes, err := readStringValue(bs, "EVTerminationExplanation")
 			if err != nil {
-				return nil, err
-			}
-			length2 -= 2
-			// Read string bytes
-			termExplBytes := make([]byte, length2)
-			for i := 0; i < int(length2); i++ {
-				b, err := bs.ReadOctet()
-				if err != nil {
-					return nil, err
-				}
-				termExplBytes[i] = b
+				return err
 			}
 			termExpl := string(termExplBytes)
 			evTerminationExplanation = &termExpl
 			// END EVTerminationExplanation (1 bit, expect 0)
 			if _, err := bs.ReadBits(1); err != nil {
-				return nil, err
+				return err
 			}
 			// Grammar ID=2: END SessionStopReq (1 bit, expect 0)
 			if _, err := bs.ReadBits(1); err != nil {
-				return nil, err
+				return err
 			}
 		}
 		// If choice2 == 1, it's END Element already handled
@@ -894,42 +870,33 @@ func DecodeSessionStopReq(bs *BitStream) (*generated.SessionStopReq, error) {
 		// EVTerminationExplanation present (without EVTerminationCode)
 		// String encoding flag (1 bit, expect 0)
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
-		// Read string length (subtract 2)
-		length, err := readUint16(bs)
+		// Read string (length+2, or a string-table hit)
+		termExplBytes, err := readStringValue(bs, "EVTerminationExplanation")
 		if err != nil {
-			return nil, err
-		}
-		length -= 2
-		// Read string bytes
-		termExplBytes := make([]byte, length)
-		for i := 0; i < int(length); i++ {
-			b, err := bs.ReadOctet()
-			if err != nil {
-				return nil, err
-			}
-			termExplBytes[i] = b
+			return err
 		}
 		termExpl := string(termExplBytes)
 		evTerminationExplanation = &termExpl
 		// END EVTerminationExplanation (1 bit, expect 0)
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
 		// Grammar ID=2: END SessionStopReq (1 bit, expect 0)
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
 	}
 	// If choice == 2, it's END Element (no optional fields)
 
-	return &generated.SessionStopReq{
-		Header:                   *header,
+	*dst = generated.SessionStopReq{
+		Header:                   header,
 		ChargingSession:          chargingSession,
 		EVTerminationCode:        evTerminationCode,
 		EVTerminationExplanation: evTerminationExplanation,
-	}, nil
+	}
+	return nil
 }
 
 // EncodeTopLevelSessionStopRes writes EXI header and event code for SessionStopRes.
@@ -993,45 +960,51 @@ func EncodeSessionStopRes(bs *BitStream, v *generated.SessionStopRes) error {
 
 // DecodeSessionStopRes decodes SessionStopRes from BitStream matching C decoder.
 func DecodeSessionStopRes(bs *BitStream) (*generated.SessionStopRes, error) {
+	return decodeNew(bs, decodeSessionStopResInto)
+}
+
+// decodeSessionStopResInto is DecodeSessionStopRes decoding into dst.
+func decodeSessionStopResInto(bs *BitStream, dst *generated.SessionStopRes) error {
 	// Grammar ID=464: START Header (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Decode MessageHeaderType (Grammar ID=277-279)
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// Grammar ID=465: START ResponseCode (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// ResponseCode encoding flag (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// ResponseCode as 6-bit enum value
 	responseCodeEnum, err := bs.ReadBits(6)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	responseCode := mapEnumToResponseCode(uint8(responseCodeEnum))
 	// END ResponseCode (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Grammar ID=2: END SessionStopRes (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.SessionStopRes{
-		Header:       *header,
+	*dst = generated.SessionStopRes{
+		Header:       header,
 		ResponseCode: responseCode,
-	}, nil
+	}
+	return nil
 }
 
 // EncodeTopLevelAuthorizationSetupReq writes EXI header and event code for AuthorizationSetupReq.
@@ -1077,25 +1050,31 @@ func EncodeAuthorizationSetupReq(bs *BitStream, v *generated.AuthorizationSetupR
 
 // DecodeAuthorizationSetupReq decodes AuthorizationSetupReq from BitStream matching C decoder.
 func DecodeAuthorizationSetupReq(bs *BitStream) (*generated.AuthorizationSetupReq, error) {
+	return decodeNew(bs, decodeAuthorizationSetupReqInto)
+}
+
+// decodeAuthorizationSetupReqInto is DecodeAuthorizationSetupReq decoding into dst.
+func decodeAuthorizationSetupReqInto(bs *BitStream, dst *generated.AuthorizationSetupReq) error {
 	// Grammar ID=409: START Header (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Decode MessageHeaderType (Grammar ID=277-279)
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// Grammar ID=2: END AuthorizationSetupReq (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.AuthorizationSetupReq{
-		Header: *header,
-	}, nil
+	*dst = generated.AuthorizationSetupReq{
+		Header: header,
+	}
+	return nil
 }
 
 // EncodeTopLevelServiceSelectionRes writes EXI header and event code for ServiceSelectionRes.
@@ -1159,45 +1138,51 @@ func EncodeServiceSelectionRes(bs *BitStream, v *generated.ServiceSelectionRes)
 
 // DecodeServiceSelectionRes decodes ServiceSelectionRes from BitStream matching C decoder.
 func DecodeServiceSelectionRes(bs *BitStream) (*generated.ServiceSelectionRes, error) {
+	return decodeNew(bs, decodeServiceSelectionResInto)
+}
+
+// decodeServiceSelectionResInto is DecodeServiceSelectionRes decoding into dst.
+func decodeServiceSelectionResInto(bs *BitStream, dst *generated.ServiceSelectionRes) error {
 	// Grammar ID=438: START Header (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Decode MessageHeaderType (Grammar ID=277-279)
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// Grammar ID=439: START ResponseCode (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// ResponseCode encoding flag (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// ResponseCode as 6-bit enum value
 	responseCodeEnum, err := bs.ReadBits(6)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	responseCode := mapEnumToResponseCode(uint8(responseCodeEnum))
 	// END ResponseCode (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Grammar ID=2: END ServiceSelectionRes (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.ServiceSelectionRes{
-		Header:       *header,
+	*dst = generated.ServiceSelectionRes{
+		Header:       header,
 		ResponseCode: responseCode,
-	}, nil
+	}
+	return nil
 }
 
 // EncodeTopLevelMeteringConfirmationRes writes EXI header and event code for MeteringConfirmationRes.
@@ -1261,45 +1246,51 @@ func EncodeMeteringConfirmationRes(bs *BitStream, v *generated.MeteringConfirmat
 
 // DecodeMeteringConfirmationRes decodes MeteringConfirmationRes from BitStream matching C decoder.
 func DecodeMeteringConfirmationRes(bs *BitStream) (*generated.MeteringConfirmationRes, error) {
+	return decodeNew(bs, decodeMeteringConfirmationResInto)
+}
+
+// decodeMeteringConfirmationResInto is DecodeMeteringConfirmationRes decoding into dst.
+func decodeMeteringConfirmationResInto(bs *BitStream, dst *generated.MeteringConfirmationRes) error {
 	// Grammar ID=458: START Header (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Decode MessageHeaderType (Grammar ID=277-279)
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// Grammar ID=459: START ResponseCode (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// ResponseCode encoding flag (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// ResponseCode as 6-bit enum value
 	responseCodeEnum, err := bs.ReadBits(6)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	responseCode := mapEnumToResponseCode(uint8(responseCodeEnum))
 	// END ResponseCode (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Grammar ID=2: END MeteringConfirmationRes (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.MeteringConfirmationRes{
-		Header:       *header,
+	*dst = generated.MeteringConfirmationRes{
+		Header:       header,
 		ResponseCode: responseCode,
-	}, nil
+	}
+	return nil
 }
 
 // EncodeTopLevelAuthorizationRes writes EXI header and event code for AuthorizationRes.
@@ -1381,65 +1372,71 @@ func EncodeAuthorizationRes(bs *BitStream, v *generated.AuthorizationRes) error
 
 // DecodeAuthorizationRes decodes AuthorizationRes from BitStream matching C decoder.
 func DecodeAuthorizationRes(bs *BitStream) (*generated.AuthorizationRes, error) {
+	return decodeNew(bs, decodeAuthorizationResInto)
+}
+
+// decodeAuthorizationResInto is DecodeAuthorizationRes decoding into dst.
+func decodeAuthorizationResInto(bs *BitStream, dst *generated.AuthorizationRes) error {
 	// Grammar ID=419: START Header (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Decode MessageHeaderType (Grammar ID=277-279)
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// Grammar ID=420: START ResponseCode (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// ResponseCode encoding flag (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// ResponseCode as 6-bit enum value
 	responseCodeEnum, err := bs.ReadBits(6)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	responseCode := mapEnumToResponseCode(uint8(responseCodeEnum))
 	// END ResponseCode (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Grammar ID=421: START EVSEProcessing (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// EVSEProcessing encoding flag (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// EVSEProcessing as 2-bit enum value
 	evseProcessingEnum, err := bs.ReadBits(2)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	evseProcessing := mapEnumToEVSEProcessing(uint8(evseProcessingEnum))
 	// END EVSEProcessing (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Grammar ID=2: END AuthorizationRes (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.AuthorizationRes{
-		Header:         *header,
+	*dst = generated.AuthorizationRes{
+		Header:         header,
 		ResponseCode:   responseCode,
 		EVSEProcessing: evseProcessing,
-	}, nil
+	}
+	return nil
 }
 
 // EncodeCertificateUpdateReq encodes CertificateUpdateReq into BitStream.
@@ -1641,13 +1638,8 @@ func EncodeSessionSetupRes(bs *BitStream, v *generated.SessionSetupRes) error {
 	if err := bs.WriteBits(1, 0); err != nil {
 		return err
 	}
-	// EVSEID length (unsigned-var, +2 for string table)
-	evseidLen := uint16(len(v.EVSEID))
-	if err := writeUint16(bs, evseidLen+2); err != nil {
-		return err
-	}
-	// EVSEID bytes
-	if err := writeRawBytes(bs, v.EVSEID); err != nil {
+	// EVSEID value (length+2 and bytes, or a string-table hit)
+	if err := writeStringValue(bs, "EVSEID", v.EVSEID); err != nil {
 		return err
 	}
 	// END EVSEID (1 bit, value 0)
@@ -1758,75 +1750,71 @@ func mapEnumToEVSEProcessing(processing uint8) string {
 // DecodeSessionSetupRes decodes SessionSetupRes from BitStream matching C decoder.
 // This follows the exact grammar path from the C implementation.
 func DecodeSessionSetupRes(bs *BitStream) (*generated.SessionSetupRes, error) {
+	return decodeNew(bs, decodeSessionSetupResInto)
+}
+
+// decodeSessionSetupResInto is DecodeSessionSetupRes decoding into dst.
+func decodeSessionSetupResInto(bs *BitStream, dst *generated.SessionSetupRes) error {
 	// Grammar ID=406: START Header (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Decode MessageHeaderType (Grammar ID=277-279)
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// Grammar ID=407: START ResponseCode (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// ResponseCode encoding flag (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// ResponseCode as 6-bit enum value
 	responseCodeEnum, err := bs.ReadBits(6)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	responseCode := mapEnumToResponseCode(uint8(responseCodeEnum))
 	// END ResponseCode (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Grammar ID=408: START EVSEID (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// String encoding flag (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
-	// EVSEID length (unsigned-var, subtract 2 for string table)
-	evseidLen, err := readUint16(bs)
+	// EVSEID value (length+2 and bytes, or a string-table hit)
+	evseid, err := readStringValue(bs, "EVSEID")
 	if err != nil {
-		return nil, err
-	}
-	evseidLen -= 2
-	// EVSEID bytes
-	evseid := make([]byte, evseidLen)
-	for i := 0; i < int(evseidLen); i++ {
-		b, err := bs.ReadOctet()
-		if err != nil {
-			return nil, err
-		}
-		evseid[i] = b
+		return err
 	}
 	// END EVSEID (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Grammar ID=2: END SessionSetupRes (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.SessionSetupRes{
-		Header:       *header,
+	*dst = generated.SessionSetupRes{
+		Header:       header,
 		ResponseCode: responseCode,
 		EVSEID:       evseid,
 		DateTimeNow:  nil, // Not present in this encoding
-	}, nil
+	}
+	return nil
 }
 
 // EncodeTopLevelServiceDiscoveryRes writes EXI header and event code for ServiceDiscoveryRes.
@@ -2020,90 +2008,104 @@ func encodeServiceType(bs *BitStream, service *generated.ServiceType) error {
 
 // DecodeServiceDiscoveryRes decodes ServiceDiscoveryRes from BitStream.
 func DecodeServiceDiscoveryRes(bs *BitStream) (*generated.ServiceDiscoveryRes, error) {
+	return decodeNew(bs, decodeServiceDiscoveryResInto)
+}
+
+// decodeServiceDiscoveryResInto is DecodeServiceDiscoveryRes decoding into dst.
+func decodeServiceDiscoveryResInto(bs *BitStream, dst *generated.ServiceDiscoveryRes) error {
 	// Grammar ID=424: START Header (1 bit)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// Grammar ID=425: START ResponseCode (1 bit)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// Encoding flag (1 bit)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// ResponseCode enum (6 bits)
 	responseCodeBits, err := bs.ReadBits(6)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	responseCode := mapEnumToResponseCode(uint8(responseCodeBits))
 	// END ResponseCode (1 bit)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Grammar ID=426: START ServiceRenegotiationSupported (1 bit)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// Boolean value
 	boolBits, err := bs.ReadBits(1)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	serviceRenegotiationSupported := boolBits == 1
 	// END ServiceRenegotiationSupported (1 bit)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Grammar ID=427: START EnergyTransferServiceList (1 bit)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
-	energyTransferServiceList, err := decodeServiceList(bs)
+	energyTransferServiceList, err := decodeServiceList(bs, dst.EnergyTransferServiceList.Services)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// Grammar ID=428: VASList or END (2 bits)
 	choice, err := bs.ReadBits(2)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	var vasList *generated.ServiceList
 	if choice == 0 {
 		// VASList present
-		vasList, err = decodeServiceList(bs)
+		var old []generated.ServiceType
+		if dst.VASList != nil {
+			old = dst.VASList.Services
+		}
+		vasList, err = decodeServiceList(bs, old)
 		if err != nil {
-			return nil, err
+			return err
 		}
 		// Grammar ID=2: END Element (1 bit)
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
 	}
 	// choice == 1 means END Element (no VASList)
 
-	return &generated.ServiceDiscoveryRes{
-		Header:                        *header,
+	*dst = generated.ServiceDiscoveryRes{
+		Header:                        header,
 		ResponseCode:                  responseCode,
 		ServiceRenegotiationSupported: serviceRenegotiationSupported,
 		EnergyTransferServiceList:     *energyTransferServiceList,
 		VASList:                       vasList,
-	}, nil
+	}
+	return nil
 }
 
-// decodeServiceList decodes ServiceListType from BitStream.
-func decodeServiceList(bs *BitStream) (*generated.ServiceList, error) {
-	var services []generated.ServiceType
+// decodeServiceList decodes ServiceListType from BitStream, appending to
+// old[:0] if DecodeInto may refill it.
+func decodeServiceList(bs *BitStream, old []generated.ServiceType) (*generated.ServiceList, error) {
+	services := bs.arena.serviceListScratch()
+	if bs.arena == nil && old != nil {
+		services = old[:0]
+	}
 
 	for {
 		// Check for START Service or END (1 bit)
@@ -2118,59 +2120,65 @@ func decodeServiceList(bs *BitStream) (*generated.ServiceList, error) {
 		}
 
 		// choice == 0: START Service
+		if err := bs.repeat(1); err != nil {
+			return nil, err
+		}
 		service, err := decodeServiceType(bs)
 		if err != nil {
 			return nil, err
 		}
-		services = append(services, *service)
+		services = append(services, service)
 	}
 
+	if len(services) == 0 && bs.arena == nil {
+		services = nil // as Decode returns it
+	}
 	return &generated.ServiceList{
-		Services: services,
+		Services: bs.arena.serviceList(services),
 	}, nil
 }
 
 // decodeServiceType decodes ServiceType from BitStream.
-func decodeServiceType(bs *BitStream) (*generated.ServiceType, error) {
+func decodeServiceType(bs *BitStream) (generated.ServiceType, error) {
 	// Grammar ID=167: START ServiceID (1 bit)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return generated.ServiceType{}, err
 	}
 	// Encoding flag (1 bit)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return generated.ServiceType{}, err
 	}
 	// ServiceID (16 bits)
 	serviceIDBits, err := bs.ReadBits(16)
 	if err != nil {
-		return nil, err
+		return generated.ServiceType{}, err
 	}
 	// END ServiceID (1 bit)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return generated.ServiceType{}, err
 	}
 
 	// Grammar ID=168: START FreeService (1 bit)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return generated.ServiceType{}, err
 	}
 	// Boolean value
 	boolBits, err := bs.ReadBits(1)
 	if err != nil {
-		return nil, err
+		return generated.ServiceType{}, err
 	}
 	freeService := boolBits == 1
 	// END FreeService (1 bit)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return generated.ServiceType{}, err
 	}
 
 	// Grammar ID=2: END Service (1 bit)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return generated.ServiceType{}, err
 	}
 
-	return &generated.ServiceType{
+	return generated.ServiceType{
 		ServiceID:   uint16(serviceIDBits),
 		FreeService: freeService,
 	}, nil
@@ -0,0 +1,291 @@
+package exi
+
+import (
+	"errors"
+	"runtime"
+	"sync"
+)
+
+// ErrExecutorClosed is returned for frames submitted after Executor.Close.
+var ErrExecutorClosed = errors.New("exi: executor closed")
+
+// defaultExecutorQueue is the default number of frames each worker queues.
+const defaultExecutorQueue = 256
+
+// defaultExecutorSessions bounds the PreparedSessions each worker caches.
+const defaultExecutorSessions = 4096
+
+// ExecutorConfig configures NewExecutor. The zero value is usable.
+type ExecutorConfig struct {
+	// Workers is the number of worker goroutines; <= 0 selects GOMAXPROCS.
+	Workers int
+	// QueueDepth is the number of frames each worker (and the shared queue)
+	// buffers before Submit blocks; <= 0 selects 256.
+	QueueDepth int
+	// MaxSessions bounds the PreparedSessions each worker caches for
+	// SessionWorker.Session. When a new session would exceed it, one cached
+	// session picked at random is evicted; it is prepared again if it is
+	// used again. <= 0 selects 4096.
+	MaxSessions int
+	// Options applies to the decodes of every worker. Its Arena is ignored:
+	// each worker decodes SubmitFunc frames into an Arena of its own.
+	Options DecodeOptions
+}
+
+// Executor decodes frames of many concurrent ISO 15118-20 sessions on a
+// fixed set of workers, sharded by SessionID. A frame is routed by hashing
+// the SessionID of its header, read in place without decoding the rest, so
+// every frame of a session is decoded by the same worker, in the order it
+// was submitted, with that worker's Decoder, Encoder, Arena and cache of
+// PreparedSessions. Workers share no codec state.
+//
+// Frames without a session (an empty or all-zero SessionID, as in
+// SessionSetupReq) and frames whose header cannot be read have no home
+// worker: they go to a shared queue that every worker takes from when it
+// is free, so a burst of them is spread over the idle workers. Frames of a
+// session are never moved to another worker, since that would reorder them
+// and share the session's state; a session that is busier than the others
+// keeps its worker busier too.
+//
+// An Executor is safe for concurrent use.
+type Executor struct {
+	workers []*SessionWorker
+	shared  chan executorJob
+
+	mu     sync.RWMutex
+	closed bool
+	wg     sync.WaitGroup
+}
+
+// SessionWorker is the state one Executor worker owns. It is passed to the
+// handlers of SubmitFunc, which run on the worker's goroutine and may use
+// it until they return.
+type SessionWorker struct {
+	queue chan executorJob
+	dec   Decoder
+	enc   Encoder
+	arena *Arena
+
+	sessions    map[string]*PreparedSession
+	maxSessions int
+}
+
+// SessionHandler processes a frame decoded by SubmitFunc, or the error
+// decoding it, on the worker that owns its session.
+type SessionHandler func(w *SessionWorker, msg interface{}, err error)
+
+// executorJob is a queued frame: the future of Submit or the handler of
+// SubmitFunc.
+type executorJob struct {
+	frame []byte
+	fut   *Future
+	fn    SessionHandler
+}
+
+// Future is the pending result of Executor.Submit.
+type Future struct {
+	done   chan struct{}
+	msg    interface{}
+	err    error
+	waited bool
+}
+
+var futurePool = sync.Pool{New: func() interface{} {
+	return &Future{done: make(chan struct{}, 1)}
+}}
+
+// Wait blocks until the frame is decoded and returns the message or the
+// error. The message is an ordinary heap value and may be kept. Wait may
+// be called more than once from the goroutine that submitted the frame.
+func (f *Future) Wait() (interface{}, error) {
+	if !f.waited {
+		<-f.done
+		f.waited = true
+	}
+	return f.msg, f.err
+}
+
+// Release waits for f and returns it to the Executor for reuse, which makes
+// steady-state Submit calls allocation-free. f must not be used afterwards.
+func (f *Future) Release() {
+	f.Wait()
+	*f = Future{done: f.done}
+	futurePool.Put(f)
+}
+
+// NewExecutor starts the workers of an Executor. Close stops them.
+func NewExecutor(cfg ExecutorConfig) *Executor {
+	n := cfg.Workers
+	if n <= 0 {
+		n = runtime.GOMAXPROCS(0)
+	}
+	depth := cfg.QueueDepth
+	if depth <= 0 {
+		depth = defaultExecutorQueue
+	}
+	maxSessions := cfg.MaxSessions
+	if maxSessions <= 0 {
+		maxSessions = defaultExecutorSessions
+	}
+	opts := cfg.Options
+	opts.Arena = nil
+
+	x := &Executor{
+		workers: make([]*SessionWorker, n),
+		shared:  make(chan executorJob, depth),
+	}
+	for i := range x.workers {
+		w := &SessionWorker{
+			queue:       make(chan executorJob, depth),
+			dec:         Decoder{Options: opts},
+			arena:       NewArena(0),
+			sessions:    make(map[string]*PreparedSession),
+			maxSessions: maxSessions,
+		}
+		x.workers[i] = w
+		x.wg.Add(1)
+		go w.run(x.shared, &x.wg)
+	}
+	return x
+}
+
+// Workers returns the number of workers.
+func (x *Executor) Workers() int {
+	return len(x.workers)
+}
+
+// Submit queues frame, a complete EXI document, for decoding on the worker
+// of its session and returns its Future. frame must not be modified until
+// the Future completes. Submit blocks while that worker's queue is full.
+func (x *Executor) Submit(frame []byte) *Future {
+	f := futurePool.Get().(*Future)
+	if err := x.submit(executorJob{frame: frame, fut: f}); err != nil {
+		f.err = err
+		f.done <- struct{}{}
+	}
+	return f
+}
+
+// SubmitFunc queues frame like Submit, and calls fn with the decoded message
+// on the worker of its session. The message is decoded into the worker's
+// Arena and is only valid until fn returns; fn may encode a response with
+// w.Encoder and w.Session. fn must not block for long, since it holds up
+// every session of its worker. SubmitFunc returns ErrExecutorClosed, without
+// calling fn, after Close.
+func (x *Executor) SubmitFunc(frame []byte, fn SessionHandler) error {
+	return x.submit(executorJob{frame: frame, fn: fn})
+}
+
+func (x *Executor) submit(j executorJob) error {
+	q := x.shared
+	if h, ok := peekSessionHash(j.frame); ok {
+		q = x.workers[h%uint64(len(x.workers))].queue
+	}
+	x.mu.RLock()
+	defer x.mu.RUnlock()
+	if x.closed {
+		return ErrExecutorClosed
+	}
+	q <- j
+	return nil
+}
+
+// Close stops accepting frames, waits for the queued ones to be processed
+// and stops the workers. Frames submitted afterwards fail with
+// ErrExecutorClosed.
+func (x *Executor) Close() {
+	x.mu.Lock()
+	if !x.closed {
+		x.closed = true
+		for _, w := range x.workers {
+			close(w.queue)
+		}
+		close(x.shared)
+	}
+	x.mu.Unlock()
+	x.wg.Wait()
+}
+
+// run processes the worker's own queue and the shared queue until both are
+// closed and drained.
+func (w *SessionWorker) run(shared chan executorJob, wg *sync.WaitGroup) {
+	defer wg.Done()
+	own := w.queue
+	for own != nil || shared != nil {
+		select {
+		case j, ok := <-own:
+			if !ok {
+				own = nil
+				continue
+			}
+			w.process(j)
+		case j, ok := <-shared:
+			if !ok {
+				shared = nil
+				continue
+			}
+			w.process(j)
+		}
+	}
+}
+
+func (w *SessionWorker) process(j executorJob) {
+	if j.fut != nil {
+		j.fut.msg, j.fut.err = w.dec.Decode(j.frame)
+		j.fut.done <- struct{}{}
+		return
+	}
+	w.dec.Options.Arena = w.arena
+	msg, err := w.dec.Decode(j.frame)
+	w.dec.Options.Arena = nil
+	j.fn(w, msg, err)
+	w.arena.Reset()
+}
+
+// Encoder returns the worker's Encoder.
+func (w *SessionWorker) Encoder() *Encoder {
+	return &w.enc
+}
+
+// Session returns the worker's PreparedSession for sessionID, preparing it
+// on first use, for encoding the session's responses with
+// Encoder.EncodeSessionInto or EncodeSessionTo.
+func (w *SessionWorker) Session(sessionID []byte) *PreparedSession {
+	if s, ok := w.sessions[string(sessionID)]; ok {
+		return s
+	}
+	if len(w.sessions) >= w.maxSessions {
+		// Map iteration starts at a random entry, which is the victim.
+		for id := range w.sessions {
+			delete(w.sessions, id)
+			break
+		}
+	}
+	s := PrepareSession(sessionID)
+	w.sessions[string(s.sessionID)] = s
+	return s
+}
+
+// EndSession drops the worker's PreparedSession for sessionID, e.g. once
+// the session's SessionStopRes has been sent.
+func (w *SessionWorker) EndSession(sessionID []byte) {
+	delete(w.sessions, string(sessionID))
+}
+
+// peekSessionHash returns an FNV-1a hash of the SessionID of data and
+// whether it names a session: it is false for an empty or all-zero ID and
+// for a document whose header cannot be read. The ID is hashed as
+// peekSessionID reads it, so nothing is copied.
+func peekSessionHash(data []byte) (uint64, bool) {
+	const offset64, prime64 = 14695981039346656037, 1099511628211
+	h := uint64(offset64)
+	var nonzero byte
+	err := peekSessionID(data, func(b byte) {
+		nonzero |= b
+		h = (h ^ uint64(b)) * prime64
+	})
+	if err != nil {
+		return 0, false
+	}
+	return h, nonzero != 0
+}
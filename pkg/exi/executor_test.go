@@ -0,0 +1,246 @@
+package exi_test
+
+import (
+	"bytes"
+	"encoding/binary"
+	"errors"
+	"reflect"
+	"sync"
+	"testing"
+
+	"example.com/exi-go/pkg/exi"
+	"example.com/exi-go/pkg/v2g/generated"
+)
+
+// sessionStopFrame encodes a SessionStopReq of sessionID whose TimeStamp
+// carries seq.
+func sessionStopFrame(t testing.TB, sessionID []byte, seq uint64) []byte {
+	t.Helper()
+	data, err := exi.EncodeStruct(&generated.SessionStopReq{
+		Header:          generated.MessageHeaderType{SessionID: sessionID, TimeStamp: seq},
+		ChargingSession: "Terminate",
+	})
+	if err != nil {
+		t.Fatal(err)
+	}
+	return data
+}
+
+func TestExecutorCorpus(t *testing.T) {
+	corpus := loadCorpus(t)
+	x := exi.NewExecutor(exi.ExecutorConfig{Workers: 4, QueueDepth: 8})
+	defer x.Close()
+	dec := exi.NewDecoder()
+
+	const passes = 20
+	futures := make([]*exi.Future, 0, passes*len(corpus))
+	var frames [][]byte
+	for pass := 0; pass < passes; pass++ {
+		for _, data := range corpus {
+			futures = append(futures, x.Submit(data))
+			frames = append(frames, data)
+		}
+	}
+	for i, f := range futures {
+		got, err := f.Wait()
+		want, wantErr := dec.Decode(frames[i])
+		if (err != nil) != (wantErr != nil) || !reflect.DeepEqual(got, want) {
+			t.Fatalf("frame %d: got %v, %v; want %v, %v", i, got, err, want, wantErr)
+		}
+		f.Release()
+	}
+}
+
+func TestExecutorSessionAffinity(t *testing.T) {
+	const sessions, perSession = 32, 50
+	x := exi.NewExecutor(exi.ExecutorConfig{Workers: 4, QueueDepth: 4})
+
+	var mu sync.Mutex
+	owner := map[uint64]*exi.SessionWorker{}
+	next := map[uint64]uint64{}
+	var failures []string
+	handle := func(w *exi.SessionWorker, msg interface{}, err error) {
+		if err != nil {
+			mu.Lock()
+			failures = append(failures, err.Error())
+			mu.Unlock()
+			return
+		}
+		h := msg.(*generated.SessionStopReq).Header
+		// The response of the session's worker carries the session's ID.
+		out, err := w.Encoder().EncodeSessionTo(nil, w.Session(h.SessionID), &generated.SessionStopRes{
+			Header:       generated.MessageHeaderType{TimeStamp: h.TimeStamp},
+			ResponseCode: "OK",
+		})
+		if err != nil {
+			mu.Lock()
+			failures = append(failures, err.Error())
+			mu.Unlock()
+			return
+		}
+		res, err := exi.DecodeStruct(out, nil)
+		if err != nil || !bytes.Equal(res.(*generated.SessionStopRes).Header.SessionID, h.SessionID) {
+			mu.Lock()
+			failures = append(failures, "response has another session")
+			mu.Unlock()
+		}
+		id := binary.BigEndian.Uint64(h.SessionID)
+		mu.Lock()
+		defer mu.Unlock()
+		if o := owner[id]; o != nil && o != w {
+			failures = append(failures, "session moved to another worker")
+		}
+		owner[id] = w
+		if h.TimeStamp != next[id] {
+			failures = append(failures, "frames of a session reordered")
+		}
+		next[id] = h.TimeStamp + 1
+	}
+
+	// One submitting goroutine per session keeps each session's frames in
+	// order; the sessions interleave.
+	var wg sync.WaitGroup
+	for s := 1; s <= sessions; s++ {
+		id := make([]byte, 8)
+		binary.BigEndian.PutUint64(id, uint64(s)*0x9E3779B97F4A7C15)
+		frames := make([][]byte, perSession)
+		for i := range frames {
+			frames[i] = sessionStopFrame(t, id, uint64(i))
+		}
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			for _, f := range frames {
+				if err := x.SubmitFunc(f, handle); err != nil {
+					t.Error(err)
+				}
+			}
+		}()
+	}
+	wg.Wait()
+	x.Close()
+
+	for _, f := range failures {
+		t.Error(f)
+	}
+	if len(owner) != sessions {
+		t.Fatalf("%d sessions handled, want %d", len(owner), sessions)
+	}
+	for id, n := range next {
+		if n != perSession {
+			t.Errorf("session %x: %d frames, want %d", id, n, perSession)
+		}
+	}
+}
+
+func TestExecutorSharedQueue(t *testing.T) {
+	x := exi.NewExecutor(exi.ExecutorConfig{Workers: 3})
+	var mu sync.Mutex
+	var decoded, failed int
+	handle := func(w *exi.SessionWorker, msg interface{}, err error) {
+		mu.Lock()
+		defer mu.Unlock()
+		if err != nil {
+			failed++
+		} else {
+			decoded++
+		}
+	}
+	// Frames without a session and frames without a readable header have
+	// no home worker but are still processed.
+	unrouted := [][]byte{
+		sessionStopFrame(t, make([]byte, 8), 0),
+		sessionStopFrame(t, nil, 1),
+		{0x80},
+		nil,
+	}
+	for i := 0; i < 25; i++ {
+		for _, f := range unrouted {
+			if err := x.SubmitFunc(f, handle); err != nil {
+				t.Fatal(err)
+			}
+		}
+	}
+	x.Close()
+	if decoded != 50 || failed != 50 {
+		t.Errorf("decoded %d failed %d, want 50 50", decoded, failed)
+	}
+
+	if _, err := x.Submit(unrouted[0]).Wait(); !errors.Is(err, exi.ErrExecutorClosed) {
+		t.Errorf("Submit after Close: err = %v, want ErrExecutorClosed", err)
+	}
+	if err := x.SubmitFunc(unrouted[0], handle); !errors.Is(err, exi.ErrExecutorClosed) {
+		t.Errorf("SubmitFunc after Close: err = %v, want ErrExecutorClosed", err)
+	}
+	x.Close()
+}
+
+// TestExecutorAllocs checks that routing and queueing a frame allocate
+// nothing beyond what decoding it does.
+func TestExecutorAllocs(t *testing.T) {
+	id := []byte{0xA1, 0xB2, 0xC3, 0xD4, 0xE5, 0xF6, 0x07, 0x18}
+	frame := sessionStopFrame(t, id, 7)
+	x := exi.NewExecutor(exi.ExecutorConfig{Workers: 2})
+	defer x.Close()
+
+	dec := exi.NewDecoder()
+	heap := testing.AllocsPerRun(100, func() { dec.Decode(frame) })
+	got := testing.AllocsPerRun(100, func() { x.Submit(frame).Release() })
+	if got > heap {
+		t.Errorf("Submit: %.1f allocs/op, Decode alone %.1f", got, heap)
+	}
+
+	arena := exi.NewArena(0)
+	dec.Options.Arena = arena
+	inArena := testing.AllocsPerRun(100, func() { dec.Decode(frame); arena.Reset() })
+	done := make(chan struct{})
+	handle := func(*exi.SessionWorker, interface{}, error) { done <- struct{}{} }
+	got = testing.AllocsPerRun(100, func() {
+		x.SubmitFunc(frame, handle)
+		<-done
+	})
+	if got > inArena {
+		t.Errorf("SubmitFunc: %.1f allocs/op, arena Decode alone %.1f", got, inArena)
+	}
+}
+
+// BenchmarkExecutor decodes the corpus through an Executor. RoundTrip has
+// parallel submitters each wait for their frame, which is the hand-off
+// latency; Pipelined submits from one goroutine and waits once at the end,
+// which is the throughput. Compare with BenchmarkCorpusParallel/Decode.
+func BenchmarkExecutor(b *testing.B) {
+	corpus := loadCorpus(b)
+	var frames [][]byte
+	for _, data := range corpus {
+		frames = append(frames, data)
+	}
+	b.Run("RoundTrip", func(b *testing.B) {
+		x := exi.NewExecutor(exi.ExecutorConfig{})
+		defer x.Close()
+		b.ReportAllocs()
+		b.RunParallel(func(pb *testing.PB) {
+			done := make(chan struct{}, 1)
+			handle := func(*exi.SessionWorker, interface{}, error) { done <- struct{}{} }
+			for i := 0; pb.Next(); i++ {
+				if err := x.SubmitFunc(frames[i%len(frames)], handle); err != nil {
+					b.Fatal(err)
+				}
+				<-done
+			}
+		})
+	})
+	b.Run("Pipelined", func(b *testing.B) {
+		x := exi.NewExecutor(exi.ExecutorConfig{})
+		var wg sync.WaitGroup
+		handle := func(*exi.SessionWorker, interface{}, error) { wg.Done() }
+		b.ReportAllocs()
+		wg.Add(b.N)
+		for i := 0; i < b.N; i++ {
+			if err := x.SubmitFunc(frames[i%len(frames)], handle); err != nil {
+				b.Fatal(err)
+			}
+		}
+		wg.Wait()
+		x.Close()
+	})
+}
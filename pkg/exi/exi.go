@@ -7,16 +7,13 @@ import (
 	"errors"
 	"io"
 	"regexp"
+	"sync"
 )
 
-// A simple EXI-like encoder/decoder implemented for development and tests.
-// This is NOT a full EXI implementation. It provides a compact, deterministic
-// binary representation used for integration tests: XML is minified then
-// compressed using gzip. The resulting payload can be round-tripped by the
-// corresponding DecodeEXI implementation.
-//
-// This lightweight approach gives us a meaningful binary format for the
-// generator/runtime integration while we later implement a real EXI engine.
+// Codec converts between XML documents and EXI. With Config.UseStub unset it
+// uses the schema-informed per-message codecs (see xml.go). The stub mode
+// kept for compatibility is NOT EXI: XML is minified then compressed using
+// gzip, which DecodeEXI reverses.
 
 var (
 	// ErrNotImplemented used when a non-stubbed branch is invoked
@@ -33,15 +30,24 @@ type Config struct {
 	// runtime will operate in a schema-less mode (more generic).
 	SchemaPaths []string
 
-	// UseStub controls whether the runtime uses the lightweight stub encoder.
-	// For development the minify+gzip encoder is used regardless; UseStub is
-	// kept for compatibility and future feature toggling.
+	// UseStub selects the minify+gzip stub instead of schema-informed EXI.
+	// NewCodec(nil) keeps the stub for compatibility with existing callers.
 	UseStub bool
+
+	// Grammar is the grammar table compiled from SchemaPaths, or loaded
+	// from a grammar cache (see schema.LoadGrammar). The per-message codecs
+	// do not need it; it is kept for callers of Codec.Grammar.
+	Grammar *GrammarTable
 }
 
 // Codec is a minimal EXI codec instance.
 type Codec struct {
 	cfg *Config
+
+	// Reused contexts for the schema-informed path; a Codec may be shared
+	// between goroutines.
+	encoders sync.Pool
+	decoders sync.Pool
 }
 
 // NewCodec creates a new Codec instance using the provided Config.
@@ -52,6 +58,11 @@ func NewCodec(cfg *Config) *Codec {
 	return &Codec{cfg: cfg}
 }
 
+// Grammar returns the grammar table of the codec's configuration, or nil.
+func (c *Codec) Grammar() *GrammarTable {
+	return c.cfg.Grammar
+}
+
 // Init prepares the codec for use. No-op for this simple implementation.
 func (c *Codec) Init() error {
 	if c == nil {
@@ -61,7 +72,9 @@ func (c *Codec) Init() error {
 	return nil
 }
 
-// Shutdown releases resources (no-op here).
+// Shutdown releases resources (no-op here). Calls already in progress on c
+// may still complete after Shutdown returns, so it must not release anything
+// they use.
 func (c *Codec) Shutdown() error {
 	return nil
 }
@@ -108,13 +121,39 @@ func gzipDecompress(in []byte) ([]byte, error) {
 	return out, nil
 }
 
-// EncodeXML encodes an XML document (as bytes) into a gzipped, minified
-// binary representation. This provides a compact, deterministic payload
-// for testing. It also validates that the input is well-formed XML.
+// EncodeXML encodes an XML document (as bytes) into EXI. The root element
+// selects the message type; see EncodeXMLTo.
 func (c *Codec) EncodeXML(xmlBytes []byte) ([]byte, error) {
+	return c.EncodeXMLTo(nil, xmlBytes)
+}
+
+// EncodeXMLTo appends the encoding of an XML document to dst and returns
+// the extended slice. In stub mode it appends the gzipped, minified XML.
+func (c *Codec) EncodeXMLTo(dst, xmlBytes []byte) ([]byte, error) {
 	if c == nil {
 		return nil, errors.New("exi: codec is nil")
 	}
+	if !c.cfg.UseStub {
+		msg, err := xmlToStruct(xmlBytes)
+		if err != nil {
+			return dst, err
+		}
+		e, _ := c.encoders.Get().(*Encoder)
+		if e == nil {
+			e = &Encoder{}
+		}
+		defer c.encoders.Put(e)
+		return e.EncodeTo(dst, msg)
+	}
+	out, err := c.encodeStub(xmlBytes)
+	if err != nil {
+		return dst, err
+	}
+	return append(dst, out...), nil
+}
+
+// encodeStub validates xmlBytes, then minifies and gzips it.
+func (c *Codec) encodeStub(xmlBytes []byte) ([]byte, error) {
 	// Ensure input is valid XML to catch user errors early.
 	var tmp any
 	if err := xml.Unmarshal(xmlBytes, &tmp); err != nil {
@@ -130,13 +169,43 @@ func (c *Codec) EncodeXML(xmlBytes []byte) ([]byte, error) {
 	return out, nil
 }
 
-// DecodeEXI decodes bytes produced by EncodeXML: it attempts to gunzip and
-// returns the minified XML bytes. The caller can unmarshal or pretty-print
-// as needed.
+// DecodeEXI decodes bytes produced by EncodeXML and returns the XML
+// document; see DecodeEXITo.
 func (c *Codec) DecodeEXI(exiBytes []byte) ([]byte, error) {
+	return c.DecodeEXITo(nil, exiBytes)
+}
+
+// DecodeEXITo decodes an EXI document and appends its XML rendering to dst,
+// returning the extended slice. The message is written straight into dst
+// without an intermediate document tree. In stub mode it gunzips exiBytes
+// and appends the minified XML.
+func (c *Codec) DecodeEXITo(dst, exiBytes []byte) ([]byte, error) {
 	if c == nil {
 		return nil, errors.New("exi: codec is nil")
 	}
+	if !c.cfg.UseStub {
+		d, _ := c.decoders.Get().(*Decoder)
+		if d == nil {
+			// The message is rendered before returning, so it may alias
+			// exiBytes.
+			d = &Decoder{Options: DecodeOptions{AliasInput: true}}
+		}
+		defer c.decoders.Put(d)
+		msg, err := d.Decode(exiBytes)
+		if err != nil {
+			return dst, err
+		}
+		return appendStructXML(dst, msg)
+	}
+	out, err := c.decodeStub(exiBytes)
+	if err != nil {
+		return dst, err
+	}
+	return append(dst, out...), nil
+}
+
+// decodeStub gunzips a payload produced by encodeStub and validates the XML.
+func (c *Codec) decodeStub(exiBytes []byte) ([]byte, error) {
 	// Try to decompress gzip payload
 	xmlOut, err := gzipDecompress(exiBytes)
 	if err == nil {
@@ -45,6 +45,12 @@ func FuzzSessionSetupReq(f *testing.F) {
 		if string(decodedMsg.EVCCID) != string(msg.EVCCID) {
 			t.Errorf("EVCCID mismatch: got %v, want %v", decodedMsg.EVCCID, msg.EVCCID)
 		}
+
+		// Validate accepts what was encoded, and all of it
+		m, n, err := Validate(encoded)
+		if err != nil || m.Name != "SessionSetupReq" || n != len(encoded) {
+			t.Errorf("Validate = %v, %d, %v; want SessionSetupReq, %d", m, n, err, len(encoded))
+		}
 	})
 }
 
@@ -100,8 +106,17 @@ func FuzzBitStream(f *testing.F) {
 	f.Add([]byte{0xFF, 0x00, 0xAA, 0x55}, 6)
 	f.Add([]byte{0xFF, 0x00, 0xAA, 0x55}, 8)
 	f.Add([]byte{0xFF, 0x00, 0xAA, 0x55}, 16)
+	f.Add([]byte{0x80, 0x8C, 0x04, 0x00, 0x00}, 8) // SessionSetupReq header
+	f.Add([]byte{0x80, 0x0C, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F}, 8)
 
 	f.Fuzz(func(t *testing.T, data []byte, bitCount int) {
+		// Validate agrees with a full decode under its repetition limit on
+		// arbitrary input and never reports more than the input
+		_, decodeErr := DecodeStructWithOptions(data, nil, DecodeOptions{MaxRepetitions: ValidateMaxRepetitions})
+		if _, n, err := Validate(data); (err == nil) != (decodeErr == nil) || n > len(data) {
+			t.Fatalf("Validate = %d, %v; DecodeStructWithOptions err = %v", n, err, decodeErr)
+		}
+
 		// Limit to valid bit counts
 		if bitCount <= 0 || bitCount > 32 {
 			return
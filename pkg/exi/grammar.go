@@ -0,0 +1,612 @@
+package exi
+
+import (
+	"errors"
+	"fmt"
+	"reflect"
+	"strings"
+	"sync"
+)
+
+// This file implements the table-driven grammar engine. A GrammarTable is
+// a flat, schema-derived description of the EXI element grammars (states,
+// productions and event-code widths); a single interpreter loop walks it to
+// encode or decode a generated Go struct. Tables are normally built from XSD
+// by schema.BuildGrammarTable; the hand-written per-message codecs in this
+// package remain the default path for DecodeStruct/EncodeStruct.
+//
+// Encoding conventions follow the schema-informed grammars used by the
+// hand-written codecs (and the reference C implementation):
+//   - an event code is written with the state's Bits width; START events are
+//     numbered in schema order and END comes last
+//   - a simple-typed element writes CHARACTERS (1 bit, 0), its value, then
+//     END (1 bit, 0)
+//   - a complex-typed element continues in the grammar of its type, whose
+//     final END closes the element
+
+// ValueKind identifies how the content of an element is encoded.
+type ValueKind uint8
+
+const (
+	// KindComplex elements continue in the grammar of a complex type.
+	KindComplex ValueKind = iota
+	// KindBinary is hexBinary/base64Binary: unsigned-var length + octets.
+	KindBinary
+	// KindString is a string-table miss: unsigned-var length+2 + UTF-8 octets.
+	KindString
+	// KindUnsigned is a non-negative integer: unsigned-var.
+	KindUnsigned
+	// KindInteger is a signed integer: sign bit + unsigned-var magnitude.
+	KindInteger
+	// KindBoolean is a single bit.
+	KindBoolean
+	// KindEnum is the n-bit index of the value in the enumeration.
+	KindEnum
+)
+
+// ProdEnd is the Production.Elem value of an END production.
+const ProdEnd = 0xFFFF
+
+// Production is one entry of a state's production list.
+type Production struct {
+	Elem uint16 // index into GrammarTable.Elements, or ProdEnd
+	Next uint16 // state entered after the element (unused for END)
+}
+
+// GrammarState is a grammar state: a window of GrammarTable.Prods whose
+// position within the window is the event code.
+type GrammarState struct {
+	First uint16 // index of the first production
+	Count uint8  // number of productions
+	Bits  uint8  // event-code width
+}
+
+// ElementDecl describes a local element of a complex type.
+type ElementDecl struct {
+	Name       string
+	Kind       ValueKind
+	Type       uint16   // KindComplex: index into GrammarTable.Types
+	EnumValues []string // KindEnum: values in schema order
+	EnumBits   uint8    // KindEnum: width of the value index
+
+	// Optional and Repeated mirror minOccurs=0 and maxOccurs>1. The states
+	// already encode occurrence; code generators use these to shape output.
+	Optional, Repeated bool
+}
+
+// TypeGrammar is the element grammar of one complex type.
+type TypeGrammar struct {
+	Name      string
+	Start     uint16 // initial state
+	ElemFirst uint16 // first element of the type in GrammarTable.Elements
+	ElemCount uint16
+}
+
+// RootElement is a global element that may start a document.
+type RootElement struct {
+	Name string
+	Type uint16 // index into GrammarTable.Types
+	Code uint32 // document-level event code
+}
+
+// GrammarTable holds the grammars of a schema in flat arrays so the
+// interpreter touches a few contiguous slices instead of per-message code.
+// A table is immutable once built and safe for concurrent use.
+type GrammarTable struct {
+	Types    []TypeGrammar
+	States   []GrammarState
+	Prods    []Production
+	Elements []ElementDecl
+	Roots    []RootElement
+	RootBits uint8 // width of the document-level event code
+
+	// bindings caches reflect.Type -> *typeBinding.
+	bindings sync.Map
+}
+
+// typeBinding maps the elements of one TypeGrammar onto the fields of a Go
+// struct type. fields is indexed by element index minus ElemFirst; a nil
+// entry means the Go type has no field for the element.
+type typeBinding struct {
+	fields []*fieldBinding
+}
+
+type fieldBinding struct {
+	index    int          // struct field index
+	optional bool         // pointer field: nil means absent
+	array    bool         // slice field holding repeated elements
+	elemType reflect.Type // type of one value, after pointer/slice
+	child    *typeBinding // KindComplex
+}
+
+var errNoRoot = errors.New("grammar: no root element")
+
+// ErrGrammarMismatch is returned when a stream takes an event code the
+// table does not define, or a Go value cannot be expressed by the grammar.
+var ErrGrammarMismatch = errors.New("grammar: event does not match schema")
+
+// Root returns the root element whose name matches name.
+func (t *GrammarTable) Root(name string) (*RootElement, bool) {
+	for i := range t.Roots {
+		if t.Roots[i].Name == name {
+			return &t.Roots[i], true
+		}
+	}
+	return nil, false
+}
+
+// Encode writes the EXI header, the document-level event code for v's root
+// element and the element content. v must be a pointer to a struct whose
+// type name matches a root element (e.g. *generated.SessionSetupReq).
+func (t *GrammarTable) Encode(bs *BitStream, v interface{}) error {
+	rv := reflect.ValueOf(v)
+	if rv.Kind() != reflect.Ptr || rv.IsNil() || rv.Elem().Kind() != reflect.Struct {
+		return fmt.Errorf("grammar: Encode expects a non-nil struct pointer, got %T", v)
+	}
+	rv = rv.Elem()
+	root, ok := t.Root(rv.Type().Name())
+	if !ok {
+		return fmt.Errorf("%w for %s", errNoRoot, rv.Type().Name())
+	}
+	b, err := t.bind(root.Type, rv.Type())
+	if err != nil {
+		return err
+	}
+	if err := bs.WriteBits(8, 0x80); err != nil {
+		return err
+	}
+	if err := bs.WriteBits(int(t.RootBits), root.Code); err != nil {
+		return err
+	}
+	return t.encodeType(bs, root.Type, b, rv)
+}
+
+// EncodeStruct is the allocating convenience form of Encode. It measures the
+// document with a counting BitStream first and allocates it exactly once.
+func (t *GrammarTable) EncodeStruct(v interface{}) ([]byte, error) {
+	var bs BitStream
+	bs.initCounting()
+	if err := t.Encode(&bs, v); err != nil {
+		return nil, err
+	}
+	size := bs.Length()
+	if size > maxEncodeBufferSize {
+		return nil, fmt.Errorf("grammar: document of %d bytes exceeds %d: %w", size, maxEncodeBufferSize, ErrBitstreamOverflow)
+	}
+	buf := make([]byte, size)
+	bs.Init(buf, 0)
+	if err := t.Encode(&bs, v); err != nil {
+		return nil, err
+	}
+	return buf[:bs.Length()], nil
+}
+
+// Decode reads a document and stores it into proto, which must be a pointer
+// to the struct type of the root element found in the stream.
+func (t *GrammarTable) Decode(bs *BitStream, proto interface{}) error {
+	rv := reflect.ValueOf(proto)
+	if rv.Kind() != reflect.Ptr || rv.IsNil() || rv.Elem().Kind() != reflect.Struct {
+		return fmt.Errorf("grammar: Decode expects a non-nil struct pointer, got %T", proto)
+	}
+	rv = rv.Elem()
+	hdr, err := bs.ReadBits(8)
+	if err != nil {
+		return err
+	}
+	if hdr != 0x80 {
+		return fmt.Errorf("grammar: invalid EXI header 0x%02x", hdr)
+	}
+	code, err := bs.ReadBits(int(t.RootBits))
+	if err != nil {
+		return err
+	}
+	var root *RootElement
+	for i := range t.Roots {
+		if t.Roots[i].Code == code {
+			root = &t.Roots[i]
+			break
+		}
+	}
+	if root == nil {
+		return fmt.Errorf("%w: document event code %d", ErrGrammarMismatch, code)
+	}
+	if root.Name != rv.Type().Name() {
+		return fmt.Errorf("grammar: stream holds %s, cannot decode into %s", root.Name, rv.Type())
+	}
+	b, err := t.bind(root.Type, rv.Type())
+	if err != nil {
+		return err
+	}
+	return t.decodeType(bs, root.Type, b, rv)
+}
+
+// DecodeStruct decodes data into proto (see Decode) and returns proto.
+func (t *GrammarTable) DecodeStruct(data []byte, proto interface{}) (interface{}, error) {
+	var bs BitStream
+	bs.Init(data, 0)
+	if err := t.Decode(&bs, proto); err != nil {
+		return nil, err
+	}
+	return proto, nil
+}
+
+// encodeType runs the interpreter loop for one complex-type grammar.
+func (t *GrammarTable) encodeType(bs *BitStream, ti uint16, b *typeBinding, v reflect.Value) error {
+	tg := &t.Types[ti]
+	state := tg.Start
+	// Sequences visit one array at a time, so a single occurrence counter
+	// suffices: it counts emitted occurrences of lastElem.
+	lastElem, occ := uint16(ProdEnd), 0
+	for {
+		st := t.States[state]
+		prods := t.Prods[st.First : st.First+uint16(st.Count)]
+		chosen := -1
+		var fv reflect.Value
+		for i, p := range prods {
+			if p.Elem == ProdEnd {
+				chosen = i
+				break
+			}
+			fb := b.fields[p.Elem-tg.ElemFirst]
+			if fb == nil {
+				continue
+			}
+			f := v.Field(fb.index)
+			switch {
+			case fb.array:
+				n := 0
+				if p.Elem == lastElem {
+					n = occ
+				}
+				if n < f.Len() {
+					fv = f.Index(n)
+				} else {
+					continue
+				}
+			case fb.optional:
+				if f.IsNil() {
+					continue
+				}
+				fv = f.Elem()
+			default:
+				fv = f
+			}
+			chosen = i
+			break
+		}
+		if chosen < 0 {
+			return fmt.Errorf("%w: %s has no value for a required element in state %d", ErrGrammarMismatch, tg.Name, state)
+		}
+		if err := bs.WriteBits(int(st.Bits), uint32(chosen)); err != nil {
+			return err
+		}
+		p := prods[chosen]
+		if p.Elem == ProdEnd {
+			return nil
+		}
+		if p.Elem == lastElem {
+			occ++
+		} else {
+			lastElem, occ = p.Elem, 1
+		}
+		if err := t.encodeElement(bs, p.Elem, b.fields[p.Elem-tg.ElemFirst], fv); err != nil {
+			return fmt.Errorf("%s.%s: %w", tg.Name, t.Elements[p.Elem].Name, err)
+		}
+		state = p.Next
+	}
+}
+
+func (t *GrammarTable) encodeElement(bs *BitStream, ei uint16, fb *fieldBinding, v reflect.Value) error {
+	el := &t.Elements[ei]
+	if el.Kind == KindComplex {
+		return t.encodeType(bs, el.Type, fb.child, v)
+	}
+	// CHARACTERS
+	if err := bs.WriteBits(1, 0); err != nil {
+		return err
+	}
+	switch el.Kind {
+	case KindBinary, KindString:
+		var p []byte
+		if v.Kind() == reflect.String {
+			p = []byte(v.String())
+		} else {
+			p = v.Bytes()
+		}
+		if el.Kind == KindString {
+			if err := writeStringValue(bs, el.Name, p); err != nil {
+				return err
+			}
+			break
+		}
+		if err := bs.WriteUnsignedVar(uint64(len(p))); err != nil {
+			return err
+		}
+		if err := bs.WriteOctets(p); err != nil {
+			return err
+		}
+	case KindUnsigned:
+		if err := bs.WriteUnsignedVar(v.Uint()); err != nil {
+			return err
+		}
+	case KindInteger:
+		n := v.Int()
+		var sign uint32
+		mag := uint64(n)
+		if n < 0 {
+			sign, mag = 1, uint64(-(n + 1))
+		}
+		if err := bs.WriteBits(1, sign); err != nil {
+			return err
+		}
+		if err := bs.WriteUnsignedVar(mag); err != nil {
+			return err
+		}
+	case KindBoolean:
+		var bit uint32
+		if v.Bool() {
+			bit = 1
+		}
+		if err := bs.WriteBits(1, bit); err != nil {
+			return err
+		}
+	case KindEnum:
+		idx := -1
+		if v.Kind() == reflect.String {
+			s := v.String()
+			for i, ev := range el.EnumValues {
+				if ev == s {
+					idx = i
+					break
+				}
+			}
+		} else if u := v.Uint(); u < uint64(len(el.EnumValues)) {
+			idx = int(u)
+		}
+		if idx < 0 {
+			return fmt.Errorf("%w: %v is not a value of the enumeration", ErrGrammarMismatch, v.Interface())
+		}
+		if el.EnumBits > 0 {
+			if err := bs.WriteBits(int(el.EnumBits), uint32(idx)); err != nil {
+				return err
+			}
+		}
+	}
+	// END of the simple-typed element
+	return bs.WriteBits(1, 0)
+}
+
+// decodeType runs the interpreter loop for one complex-type grammar. b and
+// v may be nil/invalid, in which case the content is consumed and dropped.
+func (t *GrammarTable) decodeType(bs *BitStream, ti uint16, b *typeBinding, v reflect.Value) error {
+	tg := &t.Types[ti]
+	state := tg.Start
+	for {
+		st := t.States[state]
+		code, err := bs.ReadBits(int(st.Bits))
+		if err != nil {
+			return err
+		}
+		if code >= uint32(st.Count) {
+			return fmt.Errorf("%w: %s state %d event code %d", ErrGrammarMismatch, tg.Name, state, code)
+		}
+		p := t.Prods[st.First+uint16(code)]
+		if p.Elem == ProdEnd {
+			return nil
+		}
+		var fb *fieldBinding
+		if b != nil {
+			fb = b.fields[p.Elem-tg.ElemFirst]
+		}
+		if err := t.decodeElement(bs, p.Elem, fb, v); err != nil {
+			return fmt.Errorf("%s.%s: %w", tg.Name, t.Elements[p.Elem].Name, err)
+		}
+		state = p.Next
+	}
+}
+
+// decodeElement decodes one element into the field fb of parent.
+func (t *GrammarTable) decodeElement(bs *BitStream, ei uint16, fb *fieldBinding, parent reflect.Value) error {
+	el := &t.Elements[ei]
+
+	// Resolve the value to decode into: the field itself, a freshly
+	// allocated pointee, or a new slice element.
+	var dst reflect.Value
+	var child *typeBinding
+	if fb != nil && parent.IsValid() {
+		f := parent.Field(fb.index)
+		switch {
+		case fb.array:
+			f.Set(reflect.Append(f, reflect.Zero(fb.elemType)))
+			dst = f.Index(f.Len() - 1)
+		case fb.optional:
+			p := reflect.New(fb.elemType)
+			f.Set(p)
+			dst = p.Elem()
+		default:
+			dst = f
+		}
+		child = fb.child
+	}
+
+	if el.Kind == KindComplex {
+		return t.decodeType(bs, el.Type, child, dst)
+	}
+	if err := expectBit(bs, "CHARACTERS"); err != nil {
+		return err
+	}
+	switch el.Kind {
+	case KindBinary, KindString:
+		var p []byte
+		var err error
+		if el.Kind == KindString {
+			p, err = readStringValue(bs, el.Name)
+		} else {
+			var n uint64
+			if n, err = bs.ReadUnsignedVar(); err == nil {
+				if n > uint64(len(bs.data)) {
+					return ErrBitstreamOverflow
+				}
+				p, err = bs.readOctetSlice(int(n))
+			}
+		}
+		if err != nil {
+			return err
+		}
+		if dst.IsValid() {
+			if dst.Kind() == reflect.String {
+				dst.SetString(string(p))
+			} else {
+				dst.SetBytes(p)
+			}
+		}
+	case KindUnsigned:
+		u, err := bs.ReadUnsignedVar()
+		if err != nil {
+			return err
+		}
+		if dst.IsValid() {
+			dst.SetUint(u)
+		}
+	case KindInteger:
+		sign, err := bs.ReadBits(1)
+		if err != nil {
+			return err
+		}
+		mag, err := bs.ReadUnsignedVar()
+		if err != nil {
+			return err
+		}
+		n := int64(mag)
+		if sign == 1 {
+			n = -n - 1
+		}
+		if dst.IsValid() {
+			dst.SetInt(n)
+		}
+	case KindBoolean:
+		bit, err := bs.ReadBits(1)
+		if err != nil {
+			return err
+		}
+		if dst.IsValid() {
+			dst.SetBool(bit == 1)
+		}
+	case KindEnum:
+		var idx uint32
+		if el.EnumBits > 0 {
+			var err error
+			if idx, err = bs.ReadBits(int(el.EnumBits)); err != nil {
+				return err
+			}
+		}
+		if idx >= uint32(len(el.EnumValues)) {
+			return fmt.Errorf("%w: enumeration index %d out of range", ErrGrammarMismatch, idx)
+		}
+		if dst.IsValid() {
+			if dst.Kind() == reflect.String {
+				dst.SetString(el.EnumValues[idx])
+			} else {
+				dst.SetUint(uint64(idx))
+			}
+		}
+	}
+	return expectBit(bs, "END")
+}
+
+// expectBit reads a 1-bit event code that must select the only production.
+func expectBit(bs *BitStream, event string) error {
+	bit, err := bs.ReadBits(1)
+	if err != nil {
+		return err
+	}
+	if bit != 0 {
+		return fmt.Errorf("%w: expected %s", ErrGrammarMismatch, event)
+	}
+	return nil
+}
+
+// bind returns the (cached) binding of type grammar ti to Go struct type rt.
+func (t *GrammarTable) bind(ti uint16, rt reflect.Type) (*typeBinding, error) {
+	type key struct {
+		ti uint16
+		rt reflect.Type
+	}
+	if b, ok := t.bindings.Load(key{ti, rt}); ok {
+		return b.(*typeBinding), nil
+	}
+	tg := &t.Types[ti]
+	b := &typeBinding{fields: make([]*fieldBinding, tg.ElemCount)}
+	for i := range b.fields {
+		el := &t.Elements[tg.ElemFirst+uint16(i)]
+		sf, ok := structFieldFor(rt, el.Name)
+		if !ok {
+			continue
+		}
+		fb, err := t.bindField(el, sf)
+		if err != nil {
+			return nil, fmt.Errorf("grammar: %s.%s: %w", rt.Name(), sf.Name, err)
+		}
+		b.fields[i] = fb
+	}
+	actual, _ := t.bindings.LoadOrStore(key{ti, rt}, b)
+	return actual.(*typeBinding), nil
+}
+
+func (t *GrammarTable) bindField(el *ElementDecl, sf reflect.StructField) (*fieldBinding, error) {
+	fb := &fieldBinding{index: sf.Index[0], elemType: sf.Type}
+	switch {
+	case sf.Type.Kind() == reflect.Ptr:
+		fb.optional, fb.elemType = true, sf.Type.Elem()
+	case sf.Type.Kind() == reflect.Slice && sf.Type.Elem().Kind() != reflect.Uint8:
+		fb.array, fb.elemType = true, sf.Type.Elem()
+	case sf.Type.Kind() == reflect.Slice && el.Kind != KindBinary && el.Kind != KindString:
+		// []byte for a non-octet element is a repeated unsignedByte.
+		fb.array, fb.elemType = true, sf.Type.Elem()
+	}
+	k := fb.elemType.Kind()
+	ok := false
+	switch el.Kind {
+	case KindComplex:
+		if k == reflect.Struct {
+			child, err := t.bind(el.Type, fb.elemType)
+			if err != nil {
+				return nil, err
+			}
+			fb.child, ok = child, true
+		}
+	case KindBinary, KindString:
+		ok = k == reflect.String || (k == reflect.Slice && fb.elemType.Elem().Kind() == reflect.Uint8)
+	case KindUnsigned:
+		ok = k >= reflect.Uint && k <= reflect.Uint64
+	case KindInteger:
+		ok = k >= reflect.Int && k <= reflect.Int64
+	case KindBoolean:
+		ok = k == reflect.Bool
+	case KindEnum:
+		ok = k == reflect.String || (k >= reflect.Uint && k <= reflect.Uint64)
+	}
+	if !ok {
+		return nil, fmt.Errorf("Go type %s cannot hold element %s", sf.Type, el.Name)
+	}
+	return fb, nil
+}
+
+// structFieldFor finds the field of rt bound to element name: an exported
+// field of the same name, or one whose xml tag names the element.
+func structFieldFor(rt reflect.Type, name string) (reflect.StructField, bool) {
+	if sf, ok := rt.FieldByName(name); ok && sf.PkgPath == "" && len(sf.Index) == 1 {
+		return sf, true
+	}
+	for i := 0; i < rt.NumField(); i++ {
+		sf := rt.Field(i)
+		if sf.PkgPath != "" {
+			continue
+		}
+		tag := strings.Split(sf.Tag.Get("xml"), ",")[0]
+		if tag == name {
+			return sf, true
+		}
+	}
+	return reflect.StructField{}, false
+}
@@ -0,0 +1,386 @@
+package exi
+
+import (
+	"encoding/binary"
+	"errors"
+	"fmt"
+	"hash/crc32"
+	"math"
+	"unsafe"
+)
+
+// This file implements the binary grammar cache: a GrammarTable serialized
+// with the hash of the schema sources it was built from, so a process can
+// load its grammars without reading and parsing the XSDs (see
+// schema.LoadGrammar). The layout is little-endian fixed-size records at
+// 4-byte aligned offsets, so the file can be used from a read-only mapping:
+//
+//	header     grammarCacheHeaderSize bytes (magic, version, CRC-32C of
+//	           everything after the header, source hash, record counts)
+//	types      16 bytes each: name, Start, ElemFirst, ElemCount
+//	states      4 bytes each: First, Count, Bits
+//	prods       4 bytes each: Elem, Next
+//	elements   20 bytes each: name, enum values, Type, Kind, EnumBits, flags
+//	enums       8 bytes each: enumeration value
+//	roots      16 bytes each: name, Code, Type
+//	sources    56 bytes each: schema source path, size, modification time,
+//	           SHA-256 of the content
+//	strings    the bytes of every name, value and path
+//
+// A string is an (offset, length) pair into the strings section.
+// UnmarshalBinary copies the strings section once and slices every string
+// out of the copy; UnmarshalBinaryAlias slices them out of the data itself,
+// which is how schema.ReadGrammarCache loads a mapped file.
+
+// GrammarCacheVersion is the version of the cache layout written by
+// MarshalBinary. Caches of other versions are rejected.
+const GrammarCacheVersion = 2
+
+// ErrGrammarCache is returned (wrapped) for data that is not a valid grammar
+// cache of GrammarCacheVersion.
+var ErrGrammarCache = errors.New("grammar cache: invalid cache")
+
+const (
+	grammarCacheMagic      = "EXIGRAMC"
+	grammarCacheHeaderSize = 96
+
+	cacheTypeSize    = 16
+	cacheStateSize   = 4
+	cacheProdSize    = 4
+	cacheElementSize = 20
+	cacheStringSize  = 8
+	cacheRootSize    = 16
+	cacheSourceSize  = 56
+
+	cacheFlagOptional = 1 << 0
+	cacheFlagRepeated = 1 << 1
+)
+
+var castagnoli = crc32.MakeTable(crc32.Castagnoli)
+
+// GrammarCache is a GrammarTable together with the identity of the schema
+// sources it was compiled from.
+type GrammarCache struct {
+	// SourceHash identifies the schema sources and build options of Table;
+	// a cache whose hash differs from that of the current sources is stale.
+	SourceHash [32]byte
+	// Sources are the schema files Table was compiled from, as given to the
+	// compiler.
+	Sources []string
+	// SourceStamps, if set, holds one stamp per entry of Sources.
+	SourceStamps []SourceStamp
+	Table        *GrammarTable
+}
+
+// SourceStamp records a schema source as it was when the cache was compiled.
+// A loader may take Hash for the content of a file whose size and
+// modification time are unchanged instead of reading it again.
+type SourceStamp struct {
+	Size    int64
+	ModTime int64 // Unix nanoseconds
+	Hash    [32]byte
+}
+
+// cacheCounts are the record counts stored in the header.
+type cacheCounts struct {
+	types, states, prods, elements, enums, roots, sources, strings uint32
+}
+
+func (n *cacheCounts) size() int {
+	return grammarCacheHeaderSize +
+		int(n.types)*cacheTypeSize +
+		int(n.states)*cacheStateSize +
+		int(n.prods)*cacheProdSize +
+		int(n.elements)*cacheElementSize +
+		int(n.enums)*cacheStringSize +
+		int(n.roots)*cacheRootSize +
+		int(n.sources)*cacheSourceSize +
+		int(n.strings)
+}
+
+// MarshalBinary serializes the cache in the layout described above.
+func (c *GrammarCache) MarshalBinary() ([]byte, error) {
+	t := c.Table
+	if t == nil {
+		return nil, fmt.Errorf("%w: no table", ErrGrammarCache)
+	}
+	if c.SourceStamps != nil && len(c.SourceStamps) != len(c.Sources) {
+		return nil, fmt.Errorf("%w: %d source stamps for %d sources", ErrGrammarCache, len(c.SourceStamps), len(c.Sources))
+	}
+	var strs []byte
+	offsets := map[string]uint32{}
+	ref := func(s string) (uint32, uint32) {
+		off, ok := offsets[s]
+		if !ok {
+			off = uint32(len(strs))
+			offsets[s] = off
+			strs = append(strs, s...)
+		}
+		return off, uint32(len(s))
+	}
+
+	n := cacheCounts{
+		types:    uint32(len(t.Types)),
+		states:   uint32(len(t.States)),
+		prods:    uint32(len(t.Prods)),
+		elements: uint32(len(t.Elements)),
+		roots:    uint32(len(t.Roots)),
+		sources:  uint32(len(c.Sources)),
+	}
+	for i := range t.Elements {
+		if len(t.Elements[i].EnumValues) > math.MaxUint16 {
+			return nil, fmt.Errorf("%w: element %s has %d enumeration values", ErrGrammarCache, t.Elements[i].Name, len(t.Elements[i].EnumValues))
+		}
+		n.enums += uint32(len(t.Elements[i].EnumValues))
+	}
+	// The strings are appended once the records have collected them.
+	body := make([]byte, n.size()-grammarCacheHeaderSize)
+	le := binary.LittleEndian
+	p := body
+	putString := func(b []byte, s string) {
+		off, l := ref(s)
+		le.PutUint32(b, off)
+		le.PutUint32(b[4:], l)
+	}
+	for _, tg := range t.Types {
+		putString(p, tg.Name)
+		le.PutUint16(p[8:], tg.Start)
+		le.PutUint16(p[10:], tg.ElemFirst)
+		le.PutUint16(p[12:], tg.ElemCount)
+		p = p[cacheTypeSize:]
+	}
+	for _, st := range t.States {
+		le.PutUint16(p, st.First)
+		p[2] = st.Count
+		p[3] = st.Bits
+		p = p[cacheStateSize:]
+	}
+	for _, pr := range t.Prods {
+		le.PutUint16(p, pr.Elem)
+		le.PutUint16(p[2:], pr.Next)
+		p = p[cacheProdSize:]
+	}
+	enums := p[n.elements*cacheElementSize:]
+	var enumFirst uint32
+	for i := range t.Elements {
+		el := &t.Elements[i]
+		putString(p, el.Name)
+		le.PutUint32(p[8:], enumFirst)
+		le.PutUint16(p[12:], uint16(len(el.EnumValues)))
+		le.PutUint16(p[14:], el.Type)
+		p[16] = byte(el.Kind)
+		p[17] = el.EnumBits
+		var flags byte
+		if el.Optional {
+			flags |= cacheFlagOptional
+		}
+		if el.Repeated {
+			flags |= cacheFlagRepeated
+		}
+		p[18] = flags
+		p = p[cacheElementSize:]
+		for _, v := range el.EnumValues {
+			putString(enums[enumFirst*cacheStringSize:], v)
+			enumFirst++
+		}
+	}
+	p = p[n.enums*cacheStringSize:]
+	for _, r := range t.Roots {
+		putString(p, r.Name)
+		le.PutUint32(p[8:], r.Code)
+		le.PutUint16(p[12:], r.Type)
+		p = p[cacheRootSize:]
+	}
+	for i, s := range c.Sources {
+		putString(p, s)
+		if c.SourceStamps != nil {
+			st := &c.SourceStamps[i]
+			le.PutUint64(p[8:], uint64(st.Size))
+			le.PutUint64(p[16:], uint64(st.ModTime))
+			copy(p[24:56], st.Hash[:])
+		}
+		p = p[cacheSourceSize:]
+	}
+	n.strings = uint32(len(strs))
+	body = append(body, strs...)
+
+	out := make([]byte, grammarCacheHeaderSize, grammarCacheHeaderSize+len(body))
+	copy(out, grammarCacheMagic)
+	le.PutUint32(out[8:], GrammarCacheVersion)
+	le.PutUint32(out[12:], crc32.Checksum(body, castagnoli))
+	copy(out[16:48], c.SourceHash[:])
+	for i, v := range []uint32{n.types, n.states, n.prods, n.elements, n.enums, n.roots, n.sources, n.strings} {
+		le.PutUint32(out[48+4*i:], v)
+	}
+	out[80] = t.RootBits
+	return append(out, body...), nil
+}
+
+// UnmarshalBinary loads a cache written by MarshalBinary. It checks the
+// magic, version, checksum and every index in the table, so a truncated,
+// corrupted or foreign file is reported as ErrGrammarCache instead of
+// producing a table the interpreter would misread. data is not retained.
+func (c *GrammarCache) UnmarshalBinary(data []byte) error {
+	return c.unmarshal(data, false)
+}
+
+// UnmarshalBinaryAlias is UnmarshalBinary without copying the strings: the
+// names and values of the table point into data, which must then never be
+// modified, or released while the table is in use. It suits data that is
+// read-only anyway, such as a mapped file.
+func (c *GrammarCache) UnmarshalBinaryAlias(data []byte) error {
+	return c.unmarshal(data, true)
+}
+
+func (c *GrammarCache) unmarshal(data []byte, alias bool) error {
+	if len(data) < grammarCacheHeaderSize || string(data[:8]) != grammarCacheMagic {
+		return fmt.Errorf("%w: bad magic", ErrGrammarCache)
+	}
+	le := binary.LittleEndian
+	if v := le.Uint32(data[8:]); v != GrammarCacheVersion {
+		return fmt.Errorf("%w: version %d, want %d", ErrGrammarCache, v, GrammarCacheVersion)
+	}
+	var nv [8]uint32
+	for i := range nv {
+		nv[i] = le.Uint32(data[48+4*i:])
+		if nv[i] > math.MaxInt32/cacheSourceSize { // the largest record
+			return fmt.Errorf("%w: bad record count", ErrGrammarCache)
+		}
+	}
+	n := cacheCounts{nv[0], nv[1], nv[2], nv[3], nv[4], nv[5], nv[6], nv[7]}
+	if n.size() != len(data) {
+		return fmt.Errorf("%w: %d bytes, header describes %d", ErrGrammarCache, len(data), n.size())
+	}
+	body := data[grammarCacheHeaderSize:]
+	if crc32.Checksum(body, castagnoli) != le.Uint32(data[12:]) {
+		return fmt.Errorf("%w: checksum mismatch", ErrGrammarCache)
+	}
+	var strs string
+	if b := body[len(body)-int(n.strings):]; !alias {
+		strs = string(b)
+	} else if len(b) > 0 {
+		strs = unsafe.String(&b[0], len(b))
+	}
+	var bad error
+	getString := func(b []byte) string {
+		off, l := le.Uint32(b), le.Uint32(b[4:])
+		if uint64(off)+uint64(l) > uint64(len(strs)) {
+			bad = fmt.Errorf("%w: string out of range", ErrGrammarCache)
+			return ""
+		}
+		return strs[off : off+l]
+	}
+
+	t := &GrammarTable{
+		Types:    make([]TypeGrammar, n.types),
+		States:   make([]GrammarState, n.states),
+		Prods:    make([]Production, n.prods),
+		Elements: make([]ElementDecl, n.elements),
+		Roots:    make([]RootElement, n.roots),
+		RootBits: data[80],
+	}
+	p := body
+	for i := range t.Types {
+		t.Types[i] = TypeGrammar{
+			Name:      getString(p),
+			Start:     le.Uint16(p[8:]),
+			ElemFirst: le.Uint16(p[10:]),
+			ElemCount: le.Uint16(p[12:]),
+		}
+		p = p[cacheTypeSize:]
+	}
+	for i := range t.States {
+		t.States[i] = GrammarState{First: le.Uint16(p), Count: p[2], Bits: p[3]}
+		p = p[cacheStateSize:]
+	}
+	for i := range t.Prods {
+		t.Prods[i] = Production{Elem: le.Uint16(p), Next: le.Uint16(p[2:])}
+		p = p[cacheProdSize:]
+	}
+	enumRecs := p[n.elements*cacheElementSize:]
+	enums := make([]string, n.enums)
+	for i := range enums {
+		enums[i] = getString(enumRecs[i*cacheStringSize:])
+	}
+	for i := range t.Elements {
+		first, count := le.Uint32(p[8:]), uint32(le.Uint16(p[12:]))
+		if uint64(first)+uint64(count) > uint64(n.enums) {
+			return fmt.Errorf("%w: enumeration out of range", ErrGrammarCache)
+		}
+		el := ElementDecl{
+			Name:     getString(p),
+			Type:     le.Uint16(p[14:]),
+			Kind:     ValueKind(p[16]),
+			EnumBits: p[17],
+			Optional: p[18]&cacheFlagOptional != 0,
+			Repeated: p[18]&cacheFlagRepeated != 0,
+		}
+		if count > 0 {
+			el.EnumValues = enums[first : first+count : first+count]
+		}
+		t.Elements[i] = el
+		p = p[cacheElementSize:]
+	}
+	p = p[n.enums*cacheStringSize:]
+	for i := range t.Roots {
+		t.Roots[i] = RootElement{Name: getString(p), Code: le.Uint32(p[8:]), Type: le.Uint16(p[12:])}
+		p = p[cacheRootSize:]
+	}
+	sources := make([]string, n.sources)
+	var stamps []SourceStamp
+	if n.sources > 0 {
+		stamps = make([]SourceStamp, n.sources)
+	}
+	for i := range sources {
+		sources[i] = getString(p)
+		stamps[i].Size = int64(le.Uint64(p[8:]))
+		stamps[i].ModTime = int64(le.Uint64(p[16:]))
+		copy(stamps[i].Hash[:], p[24:56])
+		p = p[cacheSourceSize:]
+	}
+	if bad != nil {
+		return bad
+	}
+	if err := t.validate(); err != nil {
+		return fmt.Errorf("%w: %v", ErrGrammarCache, err)
+	}
+	copy(c.SourceHash[:], data[16:48])
+	c.Sources = sources
+	c.SourceStamps = stamps
+	c.Table = t
+	return nil
+}
+
+// validate checks that every index in t refers to an existing entry, which
+// the interpreter relies on.
+func (t *GrammarTable) validate() error {
+	for _, tg := range t.Types {
+		if int(tg.Start) >= len(t.States) || int(tg.ElemFirst)+int(tg.ElemCount) > len(t.Elements) {
+			return fmt.Errorf("type %s out of range", tg.Name)
+		}
+	}
+	for i, st := range t.States {
+		if int(st.First)+int(st.Count) > len(t.Prods) || st.Bits > 32 {
+			return fmt.Errorf("state %d out of range", i)
+		}
+	}
+	for i, pr := range t.Prods {
+		if (pr.Elem != ProdEnd && int(pr.Elem) >= len(t.Elements)) || (pr.Elem != ProdEnd && int(pr.Next) >= len(t.States)) {
+			return fmt.Errorf("production %d out of range", i)
+		}
+	}
+	for _, el := range t.Elements {
+		if el.Kind > KindEnum || (el.Kind == KindComplex && int(el.Type) >= len(t.Types)) || el.EnumBits > 32 {
+			return fmt.Errorf("element %s out of range", el.Name)
+		}
+	}
+	for _, r := range t.Roots {
+		if int(r.Type) >= len(t.Types) {
+			return fmt.Errorf("root %s out of range", r.Name)
+		}
+	}
+	if t.RootBits > 32 {
+		return fmt.Errorf("root event code width %d", t.RootBits)
+	}
+	return nil
+}
@@ -57,23 +57,29 @@ func EncodeMeteringConfirmationReq(bs *BitStream, v *generated.MeteringConfirmat
 // It currently decodes only the shared MessageHeaderType. If SignedMeteringData
 // becomes part of the generated types, extend the decoder to parse it.
 func DecodeMeteringConfirmationReq(bs *BitStream) (*generated.MeteringConfirmationReq, error) {
+	return decodeNew(bs, decodeMeteringConfirmationReqInto)
+}
+
+// decodeMeteringConfirmationReqInto is DecodeMeteringConfirmationReq decoding into dst.
+func decodeMeteringConfirmationReqInto(bs *BitStream, dst *generated.MeteringConfirmationReq) error {
 	// START Header (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Decode shared MessageHeaderType
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// END MeteringConfirmationReq (1 bit, expect 0)
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.MeteringConfirmationReq{
-		Header: *header,
-	}, nil
+	*dst = generated.MeteringConfirmationReq{
+		Header: header,
+	}
+	return nil
 }
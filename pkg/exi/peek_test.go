@@ -0,0 +1,132 @@
+package exi
+
+import (
+	"bytes"
+	"os"
+	"path/filepath"
+	"reflect"
+	"testing"
+
+	"example.com/exi-go/pkg/v2g/generated"
+)
+
+// messageHeader returns the Header field of a decoded message.
+func messageHeader(v interface{}) generated.MessageHeaderType {
+	return reflect.ValueOf(v).Elem().FieldByName("Header").Interface().(generated.MessageHeaderType)
+}
+
+func TestPeekMessageHeaderGoldenVectors(t *testing.T) {
+	files, err := filepath.Glob(filepath.Join("..", "..", "testvectors", "*.exi"))
+	if err != nil || len(files) == 0 {
+		t.Fatalf("no test vectors: %v", err)
+	}
+	for _, f := range files {
+		data, err := os.ReadFile(f)
+		if err != nil {
+			t.Fatal(err)
+		}
+		full, err := DecodeStruct(data, nil)
+		if err != nil {
+			continue // covered by the golden decode tests
+		}
+		m, h, err := PeekMessageHeader(data)
+		if err != nil {
+			t.Errorf("%s: PeekMessageHeader: %v", filepath.Base(f), err)
+			continue
+		}
+		if m != MessageOf(full) {
+			t.Errorf("%s: peeked %s, decoded %T", filepath.Base(f), m.Name, full)
+		}
+		if want := messageHeader(full); !reflect.DeepEqual(h, want) {
+			t.Errorf("%s: header = %+v, want %+v", filepath.Base(f), h, want)
+		}
+
+		skipped, err := DecodeStructWithOptions(data, nil, DecodeOptions{SkipBinary: true})
+		if err != nil {
+			t.Errorf("%s: SkipBinary decode: %v", filepath.Base(f), err)
+			continue
+		}
+		if want := messageHeader(full); !reflect.DeepEqual(messageHeader(skipped), want) {
+			t.Errorf("%s: SkipBinary header = %+v, want %+v", filepath.Base(f), messageHeader(skipped), want)
+		}
+	}
+}
+
+func certificateInstallationResWithChain(certs int) *generated.CertificateInstallationRes {
+	chain := make([][]byte, certs)
+	for i := range chain {
+		chain[i] = bytes.Repeat([]byte{0x30, 0x82, byte(i)}, 300)
+	}
+	return &generated.CertificateInstallationRes{
+		Header:                   generated.MessageHeaderType{SessionID: []byte{0x0A, 0x1B, 0x2C, 0x3D}, TimeStamp: 1672531200},
+		ResponseCode:             "OK",
+		EVSEProcessing:           "Finished",
+		CPSCertificateChain:      generated.CertificateChain{Certificates: chain},
+		ContractCertificateChain: generated.CertificateChain{Certificates: chain},
+	}
+}
+
+func TestDecodeSkipBinary(t *testing.T) {
+	msg := certificateInstallationResWithChain(3)
+	data, err := EncodeStruct(msg)
+	if err != nil {
+		t.Fatal(err)
+	}
+	v, err := DecodeStructWithOptions(data, nil, DecodeOptions{SkipBinary: true})
+	if err != nil {
+		t.Fatal(err)
+	}
+	got := v.(*generated.CertificateInstallationRes)
+	if !reflect.DeepEqual(got.Header, msg.Header) || got.ResponseCode != "OK" || got.EVSEProcessing != "Finished" {
+		t.Fatalf("SkipBinary decoded %+v", got)
+	}
+	certs := got.CPSCertificateChain.Certificates
+	if len(certs) != 3 || certs[0] != nil || certs[2] != nil {
+		t.Fatalf("certificates were not skipped: %d entries", len(certs))
+	}
+
+	// Skipping still checks that the content is present.
+	if _, err := DecodeStructWithOptions(data[:len(data)-100], nil, DecodeOptions{SkipBinary: true}); err == nil {
+		t.Fatal("SkipBinary decode of a truncated message succeeded")
+	}
+	if _, _, err := PeekMessageHeader(data[:6]); err == nil {
+		t.Fatal("PeekMessageHeader of a truncated header succeeded")
+	}
+}
+
+func BenchmarkPeekMessageHeader(b *testing.B) {
+	for _, certs := range []int{0, 4} {
+		data, err := EncodeStruct(certificateInstallationResWithChain(certs))
+		if err != nil {
+			b.Fatal(err)
+		}
+		name := map[int]string{0: "NoCerts", 4: "FourCerts"}[certs]
+		b.Run(name+"/Peek", func(b *testing.B) {
+			b.ReportAllocs()
+			for i := 0; i < b.N; i++ {
+				if _, _, err := PeekMessageHeader(data); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+		b.Run(name+"/SkipBinary", func(b *testing.B) {
+			b.ReportAllocs()
+			d := NewDecoder()
+			d.Options.SkipBinary = true
+			for i := 0; i < b.N; i++ {
+				if _, err := d.Decode(data); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+		b.Run(name+"/Full", func(b *testing.B) {
+			b.ReportAllocs()
+			d := NewDecoder()
+			for i := 0; i < b.N; i++ {
+				if _, err := d.Decode(data); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+	}
+}
@@ -90,60 +90,66 @@ func EncodeVehicleCheckInReq(bs *BitStream, v *generated.VehicleCheckInReq) erro
 
 // DecodeVehicleCheckInReq decodes the VehicleCheckInReq body.
 func DecodeVehicleCheckInReq(bs *BitStream) (*generated.VehicleCheckInReq, error) {
+	return decodeNew(bs, decodeVehicleCheckInReqInto)
+}
+
+// decodeVehicleCheckInReqInto is DecodeVehicleCheckInReq decoding into dst.
+func decodeVehicleCheckInReqInto(bs *BitStream, dst *generated.VehicleCheckInReq) error {
 	// START Header
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// START EVCheckInStatus
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	evCheckInStatus, err := readString(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	// END EVCheckInStatus
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Optional ParkingMethod presence
 	p, err := bs.ReadBits(1)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	var parkingMethod *string
 	if p == 1 {
 		// START ParkingMethod
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
 		pm, err := readString(bs)
 		if err != nil {
-			return nil, err
+			return err
 		}
 		parkingMethod = &pm
 		// END ParkingMethod
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
 	}
 
 	// END VehicleCheckInReq
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.VehicleCheckInReq{
-		Header:          *header,
+	*dst = generated.VehicleCheckInReq{
+		Header:          header,
 		EVCheckInStatus: evCheckInStatus,
 		ParkingMethod:   parkingMethod,
-	}, nil
+	}
+	return nil
 }
 
 // -------------------------- VehicleCheckOutReq -----------------------------
@@ -219,55 +225,61 @@ func EncodeVehicleCheckOutReq(bs *BitStream, v *generated.VehicleCheckOutReq) er
 
 // DecodeVehicleCheckOutReq decodes the VehicleCheckOutReq body.
 func DecodeVehicleCheckOutReq(bs *BitStream) (*generated.VehicleCheckOutReq, error) {
+	return decodeNew(bs, decodeVehicleCheckOutReqInto)
+}
+
+// decodeVehicleCheckOutReqInto is DecodeVehicleCheckOutReq decoding into dst.
+func decodeVehicleCheckOutReqInto(bs *BitStream, dst *generated.VehicleCheckOutReq) error {
 	// START Header
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// START EVCheckOutStatus
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	evCheckOutStatus, err := readString(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	// END EVCheckOutStatus
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// START CheckOutTime
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// CheckOutTime encoding flag
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	checkOutTime, err := bs.ReadUnsignedVar()
 	if err != nil {
-		return nil, err
+		return err
 	}
 	// END CheckOutTime
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// END VehicleCheckOutReq
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.VehicleCheckOutReq{
-		Header:           *header,
+	*dst = generated.VehicleCheckOutReq{
+		Header:           header,
 		EVCheckOutStatus: evCheckOutStatus,
 		CheckOutTime:     checkOutTime,
-	}, nil
+	}
+	return nil
 }
 
 // ------------------------- ServiceSelectionReq -----------------------------
@@ -421,60 +433,70 @@ func encodeSelectedServiceList(bs *BitStream, v *generated.SelectedServiceList)
 
 // DecodeServiceSelectionReq decodes the ServiceSelectionReq body.
 func DecodeServiceSelectionReq(bs *BitStream) (*generated.ServiceSelectionReq, error) {
+	return decodeNew(bs, decodeServiceSelectionReqInto)
+}
+
+// decodeServiceSelectionReqInto is DecodeServiceSelectionReq decoding into dst.
+func decodeServiceSelectionReqInto(bs *BitStream, dst *generated.ServiceSelectionReq) error {
 	// START Header
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// START SelectedEnergyTransferService
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	selectedEnergyTransferService, err := decodeSelectedService(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	// END SelectedEnergyTransferService
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Optional SelectedVASList presence
 	p, err := bs.ReadBits(1)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	var selectedVASList *generated.SelectedServiceList
 	if p == 1 {
 		// START SelectedVASList
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
-		vasList, err := decodeSelectedServiceList(bs)
+		var old []generated.SelectedService
+		if dst.SelectedVASList != nil {
+			old = dst.SelectedVASList.SelectedServices
+		}
+		vasList, err := decodeSelectedServiceList(bs, old)
 		if err != nil {
-			return nil, err
+			return err
 		}
 		selectedVASList = vasList
 		// END SelectedVASList
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
 	}
 
 	// END ServiceSelectionReq
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.ServiceSelectionReq{
-		Header:                        *header,
+	*dst = generated.ServiceSelectionReq{
+		Header:                        header,
 		SelectedEnergyTransferService: *selectedEnergyTransferService,
 		SelectedVASList:               selectedVASList,
-	}, nil
+	}
+	return nil
 }
 
 // decodeSelectedService decodes a SelectedService.
@@ -528,15 +550,19 @@ func decodeSelectedService(bs *BitStream) (*generated.SelectedService, error) {
 	}, nil
 }
 
-// decodeSelectedServiceList decodes a SelectedServiceList.
-func decodeSelectedServiceList(bs *BitStream) (*generated.SelectedServiceList, error) {
+// decodeSelectedServiceList decodes a SelectedServiceList, refilling old
+// if it can (see reuseList).
+func decodeSelectedServiceList(bs *BitStream, old []generated.SelectedService) (*generated.SelectedServiceList, error) {
 	// Read array length
-	count, err := bs.ReadUnsignedVar()
+	count, err := readListCount(bs)
 	if err != nil {
 		return nil, err
 	}
 
-	services := make([]generated.SelectedService, count)
+	services := reuseList(bs, old, int(count))
+	if services == nil {
+		services = bs.arena.selectedServiceList(int(count))
+	}
 	for i := uint64(0); i < count; i++ {
 		// START SelectedService
 		if _, err := bs.ReadBits(1); err != nil {
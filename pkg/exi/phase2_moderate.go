@@ -230,86 +230,91 @@ func encodePnC_ASResAuthorizationMode(bs *BitStream, v *generated.PnC_ASResAutho
 
 // DecodeAuthorizationSetupRes decodes the AuthorizationSetupRes body.
 func DecodeAuthorizationSetupRes(bs *BitStream) (*generated.AuthorizationSetupRes, error) {
+	return decodeNew(bs, decodeAuthorizationSetupResInto)
+}
+
+// decodeAuthorizationSetupResInto is DecodeAuthorizationSetupRes decoding into dst.
+func decodeAuthorizationSetupResInto(bs *BitStream, dst *generated.AuthorizationSetupRes) error {
 	// START Header
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// START ResponseCode
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// ResponseCode encoding flag
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	rcEnum, err := bs.ReadBits(6)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	responseCode := mapEnumToResponseCode(uint8(rcEnum))
 	// END ResponseCode
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// START AuthorizationServices
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// Read array length
-	count, err := bs.ReadUnsignedVar()
+	count, err := readListCount(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
-	authServices := make([]string, count)
+	authServices := bs.arena.stringList(int(count))
 	for i := uint64(0); i < count; i++ {
 		// START service
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
 		service, err := readString(bs)
 		if err != nil {
-			return nil, err
+			return err
 		}
 		authServices[i] = service
 		// END service
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
 	}
 	// END AuthorizationServices
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// START CertificateInstallationService
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// Boolean encoding flag
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// Boolean value
 	certInstallBit, err := bs.ReadBits(1)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	certInstallService := certInstallBit == 1
 	// END CertificateInstallationService
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Optional mode choice (2 bits)
 	choice, err := bs.ReadBits(2)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	var eimMode *generated.EIM_ASResAuthorizationMode
@@ -319,51 +324,52 @@ func DecodeAuthorizationSetupRes(bs *BitStream) (*generated.AuthorizationSetupRe
 		// EIM mode
 		// START EIM_ASResAuthorizationMode
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
 		eim, err := decodeEIM_ASResAuthorizationMode(bs)
 		if err != nil {
-			return nil, err
+			return err
 		}
 		eimMode = eim
 		// END EIM_ASResAuthorizationMode
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
 		// END message
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
 	} else if choice == 1 {
 		// PnC mode
 		// START PnC_ASResAuthorizationMode
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
 		pnc, err := decodePnC_ASResAuthorizationMode(bs)
 		if err != nil {
-			return nil, err
+			return err
 		}
 		pncMode = pnc
 		// END PnC_ASResAuthorizationMode
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
 		// END message
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
 	}
 	// else choice == 2, no mode, message already ended
 
-	return &generated.AuthorizationSetupRes{
-		Header:                         *header,
+	*dst = generated.AuthorizationSetupRes{
+		Header:                         header,
 		ResponseCode:                   responseCode,
 		AuthorizationServices:          authServices,
 		CertificateInstallationService: certInstallService,
 		EIM_ASResAuthorizationMode:     eimMode,
 		PnC_ASResAuthorizationMode:     pncMode,
-	}, nil
+	}
+	return nil
 }
 
 // decodeEIM_ASResAuthorizationMode decodes an EIM authorization mode.
@@ -388,13 +394,9 @@ func decodePnC_ASResAuthorizationMode(bs *BitStream) (*generated.PnC_ASResAuthor
 		return nil, err
 	}
 	// Read bytes
-	genChallenge := make([]byte, genChallengeLen)
-	for i := 0; i < int(genChallengeLen); i++ {
-		b, err := bs.ReadOctet()
-		if err != nil {
-			return nil, err
-		}
-		genChallenge[i] = b
+	genChallenge, err := bs.readOctetSlice(int(genChallengeLen))
+	if err != nil {
+		return nil, err
 	}
 	// END GenChallenge
 	if _, err := bs.ReadBits(1); err != nil {
@@ -406,11 +408,11 @@ func decodePnC_ASResAuthorizationMode(bs *BitStream) (*generated.PnC_ASResAuthor
 		return nil, err
 	}
 	// Read array length
-	count, err := bs.ReadUnsignedVar()
+	count, err := readListCount(bs)
 	if err != nil {
 		return nil, err
 	}
-	providers := make([]string, count)
+	providers := bs.arena.stringList(int(count))
 	for i := uint64(0); i < count; i++ {
 		// START provider
 		if _, err := bs.ReadBits(1); err != nil {
@@ -498,41 +500,47 @@ func EncodeScheduleExchangeReq(bs *BitStream, v *generated.ScheduleExchangeReq)
 
 // DecodeScheduleExchangeReq decodes the ScheduleExchangeReq body.
 func DecodeScheduleExchangeReq(bs *BitStream) (*generated.ScheduleExchangeReq, error) {
+	return decodeNew(bs, decodeScheduleExchangeReqInto)
+}
+
+// decodeScheduleExchangeReqInto is DecodeScheduleExchangeReq decoding into dst.
+func decodeScheduleExchangeReqInto(bs *BitStream, dst *generated.ScheduleExchangeReq) error {
 	// START Header
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// START MaximumSupportingPoints
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// MaximumSupportingPoints encoding flag
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	maxSupportingPoints, err := readUint16(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	// END MaximumSupportingPoints
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// END ScheduleExchangeReq
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.ScheduleExchangeReq{
-		Header:                  *header,
+	*dst = generated.ScheduleExchangeReq{
+		Header:                  header,
 		MaximumSupportingPoints: maxSupportingPoints,
-	}, nil
+	}
+	return nil
 }
 
 // ------------------------ ScheduleExchangeRes ------------------------------
@@ -615,59 +623,65 @@ func EncodeScheduleExchangeRes(bs *BitStream, v *generated.ScheduleExchangeRes)
 
 // DecodeScheduleExchangeRes decodes the ScheduleExchangeRes body.
 func DecodeScheduleExchangeRes(bs *BitStream) (*generated.ScheduleExchangeRes, error) {
+	return decodeNew(bs, decodeScheduleExchangeResInto)
+}
+
+// decodeScheduleExchangeResInto is DecodeScheduleExchangeRes decoding into dst.
+func decodeScheduleExchangeResInto(bs *BitStream, dst *generated.ScheduleExchangeRes) error {
 	// START Header
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// START ResponseCode
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// ResponseCode encoding flag
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	rcEnum, err := bs.ReadBits(6)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	responseCode := mapEnumToResponseCode(uint8(rcEnum))
 	// END ResponseCode
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// START EVSEProcessing
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// EVSEProcessing encoding flag
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	evseProcessingEnum, err := bs.ReadBits(2)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	evseProcessing := mapEnumToEVSEProcessing(uint8(evseProcessingEnum))
 	// END EVSEProcessing
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// END ScheduleExchangeRes
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.ScheduleExchangeRes{
-		Header:         *header,
+	*dst = generated.ScheduleExchangeRes{
+		Header:         header,
 		ResponseCode:   responseCode,
 		EVSEProcessing: evseProcessing,
-	}, nil
+	}
+	return nil
 }
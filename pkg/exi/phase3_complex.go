@@ -277,132 +277,143 @@ func encodeRationalNumber(bs *BitStream, v *generated.RationalNumber) error {
 
 // DecodePowerDeliveryReq decodes the PowerDeliveryReq body.
 func DecodePowerDeliveryReq(bs *BitStream) (*generated.PowerDeliveryReq, error) {
+	return decodeNew(bs, decodePowerDeliveryReqInto)
+}
+
+// decodePowerDeliveryReqInto is DecodePowerDeliveryReq decoding into dst.
+func decodePowerDeliveryReqInto(bs *BitStream, dst *generated.PowerDeliveryReq) error {
 	// START Header
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// START EVProcessing
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// EVProcessing encoding flag
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	evProcessingEnum, err := bs.ReadBits(2)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	evProcessing := mapEnumToEVSEProcessing(uint8(evProcessingEnum))
 	// END EVProcessing
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// START ChargeProgress
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	chargeProgress, err := readString(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	// END ChargeProgress
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Optional choice (3 bits)
 	choice, err := bs.ReadBits(3)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	var evPowerProfile *generated.EVPowerProfile
 	var bptChannelSelection *string
+	var oldEntries []generated.EVPowerProfileEntry
+	if dst.EVPowerProfile != nil {
+		oldEntries = dst.EVPowerProfile.Entries
+	}
 
 	if choice == 0 {
 		// Both present
 		// START EVPowerProfile
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
-		profile, err := decodeEVPowerProfile(bs)
+		profile, err := decodeEVPowerProfile(bs, oldEntries)
 		if err != nil {
-			return nil, err
+			return err
 		}
 		evPowerProfile = profile
 		// END EVPowerProfile
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
 		// START BPT_ChannelSelection
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
 		bpt, err := readString(bs)
 		if err != nil {
-			return nil, err
+			return err
 		}
 		bptChannelSelection = &bpt
 		// END BPT_ChannelSelection
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
 	} else if choice == 1 {
 		// EVPowerProfile only
 		// START EVPowerProfile
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
-		profile, err := decodeEVPowerProfile(bs)
+		profile, err := decodeEVPowerProfile(bs, oldEntries)
 		if err != nil {
-			return nil, err
+			return err
 		}
 		evPowerProfile = profile
 		// END EVPowerProfile
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
 	} else if choice == 2 {
 		// BPT_ChannelSelection only
 		// START BPT_ChannelSelection
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
 		bpt, err := readString(bs)
 		if err != nil {
-			return nil, err
+			return err
 		}
 		bptChannelSelection = &bpt
 		// END BPT_ChannelSelection
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
 	}
 	// else choice == 3, neither present
 
 	// END PowerDeliveryReq
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.PowerDeliveryReq{
-		Header:               *header,
+	*dst = generated.PowerDeliveryReq{
+		Header:               header,
 		EVProcessing:         evProcessing,
 		ChargeProgress:       chargeProgress,
 		EVPowerProfile:       evPowerProfile,
 		BPT_ChannelSelection: bptChannelSelection,
-	}, nil
+	}
+	return nil
 }
 
-// decodeEVPowerProfile decodes an EVPowerProfile.
-func decodeEVPowerProfile(bs *BitStream) (*generated.EVPowerProfile, error) {
+// decodeEVPowerProfile decodes an EVPowerProfile, refilling the entries
+// old if it can (see reuseList).
+func decodeEVPowerProfile(bs *BitStream, old []generated.EVPowerProfileEntry) (*generated.EVPowerProfile, error) {
 	// START TimeAnchor
 	if _, err := bs.ReadBits(1); err != nil {
 		return nil, err
@@ -425,11 +436,14 @@ func decodeEVPowerProfile(bs *BitStream) (*generated.EVPowerProfile, error) {
 		return nil, err
 	}
 	// Read array length
-	count, err := bs.ReadUnsignedVar()
+	count, err := readListCount(bs)
 	if err != nil {
 		return nil, err
 	}
-	entries := make([]generated.EVPowerProfileEntry, count)
+	entries := reuseList(bs, old, int(count))
+	if entries == nil {
+		entries = bs.arena.powerProfileEntryList(int(count))
+	}
 	for i := uint64(0); i < count; i++ {
 		// START entry
 		if _, err := bs.ReadBits(1); err != nil {
@@ -742,32 +756,37 @@ func encodeCertificateChain(bs *BitStream, v *generated.CertificateChain) error
 
 // DecodeAuthorizationReq decodes the AuthorizationReq body.
 func DecodeAuthorizationReq(bs *BitStream) (*generated.AuthorizationReq, error) {
+	return decodeNew(bs, decodeAuthorizationReqInto)
+}
+
+// decodeAuthorizationReqInto is DecodeAuthorizationReq decoding into dst.
+func decodeAuthorizationReqInto(bs *BitStream, dst *generated.AuthorizationReq) error {
 	// START Header
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// START SelectedAuthorizationService
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	selectedAuthService, err := readString(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	// END SelectedAuthorizationService
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Union choice (2 bits)
 	choice, err := bs.ReadBits(2)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	var eimMode *generated.EIM_AReqAuthorizationMode
@@ -777,49 +796,54 @@ func DecodeAuthorizationReq(bs *BitStream) (*generated.AuthorizationReq, error)
 		// EIM mode
 		// START EIM_AReqAuthorizationMode
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
 		eim, err := decodeEIM_AReqAuthorizationMode(bs)
 		if err != nil {
-			return nil, err
+			return err
 		}
 		eimMode = eim
 		// END EIM_AReqAuthorizationMode
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
 		// END message
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
 	} else if choice == 1 {
 		// PnC mode
 		// START PnC_AReqAuthorizationMode
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
-		pnc, err := decodePnC_AReqAuthorizationMode(bs)
+		var oldChain [][]byte
+		if old := dst.PnC_AReqAuthorizationMode; old != nil && old.ContractCertificateChain != nil {
+			oldChain = old.ContractCertificateChain.Certificates
+		}
+		pnc, err := decodePnC_AReqAuthorizationMode(bs, oldChain)
 		if err != nil {
-			return nil, err
+			return err
 		}
 		pncMode = pnc
 		// END PnC_AReqAuthorizationMode
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
 		// END message
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
 	}
 	// else choice == 2, no mode, message already ended
 
-	return &generated.AuthorizationReq{
-		Header:                       *header,
+	*dst = generated.AuthorizationReq{
+		Header:                       header,
 		SelectedAuthorizationService: selectedAuthService,
 		EIM_AReqAuthorizationMode:    eimMode,
 		PnC_AReqAuthorizationMode:    pncMode,
-	}, nil
+	}
+	return nil
 }
 
 // decodeEIM_AReqAuthorizationMode decodes an EIM authorization mode.
@@ -828,8 +852,9 @@ func decodeEIM_AReqAuthorizationMode(bs *BitStream) (*generated.EIM_AReqAuthoriz
 	return &generated.EIM_AReqAuthorizationMode{}, nil
 }
 
-// decodePnC_AReqAuthorizationMode decodes a PnC authorization mode.
-func decodePnC_AReqAuthorizationMode(bs *BitStream) (*generated.PnC_AReqAuthorizationMode, error) {
+// decodePnC_AReqAuthorizationMode decodes a PnC authorization mode, passing
+// oldChain to decodeCertificateChain.
+func decodePnC_AReqAuthorizationMode(bs *BitStream, oldChain [][]byte) (*generated.PnC_AReqAuthorizationMode, error) {
 	// Optional GenChallenge presence
 	p1, err := bs.ReadBits(1)
 	if err != nil {
@@ -851,13 +876,9 @@ func decodePnC_AReqAuthorizationMode(bs *BitStream) (*generated.PnC_AReqAuthoriz
 			return nil, err
 		}
 		// Read bytes
-		genChallenge = make([]byte, genChallengeLen)
-		for i := 0; i < int(genChallengeLen); i++ {
-			b, err := bs.ReadOctet()
-			if err != nil {
-				return nil, err
-			}
-			genChallenge[i] = b
+		genChallenge, err = bs.readOctetSlice(int(genChallengeLen))
+		if err != nil {
+			return nil, err
 		}
 		// END GenChallenge
 		if _, err := bs.ReadBits(1); err != nil {
@@ -876,7 +897,7 @@ func decodePnC_AReqAuthorizationMode(bs *BitStream) (*generated.PnC_AReqAuthoriz
 		if _, err := bs.ReadBits(1); err != nil {
 			return nil, err
 		}
-		chain, err := decodeCertificateChain(bs)
+		chain, err := decodeCertificateChain(bs, oldChain)
 		if err != nil {
 			return nil, err
 		}
@@ -893,18 +914,23 @@ func decodePnC_AReqAuthorizationMode(bs *BitStream) (*generated.PnC_AReqAuthoriz
 	}, nil
 }
 
-// decodeCertificateChain decodes a CertificateChain.
-func decodeCertificateChain(bs *BitStream) (*generated.CertificateChain, error) {
+// decodeCertificateChain decodes a CertificateChain, refilling the list old
+// if it can (see reuseList). The certificates themselves are never reused:
+// with AliasInput they may point into an earlier input.
+func decodeCertificateChain(bs *BitStream, old [][]byte) (*generated.CertificateChain, error) {
 	// START Certificates
 	if _, err := bs.ReadBits(1); err != nil {
 		return nil, err
 	}
 	// Read array length
-	count, err := bs.ReadUnsignedVar()
+	count, err := readListCount(bs)
 	if err != nil {
 		return nil, err
 	}
-	certificates := make([][]byte, count)
+	certificates := reuseList(bs, old, int(count))
+	if certificates == nil {
+		certificates = bs.arena.binaryList(int(count))
+	}
 	for i := uint64(0); i < count; i++ {
 		// START certificate
 		if _, err := bs.ReadBits(1); err != nil {
@@ -920,13 +946,9 @@ func decodeCertificateChain(bs *BitStream) (*generated.CertificateChain, error)
 			return nil, err
 		}
 		// Read bytes
-		cert := make([]byte, certLen)
-		for j := 0; j < int(certLen); j++ {
-			b, err := bs.ReadOctet()
-			if err != nil {
-				return nil, err
-			}
-			cert[j] = b
+		cert, err := bs.readOctetSlice(int(certLen))
+		if err != nil {
+			return nil, err
 		}
 		certificates[i] = cert
 		// END certificate
@@ -1201,94 +1223,104 @@ func encodeParameter(bs *BitStream, v *generated.Parameter) error {
 
 // DecodeServiceDetailRes decodes the ServiceDetailRes body.
 func DecodeServiceDetailRes(bs *BitStream) (*generated.ServiceDetailRes, error) {
+	return decodeNew(bs, decodeServiceDetailResInto)
+}
+
+// decodeServiceDetailResInto is DecodeServiceDetailRes decoding into dst.
+func decodeServiceDetailResInto(bs *BitStream, dst *generated.ServiceDetailRes) error {
 	// START Header
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// START ResponseCode
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// ResponseCode encoding flag
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	rcEnum, err := bs.ReadBits(6)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	responseCode := mapEnumToResponseCode(uint8(rcEnum))
 	// END ResponseCode
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// START ServiceID
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// ServiceID encoding flag
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	serviceID, err := readUint16(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	// END ServiceID
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// START ServiceParameterList
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
-	paramList, err := decodeServiceParameterList(bs)
+	paramList, err := decodeServiceParameterList(bs, dst.ServiceParameterList.ParameterSets)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	// END ServiceParameterList
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// END ServiceDetailRes
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.ServiceDetailRes{
-		Header:               *header,
+	*dst = generated.ServiceDetailRes{
+		Header:               header,
 		ResponseCode:         responseCode,
 		ServiceID:            serviceID,
 		ServiceParameterList: *paramList,
-	}, nil
+	}
+	return nil
 }
 
-// decodeServiceParameterList decodes a ServiceParameterList.
-func decodeServiceParameterList(bs *BitStream) (*generated.ServiceParameterList, error) {
+// decodeServiceParameterList decodes a ServiceParameterList, refilling the
+// parameter sets old, and the parameters of each, if it can (see reuseList).
+func decodeServiceParameterList(bs *BitStream, old []generated.ParameterSet) (*generated.ServiceParameterList, error) {
 	// START ParameterSets
 	if _, err := bs.ReadBits(1); err != nil {
 		return nil, err
 	}
 	// Read array length
-	count, err := bs.ReadUnsignedVar()
+	count, err := readListCount(bs)
 	if err != nil {
 		return nil, err
 	}
-	parameterSets := make([]generated.ParameterSet, count)
+	parameterSets := reuseList(bs, old, int(count))
+	if parameterSets == nil {
+		parameterSets = bs.arena.parameterSetList(int(count))
+	}
 	for i := uint64(0); i < count; i++ {
 		// START parameter set
 		if _, err := bs.ReadBits(1); err != nil {
 			return nil, err
 		}
-		paramSet, err := decodeParameterSet(bs)
+		paramSet, err := decodeParameterSet(bs, parameterSets[i].Parameters)
 		if err != nil {
 			return nil, err
 		}
@@ -1308,8 +1340,9 @@ func decodeServiceParameterList(bs *BitStream) (*generated.ServiceParameterList,
 	}, nil
 }
 
-// decodeParameterSet decodes a ParameterSet.
-func decodeParameterSet(bs *BitStream) (*generated.ParameterSet, error) {
+// decodeParameterSet decodes a ParameterSet, refilling the parameters old if
+// it can (see reuseList).
+func decodeParameterSet(bs *BitStream, old []generated.Parameter) (*generated.ParameterSet, error) {
 	// START ParameterSetID
 	if _, err := bs.ReadBits(1); err != nil {
 		return nil, err
@@ -1332,11 +1365,14 @@ func decodeParameterSet(bs *BitStream) (*generated.ParameterSet, error) {
 		return nil, err
 	}
 	// Read array length
-	count, err := bs.ReadUnsignedVar()
+	count, err := readListCount(bs)
 	if err != nil {
 		return nil, err
 	}
-	parameters := make([]generated.Parameter, count)
+	parameters := reuseList(bs, old, int(count))
+	if parameters == nil {
+		parameters = bs.arena.parameterList(int(count))
+	}
 	for i := uint64(0); i < count; i++ {
 		// START parameter
 		if _, err := bs.ReadBits(1); err != nil {
@@ -95,68 +95,74 @@ func EncodeCertificateInstallationReq(bs *BitStream, v *generated.CertificateIns
 
 // DecodeCertificateInstallationReq decodes the CertificateInstallationReq body.
 func DecodeCertificateInstallationReq(bs *BitStream) (*generated.CertificateInstallationReq, error) {
+	return decodeNew(bs, decodeCertificateInstallationReqInto)
+}
+
+// decodeCertificateInstallationReqInto is DecodeCertificateInstallationReq decoding into dst.
+func decodeCertificateInstallationReqInto(bs *BitStream, dst *generated.CertificateInstallationReq) error {
 	// START Header
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// START OEMProvisioningCertChain
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
-	oemProvisioningCertChain, err := decodeCertificateChain(bs)
+	oemProvisioningCertChain, err := decodeCertificateChain(bs, dst.OEMProvisioningCertChain.Certificates)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	// END OEMProvisioningCertChain
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// START ListOfRootCertificateIDs
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// Read array length
-	count, err := bs.ReadUnsignedVar()
+	count, err := readListCount(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
-	rootCertIDs := make([]string, count)
+	rootCertIDs := bs.arena.stringList(int(count))
 	for i := uint64(0); i < count; i++ {
 		// START certID
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
 		certID, err := readString(bs)
 		if err != nil {
-			return nil, err
+			return err
 		}
 		rootCertIDs[i] = certID
 		// END certID
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
 	}
 	// END ListOfRootCertificateIDs
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// END CertificateInstallationReq
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.CertificateInstallationReq{
-		Header:                   *header,
+	*dst = generated.CertificateInstallationReq{
+		Header:                   header,
 		OEMProvisioningCertChain: *oemProvisioningCertChain,
 		ListOfRootCertificateIDs: rootCertIDs,
-	}, nil
+	}
+	return nil
 }
 
 // --------------------- CertificateInstallationRes --------------------------
@@ -297,129 +303,131 @@ func EncodeCertificateInstallationRes(bs *BitStream, v *generated.CertificateIns
 
 // DecodeCertificateInstallationRes decodes the CertificateInstallationRes body.
 func DecodeCertificateInstallationRes(bs *BitStream) (*generated.CertificateInstallationRes, error) {
+	return decodeNew(bs, decodeCertificateInstallationResInto)
+}
+
+// decodeCertificateInstallationResInto is DecodeCertificateInstallationRes decoding into dst.
+func decodeCertificateInstallationResInto(bs *BitStream, dst *generated.CertificateInstallationRes) error {
 	// START Header
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// START ResponseCode
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// ResponseCode encoding flag
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	rcEnum, err := bs.ReadBits(6)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	responseCode := mapEnumToResponseCode(uint8(rcEnum))
 	// END ResponseCode
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// START EVSEProcessing
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// EVSEProcessing encoding flag
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	evseProcessingEnum, err := bs.ReadBits(2)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	evseProcessing := mapEnumToEVSEProcessing(uint8(evseProcessingEnum))
 	// END EVSEProcessing
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// START CPSCertificateChain
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
-	cpsCertChain, err := decodeCertificateChain(bs)
+	cpsCertChain, err := decodeCertificateChain(bs, dst.CPSCertificateChain.Certificates)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	// END CPSCertificateChain
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// START ContractSignatureEncryptedPrivateKey
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	contractSigEncPrivKey, err := readString(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	// END ContractSignatureEncryptedPrivateKey
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// START DHPublicKey
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// hexBinary encoding flag
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// Read length
 	dhPubKeyLen, err := readUint16(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	// Read bytes
-	dhPublicKey := make([]byte, dhPubKeyLen)
-	for i := 0; i < int(dhPubKeyLen); i++ {
-		b, err := bs.ReadOctet()
-		if err != nil {
-			return nil, err
-		}
-		dhPublicKey[i] = b
+	dhPublicKey, err := bs.readOctetSlice(int(dhPubKeyLen))
+	if err != nil {
+		return err
 	}
 	// END DHPublicKey
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// START ContractCertificateChain
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
-	contractCertChain, err := decodeCertificateChain(bs)
+	contractCertChain, err := decodeCertificateChain(bs, dst.ContractCertificateChain.Certificates)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	// END ContractCertificateChain
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// END CertificateInstallationRes
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.CertificateInstallationRes{
-		Header:                               *header,
+	*dst = generated.CertificateInstallationRes{
+		Header:                               header,
 		ResponseCode:                         responseCode,
 		EVSEProcessing:                       evseProcessing,
 		CPSCertificateChain:                  *cpsCertChain,
 		ContractSignatureEncryptedPrivateKey: contractSigEncPrivKey,
 		DHPublicKey:                          dhPublicKey,
 		ContractCertificateChain:             *contractCertChain,
-	}, nil
+	}
+	return nil
 }
@@ -0,0 +1,83 @@
+package exi
+
+// sessionBlockOffset is the bit offset within its first byte at which the
+// SessionID block of a message header starts: every message begins with the
+// 8-bit EXI header, the 6-bit event code and the START Header bit.
+const sessionBlockOffset = (8 + messageCodeBits + 1) % 8
+
+// PreparedSession holds the part of a message header that stays the same for
+// every message of one charging session: the SessionID element and the
+// start of the TimeStamp element, encoded once by PrepareSession. Messages
+// encoded with Encoder.EncodeSessionInto or EncodeSessionTo copy it into
+// place instead of encoding it field by field, so a control-loop message
+// sent every few hundred milliseconds only encodes its TimeStamp and the
+// values that change.
+//
+// A PreparedSession is read-only once created and may be shared between
+// goroutines and Encoders.
+type PreparedSession struct {
+	sessionID []byte
+	// block is the encoded SessionID block, shifted so that it starts at
+	// bit sessionBlockOffset of block[0]; the bits before it are zero.
+	block []byte
+	// bits is the length of the block in bits.
+	bits int
+}
+
+// PrepareSession pre-encodes the header fields that depend only on
+// sessionID. The ID is copied.
+func PrepareSession(sessionID []byte) *PreparedSession {
+	id := append([]byte(nil), sessionID...)
+	buf := make([]byte, 3+UnsignedVarBits(uint64(uint16(len(id))))/8+len(id))
+	var bs BitStream
+	bs.Init(buf, 0)
+	bs.PutBits(sessionBlockOffset, 0)
+	if err := encodeSessionIDBlock(&bs, id); err != nil {
+		// buf is sized for the block, so this cannot happen.
+		panic("exi: PrepareSession: " + err.Error())
+	}
+	return &PreparedSession{
+		sessionID: id,
+		block:     buf[:bs.Length()],
+		bits:      8*bs.bytePos + int(bs.bitCount) - sessionBlockOffset,
+	}
+}
+
+// SessionID returns the session's ID. The slice must not be modified.
+func (s *PreparedSession) SessionID() []byte {
+	return s.sessionID
+}
+
+// writeSessionBlock writes the SessionID block of s to bs. Where the header is
+// at its usual offset this is one merge of the first byte and a copy of the
+// rest; elsewhere (e.g. the header-less certificate update messages) the
+// block is encoded normally.
+func writeSessionBlock(bs *BitStream, s *PreparedSession) error {
+	if bs.bitCount != sessionBlockOffset {
+		return encodeSessionIDBlock(bs, s.sessionID)
+	}
+	if bs.data == nil {
+		return bs.noData(s.bits)
+	}
+	if bs.bytePos+len(s.block) > bs.dataSize {
+		return ErrBitstreamOverflow
+	}
+	p := bs.data[bs.bytePos : bs.bytePos+len(s.block)]
+	p[0] = p[0]&^(0xFF>>sessionBlockOffset) | s.block[0]
+	copy(p[1:], s.block[1:])
+	bs.advance(s.bits)
+	return nil
+}
+
+// EncodeSessionInto is EncodeInto for a message of session s: the message's
+// Header.SessionID is ignored and the pre-encoded SessionID of s is written
+// in its place. Everything else, including Header.TimeStamp, comes from v.
+func (e *Encoder) EncodeSessionInto(buf []byte, s *PreparedSession, v interface{}) (int, error) {
+	return e.encodeInto(buf, s, v)
+}
+
+// EncodeSessionTo is EncodeTo for a message of session s; see
+// EncodeSessionInto.
+func (e *Encoder) EncodeSessionTo(dst []byte, s *PreparedSession, v interface{}) ([]byte, error) {
+	return e.appendTo(dst, v, s, 0, false)
+}
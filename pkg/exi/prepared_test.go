@@ -0,0 +1,147 @@
+package exi
+
+import (
+	"bytes"
+	"os"
+	"path/filepath"
+	"reflect"
+	"testing"
+
+	"example.com/exi-go/pkg/v2g/generated"
+)
+
+// TestEncodeSessionGoldenVectors re-encodes every test vector through a
+// PreparedSession for its SessionID, with the message's own SessionID
+// cleared, and expects the original bytes.
+func TestEncodeSessionGoldenVectors(t *testing.T) {
+	files, err := filepath.Glob(filepath.Join("..", "..", "testvectors", "*.exi"))
+	if err != nil || len(files) == 0 {
+		t.Fatalf("no test vectors: %v", err)
+	}
+	enc := NewEncoder()
+	for _, f := range files {
+		data, err := os.ReadFile(f)
+		if err != nil {
+			t.Fatal(err)
+		}
+		msg, err := DecodeStruct(data, nil)
+		if err != nil {
+			continue // covered by the golden decode tests
+		}
+		s := PrepareSession(messageHeader(msg).SessionID)
+		reflect.ValueOf(msg).Elem().FieldByName("Header").FieldByName("SessionID").SetBytes(nil)
+
+		got, err := enc.EncodeSessionTo(nil, s, msg)
+		if err != nil {
+			t.Errorf("%s: EncodeSessionTo: %v", filepath.Base(f), err)
+			continue
+		}
+		if !bytes.Equal(got, data) {
+			t.Errorf("%s: EncodeSessionTo = %x, want %x", filepath.Base(f), got, data)
+		}
+		buf := bytes.Repeat([]byte{0xFF}, len(data))
+		if n, err := enc.EncodeSessionInto(buf, s, msg); err != nil || !bytes.Equal(buf[:n], data) {
+			t.Errorf("%s: EncodeSessionInto into a dirty buffer = %x, %v", filepath.Base(f), buf[:n], err)
+		}
+		if _, err := enc.EncodeSessionInto(buf[:len(data)-1], s, msg); err == nil {
+			t.Errorf("%s: EncodeSessionInto into a short buffer succeeded", filepath.Base(f))
+		}
+	}
+}
+
+// TestWriteSessionBlockOffsets checks the pre-encoded block against the
+// field-by-field encoding at every bit offset, including the ones that take
+// the fallback path.
+func TestWriteSessionBlockOffsets(t *testing.T) {
+	for _, id := range [][]byte{nil, {0xAB}, {1, 2, 3, 4, 5, 6, 7, 8}} {
+		s := PrepareSession(id)
+		if !bytes.Equal(s.SessionID(), id) {
+			t.Fatalf("SessionID = %x, want %x", s.SessionID(), id)
+		}
+		for offset := 1; offset < 16; offset++ {
+			want := make([]byte, 16)
+			var ref BitStream
+			ref.Init(want, 0)
+			ref.PutBits(offset, 0x5555>>(16-offset))
+			if err := encodeSessionIDBlock(&ref, id); err != nil {
+				t.Fatal(err)
+			}
+
+			got := bytes.Repeat([]byte{0xFF}, 16)
+			var bs BitStream
+			bs.Init(got, 0)
+			bs.PutBits(offset, 0x5555>>(16-offset))
+			if err := writeSessionBlock(&bs, s); err != nil {
+				t.Fatal(err)
+			}
+			if bs.bytePos != ref.bytePos || bs.bitCount != ref.bitCount || !bytes.Equal(got[:ref.Length()], want[:ref.Length()]) {
+				t.Fatalf("id %x offset %d: wrote %x, want %x", id, offset, got[:bs.Length()], want[:ref.Length()])
+			}
+		}
+	}
+}
+
+func BenchmarkEncodeSession(b *testing.B) {
+	sid := []byte{0x0A, 0x1B, 0x2C, 0x3D, 0x4E, 0x5F, 0x60, 0x71}
+	msgs := []struct {
+		name string
+		msg  interface{}
+	}{
+		{"CLReqControlMode", &generated.CLReqControlMode{
+			Header: generated.MessageHeaderType{SessionID: sid, TimeStamp: 1700000000},
+		}},
+		{"PowerDeliveryReq", &generated.PowerDeliveryReq{
+			Header:         generated.MessageHeaderType{SessionID: sid, TimeStamp: 1700000000},
+			EVProcessing:   "Ongoing",
+			ChargeProgress: "Start",
+		}},
+	}
+	s := PrepareSession(sid)
+	buf := make([]byte, 256)
+	for _, m := range msgs {
+		b.Run(m.name+"/EncodeInto", func(b *testing.B) {
+			b.ReportAllocs()
+			enc := NewEncoder()
+			for i := 0; i < b.N; i++ {
+				if _, err := enc.EncodeInto(buf, m.msg); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+		b.Run(m.name+"/EncodeSessionInto", func(b *testing.B) {
+			b.ReportAllocs()
+			enc := NewEncoder()
+			for i := 0; i < b.N; i++ {
+				if _, err := enc.EncodeSessionInto(buf, s, m.msg); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+	}
+}
+
+// TestSessionWorkerEviction checks that a full session cache evicts one
+// session to make room, not all of them.
+func TestSessionWorkerEviction(t *testing.T) {
+	const limit = 4
+	w := &SessionWorker{sessions: map[string]*PreparedSession{}, maxSessions: limit}
+	prepared := map[byte]*PreparedSession{}
+	for id := byte(1); id <= 2*limit; id++ {
+		prepared[id] = w.Session([]byte{id})
+		if len(w.sessions) > limit {
+			t.Fatalf("%d sessions cached, max %d", len(w.sessions), limit)
+		}
+	}
+	if len(w.sessions) != limit {
+		t.Fatalf("%d sessions cached, want %d", len(w.sessions), limit)
+	}
+	// The newest session is always kept.
+	if s := w.sessions[string([]byte{2 * limit})]; s != prepared[2*limit] {
+		t.Error("the newest session was evicted")
+	}
+	for id, s := range w.sessions {
+		if prepared[id[0]] != s {
+			t.Errorf("session %x is not the one prepared", id)
+		}
+	}
+}
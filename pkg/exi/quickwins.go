@@ -106,57 +106,62 @@ func EncodePowerDeliveryRes(bs *BitStream, v *generated.PowerDeliveryRes) error
 
 // DecodePowerDeliveryRes decodes the PowerDeliveryRes body.
 func DecodePowerDeliveryRes(bs *BitStream) (*generated.PowerDeliveryRes, error) {
+	return decodeNew(bs, decodePowerDeliveryResInto)
+}
+
+// decodePowerDeliveryResInto is DecodePowerDeliveryRes decoding into dst.
+func decodePowerDeliveryResInto(bs *BitStream, dst *generated.PowerDeliveryRes) error {
 	// START Header
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// START ResponseCode
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// ResponseCode encoding flag
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	rcEnum, err := bs.ReadBits(6)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	responseCode := mapEnumToResponseCode(uint8(rcEnum))
 	// END ResponseCode
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Optional EVSEStatus presence
 	p, err := bs.ReadBits(1)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	var evseStatus *generated.EVSEStatus
 	if p == 1 {
 		// START EVSEStatus
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
 		// NotificationMaxDelay
 		nmd, err := readUint16(bs)
 		if err != nil {
-			return nil, err
+			return err
 		}
 		// EVSENotification
 		evsen, err := readString(bs)
 		if err != nil {
-			return nil, err
+			return err
 		}
 		// END EVSEStatus
 		if _, err := bs.ReadBits(1); err != nil {
-			return nil, err
+			return err
 		}
 		evseStatus = &generated.EVSEStatus{
 			NotificationMaxDelay: nmd,
@@ -166,14 +171,15 @@ func DecodePowerDeliveryRes(bs *BitStream) (*generated.PowerDeliveryRes, error)
 
 	// END PowerDeliveryRes
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.PowerDeliveryRes{
-		Header:       *header,
+	*dst = generated.PowerDeliveryRes{
+		Header:       header,
 		ResponseCode: responseCode,
 		EVSEStatus:   evseStatus,
-	}, nil
+	}
+	return nil
 }
 
 // ------------------------- VehicleCheckInRes -------------------------------
@@ -251,57 +257,63 @@ func EncodeVehicleCheckInRes(bs *BitStream, v *generated.VehicleCheckInRes) erro
 
 // DecodeVehicleCheckInRes decodes the VehicleCheckInRes body.
 func DecodeVehicleCheckInRes(bs *BitStream) (*generated.VehicleCheckInRes, error) {
+	return decodeNew(bs, decodeVehicleCheckInResInto)
+}
+
+// decodeVehicleCheckInResInto is DecodeVehicleCheckInRes decoding into dst.
+func decodeVehicleCheckInResInto(bs *BitStream, dst *generated.VehicleCheckInRes) error {
 	// START Header
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// START ResponseCode
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// encoding flag
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	rcEnum, err := bs.ReadBits(6)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	responseCode := mapEnumToResponseCode(uint8(rcEnum))
 	// END ResponseCode
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Optional VehicleCheckInResult presence
 	p, err := bs.ReadBits(1)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	var result *string
 	if p == 1 {
 		r, err := readString(bs)
 		if err != nil {
-			return nil, err
+			return err
 		}
 		result = &r
 	}
 
 	// END VehicleCheckInRes
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.VehicleCheckInRes{
-		Header:               *header,
+	*dst = generated.VehicleCheckInRes{
+		Header:               header,
 		ResponseCode:         responseCode,
 		VehicleCheckInResult: result,
-	}, nil
+	}
+	return nil
 }
 
 // ------------------------ VehicleCheckOutRes -------------------------------
@@ -377,54 +389,60 @@ func EncodeVehicleCheckOutRes(bs *BitStream, v *generated.VehicleCheckOutRes) er
 
 // DecodeVehicleCheckOutRes decodes the VehicleCheckOutRes body.
 func DecodeVehicleCheckOutRes(bs *BitStream) (*generated.VehicleCheckOutRes, error) {
+	return decodeNew(bs, decodeVehicleCheckOutResInto)
+}
+
+// decodeVehicleCheckOutResInto is DecodeVehicleCheckOutRes decoding into dst.
+func decodeVehicleCheckOutResInto(bs *BitStream, dst *generated.VehicleCheckOutRes) error {
 	// START Header
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// START ResponseCode
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	// encoding flag
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	rcEnum, err := bs.ReadBits(6)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	responseCode := mapEnumToResponseCode(uint8(rcEnum))
 	// END ResponseCode
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// EVSECheckOutStatus START
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	status, err := readString(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	// EVSECheckOutStatus END
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// END VehicleCheckOutRes
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.VehicleCheckOutRes{
-		Header:             *header,
+	*dst = generated.VehicleCheckOutRes{
+		Header:             header,
 		ResponseCode:       responseCode,
 		EVSECheckOutStatus: status,
-	}, nil
+	}
+	return nil
 }
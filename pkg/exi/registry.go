@@ -0,0 +1,220 @@
+package exi
+
+import (
+	"fmt"
+
+	"example.com/exi-go/pkg/v2g/generated"
+)
+
+// MessageInfo describes one top-level ISO 15118-20 message type. Entries of
+// the registry are indexed by the 6-bit document event code, which is also
+// the V2G_MSG_* identifier of the C API, so every dispatch is one array
+// lookup.
+type MessageInfo struct {
+	// Name is the element name, e.g. "SessionSetupReq".
+	Name string
+	// Code is the document event code.
+	Code uint8
+	// New returns a pointer to a zero message, e.g. &generated.SessionSetupReq{}.
+	New func() interface{}
+	// Reset zeroes the message v, which must have New's type.
+	Reset func(v interface{})
+
+	encode     func(bs *BitStream, v interface{}) error // header, event code and body
+	decode     func(bs *BitStream) (interface{}, error) // body after the event code
+	decodeInto func(bs *BitStream, v interface{}) error // decode into v, of New's type
+}
+
+// messageCodeBits is the width of the document event code.
+const messageCodeBits = 6
+
+// legacyVehicleCheckOutResCode is the event code older encoders used for
+// VehicleCheckOutRes; it is still accepted when decoding.
+const legacyVehicleCheckOutResCode = 45
+
+var (
+	messages       [1 << messageCodeBits]MessageInfo
+	messagesByName = map[string]*MessageInfo{}
+)
+
+// Message returns the registry entry for an event code, or nil if no message
+// uses it.
+func Message(code int) *MessageInfo {
+	if code < 0 || code >= len(messages) || messages[code].New == nil {
+		return nil
+	}
+	return &messages[code]
+}
+
+// MessageByName returns the registry entry for an element name, or nil.
+func MessageByName(name string) *MessageInfo {
+	return messagesByName[name]
+}
+
+// MessageOf returns the registry entry for the message v (a pointer to a
+// generated message struct), or nil if v is not a top-level message.
+func MessageOf(v interface{}) *MessageInfo {
+	code, ok := messageCode(v)
+	if !ok {
+		return nil
+	}
+	return &messages[code]
+}
+
+func register[T any](code uint8, name string, enc func(*BitStream, *T) error, dec func(*BitStream, *T) error) {
+	if messages[code].New != nil {
+		panic(fmt.Sprintf("exi: event code %d registered twice", code))
+	}
+	messages[code] = MessageInfo{
+		Name:   name,
+		Code:   code,
+		New:    func() interface{} { return new(T) },
+		Reset:  func(v interface{}) { var zero T; *v.(*T) = zero },
+		encode: func(bs *BitStream, v interface{}) error { return enc(bs, v.(*T)) },
+		decode: func(bs *BitStream) (interface{}, error) { return decodeNew(bs, dec) },
+		decodeInto: func(bs *BitStream, v interface{}) error {
+			dst := v.(*T)
+			if dst == nil {
+				return fmt.Errorf("DecodeInto: nil *%s", name)
+			}
+			return dec(bs, dst)
+		},
+	}
+	messagesByName[name] = &messages[code]
+}
+
+// decodeNew runs the body decoder into on a new message.
+func decodeNew[T any](bs *BitStream, into func(*BitStream, *T) error) (*T, error) {
+	v := new(T)
+	if err := into(bs, v); err != nil {
+		return nil, err
+	}
+	return v, nil
+}
+
+func init() {
+	register(0, "AuthorizationReq", EncodeTopLevelAuthorizationReq, decodeAuthorizationReqInto)
+	register(1, "AuthorizationRes", EncodeTopLevelAuthorizationRes, decodeAuthorizationResInto)
+	register(2, "AuthorizationSetupReq", EncodeTopLevelAuthorizationSetupReq, decodeAuthorizationSetupReqInto)
+	register(3, "AuthorizationSetupRes", EncodeTopLevelAuthorizationSetupRes, decodeAuthorizationSetupResInto)
+	register(4, "CLReqControlMode", EncodeTopLevelCLReqControlMode, decodeCLReqControlModeInto)
+	register(5, "CLResControlMode", EncodeTopLevelCLResControlMode, decodeCLResControlModeInto)
+	register(7, "CertificateInstallationReq", EncodeTopLevelCertificateInstallationReq, decodeCertificateInstallationReqInto)
+	register(8, "CertificateInstallationRes", EncodeTopLevelCertificateInstallationRes, decodeCertificateInstallationResInto)
+	register(16, "MeteringConfirmationReq", EncodeTopLevelMeteringConfirmationReq, decodeMeteringConfirmationReqInto)
+	register(17, "MeteringConfirmationRes", EncodeTopLevelMeteringConfirmationRes, decodeMeteringConfirmationResInto)
+	register(21, "PowerDeliveryReq", EncodeTopLevelPowerDeliveryReq, decodePowerDeliveryReqInto)
+	register(22, "PowerDeliveryRes", EncodeTopLevelPowerDeliveryRes, decodePowerDeliveryResInto)
+	register(27, "ScheduleExchangeReq", EncodeTopLevelScheduleExchangeReq, decodeScheduleExchangeReqInto)
+	register(28, "ScheduleExchangeRes", EncodeTopLevelScheduleExchangeRes, decodeScheduleExchangeResInto)
+	register(29, "ServiceDetailReq", EncodeTopLevelServiceDetailReq, decodeServiceDetailReqInto)
+	register(30, "ServiceDetailRes", EncodeTopLevelServiceDetailRes, decodeServiceDetailResInto)
+	register(31, "ServiceDiscoveryReq", EncodeTopLevelServiceDiscoveryReq, decodeServiceDiscoveryReqInto)
+	register(32, "ServiceDiscoveryRes", EncodeTopLevelServiceDiscoveryRes, decodeServiceDiscoveryResInto)
+	register(33, "ServiceSelectionReq", EncodeTopLevelServiceSelectionReq, decodeServiceSelectionReqInto)
+	register(34, "ServiceSelectionRes", EncodeTopLevelServiceSelectionRes, decodeServiceSelectionResInto)
+	register(35, "SessionSetupReq", EncodeTopLevelSessionSetupReq, decodeSessionSetupReqInto)
+	register(36, "SessionSetupRes", EncodeTopLevelSessionSetupRes, decodeSessionSetupResInto)
+	register(37, "SessionStopReq", EncodeTopLevelSessionStopReq, decodeSessionStopReqInto)
+	register(38, "SessionStopRes", EncodeTopLevelSessionStopRes, decodeSessionStopResInto)
+	register(49, "VehicleCheckInReq", EncodeTopLevelVehicleCheckInReq, decodeVehicleCheckInReqInto)
+	register(50, "VehicleCheckInRes", EncodeTopLevelVehicleCheckInRes, decodeVehicleCheckInResInto)
+	register(51, "VehicleCheckOutReq", EncodeTopLevelVehicleCheckOutReq, decodeVehicleCheckOutReqInto)
+	register(52, "VehicleCheckOutRes", EncodeTopLevelVehicleCheckOutRes, decodeVehicleCheckOutResInto)
+	register(53, "WPT_AlignmentCheckReq", EncodeTopLevelWPT_AlignmentCheckReq, decodeWPT_AlignmentCheckReqInto)
+	register(54, "WPT_AlignmentCheckRes", EncodeTopLevelWPT_AlignmentCheckRes, decodeWPT_AlignmentCheckResInto)
+	register(55, "WPT_FinePositioningReq", EncodeTopLevelWPT_FinePositioningReq, decodeWPT_FinePositioningReqInto)
+	register(56, "WPT_FinePositioningRes", EncodeTopLevelWPT_FinePositioningRes, decodeWPT_FinePositioningResInto)
+	register(57, "WPT_ChargeLoopReq", EncodeTopLevelWPT_ChargeLoopReq, decodeWPT_ChargeLoopReqInto)
+	register(58, "WPT_ChargeLoopRes", EncodeTopLevelWPT_ChargeLoopRes, decodeWPT_ChargeLoopResInto)
+	register(59, "DC_ACDPReq", EncodeTopLevelDC_ACDPReq, decodeDC_ACDPReqInto)
+	register(60, "DC_ACDPRes", EncodeTopLevelDC_ACDPRes, decodeDC_ACDPResInto)
+	register(61, "DC_ACDP_BPTReq", EncodeTopLevelDC_ACDP_BPTReq, decodeDC_ACDP_BPTReqInto)
+	register(62, "DC_ACDP_BPTRes", EncodeTopLevelDC_ACDP_BPTRes, decodeDC_ACDP_BPTResInto)
+}
+
+// messageCode maps a message pointer to its event code. A type switch is
+// used instead of a map keyed by reflect.Type: the compiler turns it into a
+// binary search over type hashes, several times faster than hashing the
+// interface for a map lookup.
+func messageCode(v interface{}) (uint8, bool) {
+	switch v.(type) {
+	case *generated.AuthorizationReq:
+		return 0, true
+	case *generated.AuthorizationRes:
+		return 1, true
+	case *generated.AuthorizationSetupReq:
+		return 2, true
+	case *generated.AuthorizationSetupRes:
+		return 3, true
+	case *generated.CLReqControlMode:
+		return 4, true
+	case *generated.CLResControlMode:
+		return 5, true
+	case *generated.CertificateInstallationReq:
+		return 7, true
+	case *generated.CertificateInstallationRes:
+		return 8, true
+	case *generated.DC_ACDPReq:
+		return 59, true
+	case *generated.DC_ACDPRes:
+		return 60, true
+	case *generated.DC_ACDP_BPTReq:
+		return 61, true
+	case *generated.DC_ACDP_BPTRes:
+		return 62, true
+	case *generated.MeteringConfirmationReq:
+		return 16, true
+	case *generated.MeteringConfirmationRes:
+		return 17, true
+	case *generated.PowerDeliveryReq:
+		return 21, true
+	case *generated.PowerDeliveryRes:
+		return 22, true
+	case *generated.ScheduleExchangeReq:
+		return 27, true
+	case *generated.ScheduleExchangeRes:
+		return 28, true
+	case *generated.ServiceDetailReq:
+		return 29, true
+	case *generated.ServiceDetailRes:
+		return 30, true
+	case *generated.ServiceDiscoveryReq:
+		return 31, true
+	case *generated.ServiceDiscoveryRes:
+		return 32, true
+	case *generated.ServiceSelectionReq:
+		return 33, true
+	case *generated.ServiceSelectionRes:
+		return 34, true
+	case *generated.SessionSetupReq:
+		return 35, true
+	case *generated.SessionSetupRes:
+		return 36, true
+	case *generated.SessionStopReq:
+		return 37, true
+	case *generated.SessionStopRes:
+		return 38, true
+	case *generated.VehicleCheckInReq:
+		return 49, true
+	case *generated.VehicleCheckInRes:
+		return 50, true
+	case *generated.VehicleCheckOutReq:
+		return 51, true
+	case *generated.VehicleCheckOutRes:
+		return 52, true
+	case *generated.WPT_AlignmentCheckReq:
+		return 53, true
+	case *generated.WPT_AlignmentCheckRes:
+		return 54, true
+	case *generated.WPT_ChargeLoopReq:
+		return 57, true
+	case *generated.WPT_ChargeLoopRes:
+		return 58, true
+	case *generated.WPT_FinePositioningReq:
+		return 55, true
+	case *generated.WPT_FinePositioningRes:
+		return 56, true
+	}
+	return 0, false
+}
@@ -0,0 +1,69 @@
+package exi
+
+import (
+	"reflect"
+	"testing"
+
+	"example.com/exi-go/pkg/v2g/generated"
+)
+
+func TestMessageRegistryConsistent(t *testing.T) {
+	n := 0
+	for code := 0; code < len(messages); code++ {
+		m := Message(code)
+		if m == nil {
+			continue
+		}
+		n++
+		v := m.New()
+		if got := reflect.TypeOf(v).Elem().Name(); got != m.Name {
+			t.Errorf("code %d: New() returns %s, name is %s", code, got, m.Name)
+		}
+		if int(m.Code) != code {
+			t.Errorf("%s: Code = %d, registered at %d", m.Name, m.Code, code)
+		}
+		if got := MessageOf(v); got != m {
+			t.Errorf("%s: MessageOf(New()) = %v", m.Name, got)
+		}
+		if got := MessageByName(m.Name); got != m {
+			t.Errorf("%s: MessageByName = %v", m.Name, got)
+		}
+	}
+	if n != 38 || len(messagesByName) != n {
+		t.Errorf("registry has %d codes and %d names, want 38", n, len(messagesByName))
+	}
+	for _, code := range []int{-1, 6, legacyVehicleCheckOutResCode, 63, 64} {
+		if m := Message(code); m != nil {
+			t.Errorf("Message(%d) = %s, want nil", code, m.Name)
+		}
+	}
+	if MessageOf(&generated.CertificateUpdateReq{}) != nil || MessageOf(generated.SessionSetupReq{}) != nil {
+		t.Error("MessageOf accepted a value that is not a top-level message pointer")
+	}
+}
+
+func TestMessageReset(t *testing.T) {
+	m := MessageByName("SessionStopReq")
+	code := "EV1"
+	v := &generated.SessionStopReq{ChargingSession: "Pause", EVTerminationCode: &code}
+	m.Reset(v)
+	if !reflect.DeepEqual(v, &generated.SessionStopReq{}) {
+		t.Fatalf("Reset left %+v", v)
+	}
+}
+
+func TestDecodeLegacyVehicleCheckOutResCode(t *testing.T) {
+	data, err := EncodeStruct(&generated.VehicleCheckOutRes{ResponseCode: "OK"})
+	if err != nil {
+		t.Fatal(err)
+	}
+	// Rewrite the 6-bit event code that follows the 0x80 header byte.
+	data[1] = data[1]&0x03 | legacyVehicleCheckOutResCode<<2
+	v, err := DecodeStruct(data, nil)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if _, ok := v.(*generated.VehicleCheckOutRes); !ok {
+		t.Fatalf("decoded %T", v)
+	}
+}
@@ -0,0 +1,109 @@
+package exi_test
+
+import (
+	"bytes"
+	"os"
+	"path/filepath"
+	"reflect"
+	"testing"
+
+	"example.com/exi-go/pkg/exi"
+	"example.com/exi-go/pkg/v2g/generated"
+)
+
+func TestSpecializedCodecsGoldenVectors(t *testing.T) {
+	codecs := map[string]struct {
+		decode func(*exi.BitStream) (interface{}, error)
+		encode func(*exi.BitStream, interface{}) error
+	}{
+		"SessionSetupReq": {
+			func(bs *exi.BitStream) (interface{}, error) { return exi.DecodeSpecializedSessionSetupReq(bs) },
+			func(bs *exi.BitStream, v interface{}) error {
+				return exi.EncodeSpecializedSessionSetupReq(bs, v.(*generated.SessionSetupReq))
+			},
+		},
+		"ServiceDiscoveryReq": {
+			func(bs *exi.BitStream) (interface{}, error) { return exi.DecodeSpecializedServiceDiscoveryReq(bs) },
+			func(bs *exi.BitStream, v interface{}) error {
+				return exi.EncodeSpecializedServiceDiscoveryReq(bs, v.(*generated.ServiceDiscoveryReq))
+			},
+		},
+		"SessionStopReq": {
+			func(bs *exi.BitStream) (interface{}, error) { return exi.DecodeSpecializedSessionStopReq(bs) },
+			func(bs *exi.BitStream, v interface{}) error {
+				return exi.EncodeSpecializedSessionStopReq(bs, v.(*generated.SessionStopReq))
+			},
+		},
+	}
+	for name, c := range codecs {
+		data, err := os.ReadFile(filepath.Join("..", "..", "testvectors", name+".exi"))
+		if err != nil {
+			t.Fatal(err)
+		}
+		var bs exi.BitStream
+		bs.Init(data, 0)
+		got, err := c.decode(&bs)
+		if err != nil {
+			t.Fatalf("%s: specialized decode: %v", name, err)
+		}
+		want, err := exi.DecodeStruct(data, nil)
+		if err != nil {
+			t.Fatalf("%s: DecodeStruct: %v", name, err)
+		}
+		if !reflect.DeepEqual(got, want) {
+			t.Errorf("%s: specialized decode = %+v, want %+v", name, got, want)
+		}
+
+		buf := make([]byte, 256)
+		bs.Init(buf, 0)
+		if err := c.encode(&bs, got); err != nil {
+			t.Fatalf("%s: specialized encode: %v", name, err)
+		}
+		if enc := buf[:bs.Length()]; !bytes.Equal(enc, data) {
+			t.Errorf("%s: specialized encode = %x, want %x", name, enc, data)
+		}
+	}
+}
+
+func TestSpecializedSessionStopReqOptionals(t *testing.T) {
+	code, expl := "EV1", "driver stopped"
+	header := generated.MessageHeaderType{SessionID: []byte{1, 2, 3, 4, 5, 6, 7, 8}, TimeStamp: 1700000000}
+	buf := make([]byte, 256)
+	for _, msg := range []*generated.SessionStopReq{
+		{Header: header, ChargingSession: "Pause"},
+		{Header: header, ChargingSession: "ServiceRenegotiation", EVTerminationCode: &code},
+		{Header: header, ChargingSession: "Terminate", EVTerminationExplanation: &expl},
+		{Header: header, ChargingSession: "Terminate", EVTerminationCode: &code, EVTerminationExplanation: &expl},
+	} {
+		want, err := exi.EncodeStruct(msg)
+		if err != nil {
+			t.Fatal(err)
+		}
+		var bs exi.BitStream
+		bs.Init(buf, 0)
+		if err := exi.EncodeSpecializedSessionStopReq(&bs, msg); err != nil {
+			t.Fatal(err)
+		}
+		if got := buf[:bs.Length()]; !bytes.Equal(got, want) {
+			t.Fatalf("%+v: specialized encode = %x, hand-written = %x", msg, got, want)
+		}
+		bs.Init(want, 0)
+		back, err := exi.DecodeSpecializedSessionStopReq(&bs)
+		if err != nil {
+			t.Fatal(err)
+		}
+		if !reflect.DeepEqual(back, msg) {
+			t.Fatalf("round trip = %+v, want %+v", back, msg)
+		}
+	}
+
+	var bs exi.BitStream
+	bs.Init(buf, 0)
+	if err := exi.EncodeSpecializedSessionStopReq(&bs, &generated.SessionStopReq{Header: header, ChargingSession: "Abort"}); err == nil {
+		t.Fatal("encoding a value outside the enumeration succeeded")
+	}
+	bs.Init(make([]byte, 4), 0)
+	if err := exi.EncodeSpecializedSessionStopReq(&bs, &generated.SessionStopReq{Header: header, ChargingSession: "Pause"}); err == nil {
+		t.Fatal("encoding into a short buffer succeeded")
+	}
+}
@@ -0,0 +1,266 @@
+package exi
+
+import (
+	"errors"
+	"math/bits"
+	"runtime"
+	"sync"
+	"sync/atomic"
+	"time"
+)
+
+// LatencyBuckets is the number of buckets of OpStats.Latency.
+const LatencyBuckets = 32
+
+// statsSampleEvery is how often a call is timed: one in statsSampleEvery
+// calls of each stream. Counting every call costs two atomic adds on a
+// cache line no other thread writes, but reading the clock twice costs
+// several times that, so only the latency histogram is sampled.
+const statsSampleEvery = 64
+
+// maxStatsShards bounds the shards the counters are spread over.
+const maxStatsShards = 64
+
+// OpStats counts the encodes or decodes of one message type.
+//
+// Calls that only ran out of room (errors wrapping ErrBitstreamOverflow)
+// are left out: EncodeTo and StreamDecoder answer them by retrying with
+// more space, so counting them would count one message twice. A Decoder
+// given truncated input therefore reports nothing either; the C API counts
+// those calls by status in struct v2g_stats.
+type OpStats struct {
+	// Calls is the number of completed calls, failed ones included.
+	Calls uint64
+	// Errors is the number of calls that returned an error.
+	Errors uint64
+	// Bytes is the EXI bytes written (encode) or read (decode) by the calls
+	// that succeeded.
+	Bytes uint64
+	// Latency is a histogram of the durations of the sampled successful
+	// calls: Latency[i] counts calls that took less than 2^i ns and at
+	// least 2^(i-1) ns. The last bucket also holds every longer call.
+	Latency [LatencyBuckets]uint64
+}
+
+// Quantile returns the upper bound of the latency bucket holding the
+// q-quantile (0 < q <= 1) of the sampled calls, e.g. Quantile(0.99) for the
+// p99, or 0 if no call was sampled. The bound is within a factor of two of
+// the true value, which is enough to see a message type get slower.
+func (o *OpStats) Quantile(q float64) time.Duration {
+	var total uint64
+	for _, n := range o.Latency {
+		total += n
+	}
+	if total == 0 {
+		return 0
+	}
+	rank := uint64(q*float64(total) + 0.5)
+	if rank < 1 {
+		rank = 1
+	}
+	var seen uint64
+	for i, n := range o.Latency {
+		if seen += n; seen >= rank {
+			return time.Duration(1) << i
+		}
+	}
+	return time.Duration(1) << (LatencyBuckets - 1)
+}
+
+// MessageStats holds the statistics of one message type.
+type MessageStats struct {
+	Encode OpStats
+	Decode OpStats
+}
+
+// CodecStats is a snapshot of the codec statistics returned by Stats.
+type CodecStats struct {
+	// Enabled reports whether the counters are running (see EnableStats).
+	Enabled bool
+	// SampleEvery is the sampling interval of the latency histograms: one
+	// call in SampleEvery is timed.
+	SampleEvery int
+	// Messages is indexed by the document event code of the message type,
+	// like the registry (see Message).
+	Messages [1 << messageCodeBits]MessageStats
+}
+
+// opCounters is the live form of OpStats, updated with atomic adds.
+type opCounters struct {
+	calls   uint64
+	errors  uint64
+	bytes   uint64
+	latency [LatencyBuckets]uint64
+}
+
+const (
+	opEncode = iota
+	opDecode
+)
+
+// statsShard holds the counters of every message type for the streams that
+// use it. Streams are spread over the shards round robin, so with at least
+// as many shards as threads every Encoder and Decoder in steady use writes
+// to counters no other thread touches, and the atomic adds stay cheap.
+type statsShard struct {
+	ops [1 << messageCodeBits][2]opCounters
+	// Keep the last counters of one shard and the first of the next off a
+	// shared cache line.
+	_ [64]byte
+}
+
+var codecStats struct {
+	enabled atomic.Bool
+	once    sync.Once
+	shards  atomic.Pointer[[]statsShard] // set once, by the first EnableStats(true)
+	next    atomic.Uint32
+}
+
+// statsEpoch is the origin of the monotonic timestamps of sampled calls.
+var statsEpoch = time.Now()
+
+// EnableStats turns the codec statistics on or off; they start off, and
+// then cost one load of a flag per call. While on, every encode and decode
+// of a top-level message (through an Encoder, a Decoder, a StreamDecoder or
+// the package-level functions) updates the counters of its message type.
+// Turning them off keeps the values; see ResetStats.
+func EnableStats(on bool) {
+	if on {
+		codecStats.once.Do(func() {
+			n := 1
+			for n < runtime.GOMAXPROCS(0) && n < maxStatsShards {
+				n <<= 1
+			}
+			shards := make([]statsShard, n)
+			codecStats.shards.Store(&shards)
+		})
+	}
+	codecStats.enabled.Store(on)
+}
+
+// Stats returns the sum of the counters of all shards. Counters keep
+// changing while it runs, so the snapshot is not atomic across message
+// types, but every value in it is one the counter held.
+func Stats() CodecStats {
+	s := CodecStats{Enabled: codecStats.enabled.Load(), SampleEvery: statsSampleEvery}
+	shards := loadStatsShards()
+	for i := range shards {
+		shard := &shards[i]
+		for code := range shard.ops {
+			shard.ops[code][opEncode].addTo(&s.Messages[code].Encode)
+			shard.ops[code][opDecode].addTo(&s.Messages[code].Decode)
+		}
+	}
+	return s
+}
+
+// ResetStats sets every counter to zero.
+func ResetStats() {
+	shards := loadStatsShards()
+	for i := range shards {
+		shard := &shards[i]
+		for code := range shard.ops {
+			for op := range shard.ops[code] {
+				c := &shard.ops[code][op]
+				atomic.StoreUint64(&c.calls, 0)
+				atomic.StoreUint64(&c.errors, 0)
+				atomic.StoreUint64(&c.bytes, 0)
+				for b := range c.latency {
+					atomic.StoreUint64(&c.latency[b], 0)
+				}
+			}
+		}
+	}
+}
+
+// loadStatsShards returns the shards, or nil before the first
+// EnableStats(true).
+func loadStatsShards() []statsShard {
+	if p := codecStats.shards.Load(); p != nil {
+		return *p
+	}
+	return nil
+}
+
+func (c *opCounters) addTo(o *OpStats) {
+	o.Calls += atomic.LoadUint64(&c.calls)
+	o.Errors += atomic.LoadUint64(&c.errors)
+	o.Bytes += atomic.LoadUint64(&c.bytes)
+	for b := range c.latency {
+		o.Latency[b] += atomic.LoadUint64(&c.latency[b])
+	}
+}
+
+// opCounters returns the counters of bs's shard for op on message code.
+func (bs *BitStream) opCounters(code uint8, op int) *opCounters {
+	shards := *codecStats.shards.Load()
+	return &shards[int(bs.statsShard)&(len(shards)-1)].ops[code][op]
+}
+
+// statsStart returns the start time of a call if it is sampled, or 0. The
+// sampling tick is the stream's own, so it costs no atomic operation.
+//
+// A stream is assigned its shard on its first counted call and keeps it.
+// Its tick starts at a phase that differs from stream to stream, so that
+// streams too short-lived to make SampleEvery calls are still timed at the
+// sampling rate on average rather than never.
+func (bs *BitStream) statsStart() int64 {
+	if bs.statsShard == 0 {
+		bs.statsShard = codecStats.next.Add(1)
+		bs.statsTick = bs.statsShard * statsPhaseStep
+	}
+	if bs.statsTick++; bs.statsTick%statsSampleEvery != 0 {
+		return 0
+	}
+	return int64(time.Since(statsEpoch)) | 1
+}
+
+// statsPhaseStep is odd, so the phases of successive streams run through
+// every residue of statsSampleEvery before repeating.
+const statsPhaseStep = 57
+
+// end records the outcome of a call that began at start and moved n bytes.
+func (c *opCounters) end(start int64, n int, err error) {
+	if err != nil {
+		if !errors.Is(err, ErrBitstreamOverflow) {
+			atomic.AddUint64(&c.calls, 1)
+			atomic.AddUint64(&c.errors, 1)
+		}
+		return
+	}
+	atomic.AddUint64(&c.calls, 1)
+	atomic.AddUint64(&c.bytes, uint64(n))
+	if start != 0 {
+		b := bits.Len64(uint64(int64(time.Since(statsEpoch)) - start))
+		if b >= LatencyBuckets {
+			b = LatencyBuckets - 1
+		}
+		atomic.AddUint64(&c.latency[b], 1)
+	}
+}
+
+// encodeCounted is encodeTopLevel for a registered message while the
+// statistics are on.
+func encodeCounted(bs *BitStream, code uint8, v interface{}) error {
+	start := bs.statsStart()
+	err := messages[code].encode(bs, v)
+	bs.opCounters(code, opEncode).end(start, bs.Length(), err)
+	return err
+}
+
+// decodeCounted is decodeTopLevel after the event code while the
+// statistics are on.
+func decodeCounted(bs *BitStream, m *MessageInfo) (interface{}, error) {
+	start := bs.statsStart()
+	msg, err := m.decode(bs)
+	bs.opCounters(m.Code, opDecode).end(start, bs.Length(), err)
+	return msg, err
+}
+
+// decodeCountedInto is decodeCounted for DecodeInto.
+func decodeCountedInto(bs *BitStream, m *MessageInfo, dst interface{}) error {
+	start := bs.statsStart()
+	err := m.decodeInto(bs, dst)
+	bs.opCounters(m.Code, opDecode).end(start, bs.Length(), err)
+	return err
+}
@@ -0,0 +1,226 @@
+package exi_test
+
+import (
+	"testing"
+	"time"
+
+	"example.com/exi-go/pkg/exi"
+)
+
+// withStats runs f with the statistics on and zeroed, and turns them off
+// again afterwards so other tests are not counted.
+func withStats(t testing.TB, f func()) {
+	t.Helper()
+	exi.EnableStats(true)
+	exi.ResetStats()
+	defer func() {
+		exi.EnableStats(false)
+		exi.ResetStats()
+	}()
+	f()
+}
+
+func TestStatsCorpus(t *testing.T) {
+	corpus := loadCorpus(t)
+	enc := exi.NewEncoder()
+	dec := exi.NewDecoder()
+
+	withStats(t, func() {
+		const passes = 40
+		want := map[uint8]uint64{}
+		for pass := 0; pass < passes; pass++ {
+			for name, data := range corpus {
+				msg, err := dec.Decode(data)
+				if err != nil {
+					t.Fatalf("%s: decode: %v", name, err)
+				}
+				if _, err := enc.Encode(msg); err != nil {
+					t.Fatalf("%s: encode: %v", name, err)
+				}
+				// EncodedSize runs the encoder too, but must not count.
+				if _, err := enc.EncodedSize(msg); err != nil {
+					t.Fatalf("%s: size: %v", name, err)
+				}
+				if pass == 0 {
+					want[exi.MessageOf(msg).Code] += uint64(len(data))
+				}
+			}
+		}
+
+		s := exi.Stats()
+		if !s.Enabled || s.SampleEvery <= 0 {
+			t.Fatalf("Enabled = %v, SampleEvery = %d", s.Enabled, s.SampleEvery)
+		}
+		var sampled [2]uint64
+		var p50 [2]time.Duration
+		for code, bytes := range want {
+			m := s.Messages[code]
+			name := exi.Message(int(code)).Name
+			for op, o := range []exi.OpStats{m.Encode, m.Decode} {
+				const calls = passes // one test vector per message type
+				if o.Calls != calls || o.Errors != 0 || o.Bytes != passes*bytes {
+					t.Errorf("%s op %d: calls %d errors %d bytes %d, want %d 0 %d",
+						name, op, o.Calls, o.Errors, o.Bytes, calls, passes*bytes)
+				}
+				for _, n := range o.Latency {
+					sampled[op] += n
+				}
+				if q := o.Quantile(0.5); q > p50[op] {
+					p50[op] = q
+				}
+			}
+		}
+		// Each stream times one call in SampleEvery, whatever its type; where
+		// in the cycle it starts depends on the stream.
+		for op, n := range sampled {
+			want := uint64(passes*len(want)) / uint64(s.SampleEvery)
+			if n != want && n != want+1 {
+				t.Errorf("op %d: %d calls sampled, want %d or %d", op, n, want, want+1)
+			}
+			if p50[op] <= 0 || p50[op] > time.Second {
+				t.Errorf("op %d: p50 = %v", op, p50[op])
+			}
+		}
+	})
+}
+
+// TestStatsPackageLevel checks that calls through the package-level
+// functions, which have no stream of their own to keep, are timed too.
+func TestStatsPackageLevel(t *testing.T) {
+	corpus := loadCorpus(t)
+	data := corpus["SessionStopReq.exi"]
+	if data == nil {
+		t.Skip("SessionStopReq.exi not in corpus")
+	}
+	code := exi.MessageByName("SessionStopReq").Code
+
+	withStats(t, func() {
+		const calls = 4096
+		for i := 0; i < calls; i++ {
+			msg, err := exi.DecodeStruct(data, nil)
+			if err != nil {
+				t.Fatal(err)
+			}
+			if _, err := exi.EncodeStruct(msg); err != nil {
+				t.Fatal(err)
+			}
+		}
+		m := exi.Stats().Messages[code]
+		for op, o := range []exi.OpStats{m.Encode, m.Decode} {
+			var sampled uint64
+			for _, n := range o.Latency {
+				sampled += n
+			}
+			if o.Calls != calls || sampled == 0 {
+				t.Errorf("op %d: calls %d, %d sampled; want %d, more than 0", op, o.Calls, sampled, calls)
+			}
+		}
+	})
+}
+
+func TestStatsErrors(t *testing.T) {
+	corpus := loadCorpus(t)
+	data := corpus["SessionStopReq.exi"]
+	if data == nil {
+		t.Skip("SessionStopReq.exi not in corpus")
+	}
+	dec := exi.NewDecoder()
+	enc := exi.NewEncoder()
+	code := exi.MessageByName("SessionStopReq").Code
+
+	withStats(t, func() {
+		msg, err := dec.Decode(data)
+		if err != nil {
+			t.Fatal(err)
+		}
+		// Running out of room is not counted: EncodeTo retries it.
+		if _, err := enc.EncodeInto(make([]byte, 2), msg); err == nil {
+			t.Fatal("EncodeInto small buffer succeeded")
+		}
+		// Corrupt the body after the event code.
+		bad := append([]byte(nil), data...)
+		for i := 2; i < len(bad); i++ {
+			bad[i] = 0xFF
+		}
+		if _, err := dec.Decode(bad); err == nil {
+			t.Fatal("Decode of corrupted message succeeded")
+		}
+
+		m := exi.Stats().Messages[code]
+		if m.Encode.Calls != 0 || m.Encode.Errors != 0 {
+			t.Errorf("encode: calls %d errors %d, want 0 0", m.Encode.Calls, m.Encode.Errors)
+		}
+		if m.Decode.Calls != 2 || m.Decode.Errors != 1 || m.Decode.Bytes != uint64(len(data)) {
+			t.Errorf("decode: calls %d errors %d bytes %d, want 2 1 %d",
+				m.Decode.Calls, m.Decode.Errors, m.Decode.Bytes, len(data))
+		}
+
+		exi.EnableStats(false)
+		if _, err := dec.Decode(data); err != nil {
+			t.Fatal(err)
+		}
+		if s := exi.Stats(); s.Enabled || s.Messages[code].Decode.Calls != 2 {
+			t.Errorf("after EnableStats(false): Enabled %v, calls %d, want false 2",
+				s.Enabled, s.Messages[code].Decode.Calls)
+		}
+		exi.ResetStats()
+		if calls := exi.Stats().Messages[code].Decode.Calls; calls != 0 {
+			t.Errorf("after ResetStats: calls %d, want 0", calls)
+		}
+	})
+}
+
+func TestOpStatsQuantile(t *testing.T) {
+	var o exi.OpStats
+	if q := o.Quantile(0.99); q != 0 {
+		t.Errorf("empty: Quantile(0.99) = %v, want 0", q)
+	}
+	o.Latency[10] = 90 // < 1024 ns
+	o.Latency[14] = 10 // < 16384 ns
+	for _, tc := range []struct {
+		q    float64
+		want time.Duration
+	}{{0.01, 1024}, {0.5, 1024}, {0.9, 1024}, {0.95, 16384}, {1, 16384}} {
+		if got := o.Quantile(tc.q); got != tc.want {
+			t.Errorf("Quantile(%v) = %v, want %v", tc.q, got, tc.want)
+		}
+	}
+}
+
+// BenchmarkStats measures the cost of the counters on the corpus: compare
+// Off (one flag load per call) with On.
+func BenchmarkStats(b *testing.B) {
+	corpus := loadCorpus(b)
+	inputs := make([][]byte, 0, len(corpus))
+	for _, data := range corpus {
+		inputs = append(inputs, data)
+	}
+	for _, on := range []bool{false, true} {
+		name := "Off"
+		if on {
+			name = "On"
+		}
+		b.Run(name, func(b *testing.B) {
+			dec := exi.NewDecoder()
+			enc := exi.NewEncoder()
+			buf := make([]byte, 0, 4096)
+			run := func() {
+				for i := 0; i < b.N; i++ {
+					msg, err := dec.Decode(inputs[i%len(inputs)])
+					if err != nil {
+						b.Fatal(err)
+					}
+					if buf, err = enc.EncodeTo(buf[:0], msg); err != nil {
+						b.Fatal(err)
+					}
+				}
+			}
+			b.ReportAllocs()
+			if on {
+				withStats(b, run)
+			} else {
+				run()
+			}
+		})
+	}
+}
@@ -0,0 +1,123 @@
+package exi
+
+import (
+	"errors"
+	"fmt"
+)
+
+// ErrNeedMoreData is returned by StreamDecoder.Feed when the input fed so far
+// ends before the message does. The chunk has been buffered; feed the next
+// one.
+var ErrNeedMoreData = errors.New("exi: need more data")
+
+// maxStreamMessageSize bounds how much input a StreamDecoder buffers for one
+// message. Like maxEncodeBufferSize it only guards against a corrupt length
+// field making the decoder wait for data that will never come.
+const maxStreamMessageSize = maxEncodeBufferSize
+
+// StreamDecoder decodes a sequence of EXI documents that arrive in arbitrary
+// fragments, such as V2GTP payloads read from a TLS connection, without the
+// caller reassembling them first.
+//
+// A chunk that holds a complete message is decoded in place. Otherwise the
+// incomplete tail is buffered and the decode is retried once enough bytes
+// have arrived: a failed attempt records how far into the input it had to
+// read, so tiny fragments do not each pay for a full decode. Retrying is
+// safe because decoding is prefix-deterministic: an attempt that succeeds on
+// a prefix of the stream consumes exactly the bits the complete message
+// occupies. A StreamDecoder is not safe for concurrent use.
+type StreamDecoder struct {
+	// Options applies to every decoded message. With AliasInput, fields may
+	// alias either the chunk passed to Feed or the decoder's own buffer, and
+	// are only valid until the next Feed or Reset.
+	Options DecodeOptions
+
+	bs BitStream
+	// buf holds the bytes of the current message fed so far when they did
+	// not arrive in one chunk.
+	buf []byte
+	// need is the smallest len(buf) at which another attempt can succeed.
+	need int
+}
+
+// NewStreamDecoder returns a StreamDecoder with default options.
+func NewStreamDecoder() *StreamDecoder {
+	return &StreamDecoder{}
+}
+
+// Feed adds chunk to the stream. When a message completes it returns the
+// message and the number of bytes of chunk that it consumed; the remaining
+// bytes chunk[n:] start the next message and should be fed again. When the
+// message is still incomplete it returns ErrNeedMoreData with n == len(chunk).
+//
+// Any other error means the buffered bytes are not a valid message. The
+// decoder discards them, so the next Feed starts a new message.
+func (s *StreamDecoder) Feed(chunk []byte) (msg interface{}, n int, err error) {
+	if len(s.buf) == 0 {
+		if len(chunk) == 0 {
+			return nil, 0, ErrNeedMoreData
+		}
+		msg, used, err := s.decode(chunk)
+		if err == nil {
+			return msg, used, nil
+		}
+		if !errors.Is(err, ErrNeedMoreData) {
+			return nil, len(chunk), err
+		}
+		s.buf = append(s.buf, chunk...)
+		return nil, len(chunk), ErrNeedMoreData
+	}
+
+	prev := len(s.buf)
+	if prev+len(chunk) > maxStreamMessageSize {
+		s.Reset()
+		return nil, len(chunk), fmt.Errorf("StreamDecoder: message exceeds %d bytes: %w", maxStreamMessageSize, ErrBitstreamOverflow)
+	}
+	s.buf = append(s.buf, chunk...)
+	if len(s.buf) < s.need {
+		return nil, len(chunk), ErrNeedMoreData
+	}
+	msg, used, err := s.decode(s.buf)
+	if errors.Is(err, ErrNeedMoreData) {
+		return nil, len(chunk), err
+	}
+	s.buf = s.buf[:0]
+	s.need = 0
+	if err != nil {
+		return nil, len(chunk), err
+	}
+	// The prefix in buf was already too short on its own, so the message
+	// ends inside chunk.
+	return msg, used - prev, nil
+}
+
+// Buffered returns the number of bytes held for the incomplete message.
+func (s *StreamDecoder) Buffered() int {
+	return len(s.buf)
+}
+
+// Reset discards any buffered input. The buffer itself is kept for reuse.
+func (s *StreamDecoder) Reset() {
+	s.buf = s.buf[:0]
+	s.need = 0
+}
+
+// decode attempts one message from data and returns it with the number of
+// bytes it occupies. A read past the end of data becomes ErrNeedMoreData and
+// updates s.need.
+func (s *StreamDecoder) decode(data []byte) (interface{}, int, error) {
+	s.bs.Init(data, 0)
+	s.Options.apply(&s.bs)
+	msg, err := decodeTopLevel(&s.bs)
+	if err == nil {
+		return msg, s.bs.Length(), nil
+	}
+	if !errors.Is(err, ErrBitstreamOverflow) {
+		return nil, 0, err
+	}
+	if s.bs.need > maxStreamMessageSize || s.bs.need < 0 {
+		return nil, 0, fmt.Errorf("StreamDecoder: message needs %d bytes, limit %d: %w", s.bs.need, maxStreamMessageSize, err)
+	}
+	s.need = s.bs.need
+	return nil, 0, ErrNeedMoreData
+}
@@ -0,0 +1,214 @@
+package exi
+
+import (
+	"bytes"
+	"errors"
+	"os"
+	"path/filepath"
+	"reflect"
+	"testing"
+
+	"example.com/exi-go/pkg/v2g/generated"
+)
+
+// feedInChunks feeds data to s in chunks of size n and returns every
+// message it emits.
+func feedInChunks(t *testing.T, s *StreamDecoder, data []byte, n int) []interface{} {
+	t.Helper()
+	var out []interface{}
+	for len(data) > 0 {
+		chunk := data
+		if len(chunk) > n {
+			chunk = chunk[:n]
+		}
+		data = data[len(chunk):]
+		for len(chunk) > 0 {
+			msg, used, err := s.Feed(chunk)
+			if errors.Is(err, ErrNeedMoreData) {
+				if used != len(chunk) {
+					t.Fatalf("ErrNeedMoreData consumed %d of %d bytes", used, len(chunk))
+				}
+				break
+			}
+			if err != nil {
+				t.Fatalf("Feed: %v", err)
+			}
+			out = append(out, msg)
+			chunk = chunk[used:]
+		}
+	}
+	return out
+}
+
+func TestStreamDecoderGoldenVectorsAnySplit(t *testing.T) {
+	files, err := filepath.Glob(filepath.Join("..", "..", "testvectors", "*.exi"))
+	if err != nil || len(files) == 0 {
+		t.Fatalf("no test vectors: %v", err)
+	}
+	s := NewStreamDecoder()
+	for _, f := range files {
+		data, err := os.ReadFile(f)
+		if err != nil {
+			t.Fatal(err)
+		}
+		want, err := DecodeStruct(data, nil)
+		if err != nil {
+			continue // covered by the golden decode tests
+		}
+		for split := 1; split <= len(data); split++ {
+			got := feedInChunks(t, s, data, split)
+			if len(got) != 1 || !reflect.DeepEqual(got[0], want) {
+				t.Fatalf("%s split %d: got %d messages %+v, want %+v", filepath.Base(f), split, len(got), got, want)
+			}
+			if s.Buffered() != 0 {
+				t.Fatalf("%s split %d: %d bytes left buffered", filepath.Base(f), split, s.Buffered())
+			}
+		}
+	}
+}
+
+func TestStreamDecoderBackToBackMessages(t *testing.T) {
+	code := "EV1"
+	msgs := []interface{}{
+		&generated.SessionSetupReq{Header: generated.MessageHeaderType{SessionID: []byte{1, 2, 3, 4, 5, 6, 7, 8}, TimeStamp: 1}, EVCCID: []byte("WMIV1")},
+		&generated.SessionStopReq{Header: generated.MessageHeaderType{SessionID: []byte{9}, TimeStamp: 2}, ChargingSession: "Pause", EVTerminationCode: &code},
+		&generated.SessionSetupRes{Header: generated.MessageHeaderType{SessionID: []byte{1}, TimeStamp: 3}, ResponseCode: "OK", EVSEID: []byte("DE*ABC")},
+	}
+	var stream []byte
+	for _, m := range msgs {
+		data, err := EncodeStruct(m)
+		if err != nil {
+			t.Fatal(err)
+		}
+		stream = append(stream, data...)
+	}
+	for _, n := range []int{1, 3, 7, len(stream)} {
+		got := feedInChunks(t, NewStreamDecoder(), stream, n)
+		if !reflect.DeepEqual(got, msgs) {
+			t.Errorf("chunk size %d: got %+v, want %+v", n, got, msgs)
+		}
+	}
+}
+
+func TestStreamDecoderWaitsForLargeField(t *testing.T) {
+	cert := bytes.Repeat([]byte{0x30, 0x82, 0x01}, 700)
+	data, err := EncodeStruct(&generated.CertificateInstallationRes{
+		Header:                   generated.MessageHeaderType{SessionID: []byte{1, 2}, TimeStamp: 3},
+		ResponseCode:             "OK",
+		EVSEProcessing:           "Finished",
+		CPSCertificateChain:      generated.CertificateChain{Certificates: [][]byte{cert}},
+		ContractCertificateChain: generated.CertificateChain{Certificates: [][]byte{cert}},
+	})
+	if err != nil {
+		t.Fatal(err)
+	}
+	s := NewStreamDecoder()
+	if _, _, err := s.Feed(data[:100]); !errors.Is(err, ErrNeedMoreData) {
+		t.Fatalf("Feed(first 100 bytes) = %v, want ErrNeedMoreData", err)
+	}
+	// The failed attempt stopped at the certificate, so the decoder knows
+	// it needs at least the whole certificate before retrying.
+	if s.need < 100+len(cert)/2 {
+		t.Fatalf("need = %d after 100 bytes of a %d-byte message", s.need, len(data))
+	}
+	got := feedInChunks(t, s, data[100:], 64)
+	if len(got) != 1 {
+		t.Fatalf("got %d messages", len(got))
+	}
+	res := got[0].(*generated.CertificateInstallationRes)
+	if !bytes.Equal(res.CPSCertificateChain.Certificates[0], cert) {
+		t.Fatal("certificate mismatch")
+	}
+}
+
+func TestStreamDecoderInvalidInput(t *testing.T) {
+	s := NewStreamDecoder()
+	if _, n, err := s.Feed([]byte{0x80}); !errors.Is(err, ErrNeedMoreData) || n != 1 {
+		t.Fatalf("Feed(header only) = %d, %v", n, err)
+	}
+	_, _, err := s.Feed([]byte{0xFC}) // event code 63 is not a message
+	if err == nil || errors.Is(err, ErrNeedMoreData) {
+		t.Fatalf("Feed(unknown event code) = %v", err)
+	}
+	if s.Buffered() != 0 {
+		t.Fatalf("%d bytes left buffered after an error", s.Buffered())
+	}
+	if _, _, err := s.Feed([]byte{0x00}); err == nil || errors.Is(err, ErrNeedMoreData) {
+		t.Fatalf("Feed(bad header) = %v", err)
+	}
+}
+
+// TestStreamDecoderCorruptLength checks that a string length past what a
+// stream may buffer fails at once rather than after the limit is reached.
+func TestStreamDecoderCorruptLength(t *testing.T) {
+	data, err := EncodeStruct(&generated.SessionSetupReq{
+		Header: generated.MessageHeaderType{SessionID: []byte{1, 2}, TimeStamp: 1},
+		EVCCID: []byte("WMIV1234"),
+	})
+	if err != nil {
+		t.Fatal(err)
+	}
+	const lengthBit = 57 // where the EVCCID length starts
+	withLength := func(n uint64) []byte {
+		var src, dst BitStream
+		src.Init(data, 0)
+		dst.Init(make([]byte, len(data)+16), 0)
+		for i := 0; i < lengthBit; i++ {
+			b, _ := src.ReadBits(1)
+			dst.WriteBits(1, b)
+		}
+		src.ReadUnsignedVar()
+		dst.WriteUnsignedVar(n)
+		for {
+			b, err := src.ReadBits(1)
+			if err != nil {
+				return dst.data[:dst.Length()]
+			}
+			dst.WriteBits(1, b)
+		}
+	}
+	if got := withLength(8 + 2); !bytes.Equal(got, data) {
+		t.Fatalf("EVCCID length is not at bit %d: % x", lengthBit, data)
+	}
+
+	s := NewStreamDecoder()
+	if _, _, err := s.Feed(withLength(1000 + 2)); !errors.Is(err, ErrNeedMoreData) || s.need < 1000 {
+		t.Fatalf("1000 octets: err = %v, need = %d", err, s.need)
+	}
+	s.Reset()
+	for _, n := range []uint64{1 << 30, 1 << 40, 1 << 62} {
+		if _, _, err := s.Feed(withLength(n + 2)); err == nil || errors.Is(err, ErrNeedMoreData) {
+			t.Errorf("%d octets: err = %v, want a decode error", n, err)
+		}
+	}
+}
+
+func BenchmarkStreamDecoder(b *testing.B) {
+	data, err := EncodeStruct(&generated.SessionSetupReq{
+		Header: generated.MessageHeaderType{SessionID: []byte{1, 2, 3, 4, 5, 6, 7, 8}, TimeStamp: 1700000000},
+		EVCCID: []byte("WMIV1234567890ABCDE"),
+	})
+	if err != nil {
+		b.Fatal(err)
+	}
+	for _, parts := range []int{1, 2, 4} {
+		size := (len(data) + parts - 1) / parts
+		b.Run(map[int]string{1: "Whole", 2: "Halves", 4: "Quarters"}[parts], func(b *testing.B) {
+			b.ReportAllocs()
+			s := NewStreamDecoder()
+			for i := 0; i < b.N; i++ {
+				rest := data
+				for len(rest) > 0 {
+					chunk := rest
+					if len(chunk) > size {
+						chunk = chunk[:size]
+					}
+					rest = rest[len(chunk):]
+					if _, _, err := s.Feed(chunk); err != nil && !errors.Is(err, ErrNeedMoreData) {
+						b.Fatal(err)
+					}
+				}
+			}
+		})
+	}
+}
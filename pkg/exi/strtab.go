@@ -0,0 +1,365 @@
+package exi
+
+import (
+	"errors"
+	"fmt"
+	"hash/maphash"
+	"math/bits"
+	"unicode/utf8"
+)
+
+// ErrStringTableHit is returned (wrapped) when a stream refers to an earlier
+// string value with a string-table hit but the decoder has no StringTable
+// (see DecodeOptions.Strings), or the hit names no value.
+var ErrStringTableHit = errors.New("exi: string-table hit")
+
+// StringTable is the string table of EXI value content (EXI 1.0 section
+// 7.3.3): a global value partition of every string value a stream has
+// carried and, per element name, a local partition of the values first seen
+// in that element. With a StringTable, a value that repeats within a
+// message is written as a hit, its local or global compact ID, in a few
+// bits instead of as a literal; the table is emptied at the start of
+// every message, since each message is an EXI stream of its own.
+//
+// Values are found through an open-addressing index of 32-bit IDs, so a
+// lookup is one hash and usually one comparison, and a reused table
+// allocates only the strings it adds. A capacity bounds the global
+// partition as valuePartitionCapacity does: once it is full, each new value
+// replaces the oldest, which also leaves its local partition.
+//
+// Streams encoded with a table can only be decoded with one of the same
+// capacity and maxLength; peers that do not implement string tables (such
+// as the reference C codec) reject the hits. A StringTable is not safe for
+// concurrent use.
+type StringTable struct {
+	capacity  int
+	maxLength int
+
+	// values is the global partition, by global ID; hashes and owners are
+	// parallel to it.
+	values []string
+	hashes []uint64
+	owners []stringOwner
+	// next is the global ID the next value replaces once values is full.
+	next int
+	// index maps hash slots to global ID + 1, 0 marking a free slot.
+	index []int32
+	seed  maphash.Seed
+
+	// partitions are the local partitions; byName maps an element name to
+	// its partition and survives Reset, since the names of a schema are
+	// fixed.
+	partitions []localPartition
+	byName     map[string]int32
+}
+
+// stringOwner records the local partition a global value was added to.
+type stringOwner struct {
+	partition int32
+	localID   int32
+}
+
+// localPartition lists the global ID of each local ID, -1 once the value
+// was replaced. Local IDs are never reused, so the width of a local hit
+// only grows within a stream.
+type localPartition struct {
+	ids []int32
+}
+
+// NewStringTable returns a StringTable whose global partition holds at most
+// capacity values and which adds only values of at most maxLength
+// characters; a value <= 0 leaves either unbounded, as in the default EXI
+// options.
+func NewStringTable(capacity, maxLength int) *StringTable {
+	if capacity < 0 {
+		capacity = 0
+	}
+	if maxLength < 0 {
+		maxLength = 0
+	}
+	return &StringTable{
+		capacity:  capacity,
+		maxLength: maxLength,
+		seed:      maphash.MakeSeed(),
+		byName:    make(map[string]int32),
+	}
+}
+
+// Len returns the number of values in the global partition.
+func (t *StringTable) Len() int {
+	return len(t.values)
+}
+
+// Reset empties the table for a new stream, keeping its memory.
+func (t *StringTable) Reset() {
+	for i := range t.values {
+		t.values[i] = ""
+	}
+	t.values = t.values[:0]
+	t.hashes = t.hashes[:0]
+	t.owners = t.owners[:0]
+	t.next = 0
+	for i := range t.index {
+		t.index[i] = 0
+	}
+	for i := range t.partitions {
+		t.partitions[i].ids = t.partitions[i].ids[:0]
+	}
+}
+
+// partition returns the local partition of the element name qname.
+func (t *StringTable) partition(qname string) int32 {
+	if p, ok := t.byName[qname]; ok {
+		return p
+	}
+	p := int32(len(t.partitions))
+	t.partitions = append(t.partitions, localPartition{})
+	t.byName[qname] = p
+	return p
+}
+
+// lookup returns the global ID of s and its hash, or -1.
+func (t *StringTable) lookup(s []byte) (int32, uint64) {
+	h := maphash.Bytes(t.seed, s)
+	if len(t.index) == 0 {
+		return -1, h
+	}
+	mask := uint64(len(t.index) - 1)
+	for i := h & mask; ; i = (i + 1) & mask {
+		id := t.index[i] - 1
+		if id < 0 {
+			return -1, h
+		}
+		if t.hashes[id] == h && t.values[id] == string(s) {
+			return id, h
+		}
+	}
+}
+
+// add adds the literal s, of hash h, to the global partition and to local
+// partition p, unless it is empty or longer than maxLength.
+func (t *StringTable) add(s string, h uint64, p int32) {
+	if len(s) == 0 || t.maxLength > 0 && len(s) > t.maxLength && utf8.RuneCountInString(s) > t.maxLength {
+		return
+	}
+	local := &t.partitions[p]
+	owner := stringOwner{partition: p, localID: int32(len(local.ids))}
+	var id int32
+	if t.capacity > 0 && len(t.values) == t.capacity {
+		id = int32(t.next)
+		t.next = (t.next + 1) % t.capacity
+		t.unindex(id)
+		old := t.owners[id]
+		t.partitions[old.partition].ids[old.localID] = -1
+		t.values[id], t.hashes[id], t.owners[id] = s, h, owner
+	} else {
+		if 4*(len(t.values)+1) > 3*len(t.index) {
+			t.grow(len(t.values) + 1)
+		}
+		id = int32(len(t.values))
+		t.values = append(t.values, s)
+		t.hashes = append(t.hashes, h)
+		t.owners = append(t.owners, owner)
+	}
+	local.ids = append(local.ids, id)
+	t.insert(id)
+}
+
+// insert adds global ID id to the index.
+func (t *StringTable) insert(id int32) {
+	mask := uint64(len(t.index) - 1)
+	i := t.hashes[id] & mask
+	for t.index[i] != 0 {
+		i = (i + 1) & mask
+	}
+	t.index[i] = id + 1
+}
+
+// unindex removes global ID id from the index, shifting the entries that
+// follow it back so that no probe sequence is broken.
+func (t *StringTable) unindex(id int32) {
+	mask := uint64(len(t.index) - 1)
+	i := t.hashes[id] & mask
+	for t.index[i] != id+1 {
+		i = (i + 1) & mask
+	}
+	for j := (i + 1) & mask; t.index[j] != 0; j = (j + 1) & mask {
+		// Move the entry at j into the hole at i if its home slot does not
+		// lie cyclically in (i, j].
+		home := t.hashes[t.index[j]-1] & mask
+		if (j-home)&mask >= (j-i)&mask {
+			t.index[i] = t.index[j]
+			i = j
+		}
+	}
+	t.index[i] = 0
+}
+
+// grow doubles the index until it fits n values at a load of 3/4 (a
+// bounded table is sized for its capacity at once) and reinserts the values.
+func (t *StringTable) grow(n int) {
+	want := n
+	n = 2 * len(t.index)
+	if n < 16 {
+		n = 16
+	}
+	if t.capacity > 0 {
+		if m := 2 << bits.Len(uint(t.capacity)); n < m {
+			n = m
+		}
+	}
+	for 4*want > 3*n {
+		n *= 2
+	}
+	if cap(t.index) >= n {
+		t.index = t.index[:n]
+		for i := range t.index {
+			t.index[i] = 0
+		}
+	} else {
+		t.index = make([]int32, n)
+	}
+	for id := range t.values {
+		t.insert(int32(id))
+	}
+}
+
+// compactIDBits is the width of a compact ID among n values, ceil(log2 n).
+func compactIDBits(n int) int {
+	if n <= 1 {
+		return 0
+	}
+	return bits.Len(uint(n - 1))
+}
+
+// writeCompactID writes the compact ID v among n values.
+func writeCompactID(bs *BitStream, n int, v int32) error {
+	if w := compactIDBits(n); w > 0 {
+		return bs.WriteBits(w, uint32(v))
+	}
+	return nil
+}
+
+// readCompactID reads a compact ID among n values.
+func readCompactID(bs *BitStream, n int) (int, error) {
+	w := compactIDBits(n)
+	if w == 0 {
+		return 0, nil
+	}
+	v, err := bs.ReadBits(w)
+	return int(v), err
+}
+
+// writeStringValue writes the content of the string element qname: a hit
+// if the stream's StringTable holds s, the literal (length+2 and the UTF-8
+// octets) otherwise. Without a StringTable it is always the literal, as
+// written by the reference C codec.
+func writeStringValue(bs *BitStream, qname string, s []byte) error {
+	if bs.strings != nil {
+		return writeStringTableValue(bs, qname, s)
+	}
+	if err := bs.WriteUnsignedVar(uint64(len(s)) + 2); err != nil {
+		return err
+	}
+	return bs.WriteOctets(s)
+}
+
+// writeStringTableValue is writeStringValue with a StringTable, kept apart
+// so that the literal path stays small.
+func writeStringTableValue(bs *BitStream, qname string, s []byte) error {
+	t := bs.strings
+	p := t.partition(qname)
+	id, h := t.lookup(s)
+	if id >= 0 {
+		if o := t.owners[id]; o.partition == p {
+			if err := bs.WriteUnsignedVar(0); err != nil {
+				return err
+			}
+			return writeCompactID(bs, len(t.partitions[p].ids), o.localID)
+		}
+		if err := bs.WriteUnsignedVar(1); err != nil {
+			return err
+		}
+		return writeCompactID(bs, len(t.values), id)
+	}
+	if err := bs.WriteUnsignedVar(uint64(len(s)) + 2); err != nil {
+		return err
+	}
+	if err := bs.WriteOctets(s); err != nil {
+		return err
+	}
+	t.add(string(s), h, p)
+	return nil
+}
+
+// readStringValue reads the content of the string element qname written by
+// writeStringValue. A literal is returned like readOctetSlice returns
+// binary content; a hit is returned as a copy of the value.
+func readStringValue(bs *BitStream, qname string) ([]byte, error) {
+	n, err := bs.ReadUnsignedVar()
+	if err != nil {
+		return nil, err
+	}
+	if bs.strings != nil || n < 2 {
+		return readStringTableValue(bs, qname, n)
+	}
+	if n-2 > uint64(bs.dataSize) {
+		return nil, bs.shortOctets(n - 2)
+	}
+	return bs.readOctetSlice(int(n - 2))
+}
+
+// readStringTableValue is readStringValue for a hit, or for any value with
+// a StringTable, after the unsigned integer n that starts it.
+func readStringTableValue(bs *BitStream, qname string, n uint64) ([]byte, error) {
+	t := bs.strings
+	if n >= 2 {
+		n -= 2
+		if n > uint64(bs.dataSize) {
+			return nil, bs.shortOctets(n)
+		}
+		// The table needs the value even where SkipBinary drops it.
+		p, err := bs.sliceOctets(int(n))
+		if err != nil {
+			return nil, err
+		}
+		s := string(p)
+		t.add(s, maphash.String(t.seed, s), t.partition(qname))
+		if bs.skipOctets {
+			return nil, nil
+		}
+		return p, nil
+	}
+	if t == nil {
+		return nil, fmt.Errorf("%w in %s: no string table", ErrStringTableHit, qname)
+	}
+	var id int32 = -1
+	if n == 0 {
+		ids := t.partitions[t.partition(qname)].ids
+		l, err := readCompactID(bs, len(ids))
+		if err != nil {
+			return nil, err
+		}
+		if l < len(ids) {
+			id = ids[l]
+		}
+	} else {
+		g, err := readCompactID(bs, len(t.values))
+		if err != nil {
+			return nil, err
+		}
+		if g < len(t.values) {
+			id = int32(g)
+		}
+	}
+	if id < 0 {
+		return nil, fmt.Errorf("%w in %s: no such value", ErrStringTableHit, qname)
+	}
+	if bs.skipOctets {
+		return nil, nil
+	}
+	v := t.values[id]
+	p := bs.arena.byteSlice(len(v))
+	copy(p, v)
+	return p, nil
+}
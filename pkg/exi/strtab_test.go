@@ -0,0 +1,229 @@
+package exi
+
+import (
+	"bytes"
+	"errors"
+	"fmt"
+	"math/rand"
+	"testing"
+
+	"example.com/exi-go/pkg/v2g/generated"
+)
+
+// refStringTable is a linear-search model of the EXI string table, written
+// straight from EXI 1.0 section 7.3.3, to check StringTable against.
+type refStringTable struct {
+	capacity, maxLength int
+	values              []string
+	owners              []stringOwner
+	locals              map[string][]int // global ID by local ID, -1 once replaced
+	names               map[string]int32
+	next                int
+}
+
+func (r *refStringTable) write(bs *BitStream, qname, s string) error {
+	if r.locals == nil {
+		r.locals, r.names = map[string][]int{}, map[string]int32{}
+	}
+	if _, ok := r.names[qname]; !ok {
+		r.names[qname] = int32(len(r.names))
+	}
+	local := r.locals[qname]
+	for l, g := range local {
+		if g >= 0 && r.values[g] == s {
+			bs.WriteUnsignedVar(0)
+			return writeCompactID(bs, len(local), int32(l))
+		}
+	}
+	for g, v := range r.values {
+		if v == s {
+			bs.WriteUnsignedVar(1)
+			return writeCompactID(bs, len(r.values), int32(g))
+		}
+	}
+	bs.WriteUnsignedVar(uint64(len(s)) + 2)
+	bs.WriteOctets([]byte(s))
+	if len(s) == 0 || r.maxLength > 0 && len(s) > r.maxLength {
+		return nil
+	}
+	owner := stringOwner{partition: r.names[qname], localID: int32(len(local))}
+	g := len(r.values)
+	if r.capacity > 0 && len(r.values) == r.capacity {
+		g = r.next
+		r.next = (r.next + 1) % r.capacity
+		for name, ids := range r.locals {
+			for l := range ids {
+				if ids[l] == g {
+					r.locals[name][l] = -1
+				}
+			}
+		}
+		r.values[g], r.owners[g] = s, owner
+	} else {
+		r.values = append(r.values, s)
+		r.owners = append(r.owners, owner)
+	}
+	r.locals[qname] = append(r.locals[qname], g)
+	return nil
+}
+
+func TestStringTableMatchesModel(t *testing.T) {
+	rng := rand.New(rand.NewSource(1))
+	names := []string{"EVSEID", "ServiceName", "Id"}
+	pool := make([]string, 24)
+	for i := range pool {
+		pool[i] = fmt.Sprintf("value-%d", i*7919)
+	}
+	pool[0] = ""
+	pool[1] = "a-value-longer-than-the-max-length"
+
+	for _, c := range []struct{ capacity, maxLength int }{{0, 0}, {5, 0}, {1, 0}, {16, 12}} {
+		name := fmt.Sprintf("cap%d_max%d", c.capacity, c.maxLength)
+		t.Run(name, func(t *testing.T) {
+			table := NewStringTable(c.capacity, c.maxLength)
+			for stream := 0; stream < 20; stream++ {
+				n := 1 + rng.Intn(200)
+				qnames, values := make([]string, n), make([]string, n)
+				for i := range values {
+					qnames[i] = names[rng.Intn(len(names))]
+					values[i] = pool[rng.Intn(len(pool))]
+				}
+
+				var got, want BitStream
+				gotBuf, wantBuf := make([]byte, 8192), make([]byte, 8192)
+				got.Init(gotBuf, 0)
+				got.UseStringTable(table)
+				want.Init(wantBuf, 0)
+				ref := &refStringTable{capacity: c.capacity, maxLength: c.maxLength}
+				for i := range values {
+					if err := writeStringValue(&got, qnames[i], []byte(values[i])); err != nil {
+						t.Fatal(err)
+					}
+					if err := ref.write(&want, qnames[i], values[i]); err != nil {
+						t.Fatal(err)
+					}
+				}
+				if !bytes.Equal(gotBuf[:got.Length()], wantBuf[:want.Length()]) {
+					t.Fatalf("stream %d: encoding differs from the model", stream)
+				}
+
+				var dec BitStream
+				dec.Init(gotBuf[:got.Length()], 0)
+				dec.UseStringTable(NewStringTable(c.capacity, c.maxLength))
+				for i := range values {
+					p, err := readStringValue(&dec, qnames[i])
+					if err != nil {
+						t.Fatalf("stream %d value %d: %v", stream, i, err)
+					}
+					if string(p) != values[i] {
+						t.Fatalf("stream %d value %d: got %q, want %q", stream, i, p, values[i])
+					}
+				}
+			}
+		})
+	}
+}
+
+func TestStringTableHits(t *testing.T) {
+	var bs BitStream
+	buf := make([]byte, 64)
+	bs.Init(buf, 0)
+	bs.UseStringTable(NewStringTable(0, 0))
+	for _, v := range []struct{ qname, s string }{
+		{"EVSEID", "DE*ABC*E1"}, // literal: length+2, then octets
+		{"EVSEID", "DE*ABC*E1"}, // local hit: 0, then 0 bits for 1 entry
+		{"Id", "DE*ABC*E1"},     // global hit: 1, then 0 bits for 1 entry
+	} {
+		if err := writeStringValue(&bs, v.qname, []byte(v.s)); err != nil {
+			t.Fatal(err)
+		}
+	}
+	want := append([]byte{9 + 2}, "DE*ABC*E1"...)
+	want = append(want, 0, 1)
+	if got := buf[:bs.Length()]; !bytes.Equal(got, want) {
+		t.Errorf("got % x, want % x", got, want)
+	}
+
+	var dec BitStream
+	dec.Init(want, 0)
+	if _, err := readStringValue(&dec, "EVSEID"); err != nil {
+		t.Fatal(err)
+	}
+	if _, err := readStringValue(&dec, "EVSEID"); !errors.Is(err, ErrStringTableHit) {
+		t.Errorf("hit without a table: err = %v, want ErrStringTableHit", err)
+	}
+}
+
+func TestEncoderStringTable(t *testing.T) {
+	same := "EV_TERMINATED"
+	msg := &generated.SessionStopReq{
+		Header:                   generated.MessageHeaderType{SessionID: []byte{1, 2, 3, 4, 5, 6, 7, 8}, TimeStamp: 1},
+		ChargingSession:          "Terminate",
+		EVTerminationCode:        &same,
+		EVTerminationExplanation: &same,
+	}
+	plain, err := NewEncoder().Encode(msg)
+	if err != nil {
+		t.Fatal(err)
+	}
+	plain = append([]byte(nil), plain...)
+
+	enc := NewEncoder()
+	enc.Strings = NewStringTable(0, 0)
+	for i := 0; i < 3; i++ { // the table starts empty for every message
+		size, err := enc.EncodedSize(msg)
+		if err != nil {
+			t.Fatal(err)
+		}
+		out, err := enc.Encode(msg)
+		if err != nil {
+			t.Fatal(err)
+		}
+		// The explanation is a global hit: one octet instead of the literal.
+		if len(out) != len(plain)-len(same) || size != len(out) {
+			t.Fatalf("pass %d: %d bytes (EncodedSize %d), want %d", i, len(out), size, len(plain)-len(same))
+		}
+
+		dec := NewDecoder()
+		if _, err := dec.Decode(out); !errors.Is(err, ErrStringTableHit) {
+			t.Errorf("decode without a table: err = %v, want ErrStringTableHit", err)
+		}
+		dec.Options.Strings = NewStringTable(0, 0)
+		got, err := dec.Decode(out)
+		if err != nil {
+			t.Fatal(err)
+		}
+		m := got.(*generated.SessionStopReq)
+		if m.EVTerminationCode == nil || *m.EVTerminationCode != same ||
+			m.EVTerminationExplanation == nil || *m.EVTerminationExplanation != same {
+			t.Errorf("pass %d: decoded %+v", i, m)
+		}
+	}
+}
+
+// BenchmarkStringTable measures writing a literal and a hit, e.g. an ID
+// repeated in a list, with and without a table.
+func BenchmarkStringTable(b *testing.B) {
+	values := [][]byte{[]byte("DE*ABC*E123456*1"), []byte("DE*ABC*E123456*1")}
+	buf := make([]byte, 64)
+	for _, on := range []bool{false, true} {
+		name := "Off"
+		var table *StringTable
+		if on {
+			name, table = "On", NewStringTable(0, 0)
+		}
+		b.Run(name, func(b *testing.B) {
+			b.ReportAllocs()
+			var bs BitStream
+			for i := 0; i < b.N; i++ {
+				bs.Init(buf, 0)
+				bs.UseStringTable(table)
+				for _, v := range values {
+					if err := writeStringValue(&bs, "EVSEID", v); err != nil {
+						b.Fatal(err)
+					}
+				}
+			}
+		})
+	}
+}
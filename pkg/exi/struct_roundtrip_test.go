@@ -946,6 +946,45 @@ func TestStructRoundTripCertificateInstallationRes(t *testing.T) {
 	}
 }
 
+// TestStructRoundTripCertificateInstallationResLargeChain checks a message
+// carrying several kilobytes of DER, larger than the default encode buffer.
+func TestStructRoundTripCertificateInstallationResLargeChain(t *testing.T) {
+	certs := make([][]byte, 3)
+	for i := range certs {
+		certs[i] = bytes.Repeat([]byte{0x30, 0x82, byte(i)}, 700)
+	}
+	orig := &generated.CertificateInstallationRes{
+		Header: generated.MessageHeaderType{
+			SessionID: []byte{0x0A, 0x1B, 0x2C, 0x3D},
+			TimeStamp: uint64(1672531200),
+		},
+		ResponseCode:             "OK",
+		EVSEProcessing:           "Finished",
+		CPSCertificateChain:      generated.CertificateChain{Certificates: certs},
+		ContractCertificateChain: generated.CertificateChain{Certificates: certs},
+	}
+
+	encoded, err := exi.EncodeStruct(orig)
+	if err != nil {
+		t.Fatalf("EncodeStruct failed: %v", err)
+	}
+	t.Logf("Encoded %d bytes", len(encoded))
+
+	decoded, err := exi.DecodeStruct(encoded, (*generated.CertificateInstallationRes)(nil))
+	if err != nil {
+		t.Fatalf("DecodeStruct failed: %v", err)
+	}
+	got := decoded.(*generated.CertificateInstallationRes)
+	for i, c := range certs {
+		if !bytes.Equal(c, got.CPSCertificateChain.Certificates[i]) {
+			t.Errorf("CPSCertificateChain certificate %d mismatch", i)
+		}
+		if !bytes.Equal(c, got.ContractCertificateChain.Certificates[i]) {
+			t.Errorf("ContractCertificateChain certificate %d mismatch", i)
+		}
+	}
+}
+
 func TestStructRoundTripVehicleCheckOutReq(t *testing.T) {
 	orig := &generated.VehicleCheckOutReq{
 		Header: generated.MessageHeaderType{
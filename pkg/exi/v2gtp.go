@@ -0,0 +1,128 @@
+package exi
+
+import (
+	"encoding/binary"
+	"errors"
+	"fmt"
+	"net"
+)
+
+// V2GTP (ISO 15118-20, Clause 7.7.3) frames every EXI message on the TCP/TLS
+// connection with an 8-byte header: protocol version, its bitwise inverse, a
+// 16-bit payload type and a 32-bit payload length, all big-endian.
+
+// V2GTPHeaderSize is the size of the V2GTP header in bytes.
+const V2GTPHeaderSize = 8
+
+// V2GTPVersion is the protocol version written and accepted in the header.
+const V2GTPVersion = 0x01
+
+// V2GTP payload types used by ISO 15118-20.
+const (
+	V2GTPPayloadSAP         uint16 = 0x8001 // SupportedAppProtocol messages
+	V2GTPPayloadMain        uint16 = 0x8002 // CommonMessages
+	V2GTPPayloadAC          uint16 = 0x8003 // AC main stream
+	V2GTPPayloadDC          uint16 = 0x8004 // DC main stream
+	V2GTPPayloadACDP        uint16 = 0x8005 // ACDP main stream
+	V2GTPPayloadWPT         uint16 = 0x8006 // WPT main stream
+	V2GTPPayloadSDPRequest  uint16 = 0x9000
+	V2GTPPayloadSDPResponse uint16 = 0x9001
+)
+
+// ErrInvalidV2GTPHeader is returned when the version bytes of a V2GTP header
+// are wrong.
+var ErrInvalidV2GTPHeader = errors.New("exi: invalid V2GTP header")
+
+// V2GTPHeader is a parsed V2GTP header.
+type V2GTPHeader struct {
+	PayloadType   uint16
+	PayloadLength uint32
+}
+
+// ParseV2GTPHeader parses the header at the start of b without copying. It
+// returns ErrNeedMoreData if b is shorter than V2GTPHeaderSize.
+func ParseV2GTPHeader(b []byte) (V2GTPHeader, error) {
+	if len(b) < V2GTPHeaderSize {
+		return V2GTPHeader{}, ErrNeedMoreData
+	}
+	if b[0] != V2GTPVersion || b[1] != ^byte(V2GTPVersion) {
+		return V2GTPHeader{}, fmt.Errorf("%w: version 0x%02x, inverse 0x%02x", ErrInvalidV2GTPHeader, b[0], b[1])
+	}
+	return V2GTPHeader{
+		PayloadType:   binary.BigEndian.Uint16(b[2:]),
+		PayloadLength: binary.BigEndian.Uint32(b[4:]),
+	}, nil
+}
+
+// ParseV2GTP parses the packet at the start of b and returns its header and
+// payload, which aliases b. It returns ErrNeedMoreData until b holds the
+// whole payload; bytes after the payload belong to the next packet. Callers
+// reading from a socket should bound PayloadLength before buffering that
+// much.
+func ParseV2GTP(b []byte) (V2GTPHeader, []byte, error) {
+	h, err := ParseV2GTPHeader(b)
+	if err != nil {
+		return h, nil, err
+	}
+	end := uint64(V2GTPHeaderSize) + uint64(h.PayloadLength)
+	if uint64(len(b)) < end {
+		return h, nil, ErrNeedMoreData
+	}
+	return h, b[V2GTPHeaderSize:end:end], nil
+}
+
+// PutV2GTPHeader writes a header for a payload of the given type and length
+// to the first V2GTPHeaderSize bytes of dst.
+func PutV2GTPHeader(dst []byte, payloadType uint16, payloadLength uint32) {
+	_ = dst[V2GTPHeaderSize-1]
+	dst[0] = V2GTPVersion
+	dst[1] = ^byte(V2GTPVersion)
+	binary.BigEndian.PutUint16(dst[2:], payloadType)
+	binary.BigEndian.PutUint32(dst[4:], payloadLength)
+}
+
+// V2GTPBuffers fills header for payload and returns both as net.Buffers, so
+// that writing them to a TCP connection is a single writev without copying
+// payload behind a header.
+func V2GTPBuffers(header *[V2GTPHeaderSize]byte, payloadType uint16, payload []byte) net.Buffers {
+	PutV2GTPHeader(header[:], payloadType, uint32(len(payload)))
+	return net.Buffers{header[:], payload}
+}
+
+// EncodeV2GTPInto encodes v into buf as a complete V2GTP packet and returns
+// its length. The EXI body is written straight after a reserved header slot
+// and the header is filled in afterwards, so nothing is copied. Like
+// EncodeInto it never allocates and reports a short buf as
+// ErrBitstreamOverflow.
+func (e *Encoder) EncodeV2GTPInto(buf []byte, payloadType uint16, v interface{}) (int, error) {
+	if len(buf) <= V2GTPHeaderSize {
+		return 0, ErrBitstreamOverflow
+	}
+	e.bs.Init(buf, V2GTPHeaderSize)
+	e.bs.UseStringTable(e.Strings)
+	if err := encodeTopLevel(&e.bs, v); err != nil {
+		return 0, err
+	}
+	n := e.bs.Length()
+	PutV2GTPHeader(buf, payloadType, uint32(n))
+	return V2GTPHeaderSize + n, nil
+}
+
+// EncodeV2GTPTo appends v as a complete V2GTP packet to dst, growing it as
+// needed like EncodeTo.
+func (e *Encoder) EncodeV2GTPTo(dst []byte, payloadType uint16, v interface{}) ([]byte, error) {
+	return e.appendTo(dst, v, nil, payloadType, true)
+}
+
+// DecodeV2GTP parses the V2GTP packet at the start of packet and decodes its
+// EXI payload. With d.Options.AliasInput the message aliases packet. The
+// payload type is returned, not checked: SDP payloads are not EXI, so
+// callers should dispatch on it before decoding.
+func (d *Decoder) DecodeV2GTP(packet []byte) (V2GTPHeader, interface{}, error) {
+	h, payload, err := ParseV2GTP(packet)
+	if err != nil {
+		return h, nil, err
+	}
+	msg, err := d.Decode(payload)
+	return h, msg, err
+}
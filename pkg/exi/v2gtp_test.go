@@ -0,0 +1,108 @@
+package exi_test
+
+import (
+	"bytes"
+	"errors"
+	"reflect"
+	"testing"
+
+	"example.com/exi-go/pkg/exi"
+	"example.com/exi-go/pkg/v2g/generated"
+)
+
+func v2gtpTestMessage() *generated.SessionSetupReq {
+	return &generated.SessionSetupReq{
+		Header: generated.MessageHeaderType{SessionID: []byte{1, 2, 3, 4, 5, 6, 7, 8}, TimeStamp: 1700000000},
+		EVCCID: []byte("WMIV1234567890ABCDE"),
+	}
+}
+
+func TestEncodeV2GTPInto(t *testing.T) {
+	msg := v2gtpTestMessage()
+	body, err := exi.EncodeStruct(msg)
+	if err != nil {
+		t.Fatal(err)
+	}
+	enc := exi.NewEncoder()
+	buf := make([]byte, 256)
+	n, err := enc.EncodeV2GTPInto(buf, exi.V2GTPPayloadMain, msg)
+	if err != nil {
+		t.Fatal(err)
+	}
+	want := append([]byte{0x01, 0xFE, 0x80, 0x02, 0, 0, 0, byte(len(body))}, body...)
+	if !bytes.Equal(buf[:n], want) {
+		t.Fatalf("EncodeV2GTPInto = % x, want % x", buf[:n], want)
+	}
+	if _, err := enc.EncodeV2GTPInto(buf[:n-1], exi.V2GTPPayloadMain, msg); !errors.Is(err, exi.ErrBitstreamOverflow) {
+		t.Fatalf("short buffer: err = %v", err)
+	}
+
+	// EncodeV2GTPTo appends after existing data and grows a small dst.
+	out, err := enc.EncodeV2GTPTo([]byte("keep"), exi.V2GTPPayloadMain, msg)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !bytes.Equal(out, append([]byte("keep"), want...)) {
+		t.Fatalf("EncodeV2GTPTo = % x", out)
+	}
+}
+
+func TestDecodeV2GTP(t *testing.T) {
+	msg := v2gtpTestMessage()
+	packet, err := exi.NewEncoder().EncodeV2GTPTo(nil, exi.V2GTPPayloadMain, msg)
+	if err != nil {
+		t.Fatal(err)
+	}
+	next := append(packet, 0x01, 0xFE) // start of the next packet
+
+	dec := exi.NewDecoder()
+	dec.Options.AliasInput = true
+	h, got, err := dec.DecodeV2GTP(next)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if h.PayloadType != exi.V2GTPPayloadMain || int(h.PayloadLength) != len(packet)-exi.V2GTPHeaderSize {
+		t.Fatalf("header = %+v", h)
+	}
+	if !reflect.DeepEqual(got, msg) {
+		t.Fatalf("decoded %+v, want %+v", got, msg)
+	}
+}
+
+func TestParseV2GTP(t *testing.T) {
+	packet := []byte{0x01, 0xFE, 0x90, 0x00, 0, 0, 0, 2, 0xAA, 0xBB, 0xCC}
+	h, payload, err := exi.ParseV2GTP(packet)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if h != (exi.V2GTPHeader{PayloadType: exi.V2GTPPayloadSDPRequest, PayloadLength: 2}) || !bytes.Equal(payload, []byte{0xAA, 0xBB}) {
+		t.Fatalf("ParseV2GTP = %+v, % x", h, payload)
+	}
+	if cap(payload) != 2 {
+		t.Errorf("payload capacity %d reaches past the packet", cap(payload))
+	}
+	for _, n := range []int{0, 7, 9} {
+		if _, _, err := exi.ParseV2GTP(packet[:n]); !errors.Is(err, exi.ErrNeedMoreData) {
+			t.Errorf("ParseV2GTP(%d bytes): err = %v, want ErrNeedMoreData", n, err)
+		}
+	}
+	if _, err := exi.ParseV2GTPHeader([]byte{0x02, 0xFD, 0x80, 0x02, 0, 0, 0, 0}); !errors.Is(err, exi.ErrInvalidV2GTPHeader) {
+		t.Errorf("bad version: err = %v", err)
+	}
+	if _, err := exi.ParseV2GTPHeader([]byte{0x01, 0xFF, 0x80, 0x02, 0, 0, 0, 0}); !errors.Is(err, exi.ErrInvalidV2GTPHeader) {
+		t.Errorf("bad inverse version: err = %v", err)
+	}
+}
+
+func TestV2GTPBuffers(t *testing.T) {
+	var hdr [exi.V2GTPHeaderSize]byte
+	payload := []byte{0x80, 0x8C}
+	bufs := exi.V2GTPBuffers(&hdr, exi.V2GTPPayloadMain, payload)
+	var w bytes.Buffer
+	if _, err := bufs.WriteTo(&w); err != nil {
+		t.Fatal(err)
+	}
+	if want := []byte{0x01, 0xFE, 0x80, 0x02, 0, 0, 0, 2, 0x80, 0x8C}; !bytes.Equal(w.Bytes(), want) {
+		t.Fatalf("wrote % x, want % x", w.Bytes(), want)
+	}
+}
@@ -0,0 +1,111 @@
+package exi
+
+import (
+	"errors"
+	"fmt"
+	"sync"
+)
+
+// ErrRepetitionLimit is returned (wrapped) when a message declares more list
+// entries than DecodeOptions.MaxRepetitions allows.
+var ErrRepetitionLimit = errors.New("exi: repetition limit exceeded")
+
+// ValidateMaxRepetitions is the number of list entries, summed over all the
+// lists of a message, that Validate accepts. The largest lists of ISO
+// 15118-20 (schedule and power profile entries) hold at most 1024 entries.
+const ValidateMaxRepetitions = 4096
+
+// validator is the state Validate reuses between calls.
+type validator struct {
+	bs    BitStream
+	arena *Arena
+	// msgs holds a message of each type to decode into, by event code.
+	msgs [1 << messageCodeBits]interface{}
+}
+
+var validatorPool = sync.Pool{New: func() interface{} {
+	return &validator{arena: NewArena(0)}
+}}
+
+// Validate checks that data starts with a well-formed EXI document: the
+// 0x80 header, a known message event code, and a body the message's decoder
+// accepts, with every length prefix and list count inside the buffer and at
+// most ValidateMaxRepetitions list entries. It returns the message type and
+// the number of bytes the document takes, which is less than len(data) if
+// data has trailing bytes.
+//
+// Validate runs the decoder in skip mode, so it accepts what Decode accepts
+// with MaxRepetitions set to ValidateMaxRepetitions. It is stricter than
+// Decode with the default options, which bound no list: a message with more
+// list entries than that fails Validate even if Decode takes it.
+//
+// Binary and string content is passed over without being copied, the
+// message is decoded into one Validate keeps, and lists are held in a reused
+// Arena. What is left to allocate is the optional parts of the message, a
+// few small objects that do not grow with the size of the frame.
+// Validate is safe for concurrent use.
+func Validate(data []byte) (*MessageInfo, int, error) {
+	v := validatorPool.Get().(*validator)
+	defer v.release()
+	return v.validate(data)
+}
+
+// validate is Validate with the state of v.
+func (v *validator) validate(data []byte) (*MessageInfo, int, error) {
+	bs := &v.bs
+	bs.Init(data, 0)
+	DecodeOptions{SkipBinary: true, Arena: v.arena, MaxRepetitions: ValidateMaxRepetitions}.apply(bs)
+	m, err := decodeDocumentStart(bs)
+	if err != nil {
+		return nil, 0, err
+	}
+	dst := v.msgs[m.Code]
+	if dst == nil {
+		dst = m.New()
+		v.msgs[m.Code] = dst
+	}
+	err = m.decodeInto(bs, dst)
+	m.Reset(dst) // drop what points into the arena
+	if err != nil {
+		return m, 0, fmt.Errorf("Validate: %s: %w", m.Name, err)
+	}
+	return m, bs.Length(), nil
+}
+
+// release returns v to the pool without keeping data alive.
+func (v *validator) release() {
+	v.bs.Init(nil, 0)
+	v.arena.Reset()
+	validatorPool.Put(v)
+}
+
+// readListCount reads the entry count of a list. Every entry takes at least
+// one bit, so a count beyond the bits left in the stream is rejected before
+// anything is allocated for it, as is one past the stream's repetition
+// limit (see DecodeOptions.MaxRepetitions).
+func readListCount(bs *BitStream) (uint64, error) {
+	n, err := bs.ReadUnsignedVar()
+	if err != nil {
+		return 0, err
+	}
+	if left := uint64((bs.dataSize-bs.bytePos)*8 - int(bs.bitCount)); n > left {
+		// The need is a lower bound, for StreamDecoder to wait for.
+		return 0, bs.shortBits(n)
+	}
+	if err := bs.repeat(n); err != nil {
+		return 0, err
+	}
+	return n, nil
+}
+
+// repeat counts n more list entries against the stream's repetition limit.
+func (bs *BitStream) repeat(n uint64) error {
+	if bs.maxRepeats == 0 {
+		return nil
+	}
+	if n > uint64(bs.maxRepeats-bs.repeats) {
+		return fmt.Errorf("%w: more than %d list entries", ErrRepetitionLimit, bs.maxRepeats)
+	}
+	bs.repeats += int(n)
+	return nil
+}
@@ -0,0 +1,190 @@
+package exi
+
+import (
+	"errors"
+	"fmt"
+	"os"
+	"path/filepath"
+	"testing"
+
+	"example.com/exi-go/pkg/v2g/generated"
+)
+
+func TestValidateGoldenVectors(t *testing.T) {
+	files, err := filepath.Glob(filepath.Join("..", "..", "testvectors", "*.exi"))
+	if err != nil || len(files) == 0 {
+		t.Fatalf("no test vectors: %v", err)
+	}
+	for _, f := range files {
+		data, err := os.ReadFile(f)
+		if err != nil {
+			t.Fatal(err)
+		}
+		name := filepath.Base(f)
+		full, decodeErr := DecodeStruct(data, nil)
+		m, n, err := Validate(data)
+		if (err == nil) != (decodeErr == nil) {
+			t.Errorf("%s: Validate err = %v, DecodeStruct err = %v", name, err, decodeErr)
+			continue
+		}
+		if err != nil {
+			continue
+		}
+		if m != MessageOf(full) || n != len(data) {
+			t.Errorf("%s: Validate = %s, %d; want %T, %d", name, m.Name, n, full, len(data))
+		}
+		// Trailing bytes are not part of the document.
+		if _, n, err := Validate(append(data[:len(data):len(data)], 0xFF, 0xFF)); err != nil || n != len(data) {
+			t.Errorf("%s with trailing bytes: Validate = %d, %v; want %d", name, n, err, len(data))
+		}
+		// Every prefix is accepted or rejected as DecodeStruct does it.
+		for i := 0; i < len(data); i++ {
+			_, decodeErr := DecodeStruct(data[:i], nil)
+			_, n, err := Validate(data[:i])
+			if (err == nil) != (decodeErr == nil) || n > i {
+				t.Errorf("%s[:%d]: Validate = %d, %v; DecodeStruct err = %v", name, i, n, err, decodeErr)
+			}
+		}
+	}
+}
+
+func TestValidateInvalid(t *testing.T) {
+	for name, data := range map[string][]byte{
+		"empty":         nil,
+		"header":        {0x90, 0x00},
+		"unknown event": {0x80, 0x18}, // event code 6
+	} {
+		if m, n, err := Validate(data); err == nil {
+			t.Errorf("%s: Validate = %v, %d, nil", name, m, n)
+		}
+	}
+}
+
+func authorizationSetupResWithServices(n int) *generated.AuthorizationSetupRes {
+	services := make([]string, n)
+	for i := range services {
+		services[i] = "EIM"
+	}
+	return &generated.AuthorizationSetupRes{
+		Header:                generated.MessageHeaderType{SessionID: []byte{1, 2, 3, 4, 5, 6, 7, 8}, TimeStamp: 1},
+		ResponseCode:          "OK",
+		AuthorizationServices: services,
+	}
+}
+
+func TestValidateRepetitionLimit(t *testing.T) {
+	data, err := EncodeStruct(authorizationSetupResWithServices(ValidateMaxRepetitions + 1))
+	if err != nil {
+		t.Fatal(err)
+	}
+	if _, err := DecodeStruct(data, nil); err != nil {
+		t.Fatalf("DecodeStruct without a limit: %v", err)
+	}
+	if _, _, err := Validate(data); !errors.Is(err, ErrRepetitionLimit) {
+		t.Errorf("Validate: err = %v, want ErrRepetitionLimit", err)
+	}
+
+	data, err = EncodeStruct(authorizationSetupResWithServices(100))
+	if err != nil {
+		t.Fatal(err)
+	}
+	if m, n, err := Validate(data); err != nil || m.Name != "AuthorizationSetupRes" || n != len(data) {
+		t.Errorf("Validate = %v, %d, %v", m, n, err)
+	}
+	if _, err := DecodeStructWithOptions(data, nil, DecodeOptions{MaxRepetitions: 99}); !errors.Is(err, ErrRepetitionLimit) {
+		t.Errorf("MaxRepetitions 99: err = %v, want ErrRepetitionLimit", err)
+	}
+	if _, err := DecodeStructWithOptions(data, nil, DecodeOptions{MaxRepetitions: 100}); err != nil {
+		t.Errorf("MaxRepetitions 100: %v", err)
+	}
+}
+
+// TestReadListCountBound checks that a list count cannot ask for more
+// entries than the stream has bits left, whatever the limit.
+func TestReadListCountBound(t *testing.T) {
+	for _, c := range []struct {
+		data []byte
+		ok   bool
+		need int // bytes for one bit per entry
+	}{
+		{[]byte{0x10, 0xFF, 0xFF}, true, 0},                      // 16 entries, 16 bits left
+		{[]byte{0x11, 0xFF, 0xFF}, false, 4},                     // 17 entries
+		{[]byte{0xFF, 0xFF, 0xFF, 0xFF, 0x0F}, false, 1<<29 + 5}, // 2^32-1 entries
+	} {
+		var bs BitStream
+		bs.Init(c.data, 0)
+		n, err := readListCount(&bs)
+		if (err == nil) != c.ok || err != nil && !errors.Is(err, ErrBitstreamOverflow) || bs.need != c.need {
+			t.Errorf("% x: readListCount = %d, %v, need %d", c.data, n, err, bs.need)
+		}
+	}
+}
+
+// TestValidateAllocs checks that what Validate allocates does not grow with
+// the binary content or the lists of a message. It runs one validator
+// rather than the pool, which the race detector empties at random.
+func TestValidateAllocs(t *testing.T) {
+	allocs := func(msg interface{}) float64 {
+		data, err := EncodeStruct(msg)
+		if err != nil {
+			t.Fatal(err)
+		}
+		v := &validator{arena: NewArena(0)}
+		return testing.AllocsPerRun(100, func() {
+			if _, _, err := v.validate(data); err != nil {
+				t.Fatal(err)
+			}
+			v.arena.Reset()
+		})
+	}
+	for _, c := range []struct{ small, large interface{} }{
+		{certificateInstallationResWithChain(0), certificateInstallationResWithChain(4)},
+		{authorizationSetupResWithServices(1), authorizationSetupResWithServices(500)},
+	} {
+		small, large := allocs(c.small), allocs(c.large)
+		if large > small {
+			t.Errorf("%T: %.0f allocs/op, %.0f for the small message", c.large, large, small)
+		}
+	}
+}
+
+// BenchmarkValidate compares Validate with a full decode of the golden
+// vectors.
+func BenchmarkValidate(b *testing.B) {
+	var vectors [][]byte
+	files, _ := filepath.Glob(filepath.Join("..", "..", "testvectors", "*.exi"))
+	for _, f := range files {
+		data, err := os.ReadFile(f)
+		if err != nil {
+			b.Fatal(err)
+		}
+		if _, err := DecodeStruct(data, nil); err == nil {
+			vectors = append(vectors, data)
+		}
+	}
+	certs, err := EncodeStruct(certificateInstallationResWithChain(4))
+	if err != nil {
+		b.Fatal(err)
+	}
+	for _, c := range []struct {
+		name    string
+		vectors [][]byte
+	}{{"Corpus", vectors}, {"Certificates", [][]byte{certs}}} {
+		b.Run(fmt.Sprintf("%s/Validate", c.name), func(b *testing.B) {
+			b.ReportAllocs()
+			for i := 0; i < b.N; i++ {
+				if _, _, err := Validate(c.vectors[i%len(c.vectors)]); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+		b.Run(fmt.Sprintf("%s/Decode", c.name), func(b *testing.B) {
+			b.ReportAllocs()
+			for i := 0; i < b.N; i++ {
+				if _, err := DecodeStruct(c.vectors[i%len(c.vectors)], nil); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+	}
+}
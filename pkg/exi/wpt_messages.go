@@ -53,23 +53,29 @@ func EncodeWPT_AlignmentCheckReq(bs *BitStream, v *generated.WPT_AlignmentCheckR
 
 // DecodeWPT_AlignmentCheckReq decodes the WPT_AlignmentCheckReq body.
 func DecodeWPT_AlignmentCheckReq(bs *BitStream) (*generated.WPT_AlignmentCheckReq, error) {
+	return decodeNew(bs, decodeWPT_AlignmentCheckReqInto)
+}
+
+// decodeWPT_AlignmentCheckReqInto is DecodeWPT_AlignmentCheckReq decoding into dst.
+func decodeWPT_AlignmentCheckReqInto(bs *BitStream, dst *generated.WPT_AlignmentCheckReq) error {
 	// START Header
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// END WPT_AlignmentCheckReq
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.WPT_AlignmentCheckReq{
-		Header: *header,
-	}, nil
+	*dst = generated.WPT_AlignmentCheckReq{
+		Header: header,
+	}
+	return nil
 }
 
 // ========================== WPT_AlignmentCheckRes ==========================
@@ -184,41 +190,46 @@ func EncodeWPT_AlignmentCheckRes(bs *BitStream, v *generated.WPT_AlignmentCheckR
 
 // DecodeWPT_AlignmentCheckRes decodes the WPT_AlignmentCheckRes body.
 func DecodeWPT_AlignmentCheckRes(bs *BitStream) (*generated.WPT_AlignmentCheckRes, error) {
+	return decodeNew(bs, decodeWPT_AlignmentCheckResInto)
+}
+
+// decodeWPT_AlignmentCheckResInto is DecodeWPT_AlignmentCheckRes decoding into dst.
+func decodeWPT_AlignmentCheckResInto(bs *BitStream, dst *generated.WPT_AlignmentCheckRes) error {
 	// START Header
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// ResponseCode
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	responseCodeVal, err := bs.ReadBits(6)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	responseCode := mapEnumToResponseCode(uint8(responseCodeVal))
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// AlignmentStatus
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	alignStatusVal, err := bs.ReadBits(2)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	var alignmentStatus string
 	switch alignStatusVal {
@@ -232,11 +243,11 @@ func DecodeWPT_AlignmentCheckRes(bs *BitStream) (*generated.WPT_AlignmentCheckRe
 		alignmentStatus = "NotAligned"
 	}
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	res := &generated.WPT_AlignmentCheckRes{
-		Header:          *header,
+	*dst = generated.WPT_AlignmentCheckRes{
+		Header:          header,
 		ResponseCode:    responseCode,
 		AlignmentStatus: alignmentStatus,
 	}
@@ -244,48 +255,48 @@ func DecodeWPT_AlignmentCheckRes(bs *BitStream) (*generated.WPT_AlignmentCheckRe
 	// Check for optional AlignmentOffset_X
 	eventCode, err := bs.ReadBits(1)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	if eventCode == 0 {
 		offsetX, err := decodeRationalNumber(bs)
 		if err != nil {
-			return nil, err
+			return err
 		}
-		res.AlignmentOffset_X = offsetX
+		dst.AlignmentOffset_X = offsetX
 
 		// Check for optional AlignmentOffset_Y
 		eventCode, err = bs.ReadBits(1)
 		if err != nil {
-			return nil, err
+			return err
 		}
 		if eventCode == 0 {
 			offsetY, err := decodeRationalNumber(bs)
 			if err != nil {
-				return nil, err
+				return err
 			}
-			res.AlignmentOffset_Y = offsetY
+			dst.AlignmentOffset_Y = offsetY
 
 			// Check for optional AlignmentOffset_Z
 			eventCode, err = bs.ReadBits(1)
 			if err != nil {
-				return nil, err
+				return err
 			}
 			if eventCode == 0 {
 				offsetZ, err := decodeRationalNumber(bs)
 				if err != nil {
-					return nil, err
+					return err
 				}
-				res.AlignmentOffset_Z = offsetZ
+				dst.AlignmentOffset_Z = offsetZ
 
 				// END marker
 				if _, err := bs.ReadBits(1); err != nil {
-					return nil, err
+					return err
 				}
 			}
 		}
 	}
 
-	return res, nil
+	return nil
 }
 
 // ========================== WPT_FinePositioningReq ==========================
@@ -326,21 +337,27 @@ func EncodeWPT_FinePositioningReq(bs *BitStream, v *generated.WPT_FinePositionin
 }
 
 func DecodeWPT_FinePositioningReq(bs *BitStream) (*generated.WPT_FinePositioningReq, error) {
+	return decodeNew(bs, decodeWPT_FinePositioningReqInto)
+}
+
+// decodeWPT_FinePositioningReqInto is DecodeWPT_FinePositioningReq decoding into dst.
+func decodeWPT_FinePositioningReqInto(bs *BitStream, dst *generated.WPT_FinePositioningReq) error {
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.WPT_FinePositioningReq{
-		Header: *header,
-	}, nil
+	*dst = generated.WPT_FinePositioningReq{
+		Header: header,
+	}
+	return nil
 }
 
 // ========================== WPT_FinePositioningRes ==========================
@@ -422,40 +439,45 @@ func EncodeWPT_FinePositioningRes(bs *BitStream, v *generated.WPT_FinePositionin
 }
 
 func DecodeWPT_FinePositioningRes(bs *BitStream) (*generated.WPT_FinePositioningRes, error) {
+	return decodeNew(bs, decodeWPT_FinePositioningResInto)
+}
+
+// decodeWPT_FinePositioningResInto is DecodeWPT_FinePositioningRes decoding into dst.
+func decodeWPT_FinePositioningResInto(bs *BitStream, dst *generated.WPT_FinePositioningRes) error {
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// ResponseCode
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	responseCodeVal, err := bs.ReadBits(6)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	responseCode := mapEnumToResponseCode(uint8(responseCodeVal))
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// PositioningStatus
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	posStatusVal, err := bs.ReadBits(2)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	var positioningStatus string
 	switch posStatusVal {
@@ -469,19 +491,20 @@ func DecodeWPT_FinePositioningRes(bs *BitStream) (*generated.WPT_FinePositioning
 		positioningStatus = "InProgress"
 	}
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Skip optional fields and END marker
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.WPT_FinePositioningRes{
-		Header:            *header,
+	*dst = generated.WPT_FinePositioningRes{
+		Header:            header,
 		ResponseCode:      responseCode,
 		PositioningStatus: positioningStatus,
-	}, nil
+	}
+	return nil
 }
 
 // ========================== WPT_ChargeLoopReq ==========================
@@ -538,39 +561,45 @@ func EncodeWPT_ChargeLoopReq(bs *BitStream, v *generated.WPT_ChargeLoopReq) erro
 }
 
 func DecodeWPT_ChargeLoopReq(bs *BitStream) (*generated.WPT_ChargeLoopReq, error) {
+	return decodeNew(bs, decodeWPT_ChargeLoopReqInto)
+}
+
+// decodeWPT_ChargeLoopReqInto is DecodeWPT_ChargeLoopReq decoding into dst.
+func decodeWPT_ChargeLoopReqInto(bs *BitStream, dst *generated.WPT_ChargeLoopReq) error {
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// EVProcessing
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	evProcVal, err := bs.ReadBits(2)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	evProcessing := mapEnumToEVProcessing(uint8(evProcVal))
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Skip to END marker
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.WPT_ChargeLoopReq{
-		Header:       *header,
+	*dst = generated.WPT_ChargeLoopReq{
+		Header:       header,
 		EVProcessing: evProcessing,
-	}, nil
+	}
+	return nil
 }
 
 // ========================== WPT_ChargeLoopRes ==========================
@@ -642,54 +671,60 @@ func EncodeWPT_ChargeLoopRes(bs *BitStream, v *generated.WPT_ChargeLoopRes) erro
 }
 
 func DecodeWPT_ChargeLoopRes(bs *BitStream) (*generated.WPT_ChargeLoopRes, error) {
+	return decodeNew(bs, decodeWPT_ChargeLoopResInto)
+}
+
+// decodeWPT_ChargeLoopResInto is DecodeWPT_ChargeLoopRes decoding into dst.
+func decodeWPT_ChargeLoopResInto(bs *BitStream, dst *generated.WPT_ChargeLoopRes) error {
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	header, err := decodeMessageHeaderType(bs)
 	if err != nil {
-		return nil, err
+		return err
 	}
 
 	// ResponseCode
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	responseCodeVal, err := bs.ReadBits(6)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	responseCode := mapEnumToResponseCode(uint8(responseCodeVal))
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// EVSEProcessing
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 	evseProcVal, err := bs.ReadBits(2)
 	if err != nil {
-		return nil, err
+		return err
 	}
 	evseProcessing := mapEnumToEVSEProcessing(uint8(evseProcVal))
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
 	// Skip to END marker
 	if _, err := bs.ReadBits(1); err != nil {
-		return nil, err
+		return err
 	}
 
-	return &generated.WPT_ChargeLoopRes{
-		Header:         *header,
+	*dst = generated.WPT_ChargeLoopRes{
+		Header:         header,
 		ResponseCode:   responseCode,
 		EVSEProcessing: evseProcessing,
-	}, nil
+	}
+	return nil
 }
@@ -0,0 +1,484 @@
+package exi
+
+import (
+	"bytes"
+	"encoding/xml"
+	"errors"
+	"fmt"
+	"io"
+	"reflect"
+	"strconv"
+	"strings"
+	"sync"
+	"unicode/utf8"
+)
+
+// Schema-informed XML path used by Codec when Config.UseStub is false.
+//
+// EncodeXML walks the document with xml.Decoder.RawToken and fills the Go
+// struct of the root element field by field (no intermediate DOM), then
+// encodes it with the per-message encoder. DecodeEXI decodes with the
+// per-message decoder and appends the XML rendering of the struct directly
+// to the output buffer. Elements are matched by local name, so namespace
+// prefixes in the input are accepted; the output carries no namespace
+// declarations. Binary fields ([]byte) use the XSD hexBinary lexical form.
+
+// ErrUnknownRootElement is returned by the schema-informed XML path for a
+// document whose root element is not a supported message.
+var ErrUnknownRootElement = errors.New("exi: unknown root element")
+
+// xmlField describes how one struct field maps to XML.
+type xmlField struct {
+	index     int
+	name      string // element or attribute local name
+	wrap      string // parent element of "wrap>name" tags, else ""
+	attr      bool
+	omitEmpty bool
+}
+
+// xmlStruct is the cached XML binding of a struct type.
+type xmlStruct struct {
+	fields []xmlField
+	elems  map[string]int // first path element -> index in fields
+	attrs  map[string]int
+}
+
+var xmlStructs sync.Map // reflect.Type -> *xmlStruct
+
+func xmlStructOf(t reflect.Type) *xmlStruct {
+	if s, ok := xmlStructs.Load(t); ok {
+		return s.(*xmlStruct)
+	}
+	s := &xmlStruct{elems: map[string]int{}, attrs: map[string]int{}}
+	for i := 0; i < t.NumField(); i++ {
+		sf := t.Field(i)
+		if !sf.IsExported() || sf.Name == "XMLName" {
+			continue
+		}
+		tag := sf.Tag.Get("xml")
+		if tag == "-" {
+			continue
+		}
+		f := xmlField{index: i, name: sf.Name}
+		if tag != "" {
+			parts := strings.Split(tag, ",")
+			if parts[0] != "" {
+				f.name = parts[0]
+			}
+			for _, opt := range parts[1:] {
+				switch opt {
+				case "attr":
+					f.attr = true
+				case "omitempty":
+					f.omitEmpty = true
+				}
+			}
+		}
+		if i := strings.IndexByte(f.name, '>'); i >= 0 {
+			f.wrap, f.name = f.name[:i], f.name[i+1:]
+		}
+		key := f.name
+		if f.wrap != "" {
+			key = f.wrap
+		}
+		if f.attr {
+			s.attrs[key] = len(s.fields)
+		} else {
+			s.elems[key] = len(s.fields)
+		}
+		s.fields = append(s.fields, f)
+	}
+	v, _ := xmlStructs.LoadOrStore(t, s)
+	return v.(*xmlStruct)
+}
+
+// xmlToStruct parses an XML document into a new message struct and returns
+// a pointer to it.
+func xmlToStruct(data []byte) (interface{}, error) {
+	r := xmlReader{d: xml.NewDecoder(bytes.NewReader(data))}
+	var root reflect.Value
+	for {
+		tok, err := r.d.RawToken()
+		if err == io.EOF {
+			if !root.IsValid() {
+				return nil, errors.New("exi: XML document has no root element")
+			}
+			return root.Interface(), nil
+		}
+		if err != nil {
+			return nil, err
+		}
+		switch tok := tok.(type) {
+		case xml.StartElement:
+			if root.IsValid() {
+				return nil, fmt.Errorf("exi: XML content after root element %s", tok.Name.Local)
+			}
+			m := MessageByName(tok.Name.Local)
+			if m == nil {
+				return nil, fmt.Errorf("%w: %s", ErrUnknownRootElement, tok.Name.Local)
+			}
+			root = reflect.ValueOf(m.New())
+			if err := r.readStruct(tok, root.Elem()); err != nil {
+				return nil, err
+			}
+		case xml.CharData:
+			if len(bytes.TrimSpace(tok)) != 0 {
+				return nil, errors.New("exi: XML text outside root element")
+			}
+		}
+	}
+}
+
+type xmlReader struct {
+	d    *xml.Decoder
+	text []byte // scratch for accumulating character data
+}
+
+// readStruct fills the struct v from the children of start, up to and
+// including the matching end element. Unknown elements are skipped.
+func (r *xmlReader) readStruct(start xml.StartElement, v reflect.Value) error {
+	s := xmlStructOf(v.Type())
+	for _, a := range start.Attr {
+		if i, ok := s.attrs[a.Name.Local]; ok {
+			if err := setXMLText(v.Field(s.fields[i].index), a.Value); err != nil {
+				return fmt.Errorf("exi: attribute %s: %w", a.Name.Local, err)
+			}
+		}
+	}
+	for {
+		tok, err := r.d.RawToken()
+		if err != nil {
+			return xmlEOF(err)
+		}
+		switch tok := tok.(type) {
+		case xml.StartElement:
+			i, ok := s.elems[tok.Name.Local]
+			if !ok {
+				if err := r.skip(); err != nil {
+					return err
+				}
+				continue
+			}
+			f := &s.fields[i]
+			fv := v.Field(f.index)
+			if f.wrap == "" {
+				err = r.readValue(tok, fv)
+			} else {
+				err = r.readWrapped(tok, f.name, fv)
+			}
+			if err != nil {
+				return err
+			}
+		case xml.EndElement:
+			return checkXMLEnd(start, tok)
+		}
+	}
+}
+
+// readWrapped reads the <name> children of a "wrap>name" wrapper element.
+func (r *xmlReader) readWrapped(start xml.StartElement, name string, fv reflect.Value) error {
+	for {
+		tok, err := r.d.RawToken()
+		if err != nil {
+			return xmlEOF(err)
+		}
+		switch tok := tok.(type) {
+		case xml.StartElement:
+			if tok.Name.Local != name {
+				if err := r.skip(); err != nil {
+					return err
+				}
+				continue
+			}
+			if err := r.readValue(tok, fv); err != nil {
+				return err
+			}
+		case xml.EndElement:
+			return checkXMLEnd(start, tok)
+		}
+	}
+}
+
+// readValue decodes the element start into fv. Pointers are allocated and
+// slices other than []byte get one item appended per element.
+func (r *xmlReader) readValue(start xml.StartElement, fv reflect.Value) error {
+	switch fv.Kind() {
+	case reflect.Ptr:
+		if fv.IsNil() {
+			fv.Set(reflect.New(fv.Type().Elem()))
+		}
+		return r.readValue(start, fv.Elem())
+	case reflect.Slice:
+		if fv.Type().Elem().Kind() != reflect.Uint8 {
+			n := fv.Len()
+			fv.Set(reflect.Append(fv, reflect.Zero(fv.Type().Elem())))
+			return r.readValue(start, fv.Index(n))
+		}
+	case reflect.Struct:
+		return r.readStruct(start, fv)
+	}
+
+	r.text = r.text[:0]
+	for {
+		tok, err := r.d.RawToken()
+		if err != nil {
+			return xmlEOF(err)
+		}
+		switch tok := tok.(type) {
+		case xml.CharData:
+			r.text = append(r.text, tok...)
+		case xml.StartElement:
+			return fmt.Errorf("exi: element %s: unexpected child %s", start.Name.Local, tok.Name.Local)
+		case xml.EndElement:
+			if err := checkXMLEnd(start, tok); err != nil {
+				return err
+			}
+			if err := setXMLText(fv, string(r.text)); err != nil {
+				return fmt.Errorf("exi: element %s: %w", start.Name.Local, err)
+			}
+			return nil
+		}
+	}
+}
+
+// skip consumes tokens up to the end of the element just started.
+func (r *xmlReader) skip() error {
+	for depth := 1; depth > 0; {
+		tok, err := r.d.RawToken()
+		if err != nil {
+			return xmlEOF(err)
+		}
+		switch tok.(type) {
+		case xml.StartElement:
+			depth++
+		case xml.EndElement:
+			depth--
+		}
+	}
+	return nil
+}
+
+func checkXMLEnd(start xml.StartElement, end xml.EndElement) error {
+	if end.Name.Local != start.Name.Local || end.Name.Space != start.Name.Space {
+		return fmt.Errorf("exi: element %s closed by %s", start.Name.Local, end.Name.Local)
+	}
+	return nil
+}
+
+func xmlEOF(err error) error {
+	if err == io.EOF {
+		return io.ErrUnexpectedEOF
+	}
+	return err
+}
+
+// setXMLText parses the lexical value s into the scalar fv.
+func setXMLText(fv reflect.Value, s string) error {
+	switch fv.Kind() {
+	case reflect.String:
+		fv.SetString(s)
+		return nil
+	case reflect.Slice:
+		b, err := parseHexBinary(strings.TrimSpace(s))
+		if err != nil {
+			return err
+		}
+		fv.SetBytes(b)
+		return nil
+	}
+	s = strings.TrimSpace(s)
+	switch fv.Kind() {
+	case reflect.Bool:
+		b, err := strconv.ParseBool(s)
+		if err != nil {
+			return err
+		}
+		fv.SetBool(b)
+	case reflect.Int, reflect.Int8, reflect.Int16, reflect.Int32, reflect.Int64:
+		n, err := strconv.ParseInt(s, 10, fv.Type().Bits())
+		if err != nil {
+			return err
+		}
+		fv.SetInt(n)
+	case reflect.Uint, reflect.Uint8, reflect.Uint16, reflect.Uint32, reflect.Uint64:
+		n, err := strconv.ParseUint(s, 10, fv.Type().Bits())
+		if err != nil {
+			return err
+		}
+		fv.SetUint(n)
+	case reflect.Float32, reflect.Float64:
+		n, err := strconv.ParseFloat(s, fv.Type().Bits())
+		if err != nil {
+			return err
+		}
+		fv.SetFloat(n)
+	default:
+		return fmt.Errorf("unsupported field type %s", fv.Type())
+	}
+	return nil
+}
+
+func parseHexBinary(s string) ([]byte, error) {
+	if len(s)%2 != 0 {
+		return nil, errors.New("odd-length hexBinary value")
+	}
+	out := make([]byte, len(s)/2)
+	for i := range out {
+		hi, ok1 := fromHexChar(s[2*i])
+		lo, ok2 := fromHexChar(s[2*i+1])
+		if !ok1 || !ok2 {
+			return nil, fmt.Errorf("invalid hexBinary value %q", s)
+		}
+		out[i] = hi<<4 | lo
+	}
+	return out, nil
+}
+
+func fromHexChar(c byte) (byte, bool) {
+	switch {
+	case '0' <= c && c <= '9':
+		return c - '0', true
+	case 'a' <= c && c <= 'f':
+		return c - 'a' + 10, true
+	case 'A' <= c && c <= 'F':
+		return c - 'A' + 10, true
+	}
+	return 0, false
+}
+
+// appendStructXML appends the XML rendering of the message struct v (a
+// pointer) to dst.
+func appendStructXML(dst []byte, v interface{}) ([]byte, error) {
+	rv := reflect.ValueOf(v)
+	if rv.Kind() != reflect.Ptr || rv.IsNil() || rv.Elem().Kind() != reflect.Struct {
+		return dst, fmt.Errorf("exi: cannot render %T as XML", v)
+	}
+	return appendElementXML(dst, rv.Elem().Type().Name(), rv.Elem())
+}
+
+func appendElementXML(dst []byte, name string, v reflect.Value) ([]byte, error) {
+	switch v.Kind() {
+	case reflect.Ptr:
+		if v.IsNil() {
+			return dst, nil
+		}
+		return appendElementXML(dst, name, v.Elem())
+	case reflect.Slice:
+		if v.Type().Elem().Kind() != reflect.Uint8 {
+			var err error
+			for i := 0; i < v.Len() && err == nil; i++ {
+				dst, err = appendElementXML(dst, name, v.Index(i))
+			}
+			return dst, err
+		}
+	}
+
+	dst = append(dst, '<')
+	dst = append(dst, name...)
+	if v.Kind() != reflect.Struct {
+		dst = append(dst, '>')
+		dst = appendXMLText(dst, v, false)
+	} else {
+		s := xmlStructOf(v.Type())
+		for i := range s.fields {
+			f := &s.fields[i]
+			if !f.attr {
+				continue
+			}
+			fv := v.Field(f.index)
+			if f.omitEmpty && fv.IsZero() {
+				continue
+			}
+			dst = append(dst, ' ')
+			dst = append(dst, f.name...)
+			dst = append(dst, `="`...)
+			dst = appendXMLText(dst, fv, true)
+			dst = append(dst, '"')
+		}
+		dst = append(dst, '>')
+		for i := range s.fields {
+			f := &s.fields[i]
+			fv := v.Field(f.index)
+			if f.attr || (f.omitEmpty && fv.IsZero()) {
+				continue
+			}
+			var err error
+			if f.wrap == "" {
+				dst, err = appendElementXML(dst, f.name, fv)
+			} else if fv.Len() > 0 {
+				dst = append(append(append(dst, '<'), f.wrap...), '>')
+				dst, err = appendElementXML(dst, f.name, fv)
+				dst = append(append(append(dst, "</"...), f.wrap...), '>')
+			}
+			if err != nil {
+				return dst, err
+			}
+		}
+	}
+	dst = append(dst, "</"...)
+	dst = append(dst, name...)
+	return append(dst, '>'), nil
+}
+
+const upperHex = "0123456789ABCDEF"
+
+// appendXMLText appends the escaped lexical form of the scalar v.
+func appendXMLText(dst []byte, v reflect.Value, attr bool) []byte {
+	switch v.Kind() {
+	case reflect.String:
+		return appendEscapedXML(dst, v.String(), attr)
+	case reflect.Slice:
+		for _, b := range v.Bytes() {
+			dst = append(dst, upperHex[b>>4], upperHex[b&0xF])
+		}
+		return dst
+	case reflect.Bool:
+		return strconv.AppendBool(dst, v.Bool())
+	case reflect.Int, reflect.Int8, reflect.Int16, reflect.Int32, reflect.Int64:
+		return strconv.AppendInt(dst, v.Int(), 10)
+	case reflect.Uint, reflect.Uint8, reflect.Uint16, reflect.Uint32, reflect.Uint64:
+		return strconv.AppendUint(dst, v.Uint(), 10)
+	case reflect.Float32, reflect.Float64:
+		return strconv.AppendFloat(dst, v.Float(), 'g', -1, v.Type().Bits())
+	}
+	return dst
+}
+
+// appendEscapedXML appends s with the XML special characters escaped and
+// invalid UTF-8 replaced by U+FFFD, matching xml.EscapeText.
+func appendEscapedXML(dst []byte, s string, attr bool) []byte {
+	for i := 0; i < len(s); {
+		c := s[i]
+		if c < utf8.RuneSelf {
+			switch {
+			case c == '&':
+				dst = append(dst, "&amp;"...)
+			case c == '<':
+				dst = append(dst, "&lt;"...)
+			case c == '>':
+				dst = append(dst, "&gt;"...)
+			case c == '"' && attr:
+				dst = append(dst, "&#34;"...)
+			case c == '\r':
+				dst = append(dst, "&#xD;"...)
+			case (c == '\n' || c == '\t') && attr:
+				dst = append(dst, "&#x"...)
+				dst = append(dst, upperHex[c>>4], upperHex[c&0xF], ';')
+			case c < 0x20 && c != '\n' && c != '\t':
+				dst = append(dst, "\uFFFD"...)
+			default:
+				dst = append(dst, c)
+			}
+			i++
+			continue
+		}
+		r, n := utf8.DecodeRuneInString(s[i:])
+		if r == utf8.RuneError && n == 1 {
+			dst = append(dst, "\uFFFD"...)
+		} else {
+			dst = append(dst, s[i:i+n]...)
+		}
+		i += n
+	}
+	return dst
+}
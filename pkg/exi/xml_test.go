@@ -0,0 +1,177 @@
+package exi_test
+
+import (
+	"bytes"
+	"errors"
+	"os"
+	"path/filepath"
+	"reflect"
+	"testing"
+
+	"example.com/exi-go/pkg/exi"
+	"example.com/exi-go/pkg/v2g/generated"
+)
+
+func newSchemaCodec(t testing.TB) *exi.Codec {
+	t.Helper()
+	c := exi.NewCodec(&exi.Config{})
+	if err := c.Init(); err != nil {
+		t.Fatal(err)
+	}
+	return c
+}
+
+const sessionSetupReqXML = `<?xml version="1.0" encoding="UTF-8"?>
+<ns:SessionSetupReq xmlns:ns="urn:iso:std:iso:15118:-20:CommonMessages" xmlns:ct="urn:iso:std:iso:15118:-20:CommonTypes">
+  <ct:Header>
+    <ct:SessionID>0102030405060708</ct:SessionID>
+    <ct:TimeStamp>1700000000</ct:TimeStamp>
+  </ct:Header>
+  <!-- VIN-derived identifier -->
+  <ns:EVCCID>574D4956313233</ns:EVCCID>
+</ns:SessionSetupReq>`
+
+func TestSchemaXMLEncodeMatchesStructPath(t *testing.T) {
+	c := newSchemaCodec(t)
+	got, err := c.EncodeXML([]byte(sessionSetupReqXML))
+	if err != nil {
+		t.Fatal(err)
+	}
+	want, err := exi.EncodeStruct(&generated.SessionSetupReq{
+		Header: generated.MessageHeaderType{SessionID: []byte{1, 2, 3, 4, 5, 6, 7, 8}, TimeStamp: 1700000000},
+		EVCCID: []byte("WMIV123"),
+	})
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !bytes.Equal(got, want) {
+		t.Fatalf("EncodeXML = %x, EncodeStruct = %x", got, want)
+	}
+
+	xmlOut, err := c.DecodeEXI(got)
+	if err != nil {
+		t.Fatal(err)
+	}
+	const wantXML = `<SessionSetupReq><Header><SessionID>0102030405060708</SessionID><TimeStamp>1700000000</TimeStamp></Header><EVCCID>574D4956313233</EVCCID></SessionSetupReq>`
+	if string(xmlOut) != wantXML {
+		t.Fatalf("DecodeEXI = %s, want %s", xmlOut, wantXML)
+	}
+}
+
+func TestSchemaXMLGoldenVectorsRoundTrip(t *testing.T) {
+	c := newSchemaCodec(t)
+	for _, name := range []string{"SessionSetupReq", "ServiceDiscoveryReq", "SessionStopReq"} {
+		data, err := os.ReadFile(filepath.Join("..", "..", "testvectors", name+".exi"))
+		if err != nil {
+			t.Fatal(err)
+		}
+		xmlOut, err := c.DecodeEXITo([]byte("prefix"), data)
+		if err != nil {
+			t.Fatalf("%s: DecodeEXITo: %v", name, err)
+		}
+		if !bytes.HasPrefix(xmlOut, []byte("prefix<"+name+">")) {
+			t.Fatalf("%s: DecodeEXITo = %s", name, xmlOut)
+		}
+		enc, err := c.EncodeXML(xmlOut[len("prefix"):])
+		if err != nil {
+			t.Fatalf("%s: EncodeXML(%s): %v", name, xmlOut, err)
+		}
+		if !bytes.Equal(enc, data) {
+			t.Errorf("%s: XML round trip = %x, want %x", name, enc, data)
+		}
+	}
+}
+
+func TestSchemaXMLStructFields(t *testing.T) {
+	c := newSchemaCodec(t)
+	code, expl := "EV<1>", "driver & co"
+	msg := &generated.SessionStopReq{
+		Header:                   generated.MessageHeaderType{SessionID: []byte{0xAB, 0xCD}, TimeStamp: 42},
+		ChargingSession:          "Terminate",
+		EVTerminationCode:        &code,
+		EVTerminationExplanation: &expl,
+	}
+	data, err := exi.EncodeStruct(msg)
+	if err != nil {
+		t.Fatal(err)
+	}
+	xmlOut, err := c.DecodeEXI(data)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !bytes.Contains(xmlOut, []byte("<EVTerminationCode>EV&lt;1&gt;</EVTerminationCode>")) {
+		t.Fatalf("special characters not escaped: %s", xmlOut)
+	}
+	enc, err := c.EncodeXML(xmlOut)
+	if err != nil {
+		t.Fatal(err)
+	}
+	back, err := exi.DecodeStruct(enc, nil)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !reflect.DeepEqual(back, msg) {
+		t.Fatalf("round trip = %+v, want %+v", back, msg)
+	}
+}
+
+func TestSchemaXMLErrors(t *testing.T) {
+	c := newSchemaCodec(t)
+	for _, tc := range []struct {
+		name, xml string
+	}{
+		{"empty", ``},
+		{"unknown root", `<Sample>hello</Sample>`},
+		{"bad hex", `<SessionSetupReq><Header><SessionID>0G</SessionID></Header></SessionSetupReq>`},
+		{"odd hex", `<SessionSetupReq><EVCCID>123</EVCCID></SessionSetupReq>`},
+		{"bad number", `<SessionSetupReq><Header><TimeStamp>soon</TimeStamp></Header></SessionSetupReq>`},
+		{"mismatched end", `<SessionSetupReq><Header></EVCCID></SessionSetupReq>`},
+		{"truncated", `<SessionSetupReq><Header>`},
+		{"two roots", `<SessionStopReq></SessionStopReq><SessionStopReq></SessionStopReq>`},
+	} {
+		if _, err := c.EncodeXML([]byte(tc.xml)); err == nil {
+			t.Errorf("%s: EncodeXML(%q) succeeded", tc.name, tc.xml)
+		}
+	}
+	if _, err := c.EncodeXML([]byte(`<Sample/>`)); !errors.Is(err, exi.ErrUnknownRootElement) {
+		t.Errorf("unknown root: err = %v, want ErrUnknownRootElement", err)
+	}
+	if _, err := c.DecodeEXI([]byte{0x1f, 0x8b}); err == nil {
+		t.Error("DecodeEXI of a gzip stub payload succeeded in schema mode")
+	}
+}
+
+func BenchmarkCodecXML(b *testing.B) {
+	for _, mode := range []struct {
+		name string
+		stub bool
+	}{{"Schema", false}, {"Stub", true}} {
+		c := exi.NewCodec(&exi.Config{UseStub: mode.stub})
+		if err := c.Init(); err != nil {
+			b.Fatal(err)
+		}
+		input := []byte(sessionSetupReqXML)
+		encoded, err := c.EncodeXML(input)
+		if err != nil {
+			b.Fatal(err)
+		}
+		b.Run(mode.name+"/EncodeXML", func(b *testing.B) {
+			b.ReportAllocs()
+			dst := make([]byte, 0, 4096)
+			for i := 0; i < b.N; i++ {
+				if _, err := c.EncodeXMLTo(dst, input); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+		b.Run(mode.name+"/DecodeEXI", func(b *testing.B) {
+			b.ReportAllocs()
+			dst := make([]byte, 0, 4096)
+			for i := 0; i < b.N; i++ {
+				if _, err := c.DecodeEXITo(dst, encoded); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+	}
+}
@@ -0,0 +1,467 @@
+// Code generated by exi-go codegen. DO NOT EDIT.
+//
+// Specialized straight-line EXI codecs compiled from the schema grammar
+// tables; see schema.CodeGenerator.GenerateCodecs.
+
+package exi
+
+import (
+	"fmt"
+
+	"example.com/exi-go/pkg/v2g/generated"
+)
+
+// specEnumChargingsession lists the ChargingSession values in schema order.
+var specEnumChargingsession = [...]string{"Pause", "Terminate", "ServiceRenegotiation"}
+
+func specEnumChargingsessionIndex(s string) (uint32, bool) {
+	switch s {
+	case "Pause":
+		return 0, true
+	case "Terminate":
+		return 1, true
+	case "ServiceRenegotiation":
+		return 2, true
+	}
+	return 0, false
+}
+
+// specBitsSessionSetupReq returns an upper bound on the encoded size of v in bits.
+func specBitsSessionSetupReq(v *generated.SessionSetupReq) int {
+	n := 14
+	n += 8*len(v.Header.SessionID) + UnsignedVarBits(uint64(len(v.Header.SessionID)))
+	n += 88
+	n += 8*len(v.EVCCID) + UnsignedVarBits(uint64(len(v.EVCCID))+2)
+	n += 5
+	return n
+}
+
+// EncodeSpecializedSessionSetupReq writes v, including the EXI header and document event code.
+func EncodeSpecializedSessionSetupReq(bs *BitStream, v *generated.SessionSetupReq) error {
+	if v == nil {
+		return fmt.Errorf("EncodeSpecializedSessionSetupReq: nil value")
+	}
+	if err := bs.Reserve(specBitsSessionSetupReq(v)); err != nil {
+		return err
+	}
+	bs.PutBits(17, 0x10118)
+	bs.PutUnsignedVar(uint64(len(v.Header.SessionID)))
+	bs.PutOctets(v.Header.SessionID)
+	bs.PutBits(3, 0x0)
+	bs.PutUnsignedVar(uint64(v.Header.TimeStamp))
+	bs.PutBits(5, 0x4)
+	bs.PutUnsignedVar(uint64(len(v.EVCCID)) + 2)
+	bs.PutOctets(v.EVCCID)
+	bs.PutBits(2, 0x0)
+	return nil
+}
+
+// DecodeSpecializedSessionSetupReq reads a SessionSetupReq document, including the EXI header.
+func DecodeSpecializedSessionSetupReq(bs *BitStream) (*generated.SessionSetupReq, error) {
+	var c uint32
+	var err error
+	out := &generated.SessionSetupReq{}
+	if c, err = bs.ReadBits(17); err != nil {
+		return nil, err
+	}
+	if c&0x1ffff != 0x10118 {
+		return nil, fmt.Errorf("DecodeSpecializedSessionSetupReq: %w", ErrGrammarMismatch)
+	}
+	n2, err := bs.ReadUnsignedVar()
+	if err != nil {
+		return nil, err
+	}
+	b3, err := bs.ReadOctetSlice(int(n2))
+	if err != nil {
+		return nil, err
+	}
+	out.Header.SessionID = b3
+	if c, err = bs.ReadBits(3); err != nil {
+		return nil, err
+	}
+	if c&0x7 != 0x0 {
+		return nil, fmt.Errorf("DecodeSpecializedSessionSetupReq: %w", ErrGrammarMismatch)
+	}
+	u4, err := bs.ReadUnsignedVar()
+	if err != nil {
+		return nil, err
+	}
+	out.Header.TimeStamp = u4
+	if c, err = bs.ReadBits(1); err != nil {
+		return nil, err
+	}
+	if c&0x1 != 0x0 {
+		return nil, fmt.Errorf("DecodeSpecializedSessionSetupReq: %w", ErrGrammarMismatch)
+	}
+	st5 := uint32(5)
+run6:
+	for {
+		switch st5 {
+		case 5:
+			c, err = bs.ReadBits(2)
+		default:
+			c, err = bs.ReadBits(1)
+		}
+		if err != nil {
+			return nil, err
+		}
+		switch st5<<8 | c {
+		case 5<<8 | 0:
+			return nil, fmt.Errorf("DecodeSpecializedSessionSetupReq: element Signature is not supported by MessageHeaderType")
+		case 5<<8 | 1, 6<<8 | 0:
+			break run6
+		default:
+			return nil, fmt.Errorf("DecodeSpecializedSessionSetupReq: %w", ErrGrammarMismatch)
+		}
+	}
+	if c, err = bs.ReadBits(2); err != nil {
+		return nil, err
+	}
+	if c&0x3 != 0x0 {
+		return nil, fmt.Errorf("DecodeSpecializedSessionSetupReq: %w", ErrGrammarMismatch)
+	}
+	n7, err := bs.ReadUnsignedVar()
+	if err != nil {
+		return nil, err
+	}
+	if n7 < 2 {
+		return nil, fmt.Errorf("DecodeSpecializedSessionSetupReq: %w", ErrGrammarMismatch)
+	}
+	n7 -= 2
+	b8, err := bs.ReadOctetSlice(int(n7))
+	if err != nil {
+		return nil, err
+	}
+	out.EVCCID = b8
+	if c, err = bs.ReadBits(2); err != nil {
+		return nil, err
+	}
+	if c&0x3 != 0x0 {
+		return nil, fmt.Errorf("DecodeSpecializedSessionSetupReq: %w", ErrGrammarMismatch)
+	}
+	return out, nil
+}
+
+// specBitsServiceDiscoveryReq returns an upper bound on the encoded size of v in bits.
+func specBitsServiceDiscoveryReq(v *generated.ServiceDiscoveryReq) int {
+	n := 14
+	n += 8*len(v.Header.SessionID) + UnsignedVarBits(uint64(len(v.Header.SessionID)))
+	n += 88
+	n += 3
+	return n
+}
+
+// EncodeSpecializedServiceDiscoveryReq writes v, including the EXI header and document event code.
+func EncodeSpecializedServiceDiscoveryReq(bs *BitStream, v *generated.ServiceDiscoveryReq) error {
+	if v == nil {
+		return fmt.Errorf("EncodeSpecializedServiceDiscoveryReq: nil value")
+	}
+	if err := bs.Reserve(specBitsServiceDiscoveryReq(v)); err != nil {
+		return err
+	}
+	bs.PutBits(17, 0x100f8)
+	bs.PutUnsignedVar(uint64(len(v.Header.SessionID)))
+	bs.PutOctets(v.Header.SessionID)
+	bs.PutBits(3, 0x0)
+	bs.PutUnsignedVar(uint64(v.Header.TimeStamp))
+	bs.PutBits(5, 0x5)
+	return nil
+}
+
+// DecodeSpecializedServiceDiscoveryReq reads a ServiceDiscoveryReq document, including the EXI header.
+func DecodeSpecializedServiceDiscoveryReq(bs *BitStream) (*generated.ServiceDiscoveryReq, error) {
+	var c uint32
+	var err error
+	out := &generated.ServiceDiscoveryReq{}
+	if c, err = bs.ReadBits(17); err != nil {
+		return nil, err
+	}
+	if c&0x1ffff != 0x100f8 {
+		return nil, fmt.Errorf("DecodeSpecializedServiceDiscoveryReq: %w", ErrGrammarMismatch)
+	}
+	n10, err := bs.ReadUnsignedVar()
+	if err != nil {
+		return nil, err
+	}
+	b11, err := bs.ReadOctetSlice(int(n10))
+	if err != nil {
+		return nil, err
+	}
+	out.Header.SessionID = b11
+	if c, err = bs.ReadBits(3); err != nil {
+		return nil, err
+	}
+	if c&0x7 != 0x0 {
+		return nil, fmt.Errorf("DecodeSpecializedServiceDiscoveryReq: %w", ErrGrammarMismatch)
+	}
+	u12, err := bs.ReadUnsignedVar()
+	if err != nil {
+		return nil, err
+	}
+	out.Header.TimeStamp = u12
+	if c, err = bs.ReadBits(1); err != nil {
+		return nil, err
+	}
+	if c&0x1 != 0x0 {
+		return nil, fmt.Errorf("DecodeSpecializedServiceDiscoveryReq: %w", ErrGrammarMismatch)
+	}
+	st13 := uint32(5)
+run14:
+	for {
+		switch st13 {
+		case 5:
+			c, err = bs.ReadBits(2)
+		default:
+			c, err = bs.ReadBits(1)
+		}
+		if err != nil {
+			return nil, err
+		}
+		switch st13<<8 | c {
+		case 5<<8 | 0:
+			return nil, fmt.Errorf("DecodeSpecializedServiceDiscoveryReq: element Signature is not supported by MessageHeaderType")
+		case 5<<8 | 1, 6<<8 | 0:
+			break run14
+		default:
+			return nil, fmt.Errorf("DecodeSpecializedServiceDiscoveryReq: %w", ErrGrammarMismatch)
+		}
+	}
+	st15 := uint32(10)
+run16:
+	for {
+		switch st15 {
+		case 10:
+			c, err = bs.ReadBits(2)
+		default:
+			c, err = bs.ReadBits(1)
+		}
+		if err != nil {
+			return nil, err
+		}
+		switch st15<<8 | c {
+		case 10<<8 | 0:
+			return nil, fmt.Errorf("DecodeSpecializedServiceDiscoveryReq: element SupportedServiceIDs is not supported by ServiceDiscoveryReq")
+		case 10<<8 | 1, 11<<8 | 0:
+			break run16
+		default:
+			return nil, fmt.Errorf("DecodeSpecializedServiceDiscoveryReq: %w", ErrGrammarMismatch)
+		}
+	}
+	return out, nil
+}
+
+// specBitsSessionStopReq returns an upper bound on the encoded size of v in bits.
+func specBitsSessionStopReq(v *generated.SessionStopReq) int {
+	n := 14
+	n += 8*len(v.Header.SessionID) + UnsignedVarBits(uint64(len(v.Header.SessionID)))
+	n += 88
+	if v.EVTerminationCode != nil {
+		n += 8*len(*v.EVTerminationCode) + UnsignedVarBits(uint64(len(*v.EVTerminationCode))+2)
+		n += 4
+	}
+	if v.EVTerminationExplanation != nil {
+		n += 8*len(*v.EVTerminationExplanation) + UnsignedVarBits(uint64(len(*v.EVTerminationExplanation))+2)
+		n += 4
+	}
+	n += 8
+	return n
+}
+
+// EncodeSpecializedSessionStopReq writes v, including the EXI header and document event code.
+func EncodeSpecializedSessionStopReq(bs *BitStream, v *generated.SessionStopReq) error {
+	if v == nil {
+		return fmt.Errorf("EncodeSpecializedSessionStopReq: nil value")
+	}
+	if err := bs.Reserve(specBitsSessionStopReq(v)); err != nil {
+		return err
+	}
+	bs.PutBits(17, 0x10128)
+	bs.PutUnsignedVar(uint64(len(v.Header.SessionID)))
+	bs.PutOctets(v.Header.SessionID)
+	bs.PutBits(3, 0x0)
+	bs.PutUnsignedVar(uint64(v.Header.TimeStamp))
+	e17, ok18 := specEnumChargingsessionIndex(string(v.ChargingSession))
+	if !ok18 {
+		return fmt.Errorf("EncodeSpecializedSessionStopReq: %q is not a valid ChargingSession", v.ChargingSession)
+	}
+	bs.PutBits(8, 0x20|e17<<1)
+	st19 := 17
+	_ = st19
+	if v.EVTerminationCode != nil {
+		bs.PutBits(3, 0x0)
+		bs.PutUnsignedVar(uint64(len(*v.EVTerminationCode)) + 2)
+		bs.PutOctets([]byte(*v.EVTerminationCode))
+		bs.PutBits(1, 0x0)
+		st19 = 18
+	}
+	if v.EVTerminationExplanation != nil {
+		switch st19 {
+		case 17:
+			bs.PutBits(2, 1)
+		default:
+			bs.PutBits(2, 0)
+		}
+		bs.PutBits(1, 0x0)
+		bs.PutUnsignedVar(uint64(len(*v.EVTerminationExplanation)) + 2)
+		bs.PutOctets([]byte(*v.EVTerminationExplanation))
+		bs.PutBits(1, 0x0)
+		st19 = 19
+	}
+	switch st19 {
+	case 17:
+		bs.PutBits(2, 2)
+	case 18:
+		bs.PutBits(2, 1)
+	default:
+		bs.PutBits(1, 0)
+	}
+	return nil
+}
+
+// DecodeSpecializedSessionStopReq reads a SessionStopReq document, including the EXI header.
+func DecodeSpecializedSessionStopReq(bs *BitStream) (*generated.SessionStopReq, error) {
+	var c uint32
+	var err error
+	out := &generated.SessionStopReq{}
+	if c, err = bs.ReadBits(17); err != nil {
+		return nil, err
+	}
+	if c&0x1ffff != 0x10128 {
+		return nil, fmt.Errorf("DecodeSpecializedSessionStopReq: %w", ErrGrammarMismatch)
+	}
+	n21, err := bs.ReadUnsignedVar()
+	if err != nil {
+		return nil, err
+	}
+	b22, err := bs.ReadOctetSlice(int(n21))
+	if err != nil {
+		return nil, err
+	}
+	out.Header.SessionID = b22
+	if c, err = bs.ReadBits(3); err != nil {
+		return nil, err
+	}
+	if c&0x7 != 0x0 {
+		return nil, fmt.Errorf("DecodeSpecializedSessionStopReq: %w", ErrGrammarMismatch)
+	}
+	u23, err := bs.ReadUnsignedVar()
+	if err != nil {
+		return nil, err
+	}
+	out.Header.TimeStamp = u23
+	if c, err = bs.ReadBits(1); err != nil {
+		return nil, err
+	}
+	if c&0x1 != 0x0 {
+		return nil, fmt.Errorf("DecodeSpecializedSessionStopReq: %w", ErrGrammarMismatch)
+	}
+	st24 := uint32(5)
+run25:
+	for {
+		switch st24 {
+		case 5:
+			c, err = bs.ReadBits(2)
+		default:
+			c, err = bs.ReadBits(1)
+		}
+		if err != nil {
+			return nil, err
+		}
+		switch st24<<8 | c {
+		case 5<<8 | 0:
+			return nil, fmt.Errorf("DecodeSpecializedSessionStopReq: element Signature is not supported by MessageHeaderType")
+		case 5<<8 | 1, 6<<8 | 0:
+			break run25
+		default:
+			return nil, fmt.Errorf("DecodeSpecializedSessionStopReq: %w", ErrGrammarMismatch)
+		}
+	}
+	var e26 uint32
+	if c, err = bs.ReadBits(5); err != nil {
+		return nil, err
+	}
+	if c&0x19 != 0x0 {
+		return nil, fmt.Errorf("DecodeSpecializedSessionStopReq: %w", ErrGrammarMismatch)
+	}
+	e26 = (c >> 1) & 0x3
+	if e26 >= 3 {
+		return nil, fmt.Errorf("DecodeSpecializedSessionStopReq: %w", ErrGrammarMismatch)
+	}
+	out.ChargingSession = specEnumChargingsession[e26]
+	st27 := uint32(17)
+run28:
+	for {
+		switch st27 {
+		case 17, 18:
+			c, err = bs.ReadBits(2)
+		default:
+			c, err = bs.ReadBits(1)
+		}
+		if err != nil {
+			return nil, err
+		}
+		switch st27<<8 | c {
+		case 17<<8 | 0:
+			if c, err = bs.ReadBits(1); err != nil {
+				return nil, err
+			}
+			if c&0x1 != 0x0 {
+				return nil, fmt.Errorf("DecodeSpecializedSessionStopReq: %w", ErrGrammarMismatch)
+			}
+			n29, err := bs.ReadUnsignedVar()
+			if err != nil {
+				return nil, err
+			}
+			if n29 < 2 {
+				return nil, fmt.Errorf("DecodeSpecializedSessionStopReq: %w", ErrGrammarMismatch)
+			}
+			n29 -= 2
+			b30, err := bs.ReadOctetSlice(int(n29))
+			if err != nil {
+				return nil, err
+			}
+			t31 := string(b30)
+			out.EVTerminationCode = &t31
+			if c, err = bs.ReadBits(1); err != nil {
+				return nil, err
+			}
+			if c&0x1 != 0x0 {
+				return nil, fmt.Errorf("DecodeSpecializedSessionStopReq: %w", ErrGrammarMismatch)
+			}
+			st27 = 18
+		case 17<<8 | 1, 18<<8 | 0:
+			if c, err = bs.ReadBits(1); err != nil {
+				return nil, err
+			}
+			if c&0x1 != 0x0 {
+				return nil, fmt.Errorf("DecodeSpecializedSessionStopReq: %w", ErrGrammarMismatch)
+			}
+			n32, err := bs.ReadUnsignedVar()
+			if err != nil {
+				return nil, err
+			}
+			if n32 < 2 {
+				return nil, fmt.Errorf("DecodeSpecializedSessionStopReq: %w", ErrGrammarMismatch)
+			}
+			n32 -= 2
+			b33, err := bs.ReadOctetSlice(int(n32))
+			if err != nil {
+				return nil, err
+			}
+			t34 := string(b33)
+			out.EVTerminationExplanation = &t34
+			if c, err = bs.ReadBits(1); err != nil {
+				return nil, err
+			}
+			if c&0x1 != 0x0 {
+				return nil, fmt.Errorf("DecodeSpecializedSessionStopReq: %w", ErrGrammarMismatch)
+			}
+			st27 = 19
+		case 17<<8 | 2, 18<<8 | 1, 19<<8 | 0:
+			break run28
+		default:
+			return nil, fmt.Errorf("DecodeSpecializedSessionStopReq: %w", ErrGrammarMismatch)
+		}
+	}
+	return out, nil
+}
@@ -0,0 +1,286 @@
+package schema
+
+import (
+	"crypto/sha256"
+	"encoding/binary"
+	"errors"
+	"fmt"
+	"io"
+	"os"
+	"path/filepath"
+	"sort"
+	"sync"
+
+	"example.com/exi-go/internal/mmap"
+	"example.com/exi-go/pkg/exi"
+)
+
+// GrammarSourceHash returns the hash that identifies a grammar built from
+// paths (files or directories, as for LoadSchemas) with opts, and the XSD
+// files it covers. The hash covers the name and content of every file and
+// the options, so any edit to the schemas or a different build invalidates
+// a cache carrying the old hash. Hashing reads the files but does not parse
+// them.
+func GrammarSourceHash(paths []string, opts GrammarOptions) ([32]byte, []string, error) {
+	files, err := ValidateSchemaPaths(paths)
+	if err != nil {
+		return [32]byte{}, nil, err
+	}
+	hash, _, err := sourceHash(files, opts, nil)
+	return hash, files, err
+}
+
+// sourceHash is GrammarSourceHash over files, and also returns their
+// stamps. A file found in known with its size and modification time
+// unchanged is not read: the content hash of its stamp is used.
+func sourceHash(files []string, opts GrammarOptions, known map[string]exi.SourceStamp) ([32]byte, []exi.SourceStamp, error) {
+	h := sha256.New()
+	var n [8]byte
+	writeString := func(s string) {
+		binary.LittleEndian.PutUint64(n[:], uint64(len(s)))
+		h.Write(n[:])
+		h.Write([]byte(s))
+	}
+	stamps := make([]exi.SourceStamp, len(files))
+	for i, f := range files {
+		st, err := stampSource(f, known)
+		if err != nil {
+			return [32]byte{}, nil, err
+		}
+		stamps[i] = st
+		writeString(filepath.Base(f))
+		h.Write(st.Hash[:])
+	}
+	for _, r := range opts.Roots {
+		writeString("root:" + r)
+	}
+	codes := make([]string, 0, len(opts.RootCodes))
+	for name := range opts.RootCodes {
+		codes = append(codes, name)
+	}
+	sort.Strings(codes)
+	for _, name := range codes {
+		writeString(fmt.Sprintf("code:%s=%d", name, opts.RootCodes[name]))
+	}
+	writeString(fmt.Sprintf("bits:%d", opts.RootBits))
+
+	var sum [32]byte
+	h.Sum(sum[:0])
+	return sum, stamps, nil
+}
+
+// stampSource returns the stamp of the schema file at path, hashing its
+// content unless known has a stamp of the same size and modification time.
+// Like make, this trusts a file rewritten within the resolution of its
+// file system's timestamps to have changed size.
+func stampSource(path string, known map[string]exi.SourceStamp) (exi.SourceStamp, error) {
+	f, err := os.Open(path)
+	if err != nil {
+		return exi.SourceStamp{}, fmt.Errorf("read %s: %w", path, err)
+	}
+	defer f.Close()
+	// The stamp is taken before the content is read, so an edit in between
+	// leaves a stamp older than the file and is hashed again next time.
+	fi, err := f.Stat()
+	if err != nil {
+		return exi.SourceStamp{}, fmt.Errorf("read %s: %w", path, err)
+	}
+	st := exi.SourceStamp{Size: fi.Size(), ModTime: fi.ModTime().UnixNano()}
+	if k, ok := known[path]; ok && k.Size == st.Size && k.ModTime == st.ModTime {
+		st.Hash = k.Hash
+		return st, nil
+	}
+	h := sha256.New()
+	if _, err := io.Copy(h, f); err != nil {
+		return exi.SourceStamp{}, fmt.Errorf("read %s: %w", path, err)
+	}
+	h.Sum(st.Hash[:0])
+	return st, nil
+}
+
+// CompileGrammar loads and parses the XSDs at paths and builds their grammar
+// table, stamped with GrammarSourceHash so it can be written as a cache.
+func CompileGrammar(paths []string, opts GrammarOptions) (*exi.GrammarCache, error) {
+	files, err := ValidateSchemaPaths(paths)
+	if err != nil {
+		return nil, err
+	}
+	hash, stamps, err := sourceHash(files, opts, nil)
+	if err != nil {
+		return nil, err
+	}
+	schemas, err := LoadSchemas(files)
+	if err != nil {
+		return nil, err
+	}
+	defs, err := ParseSchemas(schemas)
+	if err != nil {
+		return nil, err
+	}
+	table, err := BuildGrammarTable(defs, opts)
+	if err != nil {
+		return nil, err
+	}
+	return &exi.GrammarCache{SourceHash: hash, Sources: files, SourceStamps: stamps, Table: table}, nil
+}
+
+// WriteGrammarCache writes c to path. The file is written next to path and
+// renamed into place, so a process loading path concurrently sees either
+// the old cache or the new one.
+func WriteGrammarCache(path string, c *exi.GrammarCache) error {
+	data, err := c.MarshalBinary()
+	if err != nil {
+		return err
+	}
+	tmp, err := os.CreateTemp(filepath.Dir(path), filepath.Base(path)+".*")
+	if err != nil {
+		return err
+	}
+	if err := tmp.Chmod(0o644); err != nil {
+		tmp.Close()
+		os.Remove(tmp.Name())
+		return err
+	}
+	if _, err := tmp.Write(data); err != nil {
+		tmp.Close()
+		os.Remove(tmp.Name())
+		return err
+	}
+	if err := tmp.Close(); err != nil {
+		os.Remove(tmp.Name())
+		return err
+	}
+	if err := os.Rename(tmp.Name(), path); err != nil {
+		os.Remove(tmp.Name())
+		return err
+	}
+	return nil
+}
+
+// ReadGrammarCache reads the cache at path without consulting its sources.
+//
+// The file is memory-mapped where the system supports it, and the names and
+// values of the table point into the mapping (see UnmarshalBinaryAlias), so
+// loading decodes the fixed-size records and copies nothing else. Since
+// tables loaded from a mapping may be in use anywhere, it is never unmapped;
+// each version of the file, told apart by identity, size and modification
+// time, is mapped once per process. WriteGrammarCache replaces the file
+// rather than writing into it, so a mapped version never changes; a cache
+// file must not be rewritten in place while a process may have it mapped.
+func ReadGrammarCache(path string) (*exi.GrammarCache, error) {
+	data, err := mapGrammarCache(path)
+	if err != nil {
+		return nil, err
+	}
+	c := &exi.GrammarCache{}
+	if err := c.UnmarshalBinaryAlias(data); err != nil {
+		return nil, fmt.Errorf("%s: %w", path, err)
+	}
+	return c, nil
+}
+
+// grammarCacheMaps holds the current mapping of each cache file read.
+var grammarCacheMaps struct {
+	sync.Mutex
+	m map[string]mappedCache
+}
+
+type mappedCache struct {
+	fi   os.FileInfo
+	data []byte
+}
+
+// mapGrammarCache returns the mapping of the cache file at path, reusing
+// the one made for the same version of the file.
+func mapGrammarCache(path string) ([]byte, error) {
+	f, err := os.Open(path)
+	if err != nil {
+		return nil, err
+	}
+	defer f.Close()
+	fi, err := f.Stat()
+	if err != nil {
+		return nil, err
+	}
+	maps := &grammarCacheMaps
+	maps.Lock()
+	defer maps.Unlock()
+	if mc, ok := maps.m[path]; ok && os.SameFile(mc.fi, fi) &&
+		mc.fi.Size() == fi.Size() && mc.fi.ModTime().Equal(fi.ModTime()) {
+		return mc.data, nil
+	}
+	data, _, err := mmap.Map(f)
+	if err != nil {
+		return nil, err
+	}
+	if maps.m == nil {
+		maps.m = map[string]mappedCache{}
+	}
+	maps.m[path] = mappedCache{fi: fi, data: data}
+	return data, nil
+}
+
+// LoadGrammar returns the grammar of the XSDs at paths, from the cache at
+// cachePath when it is current and by parsing the XSDs otherwise. The
+// boolean reports whether the cache was used.
+//
+// With no paths, the sources recorded in the cache are checked instead. A
+// cache whose recorded sources are missing (e.g. a deployment that ships
+// only the cache) is used as is; one whose sources changed is rebuilt from
+// them. An unreadable or invalid cache falls back the same way, so the
+// cache only ever saves time and never changes the result. The cache file
+// is not rewritten; use WriteGrammarCache or `v2gcodec generate`.
+func LoadGrammar(cachePath string, paths []string, opts GrammarOptions) (*exi.GrammarCache, bool, error) {
+	var cacheErr error
+	if cachePath != "" {
+		c, err := ReadGrammarCache(cachePath)
+		if err == nil {
+			sources := paths
+			if len(sources) == 0 {
+				sources = c.Sources
+			}
+			hash, herr := cachedSourceHash(c, sources, opts)
+			switch {
+			case herr == nil && hash == c.SourceHash:
+				return c, true, nil
+			case herr != nil && len(paths) == 0 && errors.Is(herr, os.ErrNotExist):
+				return c, true, nil
+			case herr == nil:
+				cacheErr = fmt.Errorf("%s: stale: schema sources changed", cachePath)
+			default:
+				cacheErr = herr
+			}
+			if len(paths) == 0 {
+				paths = c.Sources
+			}
+		} else {
+			cacheErr = err
+		}
+	}
+	if len(paths) == 0 {
+		if cacheErr == nil {
+			cacheErr = errors.New("no schema paths provided")
+		}
+		return nil, false, fmt.Errorf("load grammar: %w", cacheErr)
+	}
+	c, err := CompileGrammar(paths, opts)
+	if err != nil {
+		return nil, false, err
+	}
+	return c, false, nil
+}
+
+// cachedSourceHash is GrammarSourceHash of paths, hashing only the files
+// whose size or modification time differ from their stamps in c.
+func cachedSourceHash(c *exi.GrammarCache, paths []string, opts GrammarOptions) ([32]byte, error) {
+	files, err := ValidateSchemaPaths(paths)
+	if err != nil {
+		return [32]byte{}, err
+	}
+	known := make(map[string]exi.SourceStamp, len(c.SourceStamps))
+	for i, st := range c.SourceStamps {
+		known[c.Sources[i]] = st
+	}
+	hash, _, err := sourceHash(files, opts, known)
+	return hash, err
+}
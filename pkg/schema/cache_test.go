@@ -0,0 +1,276 @@
+package schema
+
+import (
+	"errors"
+	"os"
+	"path/filepath"
+	"reflect"
+	"strings"
+	"testing"
+	"time"
+
+	"example.com/exi-go/pkg/exi"
+)
+
+var subsetOptions = GrammarOptions{RootCodes: subsetRootCodes, RootBits: 6}
+
+// copySubset copies the subset schema into a temporary directory, so tests
+// can edit or remove it.
+func copySubset(t testing.TB) string {
+	t.Helper()
+	data, err := os.ReadFile(filepath.Join("testdata", "v2g_subset.xsd"))
+	if err != nil {
+		t.Fatal(err)
+	}
+	path := filepath.Join(t.TempDir(), "v2g_subset.xsd")
+	if err := os.WriteFile(path, data, 0o644); err != nil {
+		t.Fatal(err)
+	}
+	return path
+}
+
+func TestGrammarCacheRoundTrip(t *testing.T) {
+	c, err := CompileGrammar([]string{filepath.Join("testdata", "v2g_subset.xsd")}, subsetOptions)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !reflect.DeepEqual(c.Table, loadSubsetTable(t)) {
+		t.Fatal("CompileGrammar table differs from BuildGrammarTable")
+	}
+	data, err := c.MarshalBinary()
+	if err != nil {
+		t.Fatal(err)
+	}
+	var got exi.GrammarCache
+	if err := got.UnmarshalBinary(data); err != nil {
+		t.Fatal(err)
+	}
+	if !reflect.DeepEqual(&got, c) {
+		t.Errorf("round trip differs:\n got %+v\nwant %+v", got.Table, c.Table)
+	}
+}
+
+func TestGrammarCacheInvalid(t *testing.T) {
+	c, err := CompileGrammar([]string{filepath.Join("testdata", "v2g_subset.xsd")}, subsetOptions)
+	if err != nil {
+		t.Fatal(err)
+	}
+	data, err := c.MarshalBinary()
+	if err != nil {
+		t.Fatal(err)
+	}
+	flip := func(off int) []byte {
+		d := append([]byte(nil), data...)
+		d[off] ^= 0x40
+		return d
+	}
+	cases := map[string][]byte{
+		"empty":     nil,
+		"truncated": data[:len(data)-1],
+		"header":    data[:40],
+		"magic":     flip(0),
+		"version":   flip(8),
+		"count":     flip(48),
+		"body":      flip(len(data) - 1),
+	}
+	for name, d := range cases {
+		var got exi.GrammarCache
+		if err := got.UnmarshalBinary(d); !errors.Is(err, exi.ErrGrammarCache) {
+			t.Errorf("%s: err = %v, want ErrGrammarCache", name, err)
+		}
+	}
+}
+
+func TestLoadGrammar(t *testing.T) {
+	xsd := copySubset(t)
+	cachePath := filepath.Join(t.TempDir(), "v2g.grammar")
+	paths := []string{xsd}
+
+	// No cache yet: compiled from the sources.
+	c, fromCache, err := LoadGrammar(cachePath, paths, subsetOptions)
+	if err != nil || fromCache {
+		t.Fatalf("missing cache: fromCache %v, err %v", fromCache, err)
+	}
+	if err := WriteGrammarCache(cachePath, c); err != nil {
+		t.Fatal(err)
+	}
+	for _, p := range [][]string{paths, nil} {
+		got, fromCache, err := LoadGrammar(cachePath, p, subsetOptions)
+		if err != nil || !fromCache {
+			t.Fatalf("paths %v: fromCache %v, err %v", p, fromCache, err)
+		}
+		if !reflect.DeepEqual(got.Table, c.Table) {
+			t.Errorf("paths %v: cached table differs", p)
+		}
+	}
+
+	// Other options do not match the cache.
+	if _, fromCache, err := LoadGrammar(cachePath, paths, GrammarOptions{}); err != nil || fromCache {
+		t.Errorf("other options: fromCache %v, err %v", fromCache, err)
+	}
+
+	// An edit to the schema makes the cache stale.
+	data, err := os.ReadFile(xsd)
+	if err != nil {
+		t.Fatal(err)
+	}
+	edited := strings.Replace(string(data), "</xs:schema>", "<!-- edited -->\n</xs:schema>", 1)
+	if err := os.WriteFile(xsd, []byte(edited), 0o644); err != nil {
+		t.Fatal(err)
+	}
+	for _, p := range [][]string{paths, nil} {
+		if _, fromCache, err := LoadGrammar(cachePath, p, subsetOptions); err != nil || fromCache {
+			t.Errorf("edited, paths %v: fromCache %v, err %v", p, fromCache, err)
+		}
+	}
+
+	// A cache deployed without its sources is trusted, unless paths are
+	// given explicitly.
+	if err := os.Remove(xsd); err != nil {
+		t.Fatal(err)
+	}
+	if _, fromCache, err := LoadGrammar(cachePath, nil, subsetOptions); err != nil || !fromCache {
+		t.Errorf("sources removed: fromCache %v, err %v", fromCache, err)
+	}
+	if _, _, err := LoadGrammar(cachePath, paths, subsetOptions); err == nil {
+		t.Error("sources removed, explicit paths: LoadGrammar succeeded")
+	}
+
+	// A corrupt cache falls back to the sources.
+	if err := os.WriteFile(xsd, data, 0o644); err != nil {
+		t.Fatal(err)
+	}
+	if err := os.WriteFile(cachePath, []byte("EXIGRAMC garbage"), 0o644); err != nil {
+		t.Fatal(err)
+	}
+	if _, fromCache, err := LoadGrammar(cachePath, paths, subsetOptions); err != nil || fromCache {
+		t.Errorf("corrupt cache: fromCache %v, err %v", fromCache, err)
+	}
+	if _, _, err := LoadGrammar(cachePath, nil, subsetOptions); !errors.Is(err, exi.ErrGrammarCache) {
+		t.Errorf("corrupt cache, no paths: err = %v, want ErrGrammarCache", err)
+	}
+}
+
+// TestLoadGrammarStamps checks that a source whose size and modification
+// time match its stamp is not hashed again, and that one whose time moved is.
+func TestLoadGrammarStamps(t *testing.T) {
+	xsd := copySubset(t)
+	cachePath := filepath.Join(t.TempDir(), "v2g.grammar")
+	c, err := CompileGrammar([]string{xsd}, subsetOptions)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if err := WriteGrammarCache(cachePath, c); err != nil {
+		t.Fatal(err)
+	}
+	fi, err := os.Stat(xsd)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if st := c.SourceStamps[0]; st.Size != fi.Size() || st.ModTime != fi.ModTime().UnixNano() {
+		t.Fatalf("stamp %+v, file size %d time %v", st, fi.Size(), fi.ModTime())
+	}
+
+	// An edit of the same size that keeps the time goes unnoticed, which
+	// shows the content was not read.
+	data, err := os.ReadFile(xsd)
+	if err != nil {
+		t.Fatal(err)
+	}
+	edited := strings.Replace(string(data), "xs:schema", "xs:SCHEMA", 1)
+	if err := os.WriteFile(xsd, []byte(edited), 0o644); err != nil {
+		t.Fatal(err)
+	}
+	if err := os.Chtimes(xsd, fi.ModTime(), fi.ModTime()); err != nil {
+		t.Fatal(err)
+	}
+	if _, fromCache, err := LoadGrammar(cachePath, nil, subsetOptions); err != nil || !fromCache {
+		t.Errorf("same stamp: fromCache %v, err %v", fromCache, err)
+	}
+	// A new time makes the file hashed, and the edit found.
+	later := fi.ModTime().Add(time.Second)
+	if err := os.Chtimes(xsd, later, later); err != nil {
+		t.Fatal(err)
+	}
+	if _, fromCache, _ := LoadGrammar(cachePath, nil, subsetOptions); fromCache {
+		t.Error("newer source: cache used")
+	}
+	// Touching a file without changing it keeps the cache current.
+	if err := os.WriteFile(xsd, data, 0o644); err != nil {
+		t.Fatal(err)
+	}
+	if _, fromCache, err := LoadGrammar(cachePath, nil, subsetOptions); err != nil || !fromCache {
+		t.Errorf("touched source: fromCache %v, err %v", fromCache, err)
+	}
+}
+
+// TestReadGrammarCacheMapped checks that a replaced cache file is mapped
+// again while tables loaded from the old version stay intact.
+func TestReadGrammarCacheMapped(t *testing.T) {
+	c, err := CompileGrammar([]string{filepath.Join("testdata", "v2g_subset.xsd")}, subsetOptions)
+	if err != nil {
+		t.Fatal(err)
+	}
+	cachePath := filepath.Join(t.TempDir(), "v2g.grammar")
+	if err := WriteGrammarCache(cachePath, c); err != nil {
+		t.Fatal(err)
+	}
+	first, err := ReadGrammarCache(cachePath)
+	if err != nil {
+		t.Fatal(err)
+	}
+	again, err := ReadGrammarCache(cachePath)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !reflect.DeepEqual(first, c) || !reflect.DeepEqual(again, c) {
+		t.Fatal("cache read back differs")
+	}
+
+	other := *c
+	other.Sources = []string{"renamed.xsd"}
+	if err := WriteGrammarCache(cachePath, &other); err != nil {
+		t.Fatal(err)
+	}
+	got, err := ReadGrammarCache(cachePath)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !reflect.DeepEqual(got.Sources, other.Sources) {
+		t.Errorf("replaced cache: Sources %v, want %v", got.Sources, other.Sources)
+	}
+	if !reflect.DeepEqual(first, c) {
+		t.Error("a table of the replaced file changed")
+	}
+}
+
+// BenchmarkLoadGrammar compares loading the subset grammar from a current
+// cache (which stats the XSD rather than hashing it) with compiling it from
+// the XSD.
+func BenchmarkLoadGrammar(b *testing.B) {
+	xsd := copySubset(b)
+	cachePath := filepath.Join(b.TempDir(), "v2g.grammar")
+	c, err := CompileGrammar([]string{xsd}, subsetOptions)
+	if err != nil {
+		b.Fatal(err)
+	}
+	if err := WriteGrammarCache(cachePath, c); err != nil {
+		b.Fatal(err)
+	}
+	b.Run("Cache", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			if _, fromCache, err := LoadGrammar(cachePath, []string{xsd}, subsetOptions); err != nil || !fromCache {
+				b.Fatal(fromCache, err)
+			}
+		}
+	})
+	b.Run("Compile", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			if _, err := CompileGrammar([]string{xsd}, subsetOptions); err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
+}
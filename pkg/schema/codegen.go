@@ -21,6 +21,19 @@ type CodeGenerator struct {
 	PackageName string
 	// Author optionally included in header comment
 	Author string
+
+	// EmitCodecs makes GenerateFromSchemas also write zz_generated_codecs.go
+	// with specialized encoders/decoders for CodecTypes (see GenerateCodecs).
+	EmitCodecs bool
+	// CodecTypes are prototypes of the Go structs the codecs read and write,
+	// e.g. &generated.SessionSetupReq{}. Each type must be named after a
+	// global element; nested types are reached through its fields.
+	CodecTypes []interface{}
+	// CodecPackage is the package clause of the codecs file (default
+	// PackageName).
+	CodecPackage string
+	// Grammar configures the grammar tables the codecs are compiled from.
+	Grammar GrammarOptions
 }
 
 // Ensure CodeGenerator implements Generator
@@ -97,6 +110,9 @@ func (g *CodeGenerator) GenerateFromSchemas(schemas []*Schema, outDir string) er
 	if err := os.WriteFile(target, src, 0o644); err != nil {
 		return fmt.Errorf("write generated file: %w", err)
 	}
+	if g.EmitCodecs {
+		return g.WriteCodecs(types, outDir)
+	}
 	return nil
 }
 
@@ -0,0 +1,1083 @@
+package schema
+
+import (
+	"bytes"
+	"fmt"
+	"go/format"
+	"os"
+	"path/filepath"
+	"reflect"
+	"sort"
+	"strings"
+
+	"example.com/exi-go/pkg/exi"
+)
+
+// exiImportPath is the import path of the EXI runtime used by generated
+// codecs.
+const exiImportPath = "example.com/exi-go/pkg/exi"
+
+// WriteCodecs compiles the grammar of every CodecTypes root and writes the
+// specialized codecs to zz_generated_codecs.go in outDir.
+func (g *CodeGenerator) WriteCodecs(defs []*TypeDefinition, outDir string) error {
+	src, err := g.GenerateCodecs(defs)
+	if err != nil {
+		return err
+	}
+	if err := os.MkdirAll(outDir, 0o755); err != nil {
+		return fmt.Errorf("create outdir: %w", err)
+	}
+	if err := os.WriteFile(filepath.Join(outDir, "zz_generated_codecs.go"), src, 0o644); err != nil {
+		return fmt.Errorf("write generated codecs: %w", err)
+	}
+	return nil
+}
+
+// GenerateCodecs returns the source of the specialized codecs: for every
+// root R in CodecTypes, EncodeSpecializedR and DecodeSpecializedR. They are
+// straight-line code compiled from the same grammar tables the exi
+// GrammarTable interprets:
+//   - nested types are inlined, so a message is one function
+//   - consecutive fixed-width items (event codes, CHARACTERS/END bits,
+//     enumeration and boolean values) are fused into a single PutBits or
+//     ReadBits of up to 32 bits
+//   - encoders reserve a worst-case size once and then write unchecked
+//
+// Runs of optional or repeated elements keep a state variable and switch on
+// it, as the event-code width depends on what was present before.
+func (g *CodeGenerator) GenerateCodecs(defs []*TypeDefinition) ([]byte, error) {
+	pkg := g.CodecPackage
+	if pkg == "" {
+		pkg = g.PackageName
+	}
+	if pkg == "" {
+		pkg = "generated"
+	}
+	opts := g.Grammar
+	var rootTypes []reflect.Type
+	for _, proto := range g.CodecTypes {
+		rt := reflect.TypeOf(proto)
+		if rt == nil || rt.Kind() != reflect.Ptr || rt.Elem().Kind() != reflect.Struct {
+			return nil, fmt.Errorf("codegen: codec prototype %T is not a struct pointer", proto)
+		}
+		rootTypes = append(rootTypes, rt.Elem())
+	}
+	if len(rootTypes) == 0 {
+		return nil, fmt.Errorf("codegen: no CodecTypes given")
+	}
+	if len(opts.Roots) == 0 {
+		for _, rt := range rootTypes {
+			opts.Roots = append(opts.Roots, rt.Name())
+		}
+	}
+	table, err := BuildGrammarTable(defs, opts)
+	if err != nil {
+		return nil, err
+	}
+
+	e := &codecEmitter{
+		t:       table,
+		pkg:     pkg,
+		imports: map[string]string{"fmt": "fmt"},
+		enums:   map[string]string{},
+	}
+	if pkg != "exi" {
+		e.exiQ = "exi."
+		e.imports[exiImportPath] = "exi"
+	}
+	for _, rt := range rootTypes {
+		root, ok := table.Root(rt.Name())
+		if !ok {
+			return nil, fmt.Errorf("codegen: %s is not a root element", rt.Name())
+		}
+		if err := e.emitRoot(root, rt); err != nil {
+			return nil, fmt.Errorf("codegen: %s: %w", rt.Name(), err)
+		}
+	}
+
+	var out bytes.Buffer
+	fmt.Fprintf(&out, "// Code generated by exi-go codegen. DO NOT EDIT.\n//\n")
+	fmt.Fprintf(&out, "// Specialized straight-line EXI codecs compiled from the schema grammar\n")
+	fmt.Fprintf(&out, "// tables; see schema.CodeGenerator.GenerateCodecs.\n\n")
+	fmt.Fprintf(&out, "package %s\n\n", pkg)
+	var std, other []string
+	for p := range e.imports {
+		if strings.Contains(p, ".") {
+			other = append(other, p)
+		} else {
+			std = append(std, p)
+		}
+	}
+	sort.Strings(std)
+	sort.Strings(other)
+	fmt.Fprintln(&out, "import (")
+	for _, p := range std {
+		fmt.Fprintf(&out, "\t%q\n", p)
+	}
+	if len(std) > 0 && len(other) > 0 {
+		fmt.Fprintln(&out)
+	}
+	for _, p := range other {
+		fmt.Fprintf(&out, "\t%q\n", p)
+	}
+	fmt.Fprintln(&out, ")")
+	out.Write(e.enumBuf.Bytes())
+	out.Write(e.buf.Bytes())
+
+	src, err := format.Source(out.Bytes())
+	if err != nil {
+		return nil, fmt.Errorf("codegen: gofmt generated codecs: %w", err)
+	}
+	return src, nil
+}
+
+// codecEmitter carries the state of one GenerateCodecs run.
+type codecEmitter struct {
+	t       *exi.GrammarTable
+	pkg     string
+	exiQ    string            // qualifier for the exi runtime ("exi." or "")
+	imports map[string]string // import path -> package name
+	enums   map[string]string // enumeration values key -> helper name
+	enumBuf bytes.Buffer
+	buf     bytes.Buffer // function bodies
+	fn      string       // function being emitted, for error messages
+	tmp     int          // temporary name counter
+
+	// pending fixed-width items not yet written or read.
+	pending []bitItem
+}
+
+// bitItem is one fixed-width item of a fused write or read. For writes,
+// expr is its value (konst when expr is empty). For reads, a non-empty
+// assign is a statement with %s standing for the extracted bits, and post
+// statements run after the fused read; otherwise konst is the expected value.
+type bitItem struct {
+	width  int
+	konst  uint32
+	expr   string
+	assign string
+	post   []string
+}
+
+func (e *codecEmitter) name(prefix string) string {
+	e.tmp++
+	return fmt.Sprintf("%s%d", prefix, e.tmp)
+}
+
+func (e *codecEmitter) p(format string, args ...interface{}) {
+	fmt.Fprintf(&e.buf, format, args...)
+	e.buf.WriteByte('\n')
+}
+
+// goType renders rt as Go source, registering imports as needed.
+func (e *codecEmitter) goType(rt reflect.Type) string {
+	switch rt.Kind() {
+	case reflect.Ptr:
+		return "*" + e.goType(rt.Elem())
+	case reflect.Slice:
+		return "[]" + e.goType(rt.Elem())
+	}
+	if rt.PkgPath() == "" {
+		return rt.String()
+	}
+	name := rt.String()[:strings.IndexByte(rt.String(), '.')]
+	if name == e.pkg {
+		return rt.Name()
+	}
+	e.imports[rt.PkgPath()] = name
+	return name + "." + rt.Name()
+}
+
+// --- encode ----------------------------------------------------------------
+
+// push queues a fixed-width write, flushing first if the fused write would
+// exceed 32 bits.
+func (e *codecEmitter) push(it bitItem) {
+	if it.width == 0 {
+		return
+	}
+	total := 0
+	for _, q := range e.pending {
+		total += q.width
+	}
+	if total+it.width > 32 {
+		e.flush()
+	}
+	e.pending = append(e.pending, it)
+}
+
+// flush emits one PutBits for the pending items.
+func (e *codecEmitter) flush() {
+	if len(e.pending) == 0 {
+		return
+	}
+	total := 0
+	for _, q := range e.pending {
+		total += q.width
+	}
+	var konst uint32
+	var terms []string
+	shift := total
+	for _, q := range e.pending {
+		shift -= q.width
+		if q.expr == "" {
+			konst |= q.konst << uint(shift)
+			continue
+		}
+		if shift == 0 {
+			terms = append(terms, q.expr)
+		} else {
+			terms = append(terms, fmt.Sprintf("%s<<%d", q.expr, shift))
+		}
+	}
+	if konst != 0 || len(terms) == 0 {
+		terms = append([]string{fmt.Sprintf("%#x", konst)}, terms...)
+	}
+	e.p("bs.PutBits(%d, %s)", total, strings.Join(terms, " | "))
+	e.pending = e.pending[:0]
+}
+
+func (e *codecEmitter) emitRoot(root *exi.RootElement, rt reflect.Type) error {
+	tn := e.goType(rt)
+
+	// Worst-case size.
+	sizeFn := "specBits" + root.Name
+	e.p("// %s returns an upper bound on the encoded size of v in bits.", sizeFn)
+	e.p("func %s(v *%s) int {", sizeFn, tn)
+	e.p("n := %d", 8+int(e.t.RootBits))
+	if err := e.sizeType(root.Type, rt, "v"); err != nil {
+		return err
+	}
+	e.p("return n")
+	e.p("}\n")
+
+	// Encoder.
+	e.fn = "EncodeSpecialized" + root.Name
+	e.p("// %s writes v, including the EXI header and document event code.", e.fn)
+	e.p("func %s(bs *%sBitStream, v *%s) error {", e.fn, e.exiQ, tn)
+	e.p("if v == nil {")
+	e.p("return fmt.Errorf(\"%s: nil value\")", e.fn)
+	e.p("}")
+	e.p("if err := bs.Reserve(%s(v)); err != nil {", sizeFn)
+	e.p("return err")
+	e.p("}")
+	e.push(bitItem{width: 8, konst: 0x80})
+	e.push(bitItem{width: int(e.t.RootBits), konst: root.Code})
+	if err := e.encType(root.Type, rt, "v"); err != nil {
+		return err
+	}
+	e.flush()
+	e.p("return nil")
+	e.p("}\n")
+
+	// Decoder.
+	e.fn = "DecodeSpecialized" + root.Name
+	e.p("// %s reads a %s document, including the EXI header.", e.fn, root.Name)
+	e.p("func %s(bs *%sBitStream) (*%s, error) {", e.fn, e.exiQ, tn)
+	e.p("var c uint32")
+	e.p("var err error")
+	e.p("out := &%s{}", tn)
+	e.push(bitItem{width: 8, konst: 0x80})
+	e.push(bitItem{width: int(e.t.RootBits), konst: root.Code})
+	if err := e.decType(root.Type, rt, "out"); err != nil {
+		return err
+	}
+	e.flushRead()
+	e.p("return out, nil")
+	e.p("}\n")
+	return nil
+}
+
+// codeAt returns the event code and width of elem (or exi.ProdEnd) in state s.
+func (e *codecEmitter) codeAt(s uint16, elem uint16) (code, width int, ok bool) {
+	st := e.t.States[s]
+	for i := 0; i < int(st.Count); i++ {
+		if e.t.Prods[int(st.First)+i].Elem == elem {
+			return i, int(st.Bits), true
+		}
+	}
+	return 0, 0, false
+}
+
+// nextOf returns the state entered after elem.
+func (e *codecEmitter) nextOf(s uint16, elem uint16) uint16 {
+	st := e.t.States[s]
+	for i := 0; i < int(st.Count); i++ {
+		if p := e.t.Prods[int(st.First)+i]; p.Elem == elem {
+			return p.Next
+		}
+	}
+	return 0
+}
+
+// stateSet is a small ordered set of grammar states.
+type stateSet []uint16
+
+func (ss stateSet) with(s uint16) stateSet {
+	for _, x := range ss {
+		if x == s {
+			return ss
+		}
+	}
+	out := append(stateSet(nil), ss...)
+	out = append(out, s)
+	sort.Slice(out, func(i, j int) bool { return out[i] < out[j] })
+	return out
+}
+
+// encCode writes the event code of elem given the possible current states.
+func (e *codecEmitter) encCode(elem uint16, possible stateSet, stVar string) error {
+	type cw struct{ code, width int }
+	groups := map[cw][]uint16{}
+	var order []cw
+	for _, s := range possible {
+		code, width, ok := e.codeAt(s, elem)
+		if !ok {
+			continue
+		}
+		k := cw{code, width}
+		if _, seen := groups[k]; !seen {
+			order = append(order, k)
+		}
+		groups[k] = append(groups[k], s)
+	}
+	switch len(order) {
+	case 0:
+		return fmt.Errorf("no state produces element %d", elem)
+	case 1:
+		e.push(bitItem{width: order[0].width, konst: uint32(order[0].code)})
+		return nil
+	}
+	e.flush()
+	e.p("switch %s {", stVar)
+	for i, k := range order {
+		if i == len(order)-1 {
+			e.p("default:")
+		} else {
+			e.p("case %s:", joinStates(groups[k]))
+		}
+		e.p("bs.PutBits(%d, %d)", k.width, k.code)
+	}
+	e.p("}")
+	return nil
+}
+
+func joinStates(ss []uint16) string {
+	parts := make([]string, len(ss))
+	for i, s := range ss {
+		parts[i] = fmt.Sprint(s)
+	}
+	return strings.Join(parts, ", ")
+}
+
+// codecField is the Go field bound to an element.
+type codecField struct {
+	name     string
+	optional bool // pointer
+	array    bool // slice of occurrences
+	elem     reflect.Type
+}
+
+func (e *codecEmitter) fieldFor(rt reflect.Type, el *exi.ElementDecl) (codecField, bool, error) {
+	sf, ok := lookupStructField(rt, el.Name)
+	if !ok {
+		return codecField{}, false, nil
+	}
+	f := codecField{name: sf.Name, elem: sf.Type}
+	octets := el.Kind == exi.KindBinary || el.Kind == exi.KindString
+	switch {
+	case sf.Type.Kind() == reflect.Ptr:
+		f.optional, f.elem = true, sf.Type.Elem()
+	case sf.Type.Kind() == reflect.Slice && (sf.Type.Elem().Kind() != reflect.Uint8 || !octets):
+		f.array, f.elem = true, sf.Type.Elem()
+	}
+	k := f.elem.Kind()
+	valid := false
+	switch el.Kind {
+	case exi.KindComplex:
+		valid = k == reflect.Struct
+	case exi.KindBinary, exi.KindString:
+		valid = k == reflect.String || (k == reflect.Slice && f.elem.Elem().Kind() == reflect.Uint8)
+	case exi.KindUnsigned:
+		valid = k >= reflect.Uint && k <= reflect.Uint64
+	case exi.KindInteger:
+		valid = k >= reflect.Int && k <= reflect.Int64
+	case exi.KindBoolean:
+		valid = k == reflect.Bool
+	case exi.KindEnum:
+		valid = k == reflect.String || (k >= reflect.Uint && k <= reflect.Uint64)
+	}
+	if !valid {
+		return f, false, fmt.Errorf("Go type %s of %s.%s cannot hold element %s", sf.Type, rt.Name(), sf.Name, el.Name)
+	}
+	if f.array && !el.Repeated {
+		return f, false, fmt.Errorf("%s.%s is a slice but element %s is not repeated", rt.Name(), sf.Name, el.Name)
+	}
+	return f, true, nil
+}
+
+// lookupStructField finds the exported field of rt bound to element name:
+// one of the same name or whose xml tag names the element.
+func lookupStructField(rt reflect.Type, name string) (reflect.StructField, bool) {
+	if sf, ok := rt.FieldByName(name); ok && sf.PkgPath == "" && len(sf.Index) == 1 {
+		return sf, true
+	}
+	for i := 0; i < rt.NumField(); i++ {
+		sf := rt.Field(i)
+		if sf.PkgPath == "" && strings.Split(sf.Tag.Get("xml"), ",")[0] == name {
+			return sf, true
+		}
+	}
+	return reflect.StructField{}, false
+}
+
+// encType emits the encoding of type grammar ti for struct expression v.
+func (e *codecEmitter) encType(ti uint16, rt reflect.Type, v string) error {
+	tg := e.t.Types[ti]
+	possible := stateSet{tg.Start}
+	stVar := ""
+	// useState makes stVar hold the current state when it is statically known.
+	useState := func() {
+		if len(possible) != 1 {
+			return
+		}
+		if stVar == "" {
+			stVar = e.name("st")
+			e.p("%s := %d", stVar, possible[0])
+			e.p("_ = %s", stVar)
+		} else {
+			e.p("%s = %d", stVar, possible[0])
+		}
+	}
+	for k := 0; k < int(tg.ElemCount); k++ {
+		ei := tg.ElemFirst + uint16(k)
+		el := &e.t.Elements[ei]
+		f, has, err := e.fieldFor(rt, el)
+		if err != nil {
+			return err
+		}
+		if !has {
+			if !el.Optional {
+				return fmt.Errorf("%s has no field for required element %s", rt.Name(), el.Name)
+			}
+			continue
+		}
+		next := e.nextOf(possible[0], ei)
+		x := v + "." + f.name
+		switch {
+		case f.array:
+			if !el.Optional {
+				e.flush()
+				e.p("if len(%s) == 0 {", x)
+				e.p("return fmt.Errorf(\"%s: %s needs at least one %s\")", e.fn, rt.Name(), el.Name)
+				e.p("}")
+			}
+			inLoop := possible.with(next)
+			e.flush()
+			useState()
+			idx := e.name("i")
+			e.p("for %s := range %s {", idx, x)
+			if err := e.encCode(ei, inLoop, stVar); err != nil {
+				return err
+			}
+			if err := e.encElement(ei, f, x+"["+idx+"]"); err != nil {
+				return err
+			}
+			e.flush()
+			e.p("%s = %d", stVar, next)
+			e.p("}")
+			if el.Optional {
+				possible = inLoop
+			} else {
+				possible = stateSet{next}
+			}
+		case f.optional && el.Optional:
+			e.flush()
+			after := possible.with(next)
+			useState()
+			e.p("if %s != nil {", x)
+			if err := e.encCode(ei, possible, stVar); err != nil {
+				return err
+			}
+			val := x
+			if f.elem.Kind() != reflect.Struct {
+				val = "*" + x
+			}
+			if err := e.encElement(ei, f, val); err != nil {
+				return err
+			}
+			e.flush()
+			e.p("%s = %d", stVar, next)
+			e.p("}")
+			possible = after
+		default:
+			if f.optional {
+				// A pointer for a required element must be set.
+				e.flush()
+				e.p("if %s == nil {", x)
+				e.p("return fmt.Errorf(\"%s: %s.%s is required\")", e.fn, rt.Name(), f.name)
+				e.p("}")
+				if f.elem.Kind() != reflect.Struct {
+					x = "*" + x
+				}
+			}
+			if err := e.encCode(ei, possible, stVar); err != nil {
+				return err
+			}
+			if err := e.encElement(ei, f, x); err != nil {
+				return err
+			}
+			possible = stateSet{next}
+		}
+	}
+	return e.encCode(exi.ProdEnd, possible, stVar)
+}
+
+// encElement emits the content of element ei whose value is expression x.
+func (e *codecEmitter) encElement(ei uint16, f codecField, x string) error {
+	el := &e.t.Elements[ei]
+	if el.Kind == exi.KindComplex {
+		return e.encType(el.Type, f.elem, x)
+	}
+	e.push(bitItem{width: 1}) // CHARACTERS
+	switch el.Kind {
+	case exi.KindBinary, exi.KindString:
+		e.flush()
+		extra := ""
+		if el.Kind == exi.KindString {
+			extra = "+2"
+		}
+		e.p("bs.PutUnsignedVar(uint64(len(%s))%s)", x, extra)
+		if f.elem.Kind() == reflect.String {
+			e.p("bs.PutOctets([]byte(%s))", x)
+		} else {
+			e.p("bs.PutOctets(%s)", x)
+		}
+	case exi.KindUnsigned:
+		e.flush()
+		e.p("bs.PutUnsignedVar(uint64(%s))", x)
+	case exi.KindInteger:
+		n, sign, mag := e.name("n"), e.name("sign"), e.name("mag")
+		e.p("%s := int64(%s)", n, x)
+		e.p("%s, %s := uint32(0), uint64(%s)", sign, mag, n)
+		e.p("if %s < 0 {", n)
+		e.p("%s, %s = 1, uint64(-(%s + 1))", sign, mag, n)
+		e.p("}")
+		e.push(bitItem{width: 1, expr: sign})
+		e.flush()
+		e.p("bs.PutUnsignedVar(%s)", mag)
+	case exi.KindBoolean:
+		b := e.name("b")
+		e.p("%s := uint32(0)", b)
+		e.p("if %s {", x)
+		e.p("%s = 1", b)
+		e.p("}")
+		e.push(bitItem{width: 1, expr: b})
+	case exi.KindEnum:
+		idx := e.name("e")
+		if f.elem.Kind() == reflect.String {
+			helper := e.enumHelper(el)
+			ok := e.name("ok")
+			e.p("%s, %s := %sIndex(string(%s))", idx, ok, helper, x)
+			e.p("if !%s {", ok)
+			e.p("return fmt.Errorf(\"%s: %%q is not a valid %s\", %s)", e.fn, el.Name, x)
+			e.p("}")
+		} else {
+			e.p("if uint64(%s) >= %d {", x, len(el.EnumValues))
+			e.p("return fmt.Errorf(\"%s: %%d is not a valid %s\", %s)", e.fn, el.Name, x)
+			e.p("}")
+			e.p("%s := uint32(%s)", idx, x)
+		}
+		if el.EnumBits > 0 {
+			e.push(bitItem{width: int(el.EnumBits), expr: idx})
+		} else {
+			e.p("_ = %s", idx)
+		}
+	}
+	e.push(bitItem{width: 1}) // END
+	return nil
+}
+
+// enumHelper returns the name of the value table and index function for an
+// enumeration, emitting them on first use.
+func (e *codecEmitter) enumHelper(el *exi.ElementDecl) string {
+	key := strings.Join(el.EnumValues, "\x00")
+	if name, ok := e.enums[key]; ok {
+		return name
+	}
+	name := "specEnum" + exportName(el.Name)
+	for taken := true; taken; {
+		taken = false
+		for _, n := range e.enums {
+			if n == name {
+				name += "X"
+				taken = true
+			}
+		}
+	}
+	e.enums[key] = name
+	w := &e.enumBuf
+	fmt.Fprintf(w, "\n// %s lists the %s values in schema order.\n", name, el.Name)
+	fmt.Fprintf(w, "var %s = [...]string{", name)
+	for i, v := range el.EnumValues {
+		if i > 0 {
+			w.WriteString(", ")
+		}
+		fmt.Fprintf(w, "%q", v)
+	}
+	fmt.Fprintf(w, "}\n\nfunc %sIndex(s string) (uint32, bool) {\n\tswitch s {\n", name)
+	for i, v := range el.EnumValues {
+		fmt.Fprintf(w, "\tcase %q:\n\t\treturn %d, true\n", v, i)
+	}
+	fmt.Fprintf(w, "\t}\n\treturn 0, false\n}\n")
+	return name
+}
+
+// --- size ------------------------------------------------------------------
+
+// maxCodeBits returns the widest event code elem can take in type ti.
+func (e *codecEmitter) maxCodeBits(ti uint16, elem uint16) int {
+	tg := e.t.Types[ti]
+	last := len(e.t.States)
+	if int(ti)+1 < len(e.t.Types) {
+		last = int(e.t.Types[ti+1].Start)
+	}
+	max := 0
+	for s := int(tg.Start); s < last; s++ {
+		if _, w, ok := e.codeAt(uint16(s), elem); ok && w > max {
+			max = w
+		}
+	}
+	return max
+}
+
+// unsignedVarMaxBits is the largest unsigned-var encoding of a Go kind.
+func unsignedVarMaxBits(k reflect.Kind) int {
+	switch k {
+	case reflect.Uint8, reflect.Int8:
+		return 16
+	case reflect.Uint16, reflect.Int16:
+		return 24
+	case reflect.Uint32, reflect.Int32:
+		return 40
+	}
+	return 80
+}
+
+// sizeType emits statements adding the worst-case size of type ti for
+// struct expression v to n.
+func (e *codecEmitter) sizeType(ti uint16, rt reflect.Type, v string) error {
+	tg := e.t.Types[ti]
+	konst := e.maxCodeBits(ti, exi.ProdEnd)
+	for k := 0; k < int(tg.ElemCount); k++ {
+		ei := tg.ElemFirst + uint16(k)
+		el := &e.t.Elements[ei]
+		f, has, err := e.fieldFor(rt, el)
+		if err != nil {
+			return err
+		}
+		if !has {
+			continue
+		}
+		x := v + "." + f.name
+		code := e.maxCodeBits(ti, ei)
+		switch {
+		case f.array:
+			idx := e.name("i")
+			mark := e.buf.Len()
+			e.p("for %s := range %s {", idx, x)
+			body := e.buf.Len()
+			c, err := e.sizeElement(ei, f, x+"["+idx+"]")
+			if err != nil {
+				return err
+			}
+			if e.buf.Len() == body {
+				// Fixed-size occurrences need no loop.
+				e.buf.Truncate(mark)
+				e.p("n += %d * len(%s)", code+c, x)
+				break
+			}
+			e.p("n += %d", code+c)
+			e.p("}")
+		case f.optional:
+			val := x
+			if f.elem.Kind() != reflect.Struct {
+				val = "*" + x
+			}
+			e.p("if %s != nil {", x)
+			c, err := e.sizeElement(ei, f, val)
+			if err != nil {
+				return err
+			}
+			e.p("n += %d", code+c)
+			e.p("}")
+		default:
+			c, err := e.sizeElement(ei, f, x)
+			if err != nil {
+				return err
+			}
+			konst += code + c
+		}
+	}
+	if konst > 0 {
+		e.p("n += %d", konst)
+	}
+	return nil
+}
+
+// sizeElement returns the constant part of an element's size and emits
+// statements for the variable part.
+func (e *codecEmitter) sizeElement(ei uint16, f codecField, x string) (int, error) {
+	el := &e.t.Elements[ei]
+	switch el.Kind {
+	case exi.KindComplex:
+		return 0, e.sizeType(el.Type, f.elem, x)
+	case exi.KindBinary, exi.KindString:
+		extra := ""
+		if el.Kind == exi.KindString {
+			extra = "+2"
+		}
+		e.p("n += 8*len(%s) + %sUnsignedVarBits(uint64(len(%s))%s)", x, e.exiQ, x, extra)
+		return 2, nil
+	case exi.KindUnsigned:
+		return 2 + unsignedVarMaxBits(f.elem.Kind()), nil
+	case exi.KindInteger:
+		return 3 + unsignedVarMaxBits(f.elem.Kind()), nil
+	case exi.KindBoolean:
+		return 3, nil
+	case exi.KindEnum:
+		return 2 + int(el.EnumBits), nil
+	}
+	return 0, fmt.Errorf("element %s: unknown kind", el.Name)
+}
+
+// --- decode ----------------------------------------------------------------
+
+// flushRead emits one ReadBits for the pending items: constant items are
+// checked together, the others are extracted and assigned.
+func (e *codecEmitter) flushRead() {
+	if len(e.pending) == 0 {
+		return
+	}
+	total := 0
+	for _, q := range e.pending {
+		total += q.width
+	}
+	e.p("if c, err = bs.ReadBits(%d); err != nil {", total)
+	e.p("return nil, err")
+	e.p("}")
+	var mask, want uint32
+	shift := total
+	var assigns, posts []string
+	for _, q := range e.pending {
+		shift -= q.width
+		m := uint32(1)<<uint(q.width) - 1
+		if q.assign == "" {
+			mask |= m << uint(shift)
+			want |= q.konst << uint(shift)
+			continue
+		}
+		bits := "c"
+		if shift > 0 {
+			bits = fmt.Sprintf("c>>%d", shift)
+		}
+		if shift+q.width < total {
+			bits = fmt.Sprintf("(%s)&%#x", bits, m)
+		}
+		assigns = append(assigns, fmt.Sprintf(q.assign, bits))
+		posts = append(posts, q.post...)
+	}
+	if mask != 0 {
+		e.p("if c&%#x != %#x {", mask, want)
+		e.p("return nil, %s", e.mismatch())
+		e.p("}")
+	}
+	for _, a := range assigns {
+		e.p("%s", a)
+	}
+	for _, s := range posts {
+		e.p("%s", s)
+	}
+	e.pending = e.pending[:0]
+}
+
+func (e *codecEmitter) mismatch() string {
+	return fmt.Sprintf("fmt.Errorf(\"%s: %%w\", %sErrGrammarMismatch)", e.fn, e.exiQ)
+}
+
+// pushRead queues a fixed-width read like push.
+func (e *codecEmitter) pushRead(it bitItem) {
+	if it.width == 0 {
+		return
+	}
+	total := 0
+	for _, q := range e.pending {
+		total += q.width
+	}
+	if total+it.width > 32 {
+		e.flushRead()
+	}
+	e.pending = append(e.pending, it)
+}
+
+// decType emits the decoding of type grammar ti into addressable struct
+// expression v.
+func (e *codecEmitter) decType(ti uint16, rt reflect.Type, v string) error {
+	tg := e.t.Types[ti]
+	state := tg.Start
+	stVar := ""
+	for k := 0; k < int(tg.ElemCount); {
+		ei := tg.ElemFirst + uint16(k)
+		el := &e.t.Elements[ei]
+		if !el.Optional && !el.Repeated {
+			code, width, _ := e.codeAt(state, ei)
+			e.pushRead(bitItem{width: width, konst: uint32(code)})
+			if err := e.decElementInto(ei, rt, v); err != nil {
+				return err
+			}
+			state = e.nextOf(state, ei)
+			k++
+			continue
+		}
+
+		// A run of optional/repeated elements up to the next required one
+		// (or END) is decoded by a loop switching on state and event code.
+		end := k
+		for end < int(tg.ElemCount) {
+			d := &e.t.Elements[tg.ElemFirst+uint16(end)]
+			end++
+			if !d.Optional && !d.Repeated {
+				break
+			}
+		}
+		last := tg.ElemFirst + uint16(end-1)
+		terminator := !e.t.Elements[last].Optional && !e.t.Elements[last].Repeated
+		inRun := end
+		if terminator {
+			inRun-- // the state after the terminator is outside the run
+		}
+		states := stateSet{state}
+		for j := k; j < inRun; j++ {
+			states = states.with(e.nextOf(state, tg.ElemFirst+uint16(j)))
+		}
+
+		e.flushRead()
+		if stVar == "" {
+			stVar = e.name("st")
+			e.p("%s := uint32(%d)", stVar, state)
+		} else {
+			e.p("%s = %d", stVar, state)
+		}
+		label := e.name("run")
+		e.p("%s:", label)
+		e.p("for {")
+		byWidth := map[int][]uint16{}
+		var widths []int
+		for _, s := range states {
+			w := int(e.t.States[s].Bits)
+			if _, ok := byWidth[w]; !ok {
+				widths = append(widths, w)
+			}
+			byWidth[w] = append(byWidth[w], s)
+		}
+		if len(widths) == 1 {
+			e.p("c, err = bs.ReadBits(%d)", widths[0])
+		} else {
+			e.p("switch %s {", stVar)
+			for i, w := range widths {
+				if i == len(widths)-1 {
+					e.p("default:")
+				} else {
+					e.p("case %s:", joinStates(byWidth[w]))
+				}
+				e.p("c, err = bs.ReadBits(%d)", w)
+			}
+			e.p("}")
+		}
+		e.p("if err != nil {")
+		e.p("return nil, err")
+		e.p("}")
+		e.p("switch %s<<8 | c {", stVar)
+		for j := k; j < end; j++ {
+			ej := tg.ElemFirst + uint16(j)
+			var keys []string
+			var next uint16
+			for _, s := range states {
+				if code, _, ok := e.codeAt(s, ej); ok {
+					keys = append(keys, fmt.Sprintf("%d<<8 | %d", s, code))
+					next = e.nextOf(s, ej)
+				}
+			}
+			if len(keys) == 0 {
+				continue
+			}
+			e.p("case %s:", strings.Join(keys, ", "))
+			if _, has, _ := e.fieldFor(rt, &e.t.Elements[ej]); !has {
+				e.p("return nil, fmt.Errorf(\"%s: element %s is not supported by %s\")", e.fn, e.t.Elements[ej].Name, rt.Name())
+				continue
+			}
+			if err := e.decElementInto(ej, rt, v); err != nil {
+				return err
+			}
+			e.flushRead()
+			if j == end-1 && terminator {
+				e.p("break %s", label)
+			} else {
+				e.p("%s = %d", stVar, next)
+			}
+			if j == end-1 && terminator {
+				state = next
+			}
+		}
+		if !terminator {
+			var keys []string
+			for _, s := range states {
+				if code, _, ok := e.codeAt(s, exi.ProdEnd); ok {
+					keys = append(keys, fmt.Sprintf("%d<<8 | %d", s, code))
+				}
+			}
+			e.p("case %s:", strings.Join(keys, ", "))
+			e.p("break %s", label)
+		}
+		e.p("default:")
+		e.p("return nil, %s", e.mismatch())
+		e.p("}")
+		e.p("}")
+		if !terminator {
+			return nil // END consumed by the run
+		}
+		k = end
+	}
+	code, width, _ := e.codeAt(state, exi.ProdEnd)
+	e.pushRead(bitItem{width: width, konst: uint32(code)})
+	return nil
+}
+
+// convert returns val converted to Go type et unless it already has type have.
+func (e *codecEmitter) convert(et, val, have string) string {
+	if et == have {
+		return val
+	}
+	return et + "(" + val + ")"
+}
+
+// decElementInto emits decoding of element ei into the bound field of v.
+func (e *codecEmitter) decElementInto(ei uint16, rt reflect.Type, v string) error {
+	el := &e.t.Elements[ei]
+	f, has, err := e.fieldFor(rt, el)
+	if err != nil {
+		return err
+	}
+	if !has {
+		return fmt.Errorf("%s has no field for required element %s", rt.Name(), el.Name)
+	}
+	x := v + "." + f.name
+	et := e.goType(f.elem)
+
+	if el.Kind == exi.KindComplex {
+		ptr := e.name("p")
+		switch {
+		case f.array:
+			e.flushRead()
+			e.p("%s = append(%s, %s{})", x, x, et)
+			e.p("%s := &%s[len(%s)-1]", ptr, x, x)
+		case f.optional:
+			e.flushRead()
+			e.p("%s := new(%s)", ptr, et)
+			e.p("%s = %s", x, ptr)
+		default:
+			return e.decType(el.Type, f.elem, x)
+		}
+		return e.decType(el.Type, f.elem, ptr)
+	}
+
+	// set returns a statement storing a value expression of type et.
+	set := func(val string) string {
+		switch {
+		case f.array:
+			return fmt.Sprintf("%s = append(%s, %s)", x, x, val)
+		case f.optional:
+			t := e.name("t")
+			return fmt.Sprintf("%s := %s\n%s = &%s", t, val, x, t)
+		}
+		return fmt.Sprintf("%s = %s", x, val)
+	}
+
+	e.pushRead(bitItem{width: 1}) // CHARACTERS
+	switch el.Kind {
+	case exi.KindBinary, exi.KindString:
+		e.flushRead()
+		n, b := e.name("n"), e.name("b")
+		e.p("%s, err := bs.ReadUnsignedVar()", n)
+		e.p("if err != nil {")
+		e.p("return nil, err")
+		e.p("}")
+		if el.Kind == exi.KindString {
+			e.p("if %s < 2 {", n)
+			e.p("return nil, %s", e.mismatch())
+			e.p("}")
+			e.p("%s -= 2", n)
+		}
+		e.p("%s, err := bs.ReadOctetSlice(int(%s))", b, n)
+		e.p("if err != nil {")
+		e.p("return nil, err")
+		e.p("}")
+		if f.elem.Kind() == reflect.String {
+			e.p("%s", set(e.convert(et, b, "[]byte")))
+		} else {
+			e.p("%s", set(b))
+		}
+	case exi.KindUnsigned:
+		e.flushRead()
+		u := e.name("u")
+		e.p("%s, err := bs.ReadUnsignedVar()", u)
+		e.p("if err != nil {")
+		e.p("return nil, err")
+		e.p("}")
+		if bits := f.elem.Bits(); bits < 64 {
+			e.p("if %s>>%d != 0 {", u, bits)
+			e.p("return nil, %s", e.mismatch())
+			e.p("}")
+		}
+		e.p("%s", set(e.convert(et, u, "uint64")))
+	case exi.KindInteger:
+		sign := e.name("sign")
+		e.p("var %s uint32", sign)
+		e.pushRead(bitItem{width: 1, assign: sign + " = %s"})
+		e.flushRead()
+		m := e.name("m")
+		e.p("%s, err := bs.ReadUnsignedVar()", m)
+		e.p("if err != nil {")
+		e.p("return nil, err")
+		e.p("}")
+		nv := e.name("n")
+		e.p("%s := int64(%s)", nv, m)
+		e.p("if %s == 1 {", sign)
+		e.p("%s = -%s - 1", nv, nv)
+		e.p("}")
+		e.p("%s", set(e.convert(et, nv, "int64")))
+	case exi.KindBoolean:
+		e.pushRead(bitItem{width: 1, assign: set("%[1]s == 1")})
+	case exi.KindEnum:
+		var val string
+		if f.elem.Kind() == reflect.String {
+			val = e.convert(et, e.enumHelper(el)+"[%[1]s]", "string")
+		} else {
+			val = fmt.Sprintf("%s(%%[1]s)", et)
+		}
+		if el.EnumBits == 0 {
+			e.p("%s", fmt.Sprintf(set(val), "0"))
+			break
+		}
+		idx := e.name("e")
+		e.p("var %s uint32", idx)
+		check := fmt.Sprintf("if %s >= %d {\nreturn nil, %s\n}", idx, len(el.EnumValues), e.mismatch())
+		it := bitItem{width: int(el.EnumBits), assign: idx + " = %s", post: []string{check, fmt.Sprintf(set(val), idx)}}
+		if len(el.EnumValues) == 1<<el.EnumBits {
+			it.post = it.post[1:]
+		}
+		e.pushRead(it)
+	}
+	e.pushRead(bitItem{width: 1}) // END
+	return nil
+}
@@ -0,0 +1,53 @@
+package schema
+
+import (
+	"bytes"
+	"flag"
+	"os"
+	"path/filepath"
+	"testing"
+
+	"example.com/exi-go/pkg/v2g/generated"
+)
+
+var updateCodecs = flag.Bool("update", false, "rewrite pkg/exi/zz_generated_codecs.go")
+
+// TestGeneratedCodecsUpToDate regenerates the specialized codecs checked in
+// to pkg/exi from the test schema subset and fails if they differ. Run with
+// -update after changing the generator.
+func TestGeneratedCodecsUpToDate(t *testing.T) {
+	schemas, err := LoadSchemas([]string{filepath.Join("testdata", "v2g_subset.xsd")})
+	if err != nil {
+		t.Fatal(err)
+	}
+	defs, err := ParseSchemas(schemas)
+	if err != nil {
+		t.Fatal(err)
+	}
+	g := &CodeGenerator{
+		CodecPackage: "exi",
+		CodecTypes: []interface{}{
+			&generated.SessionSetupReq{},
+			&generated.ServiceDiscoveryReq{},
+			&generated.SessionStopReq{},
+		},
+		Grammar: GrammarOptions{RootCodes: subsetRootCodes, RootBits: 6},
+	}
+	src, err := g.GenerateCodecs(defs)
+	if err != nil {
+		t.Fatal(err)
+	}
+	target := filepath.Join("..", "exi", "zz_generated_codecs.go")
+	if *updateCodecs {
+		if err := os.WriteFile(target, src, 0o644); err != nil {
+			t.Fatal(err)
+		}
+	}
+	current, err := os.ReadFile(target)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !bytes.Equal(current, src) {
+		t.Fatalf("%s is stale; run go test ./pkg/schema -run TestGeneratedCodecsUpToDate -update", target)
+	}
+}
@@ -0,0 +1,278 @@
+package schema
+
+import (
+	"fmt"
+	"math/bits"
+	"sort"
+	"strings"
+
+	"example.com/exi-go/pkg/exi"
+)
+
+// GrammarOptions tunes BuildGrammarTable.
+type GrammarOptions struct {
+	// Roots restricts the table to these global elements (and the types
+	// they reach). Empty means every global element.
+	Roots []string
+
+	// RootCodes overrides document-level event codes by element name. By
+	// default a global element's code is its index in EXI order (sorted by
+	// local name) among all global elements of the schema set.
+	RootCodes map[string]uint32
+
+	// RootBits overrides the width of the document-level event code, which
+	// defaults to ceil(log2(globals+1)).
+	RootBits int
+}
+
+// xsdBuiltinKinds maps XSD built-in types (local names) to value kinds.
+var xsdBuiltinKinds = map[string]exi.ValueKind{
+	"string": exi.KindString, "normalizedString": exi.KindString, "token": exi.KindString,
+	"anyURI": exi.KindString, "ID": exi.KindString, "NCName": exi.KindString, "language": exi.KindString,
+
+	"hexBinary": exi.KindBinary, "base64Binary": exi.KindBinary,
+
+	"unsignedLong": exi.KindUnsigned, "unsignedInt": exi.KindUnsigned, "unsignedShort": exi.KindUnsigned,
+	"unsignedByte": exi.KindUnsigned, "nonNegativeInteger": exi.KindUnsigned, "positiveInteger": exi.KindUnsigned,
+
+	"long": exi.KindInteger, "int": exi.KindInteger, "short": exi.KindInteger,
+	"byte": exi.KindInteger, "integer": exi.KindInteger,
+
+	"boolean": exi.KindBoolean,
+}
+
+// BuildGrammarTable compiles the IR returned by ParseSchemas into the flat
+// grammar tables interpreted by exi.GrammarTable.
+//
+// Each complex type with fields f0..fn-1 (base-type fields first) becomes
+// states S0..Sn: Sj holds a START production for every field that can come
+// next (fj up to and including the first required one) followed by END if
+// all of those are optional, and the event-code width is
+// ceil(log2(productions+1)), the extra code being the non-strict escape used
+// by the ISO 15118-20 grammars. A repeated field fk gets a loop state holding
+// fk followed by the productions of Sk+1.
+func BuildGrammarTable(defs []*TypeDefinition, opts GrammarOptions) (*exi.GrammarTable, error) {
+	b := &grammarBuilder{
+		defs:  map[string]*TypeDefinition{},
+		types: map[string]uint16{},
+		t:     &exi.GrammarTable{},
+	}
+	var globals []string
+	for _, td := range defs {
+		if td == nil || td.Name == "" {
+			continue
+		}
+		b.defs[td.Name] = td
+		if td.ElementType != "" {
+			globals = append(globals, td.Name)
+		}
+	}
+	sort.Strings(globals)
+
+	roots := opts.Roots
+	if len(roots) == 0 {
+		roots = globals
+	}
+	b.t.RootBits = uint8(bitsFor(len(globals) + 1))
+	if opts.RootBits > 0 {
+		b.t.RootBits = uint8(opts.RootBits)
+	}
+	for _, name := range roots {
+		td, ok := b.defs[name]
+		if !ok || td.ElementType == "" {
+			return nil, fmt.Errorf("grammar: %s is not a global element", name)
+		}
+		ti, err := b.complexType(localType(td.ElementType))
+		if err != nil {
+			return nil, fmt.Errorf("grammar: element %s: %w", name, err)
+		}
+		code, ok := opts.RootCodes[name]
+		if !ok {
+			code = uint32(sort.SearchStrings(globals, name))
+		}
+		if code >= 1<<b.t.RootBits {
+			return nil, fmt.Errorf("grammar: element %s: event code %d does not fit %d bits", name, code, b.t.RootBits)
+		}
+		b.t.Roots = append(b.t.Roots, exi.RootElement{Name: name, Type: ti, Code: code})
+	}
+	return b.t, nil
+}
+
+type grammarBuilder struct {
+	defs  map[string]*TypeDefinition
+	types map[string]uint16 // complex type name -> index in t.Types
+	t     *exi.GrammarTable
+}
+
+// complexType returns the index of the grammar for the named complex type,
+// building it (and the types it references) on first use.
+func (b *grammarBuilder) complexType(name string) (uint16, error) {
+	if ti, ok := b.types[name]; ok {
+		return ti, nil
+	}
+	td, ok := b.defs[name]
+	if !ok || !td.IsComplex {
+		return 0, fmt.Errorf("complex type %s not found", name)
+	}
+	fields, err := b.fieldsOf(td, 0)
+	if err != nil {
+		return 0, err
+	}
+
+	t := b.t
+	ti := uint16(len(t.Types))
+	b.types[name] = ti
+	elemFirst := len(t.Elements)
+	t.Types = append(t.Types, exi.TypeGrammar{
+		Name:      name,
+		Start:     uint16(len(t.States)),
+		ElemFirst: uint16(elemFirst),
+		ElemCount: uint16(len(fields)),
+	})
+
+	// Elements of the type are contiguous; reserve them before recursing
+	// into child types, which append their own.
+	for _, f := range fields {
+		t.Elements = append(t.Elements, exi.ElementDecl{Name: f.Name})
+	}
+
+	// States S0..Sn, then one loop state per repeated field.
+	n := len(fields)
+	seq := len(t.States)
+	loop := map[int]int{}
+	for k, f := range fields {
+		if f.IsArray {
+			loop[k] = seq + n + 1 + len(loop)
+		}
+	}
+	next := func(k int) uint16 {
+		if s, ok := loop[k]; ok {
+			return uint16(s)
+		}
+		return uint16(seq + k + 1)
+	}
+	follow := func(j int) []exi.Production {
+		var prods []exi.Production
+		for k := j; k < n; k++ {
+			prods = append(prods, exi.Production{Elem: uint16(elemFirst + k), Next: next(k)})
+			if !fields[k].IsOptional {
+				return prods
+			}
+		}
+		return append(prods, exi.Production{Elem: exi.ProdEnd})
+	}
+	for j := 0; j <= n; j++ {
+		if err := b.addState(follow(j)); err != nil {
+			return 0, fmt.Errorf("%s: %w", name, err)
+		}
+	}
+	for k := range fields {
+		if s, ok := loop[k]; ok {
+			prods := append([]exi.Production{{Elem: uint16(elemFirst + k), Next: uint16(s)}}, follow(k+1)...)
+			if err := b.addState(prods); err != nil {
+				return 0, fmt.Errorf("%s: %w", name, err)
+			}
+		}
+	}
+
+	for k, f := range fields {
+		el, err := b.element(f)
+		if err != nil {
+			return 0, fmt.Errorf("%s.%s: %w", name, f.Name, err)
+		}
+		el.Optional, el.Repeated = f.IsOptional, f.IsArray
+		t.Elements[elemFirst+k] = el
+	}
+	if len(t.States) > exi.ProdEnd || len(t.Elements) >= exi.ProdEnd {
+		return 0, fmt.Errorf("grammar table exceeds %d states or elements", exi.ProdEnd)
+	}
+	return ti, nil
+}
+
+func (b *grammarBuilder) addState(prods []exi.Production) error {
+	if len(prods) > 255 {
+		return fmt.Errorf("state with %d productions", len(prods))
+	}
+	b.t.States = append(b.t.States, exi.GrammarState{
+		First: uint16(len(b.t.Prods)),
+		Count: uint8(len(prods)),
+		Bits:  uint8(bitsFor(len(prods) + 1)),
+	})
+	b.t.Prods = append(b.t.Prods, prods...)
+	return nil
+}
+
+// fieldsOf returns td's fields preceded by those of its extension bases.
+func (b *grammarBuilder) fieldsOf(td *TypeDefinition, depth int) ([]Field, error) {
+	if td.Base == "" {
+		return td.Fields, nil
+	}
+	if depth > 32 {
+		return nil, fmt.Errorf("extension chain of %s too deep", td.Name)
+	}
+	base, ok := b.defs[localType(td.Base)]
+	if !ok {
+		if _, builtin := xsdBuiltinKinds[localType(td.Base)]; builtin {
+			return td.Fields, nil // simpleContent-style extension
+		}
+		return nil, fmt.Errorf("base type %s of %s not found", td.Base, td.Name)
+	}
+	baseFields, err := b.fieldsOf(base, depth+1)
+	if err != nil {
+		return nil, err
+	}
+	return append(append([]Field(nil), baseFields...), td.Fields...), nil
+}
+
+// element resolves the value kind of a field's type.
+func (b *grammarBuilder) element(f Field) (exi.ElementDecl, error) {
+	el := exi.ElementDecl{Name: f.Name}
+	name := localType(f.Type)
+	if name == "" {
+		return el, fmt.Errorf("element has no named type")
+	}
+	for depth := 0; depth < 32; depth++ {
+		if k, ok := xsdBuiltinKinds[name]; ok {
+			el.Kind = k
+			return el, nil
+		}
+		td, ok := b.defs[name]
+		if !ok {
+			return el, fmt.Errorf("type %s not found", name)
+		}
+		switch {
+		case td.IsComplex:
+			ti, err := b.complexType(name)
+			if err != nil {
+				return el, err
+			}
+			el.Kind, el.Type = exi.KindComplex, ti
+			return el, nil
+		case td.IsEnum:
+			el.Kind = exi.KindEnum
+			el.EnumValues = td.EnumValues
+			el.EnumBits = uint8(bitsFor(len(td.EnumValues)))
+			return el, nil
+		case td.Base == "":
+			return el, fmt.Errorf("simple type %s has no base", name)
+		}
+		name = localType(td.Base)
+	}
+	return el, fmt.Errorf("restriction chain of %s too deep", f.Type)
+}
+
+// localType strips a namespace prefix ("xs:string" -> "string").
+func localType(qname string) string {
+	if i := strings.LastIndexByte(qname, ':'); i >= 0 {
+		return qname[i+1:]
+	}
+	return qname
+}
+
+// bitsFor returns ceil(log2(n)), the width needed to number n alternatives.
+func bitsFor(n int) int {
+	if n <= 1 {
+		return 0
+	}
+	return bits.Len(uint(n - 1))
+}
@@ -0,0 +1,236 @@
+package schema
+
+import (
+	"bytes"
+	"errors"
+	"os"
+	"path/filepath"
+	"reflect"
+	"testing"
+
+	"example.com/exi-go/pkg/exi"
+	"example.com/exi-go/pkg/v2g/generated"
+)
+
+// subsetRootCodes are the ISO 15118-20 document event codes of the subset's
+// global elements; the subset has fewer globals than the full schema, so
+// the derived codes would differ.
+var subsetRootCodes = map[string]uint32{
+	"ServiceDiscoveryReq": 31,
+	"SessionSetupReq":     35,
+	"SessionStopReq":      37,
+}
+
+func loadSubsetTable(t testing.TB) *exi.GrammarTable {
+	t.Helper()
+	schemas, err := LoadSchemas([]string{filepath.Join("testdata", "v2g_subset.xsd")})
+	if err != nil {
+		t.Fatal(err)
+	}
+	defs, err := ParseSchemas(schemas)
+	if err != nil {
+		t.Fatal(err)
+	}
+	table, err := BuildGrammarTable(defs, GrammarOptions{RootCodes: subsetRootCodes, RootBits: 6})
+	if err != nil {
+		t.Fatal(err)
+	}
+	return table
+}
+
+func stateBits(table *exi.GrammarTable, typeName string, n int) []uint8 {
+	for _, tg := range table.Types {
+		if tg.Name == typeName {
+			var out []uint8
+			for i := 0; i < n; i++ {
+				out = append(out, table.States[int(tg.Start)+i].Bits)
+			}
+			return out
+		}
+	}
+	return nil
+}
+
+func TestBuildGrammarTableEventCodeWidths(t *testing.T) {
+	table := loadSubsetTable(t)
+	// These are the widths hard-coded by the hand-written codecs: grammar
+	// IDs 277-279 for the header and 460-463 for SessionStopReq.
+	cases := []struct {
+		typ  string
+		want []uint8
+	}{
+		{"MessageHeaderType", []uint8{1, 1, 2, 1}},
+		{"SessionSetupReqType", []uint8{1, 1, 1}},
+		{"ServiceDiscoveryReqType", []uint8{1, 2, 1}},
+		{"SessionStopReqType", []uint8{1, 1, 2, 2, 1}},
+	}
+	for _, c := range cases {
+		if got := stateBits(table, c.typ, len(c.want)); !bytes.Equal(got, c.want) {
+			t.Errorf("%s state widths = %v, want %v", c.typ, got, c.want)
+		}
+	}
+}
+
+func TestGrammarTableGoldenVectors(t *testing.T) {
+	table := loadSubsetTable(t)
+	protos := map[string]func() interface{}{
+		"SessionSetupReq":     func() interface{} { return &generated.SessionSetupReq{} },
+		"ServiceDiscoveryReq": func() interface{} { return &generated.ServiceDiscoveryReq{} },
+		"SessionStopReq":      func() interface{} { return &generated.SessionStopReq{} },
+	}
+	for name, proto := range protos {
+		data, err := os.ReadFile(filepath.Join("..", "..", "testvectors", name+".exi"))
+		if err != nil {
+			t.Fatal(err)
+		}
+		got, err := table.DecodeStruct(data, proto())
+		if err != nil {
+			t.Fatalf("%s: table decode: %v", name, err)
+		}
+		want, err := exi.DecodeStruct(data, nil)
+		if err != nil {
+			t.Fatalf("%s: DecodeStruct: %v", name, err)
+		}
+		if !reflect.DeepEqual(got, want) {
+			t.Errorf("%s: table decode = %+v, want %+v", name, got, want)
+		}
+		enc, err := table.EncodeStruct(got)
+		if err != nil {
+			t.Fatalf("%s: table encode: %v", name, err)
+		}
+		if !bytes.Equal(enc, data) {
+			t.Errorf("%s: table encode = %x, want %x", name, enc, data)
+		}
+	}
+}
+
+func TestGrammarTableMatchesHandWrittenOptionals(t *testing.T) {
+	table := loadSubsetTable(t)
+	code, expl := "EV1", "driver stopped"
+	header := generated.MessageHeaderType{SessionID: []byte{1, 2, 3, 4, 5, 6, 7, 8}, TimeStamp: 1700000000}
+	for _, msg := range []*generated.SessionStopReq{
+		{Header: header, ChargingSession: "Pause"},
+		{Header: header, ChargingSession: "ServiceRenegotiation", EVTerminationCode: &code},
+		{Header: header, ChargingSession: "Terminate", EVTerminationExplanation: &expl},
+		{Header: header, ChargingSession: "Terminate", EVTerminationCode: &code, EVTerminationExplanation: &expl},
+	} {
+		want, err := exi.EncodeStruct(msg)
+		if err != nil {
+			t.Fatal(err)
+		}
+		got, err := table.EncodeStruct(msg)
+		if err != nil {
+			t.Fatal(err)
+		}
+		if !bytes.Equal(got, want) {
+			t.Fatalf("%+v: table encode = %x, hand-written = %x", msg, got, want)
+		}
+		back, err := table.DecodeStruct(got, &generated.SessionStopReq{})
+		if err != nil {
+			t.Fatal(err)
+		}
+		if !reflect.DeepEqual(back, msg) {
+			t.Fatalf("round trip = %+v, want %+v", back, msg)
+		}
+	}
+
+	if _, err := table.EncodeStruct(&generated.SessionStopReq{Header: header, ChargingSession: "Abort"}); err == nil {
+		t.Fatal("encoding a value outside the enumeration succeeded")
+	}
+}
+
+// TestGrammarTableStringTable checks that the table path writes the same
+// string-table hits as the hand-written codecs.
+func TestGrammarTableStringTable(t *testing.T) {
+	table := loadSubsetTable(t)
+	same := "EV_TERMINATED"
+	msg := &generated.SessionStopReq{
+		Header:                   generated.MessageHeaderType{SessionID: []byte{1, 2, 3, 4, 5, 6, 7, 8}, TimeStamp: 1},
+		ChargingSession:          "Terminate",
+		EVTerminationCode:        &same,
+		EVTerminationExplanation: &same,
+	}
+	enc := exi.NewEncoder()
+	enc.Strings = exi.NewStringTable(0, 0)
+	want, err := enc.Encode(msg)
+	if err != nil {
+		t.Fatal(err)
+	}
+
+	buf := make([]byte, 64)
+	var bs exi.BitStream
+	bs.Init(buf, 0)
+	bs.UseStringTable(exi.NewStringTable(0, 0))
+	if err := table.Encode(&bs, msg); err != nil {
+		t.Fatal(err)
+	}
+	if got := buf[:bs.Length()]; !bytes.Equal(got, want) {
+		t.Fatalf("table encode = %x, hand-written = %x", got, want)
+	}
+
+	if _, err := table.DecodeStruct(want, &generated.SessionStopReq{}); !errors.Is(err, exi.ErrStringTableHit) {
+		t.Errorf("decode without a string table: err = %v, want ErrStringTableHit", err)
+	}
+	bs.Init(want, 0)
+	bs.UseStringTable(exi.NewStringTable(0, 0))
+	back := &generated.SessionStopReq{}
+	if err := table.Decode(&bs, back); err != nil {
+		t.Fatal(err)
+	}
+	if !reflect.DeepEqual(back, msg) {
+		t.Fatalf("round trip = %+v, want %+v", back, msg)
+	}
+}
+
+func BenchmarkGrammarTableSessionSetupReq(b *testing.B) {
+	table := loadSubsetTable(b)
+	msg := &generated.SessionSetupReq{
+		Header: generated.MessageHeaderType{SessionID: []byte{1, 2, 3, 4, 5, 6, 7, 8}, TimeStamp: 1700000000},
+		EVCCID: []byte("WMIV1234567890ABCDEX"),
+	}
+	data, err := exi.EncodeStruct(msg)
+	if err != nil {
+		b.Fatal(err)
+	}
+	buf := make([]byte, 256)
+
+	b.Run("Table/Encode", func(b *testing.B) {
+		b.ReportAllocs()
+		var bs exi.BitStream
+		for i := 0; i < b.N; i++ {
+			bs.Init(buf, 0)
+			if err := table.Encode(&bs, msg); err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
+	b.Run("HandWritten/Encode", func(b *testing.B) {
+		b.ReportAllocs()
+		e := exi.NewEncoder()
+		for i := 0; i < b.N; i++ {
+			if _, err := e.EncodeInto(buf, msg); err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
+	b.Run("Table/Decode", func(b *testing.B) {
+		b.ReportAllocs()
+		var bs exi.BitStream
+		for i := 0; i < b.N; i++ {
+			bs.Init(data, 0)
+			var out generated.SessionSetupReq
+			if err := table.Decode(&bs, &out); err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
+	b.Run("HandWritten/Decode", func(b *testing.B) {
+		b.ReportAllocs()
+		d := exi.NewDecoder()
+		for i := 0; i < b.N; i++ {
+			if _, err := d.Decode(data); err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
+}
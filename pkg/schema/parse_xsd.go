@@ -24,10 +24,13 @@ import (
 //   - inline (anonymous) complexType under an element is handled by creating
 //     a TypeDefinition named <ElementName>Type and associating it with the
 //     element name.
+//   - <xs:complexContent><xs:extension base="..."> records Base and the
+//     extension's own sequence; the base's fields come first.
+//   - simpleType restriction bases are recorded in Base.
 //
 // Limitations:
-//   - does not support all XSD constructs (choices, attributes, substitution
-//     groups, complexContent/extension, unions, lists, etc.).
+//   - does not support all XSD constructs (choices, substitution groups,
+//     complexContent/restriction, unions, lists, etc.).
 //   - only handles sequence->element children for complex types.
 //   - referenced type names are recorded as-is; no attempt is made to
 //     resolve namespace prefixes to schema files here.
@@ -127,18 +130,20 @@ func ParseSchemas(schemas []*Schema) ([]*TypeDefinition, error) {
 						typeMap[inlineTd.Name] = inlineTd
 						// Also create an element wrapper type referencing inline type
 						elemTd := &TypeDefinition{
-							Name:      name,
-							Namespace: s.Namespace,
-							Docs:      fmt.Sprintf("element -> inline complexType %s", inlineTd.Name),
+							Name:        name,
+							Namespace:   s.Namespace,
+							Docs:        fmt.Sprintf("element -> inline complexType %s", inlineTd.Name),
+							ElementType: inlineTd.Name,
 						}
 						typeMap[name] = elemTd
 						continue
 					}
 					// No inline type: create a TypeDefinition that references typ (if any)
 					td := &TypeDefinition{
-						Name:      name,
-						Namespace: s.Namespace,
-						Docs:      fmt.Sprintf("element references type %s", typ),
+						Name:        name,
+						Namespace:   s.Namespace,
+						Docs:        fmt.Sprintf("element references type %s", typ),
+						ElementType: typ,
 					}
 					typeMap[name] = td
 				default:
@@ -168,6 +173,7 @@ func parseComplexType(decoder *xml.Decoder, start xml.StartElement, s *Schema) (
 		Name:      name,
 		Namespace: s.Namespace,
 		Fields:    nil,
+		IsComplex: true,
 	}
 
 	// Depth-first scan until matching end for complexType
@@ -186,6 +192,10 @@ func parseComplexType(decoder *xml.Decoder, start xml.StartElement, s *Schema) (
 					return nil, err
 				}
 				td.Fields = append(td.Fields, fields...)
+			} else if ln == "complexContent" {
+				// descend; the extension is handled below
+			} else if ln == "extension" {
+				td.Base = getAttr(t.Attr, "base")
 			} else if ln == "attribute" {
 				// parse attribute as field (optional)
 				attrName := getAttr(t.Attr, "name")
@@ -295,7 +305,9 @@ func parseSimpleType(decoder *xml.Decoder, start xml.StartElement, s *Schema) (*
 		switch t := tok.(type) {
 		case xml.StartElement:
 			if localName(t.Name) == "restriction" {
+				td.Base = getAttr(t.Attr, "base")
 				// parse enumeration children until end of restriction
+			restriction:
 				for {
 					rtok, err := decoder.Token()
 					if err != nil {
@@ -320,7 +332,7 @@ func parseSimpleType(decoder *xml.Decoder, start xml.StartElement, s *Schema) (*
 						}
 					case xml.EndElement:
 						if localName(r.Name) == "restriction" {
-							break
+							break restriction
 						}
 					}
 					// continue until restriction end is found in the outer loop
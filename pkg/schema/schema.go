@@ -68,6 +68,15 @@ type TypeDefinition struct {
 	IsEnum     bool    // whether this type is an enumeration
 	EnumValues []string
 	Docs       string // captured documentation/comments (if any)
+
+	// IsComplex is set for xs:complexType declarations.
+	IsComplex bool
+	// Base is the restriction base of a simple type or the extension base
+	// of a complex type (whose Fields then follow the base's fields).
+	Base string
+	// ElementType is set for top-level element declarations and names the
+	// declared (or generated inline) type.
+	ElementType string
 }
 
 // Generator is the interface implemented by components that turn the
@@ -0,0 +1,50 @@
+package generated
+
+// Message is implemented by the pointer types of the top-level ISO 15118-20
+// messages, the structs that can be the document element of a V2G message.
+// It lets exi.DecodeInto take any message without an interface{} argument.
+//
+// This file is maintained by hand and is not overwritten by the generator.
+type Message interface {
+	// MessageName returns the element name, e.g. "SessionSetupReq".
+	MessageName() string
+}
+
+func (*AuthorizationReq) MessageName() string           { return "AuthorizationReq" }
+func (*AuthorizationRes) MessageName() string           { return "AuthorizationRes" }
+func (*AuthorizationSetupReq) MessageName() string      { return "AuthorizationSetupReq" }
+func (*AuthorizationSetupRes) MessageName() string      { return "AuthorizationSetupRes" }
+func (*CLReqControlMode) MessageName() string           { return "CLReqControlMode" }
+func (*CLResControlMode) MessageName() string           { return "CLResControlMode" }
+func (*CertificateInstallationReq) MessageName() string { return "CertificateInstallationReq" }
+func (*CertificateInstallationRes) MessageName() string { return "CertificateInstallationRes" }
+func (*MeteringConfirmationReq) MessageName() string    { return "MeteringConfirmationReq" }
+func (*MeteringConfirmationRes) MessageName() string    { return "MeteringConfirmationRes" }
+func (*PowerDeliveryReq) MessageName() string           { return "PowerDeliveryReq" }
+func (*PowerDeliveryRes) MessageName() string           { return "PowerDeliveryRes" }
+func (*ScheduleExchangeReq) MessageName() string        { return "ScheduleExchangeReq" }
+func (*ScheduleExchangeRes) MessageName() string        { return "ScheduleExchangeRes" }
+func (*ServiceDetailReq) MessageName() string           { return "ServiceDetailReq" }
+func (*ServiceDetailRes) MessageName() string           { return "ServiceDetailRes" }
+func (*ServiceDiscoveryReq) MessageName() string        { return "ServiceDiscoveryReq" }
+func (*ServiceDiscoveryRes) MessageName() string        { return "ServiceDiscoveryRes" }
+func (*ServiceSelectionReq) MessageName() string        { return "ServiceSelectionReq" }
+func (*ServiceSelectionRes) MessageName() string        { return "ServiceSelectionRes" }
+func (*SessionSetupReq) MessageName() string            { return "SessionSetupReq" }
+func (*SessionSetupRes) MessageName() string            { return "SessionSetupRes" }
+func (*SessionStopReq) MessageName() string             { return "SessionStopReq" }
+func (*SessionStopRes) MessageName() string             { return "SessionStopRes" }
+func (*VehicleCheckInReq) MessageName() string          { return "VehicleCheckInReq" }
+func (*VehicleCheckInRes) MessageName() string          { return "VehicleCheckInRes" }
+func (*VehicleCheckOutReq) MessageName() string         { return "VehicleCheckOutReq" }
+func (*VehicleCheckOutRes) MessageName() string         { return "VehicleCheckOutRes" }
+func (*WPT_AlignmentCheckReq) MessageName() string      { return "WPT_AlignmentCheckReq" }
+func (*WPT_AlignmentCheckRes) MessageName() string      { return "WPT_AlignmentCheckRes" }
+func (*WPT_FinePositioningReq) MessageName() string     { return "WPT_FinePositioningReq" }
+func (*WPT_FinePositioningRes) MessageName() string     { return "WPT_FinePositioningRes" }
+func (*WPT_ChargeLoopReq) MessageName() string          { return "WPT_ChargeLoopReq" }
+func (*WPT_ChargeLoopRes) MessageName() string          { return "WPT_ChargeLoopRes" }
+func (*DC_ACDPReq) MessageName() string                 { return "DC_ACDPReq" }
+func (*DC_ACDPRes) MessageName() string                 { return "DC_ACDPRes" }
+func (*DC_ACDP_BPTReq) MessageName() string             { return "DC_ACDP_BPTReq" }
+func (*DC_ACDP_BPTRes) MessageName() string             { return "DC_ACDP_BPTRes" }
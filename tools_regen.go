@@ -9,8 +9,17 @@ import (
 	"strings"
 
 	"example.com/exi-go/pkg/schema"
+	"example.com/exi-go/pkg/v2g/generated"
 )
 
+// codecPrototypes maps the global elements accepted by -codecs to the Go
+// structs their specialized codecs read and write.
+var codecPrototypes = map[string]interface{}{
+	"SessionSetupReq":     &generated.SessionSetupReq{},
+	"ServiceDiscoveryReq": &generated.ServiceDiscoveryReq{},
+	"SessionStopReq":      &generated.SessionStopReq{},
+}
+
 // This small tool regenerates Go types from XSD schemas using the in-repo
 // CodeGenerator. It is intended to be run from the go module directory
 // (exi-go) during development to refresh generated types.
@@ -23,6 +32,9 @@ import (
 //	# regenerate using explicit schema directories and output directory
 //	go run tools_regen.go -schemas ./schemas/switchev,./schemas/tux-evse -out ./pkg/v2g/generated -pkg generated -author "exi-go"
 //
+//	# also emit specialized codecs for some messages into pkg/exi
+//	go run tools_regen.go -codecs SessionSetupReq,SessionStopReq -codecs-out ./pkg/exi -codecs-pkg exi
+//
 // Notes:
 //   - The tool will load all .xsd files found in the provided schema paths
 //     (each schema path may be a file or a directory).
@@ -34,6 +46,9 @@ func main() {
 		pkgName         string
 		author          string
 		force           bool
+		codecs          string
+		codecsOut       string
+		codecsPkg       string
 	)
 
 	flag.StringVar(&schemaPathsFlag, "schemas", "./schemas/switchev", "Comma-separated list of schema files or directories to use")
@@ -41,6 +56,9 @@ func main() {
 	flag.StringVar(&pkgName, "pkg", "generated", "Package name for generated code")
 	flag.StringVar(&author, "author", "exi-go", "Author string to embed in generated headers")
 	flag.BoolVar(&force, "force", false, "Remove output directory before generation")
+	flag.StringVar(&codecs, "codecs", "", "Comma-separated global elements to emit specialized codecs for")
+	flag.StringVar(&codecsOut, "codecs-out", "./pkg/exi", "Output directory for zz_generated_codecs.go")
+	flag.StringVar(&codecsPkg, "codecs-pkg", "exi", "Package name of the specialized codecs file")
 	flag.Parse()
 
 	// Expand the schema path list
@@ -106,5 +124,25 @@ func main() {
 		log.Fatalf("generation failed: %v", err)
 	}
 
+	if codecs != "" {
+		gen.CodecPackage = codecsPkg
+		for _, name := range strings.Split(codecs, ",") {
+			name = strings.TrimSpace(name)
+			proto, ok := codecPrototypes[name]
+			if !ok {
+				log.Fatalf("no Go type registered for codec root %q", name)
+			}
+			gen.CodecTypes = append(gen.CodecTypes, proto)
+		}
+		defs, err := schema.ParseSchemas(schemas)
+		if err != nil {
+			log.Fatalf("failed to parse schemas: %v", err)
+		}
+		log.Printf("generating specialized codecs into %s (package %s)", codecsOut, codecsPkg)
+		if err := gen.WriteCodecs(defs, codecsOut); err != nil {
+			log.Fatalf("codec generation failed: %v", err)
+		}
+	}
+
 	fmt.Printf("Generation completed successfully. Output written to: %s\n", absOut)
 }